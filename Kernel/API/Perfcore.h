@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// This is the binary format of /proc/<pid>/perf_events, /sys/kernel/profile and of the
+// perfcore files written when a profiled process exits.
+//
+// A perfcore starts with a PerfcoreHeader, followed by string_count strings (each a u32
+// byte length followed by that many bytes of UTF-8), followed by event_count event records.
+// Each record is a PerfcoreEvent followed by payload_size bytes of payload (one of the
+// Perfcore*Payload structs below, depending on the event type) and stack_size u64 return
+// addresses, innermost first.
+//
+// Reading /sys/kernel/profile_stream drains the kernel's buffer, and every read returns a
+// perfcore of its own. A profile saved from it is several perfcores back to back, which
+// together hold the events in order. Their string tables are separate.
+//
+// Readers should ignore payload bytes past the end of the payload struct they know about,
+// and treat missing ones as zero, so that payloads can grow without bumping the version.
+
+namespace Kernel {
+
+static constexpr u32 perfcore_magic = 0x46524550; // "PERF"
+static constexpr u32 perfcore_version = 2;
+
+struct [[gnu::packed]] PerfcoreHeader {
+    u32 magic { perfcore_magic };
+    u32 version { perfcore_version };
+    u32 string_count { 0 };
+    u32 dropped_event_count { 0 };
+    u32 event_count { 0 };
+};
+
+struct [[gnu::packed]] PerfcoreEvent {
+    u32 type { 0 }; // One of PERF_EVENT_*.
+    u32 pid { 0 };
+    u32 tid { 0 };
+    u64 timestamp { 0 };
+    u32 lost_samples { 0 };
+    u16 payload_size { 0 };
+    u8 stack_size { 0 };
+};
+
+// PERF_EVENT_MALLOC, PERF_EVENT_FREE, PERF_EVENT_MUNMAP, PERF_EVENT_KMALLOC and PERF_EVENT_KFREE.
+struct [[gnu::packed]] PerfcoreMemoryPayload {
+    u64 ptr { 0 };
+    u64 size { 0 };
+};
+
+struct [[gnu::packed]] PerfcoreMmapPayload {
+    u64 ptr { 0 };
+    u64 size { 0 };
+    u32 name_index { 0 };
+};
+
+// PERF_EVENT_PROCESS_CREATE and PERF_EVENT_PROCESS_EXEC.
+struct [[gnu::packed]] PerfcoreProcessPayload {
+    u32 parent_pid { 0 };
+    u32 executable_index { 0 };
+};
+
+struct [[gnu::packed]] PerfcoreThreadCreatePayload {
+    u32 parent_tid { 0 };
+};
+
+struct [[gnu::packed]] PerfcoreContextSwitchPayload {
+    u32 next_pid { 0 };
+    u32 next_tid { 0 };
+};
+
+struct [[gnu::packed]] PerfcoreSignpostPayload {
+    u64 string_index { 0 };
+    u64 arg { 0 };
+};
+
+// The site is the kernel address the lock was acquired from. Wait times are in the
+// kernel's scheduler time units, see TimeManagement::scheduler_current_time().
+struct [[gnu::packed]] PerfcoreLockContentionPayload {
+    u64 site { 0 };
+    u64 wait_time { 0 };
+    u32 name_index { 0 };
+};
+
+// Why a thread was off the CPU. This mirrors Thread::Blocker::Type, plus Mutex for threads
+// that blocked on a Kernel::Mutex.
+enum class OffCPUReason : u8 {
+    Unknown,
+    File,
+    Futex,
+    Plan9FS,
+    Join,
+    Queue,
+    Routing,
+    Sleep,
+    Signal,
+    Wait,
+    Flock,
+    Mutex,
+};
+
+// The event is emitted when the thread is unblocked, with the stack it blocked on.
+struct [[gnu::packed]] PerfcoreOffCPUPayload {
+    u64 duration_ns { 0 };
+    OffCPUReason reason { OffCPUReason::Unknown };
+};
+
+enum class FilesystemEventType : u8 {
+    Open,
+    Close,
+    Readv,
+    Read,
+    Pread
+};
+
+// Fields that don't apply to the filesystem event type are zero. The fd is the dirfd for Open.
+struct [[gnu::packed]] PerfcoreFilesystemPayload {
+    FilesystemEventType type { FilesystemEventType::Open };
+    u64 duration_ns { 0 };
+    i32 fd { 0 };
+    u32 filename_index { 0 };
+    i32 options { 0 };
+    u64 mode { 0 };
+    u64 buffer_ptr { 0 };
+    u64 size { 0 };
+    i64 offset { 0 };
+};
+
+}
@@ -182,7 +182,7 @@ protected:
     u8 m_virtual_address_bit_width;
 
 private:
-    void* m_processor_specific_data[static_cast<size_t>(ProcessorSpecificDataID::__Count)];
+    void* m_processor_specific_data[static_cast<size_t>(ProcessorSpecificDataID::__Count)] {};
     Thread* m_idle_thread;
     Thread* m_current_thread;
 
@@ -50,6 +50,7 @@
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
+#include <Kernel/Locking/LockContention.h>
 #include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Net/NetworkTask.h>
 #include <Kernel/Net/NetworkingManagement.h>
@@ -302,6 +303,9 @@ extern "C" [[noreturn]] UNMAP_AFTER_INIT NO_SANITIZE_COVERAGE void init([[maybe_
 
     // Initialize TimeManagement before using randomness!
     TimeManagement::initialize(0);
+#if LOCK_CONTENTION_PROFILING
+    lock_contention_profiling_initialize();
+#endif
 
     DeviceManagement::initialize();
     SysFSComponentRegistry::initialize();
@@ -242,7 +242,7 @@ ErrorOr<void> Process::procfs_get_perf_events(KBufferBuilder& builder) const
         dbgln("ProcFS: No perf events for {}", pid());
         return Error::from_errno(ENOBUFS);
     }
-    return perf_events()->to_json(builder);
+    return perf_events()->to_perfcore(builder);
 }
 
 ErrorOr<void> Process::procfs_get_fds_stats(KBufferBuilder& builder) const
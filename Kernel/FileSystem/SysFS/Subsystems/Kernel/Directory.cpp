@@ -7,6 +7,7 @@
 #include <AK/Error.h>
 #include <AK/Try.h>
 #include <Kernel/Boot/CommandLine.h>
+#include <Kernel/Debug.h>
 #include <Kernel/FileSystem/SysFS/Component.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/CPUInfo.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/Directory.h>
@@ -17,12 +18,14 @@
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Interrupts.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Jails.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Keymap.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/LockContention.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Log.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/MemoryStatus.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Network/Directory.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/PowerStateSwitch.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Processes.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Profile.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/ProfileStream.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/RequestPanic.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SystemStatistics.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Uptime.h>
@@ -43,6 +46,10 @@ UNMAP_AFTER_INIT NonnullRefPtr<SysFSGlobalKernelStatsDirectory> SysFSGlobalKerne
         list.append(SysFSKeymap::must_create(*global_kernel_stats_directory));
         list.append(SysFSUptime::must_create(*global_kernel_stats_directory));
         list.append(SysFSProfile::must_create(*global_kernel_stats_directory));
+        list.append(SysFSProfileStream::must_create(*global_kernel_stats_directory));
+#if LOCK_CONTENTION_PROFILING
+        list.append(SysFSLockContention::must_create(*global_kernel_stats_directory));
+#endif
         list.append(SysFSPowerStateSwitchNode::must_create(*global_kernel_stats_directory));
         list.append(SysFSJails::must_create(*global_kernel_stats_directory));
         list.append(SysFSSystemRequestPanic::must_create(*global_kernel_stats_directory));
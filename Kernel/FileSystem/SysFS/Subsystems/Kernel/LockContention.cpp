@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/LockContention.h>
+#include <Kernel/KSyms.h>
+#include <Kernel/Locking/LockContention.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+#if LOCK_CONTENTION_PROFILING
+
+UNMAP_AFTER_INIT SysFSLockContention::SysFSLockContention(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSLockContention> SysFSLockContention::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSLockContention(parent_directory)).release_nonnull();
+}
+
+static ErrorOr<void> add_lock_class(JsonArraySerializer<KBufferBuilder>& array, LockClassStatistics const& statistics)
+{
+    auto obj = TRY(array.add_object());
+    TRY(obj.add("kind"sv, statistics.kind == LockKind::Mutex ? "mutex"sv : "spinlock"sv));
+    TRY(obj.add("name"sv, statistics.name()));
+    TRY(obj.add("rank"sv, static_cast<u32>(statistics.rank)));
+    TRY(obj.add("site"sv, statistics.site));
+    if (auto const* symbol = symbolicate_kernel_address(statistics.site)) {
+        TRY(obj.add("symbol"sv, StringView { symbol->name, strlen(symbol->name) }));
+        TRY(obj.add("symbol_offset"sv, statistics.site - symbol->address));
+    }
+    TRY(obj.add("acquire_count"sv, statistics.acquire_count.load(AK::memory_order_relaxed)));
+    TRY(obj.add("contended_count"sv, statistics.contended_count.load(AK::memory_order_relaxed)));
+    TRY(obj.add("total_wait_time"sv, statistics.total_wait_time.load(AK::memory_order_relaxed)));
+    TRY(obj.add("max_wait_time"sv, statistics.max_wait_time.load(AK::memory_order_relaxed)));
+    TRY(obj.add("total_hold_time"sv, statistics.total_hold_time.load(AK::memory_order_relaxed)));
+    TRY(obj.add("max_hold_time"sv, statistics.max_hold_time.load(AK::memory_order_relaxed)));
+    auto histogram = TRY(obj.add_array("wait_time_histogram"sv));
+    for (auto const& bucket : statistics.wait_time_histogram)
+        TRY(histogram.add(bucket.load(AK::memory_order_relaxed)));
+    TRY(histogram.finish());
+    TRY(obj.finish());
+    return {};
+}
+
+ErrorOr<void> SysFSLockContention::try_generate(KBufferBuilder& builder)
+{
+    auto json = TRY(JsonObjectSerializer<>::try_create(builder));
+    TRY(json.add("overflow_count"sv, lock_class_overflow_count()));
+    auto array = TRY(json.add_array("lock_classes"sv));
+    ErrorOr<void> result;
+    for_each_lock_class([&](LockClassStatistics const& statistics) {
+        if (!result.is_error())
+            result = add_lock_class(array, statistics);
+    });
+    TRY(result);
+    TRY(array.finish());
+    TRY(json.finish());
+    return {};
+}
+
+#endif
+
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/GlobalInformation.h>
+#include <Kernel/Library/KBufferBuilder.h>
+#include <Kernel/Library/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+// Only registered when the kernel is built with LOCK_CONTENTION_PROFILING.
+class SysFSLockContention final : public SysFSGlobalInformation {
+public:
+    virtual StringView name() const override { return "lock_contention"sv; }
+
+    static NonnullRefPtr<SysFSLockContention> must_create(SysFSDirectory const& parent_directory);
+
+private:
+    explicit SysFSLockContention(SysFSDirectory const& parent_directory);
+    virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
+
+    // Lock sites are kernel addresses.
+    virtual mode_t permissions() const override { return S_IRUSR; }
+};
+
+}
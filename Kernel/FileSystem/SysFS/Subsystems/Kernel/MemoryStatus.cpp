@@ -37,6 +37,21 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+
+    auto slabheaps = TRY(json.add_array("kmalloc_slabheaps"sv));
+    for (auto const& slabheap : stats.slabheaps) {
+        auto obj = TRY(slabheaps.add_object());
+        TRY(obj.add("slab_size"sv, slabheap.slab_size));
+        TRY(obj.add("allocated"sv, slabheap.bytes_allocated));
+        TRY(obj.add("available"sv, slabheap.bytes_free));
+        TRY(obj.add("cached"sv, slabheap.bytes_cached));
+        TRY(obj.add("cache_hit_count"sv, slabheap.cache_hit_count));
+        TRY(obj.add("cache_refill_count"sv, slabheap.cache_refill_count));
+        TRY(obj.add("cache_flush_count"sv, slabheap.cache_flush_count));
+        TRY(obj.finish());
+    }
+    TRY(slabheaps.finish());
+
     TRY(json.finish());
     return {};
 }
@@ -24,7 +24,7 @@ ErrorOr<void> SysFSProfile::try_generate(KBufferBuilder& builder)
 {
     if (!g_global_perf_events)
         return ENOENT;
-    TRY(g_global_perf_events->to_json(builder));
+    TRY(g_global_perf_events->to_perfcore(builder));
     return {};
 }
 
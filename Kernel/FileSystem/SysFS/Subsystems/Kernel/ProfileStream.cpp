@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/ProfileStream.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PerformanceEventBuffer.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSProfileStream::SysFSProfileStream(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSProfileStream> SysFSProfileStream::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSProfileStream(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSProfileStream::try_generate(KBufferBuilder& builder)
+{
+    if (!g_global_perf_events)
+        return ENOENT;
+    TRY(g_global_perf_events->drain_to_perfcore(builder));
+    return {};
+}
+
+mode_t SysFSProfileStream::permissions() const
+{
+    return S_IRUSR;
+}
+
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/GlobalInformation.h>
+#include <Kernel/Library/KBufferBuilder.h>
+#include <Kernel/Library/UserOrKernelBuffer.h>
+
+namespace Kernel {
+
+// Unlike SysFSProfile, every read removes the events it returns from the buffer.
+class SysFSProfileStream final : public SysFSGlobalInformation {
+public:
+    virtual StringView name() const override { return "profile_stream"sv; }
+
+    static NonnullRefPtr<SysFSProfileStream> must_create(SysFSDirectory const& parent_directory);
+
+private:
+    virtual mode_t permissions() const override;
+
+    explicit SysFSProfileStream(SysFSDirectory const& parent_directory);
+    virtual ErrorOr<void> try_generate(KBufferBuilder& builder) override;
+};
+
+}
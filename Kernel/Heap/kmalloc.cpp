@@ -10,6 +10,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -127,6 +128,23 @@ private:
     [[gnu::aligned(16)]] u8 m_data[];
 };
 
+// A per-CPU stack of free slabs of a slabheap. Slabs are moved between a magazine and its slabheap
+// in batches, so most allocations and deallocations don't have to take the global kmalloc lock.
+struct KmallocMagazine {
+    static constexpr size_t capacity = 32;
+    static constexpr size_t batch_size = capacity / 2;
+
+    bool is_empty() const { return count == 0; }
+    bool is_full() const { return count == capacity; }
+
+    size_t count { 0 };
+    void* slabs[capacity];
+
+    size_t hit_count { 0 };
+    size_t refill_count { 0 };
+    size_t flush_count { 0 };
+};
+
 class KmallocSlabheap {
 public:
     KmallocSlabheap(size_t slab_size)
@@ -138,21 +156,9 @@ public:
 
     void* allocate(size_t requested_size, [[maybe_unused]] CallerWillInitializeMemory caller_will_initialize_memory)
     {
-        if (m_usable_blocks.is_empty()) {
-            // FIXME: This allocation wastes `block_size` bytes due to the implementation of kmalloc_aligned().
-            //        Handle this with a custom VM+page allocator instead of using kmalloc_aligned().
-            auto* slot = kmalloc_aligned(KmallocSlabBlock::block_size, KmallocSlabBlock::block_size);
-            if (!slot) {
-                dbgln_if(KMALLOC_DEBUG, "OOM while growing slabheap ({})", m_slab_size);
-                return nullptr;
-            }
-            auto* block = new (slot) KmallocSlabBlock(m_slab_size);
-            m_usable_blocks.append(*block);
-        }
-        auto* block = m_usable_blocks.first();
-        auto* ptr = block->allocate(requested_size);
-        if (block->is_full())
-            m_full_blocks.append(*block);
+        auto* ptr = allocate_slab(requested_size);
+        if (!ptr)
+            return nullptr;
 
 #ifndef HAS_ADDRESS_SANITIZER
         if (caller_will_initialize_memory == CallerWillInitializeMemory::No) {
@@ -167,12 +173,27 @@ public:
 #ifndef HAS_ADDRESS_SANITIZER
         memset(ptr, KFREE_SCRUB_BYTE, m_slab_size);
 #endif
+        deallocate_slab(ptr);
+    }
 
-        auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
-        bool block_was_full = block->is_full();
-        block->deallocate(ptr);
-        if (block_was_full)
-            m_usable_blocks.append(*block);
+    // NOTE: Slabs are scrubbed by kfree() before they go into a magazine, and by kmalloc() when they're handed out,
+    //       so they're not scrubbed when moving between a magazine and its slabheap.
+    void fill_magazine(KmallocMagazine& magazine)
+    {
+        ++magazine.refill_count;
+        while (magazine.count < KmallocMagazine::batch_size) {
+            auto* ptr = allocate_slab(m_slab_size);
+            if (!ptr)
+                return;
+            magazine.slabs[magazine.count++] = ptr;
+        }
+    }
+
+    void flush_magazine(KmallocMagazine& magazine, size_t slab_count)
+    {
+        ++magazine.flush_count;
+        for (size_t i = 0; i < slab_count && !magazine.is_empty(); ++i)
+            deallocate_slab(magazine.slabs[--magazine.count]);
     }
 
     size_t allocated_bytes() const
@@ -217,12 +238,43 @@ public:
     }
 
 private:
+    void* allocate_slab(size_t requested_size)
+    {
+        if (m_usable_blocks.is_empty()) {
+            // FIXME: This allocation wastes `block_size` bytes due to the implementation of kmalloc_aligned().
+            //        Handle this with a custom VM+page allocator instead of using kmalloc_aligned().
+            auto* slot = kmalloc_aligned(KmallocSlabBlock::block_size, KmallocSlabBlock::block_size);
+            if (!slot) {
+                dbgln_if(KMALLOC_DEBUG, "OOM while growing slabheap ({})", m_slab_size);
+                return nullptr;
+            }
+            auto* block = new (slot) KmallocSlabBlock(m_slab_size);
+            m_usable_blocks.append(*block);
+        }
+        auto* block = m_usable_blocks.first();
+        auto* ptr = block->allocate(requested_size);
+        if (block->is_full())
+            m_full_blocks.append(*block);
+        return ptr;
+    }
+
+    void deallocate_slab(void* ptr)
+    {
+        auto* block = (KmallocSlabBlock*)((FlatPtr)ptr & KmallocSlabBlock::block_mask);
+        bool block_was_full = block->is_full();
+        block->deallocate(ptr);
+        if (block_was_full)
+            m_usable_blocks.append(*block);
+    }
+
     size_t m_slab_size { 0 };
 
     KmallocSlabBlock::List m_usable_blocks;
     KmallocSlabBlock::List m_full_blocks;
 };
 
+static void flush_current_processor_magazines();
+
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
 
@@ -257,6 +309,8 @@ struct KmallocGlobalData {
         if (size <= KmallocSlabBlock::block_size * 2 + sizeof(ptrdiff_t) + sizeof(size_t)) {
             // FIXME: We should propagate a freed pointer, to find the specific subheap it belonged to
             //        This would save us iterating over them in the next step and remove a recursion
+            // NOTE: Slabs cached by other processors can't be returned from here, so they keep their blocks alive.
+            flush_current_processor_magazines();
             bool did_purge = false;
             for (auto& slabheap : slabheaps) {
                 if (slabheap.try_purge()) {
@@ -412,7 +466,7 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    KmallocSlabheap slabheaps[KMALLOC_SLABHEAP_COUNT] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -425,6 +479,84 @@ static size_t g_kfree_call_count;
 static size_t g_nested_kfree_calls;
 bool g_dump_kmalloc_stacks;
 
+// NOTE: The per-processor data is only ever touched by its own processor with interrupts disabled,
+//       so it needs no locking. Other processors only read it to report statistics.
+struct KmallocProcessorData {
+    static ProcessorSpecificDataID processor_specific_data_id() { return ProcessorSpecificDataID::Kmalloc; }
+
+    static KmallocProcessorData* current()
+    {
+        VERIFY(!Processor::are_interrupts_enabled());
+        if (!Processor::is_initialized())
+            return nullptr;
+        return Processor::current().get_specific<KmallocProcessorData>();
+    }
+
+    void* allocate(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
+    {
+        for (size_t i = 0; i < KMALLOC_SLABHEAP_COUNT; ++i) {
+            auto& slabheap = g_kmalloc_global->slabheaps[i];
+            if (size > slabheap.slab_size() || alignment > slabheap.slab_size())
+                continue;
+
+            auto& magazine = magazines[i];
+            if (magazine.is_empty()) {
+                SpinlockLocker lock(s_lock);
+                slabheap.fill_magazine(magazine);
+                if (magazine.is_empty())
+                    return nullptr;
+            } else {
+                ++magazine.hit_count;
+            }
+
+            auto* ptr = magazine.slabs[--magazine.count];
+            if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+                memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+            return ptr;
+        }
+        return nullptr;
+    }
+
+    bool deallocate(void* ptr, size_t size)
+    {
+        for (size_t i = 0; i < KMALLOC_SLABHEAP_COUNT; ++i) {
+            auto& slabheap = g_kmalloc_global->slabheaps[i];
+            if (size > slabheap.slab_size())
+                continue;
+
+            auto& magazine = magazines[i];
+            if (magazine.is_full()) {
+                SpinlockLocker lock(s_lock);
+                slabheap.flush_magazine(magazine, KmallocMagazine::batch_size);
+            }
+
+            memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+            magazine.slabs[magazine.count++] = ptr;
+            return true;
+        }
+        return false;
+    }
+
+    void flush_magazines()
+    {
+        for (size_t i = 0; i < KMALLOC_SLABHEAP_COUNT; ++i)
+            g_kmalloc_global->slabheaps[i].flush_magazine(magazines[i], KmallocMagazine::capacity);
+    }
+
+    KmallocMagazine magazines[KMALLOC_SLABHEAP_COUNT];
+
+    size_t kmalloc_call_count { 0 };
+    size_t kfree_call_count { 0 };
+    size_t nested_kfree_calls { 0 };
+};
+
+static void flush_current_processor_magazines()
+{
+    VERIFY(s_lock.is_locked());
+    if (auto* processor_data = KmallocProcessorData::current())
+        processor_data->flush_magazines();
+}
+
 void kmalloc_enable_expand()
 {
     g_kmalloc_global->enable_expansion();
@@ -439,6 +571,14 @@ UNMAP_AFTER_INIT void kmalloc_init()
     s_lock.initialize();
 }
 
+// NOTE: The magazines are disabled when building with KASAN, since it tracks every slab handed out by the slabheaps.
+UNMAP_AFTER_INIT void kmalloc_init_processor_caches()
+{
+#ifndef HAS_ADDRESS_SANITIZER
+    ProcessorSpecific<KmallocProcessorData>::initialize();
+#endif
+}
+
 static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
 {
     // Catch bad callers allocating under spinlock.
@@ -449,15 +589,27 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    SpinlockLocker lock(s_lock);
-    ++g_kmalloc_call_count;
+    InterruptDisabler disabler;
+    auto* processor_data = KmallocProcessorData::current();
 
     if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
+        SpinlockLocker lock(s_lock);
         dbgln("kmalloc({})", size);
         Kernel::dump_backtrace();
     }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    void* ptr = nullptr;
+    if (processor_data) {
+        ++processor_data->kmalloc_call_count;
+        ptr = processor_data->allocate(size, alignment, caller_will_initialize_memory);
+    }
+
+    if (!ptr) {
+        SpinlockLocker lock(s_lock);
+        if (!processor_data)
+            ++g_kmalloc_call_count;
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -488,6 +640,17 @@ void* kcalloc(size_t count, size_t size)
     return ptr;
 }
 
+static void add_kfree_perf_event(void* ptr)
+{
+    Thread* current_thread = Thread::current();
+    if (!current_thread)
+        current_thread = Processor::idle_thread();
+    if (current_thread) {
+        VERIFY(current_thread->is_allocation_enabled());
+        PerformanceManager::add_kfree_perf_event(*current_thread, 0, (FlatPtr)ptr);
+    }
+}
+
 void kfree_sized(void* ptr, size_t size)
 {
     if (!ptr)
@@ -500,22 +663,31 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
-    SpinlockLocker lock(s_lock);
-    ++g_kfree_call_count;
-    ++g_nested_kfree_calls;
-
-    if (g_nested_kfree_calls == 1) {
-        Thread* current_thread = Thread::current();
-        if (!current_thread)
-            current_thread = Processor::idle_thread();
-        if (current_thread) {
-            VERIFY(current_thread->is_allocation_enabled());
-            PerformanceManager::add_kfree_perf_event(*current_thread, 0, (FlatPtr)ptr);
-        }
+    InterruptDisabler disabler;
+    auto* processor_data = KmallocProcessorData::current();
+
+    if (!processor_data) {
+        SpinlockLocker lock(s_lock);
+        ++g_kfree_call_count;
+        ++g_nested_kfree_calls;
+        if (g_nested_kfree_calls == 1)
+            add_kfree_perf_event(ptr);
+        g_kmalloc_global->deallocate(ptr, size);
+        --g_nested_kfree_calls;
+        return;
     }
 
-    g_kmalloc_global->deallocate(ptr, size);
-    --g_nested_kfree_calls;
+    ++processor_data->kfree_call_count;
+    ++processor_data->nested_kfree_calls;
+    if (processor_data->nested_kfree_calls == 1)
+        add_kfree_perf_event(ptr);
+
+    VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+    if (!processor_data->deallocate(ptr, size)) {
+        SpinlockLocker lock(s_lock);
+        g_kmalloc_global->deallocate(ptr, size);
+    }
+    --processor_data->nested_kfree_calls;
 }
 
 size_t kmalloc_good_size(size_t size)
@@ -604,4 +776,44 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     stats.bytes_free = g_kmalloc_global->free_bytes();
     stats.kmalloc_call_count = g_kmalloc_call_count;
     stats.kfree_call_count = g_kfree_call_count;
+
+    for (size_t i = 0; i < KMALLOC_SLABHEAP_COUNT; ++i) {
+        auto const& slabheap = g_kmalloc_global->slabheaps[i];
+        stats.slabheaps[i] = {
+            .slab_size = slabheap.slab_size(),
+            .bytes_allocated = slabheap.allocated_bytes(),
+            .bytes_free = slabheap.free_bytes(),
+            .bytes_cached = 0,
+            .cache_hit_count = 0,
+            .cache_refill_count = 0,
+            .cache_flush_count = 0,
+        };
+    }
+
+    // NOTE: The counters of other processors may change while we read them, which is fine for statistics.
+    Processor::for_each([&](Processor& processor) {
+        auto const* processor_data = processor.get_specific<KmallocProcessorData>();
+        if (!processor_data)
+            return;
+
+        stats.kmalloc_call_count += processor_data->kmalloc_call_count;
+        stats.kfree_call_count += processor_data->kfree_call_count;
+
+        for (size_t i = 0; i < KMALLOC_SLABHEAP_COUNT; ++i) {
+            auto const& magazine = processor_data->magazines[i];
+            auto& slabheap_stats = stats.slabheaps[i];
+            slabheap_stats.bytes_cached += magazine.count * slabheap_stats.slab_size;
+            slabheap_stats.cache_hit_count += magazine.hit_count;
+            slabheap_stats.cache_refill_count += magazine.refill_count;
+            slabheap_stats.cache_flush_count += magazine.flush_count;
+        }
+    });
+
+    // Slabs cached in magazines are free as far as the rest of the kernel is concerned.
+    for (auto& slabheap_stats : stats.slabheaps) {
+        slabheap_stats.bytes_allocated -= slabheap_stats.bytes_cached;
+        slabheap_stats.bytes_free += slabheap_stats.bytes_cached;
+        stats.bytes_allocated -= slabheap_stats.bytes_cached;
+        stats.bytes_free += slabheap_stats.bytes_cached;
+    }
 }
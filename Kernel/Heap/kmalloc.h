@@ -47,11 +47,26 @@ void kmalloc_init();
 
 void kfree_sized(void*, size_t);
 
+void kmalloc_init_processor_caches();
+
+static constexpr size_t KMALLOC_SLABHEAP_COUNT = 6;
+
+struct kmalloc_slabheap_stats {
+    size_t slab_size;
+    size_t bytes_allocated;
+    size_t bytes_free;
+    size_t bytes_cached;
+    size_t cache_hit_count;
+    size_t cache_refill_count;
+    size_t cache_flush_count;
+};
+
 struct kmalloc_stats {
     size_t bytes_allocated;
     size_t bytes_free;
     size_t kmalloc_call_count;
     size_t kfree_call_count;
+    kmalloc_slabheap_stats slabheaps[KMALLOC_SLABHEAP_COUNT];
 };
 void get_kmalloc_stats(kmalloc_stats&);
 
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/HashFunctions.h>
+#include <AK/StringHash.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Locking/LockContention.h>
+#include <Kernel/Time/TimeManagement.h>
+
+#if LOCK_CONTENTION_PROFILING
+
+namespace Kernel {
+
+// This is used from within Spinlock::lock(), so it can neither allocate nor take any locks.
+static constexpr size_t lock_class_table_size = 1024;
+static LockClassStatistics s_lock_classes[lock_class_table_size];
+
+static Atomic<bool> s_enabled { false };
+static Atomic<u64> s_overflow_count { 0 };
+
+void lock_contention_profiling_initialize()
+{
+    // TimeManagement::scheduler_current_time() can't be used before TimeManagement is initialized.
+    VERIFY(TimeManagement::is_initialized());
+    s_enabled.store(true, AK::memory_order_release);
+}
+
+ReadonlySpan<LockClassStatistics> lock_class_statistics_table()
+{
+    return { s_lock_classes, lock_class_table_size };
+}
+
+u64 lock_class_overflow_count()
+{
+    return s_overflow_count.load(AK::memory_order_relaxed);
+}
+
+static bool lock_class_matches(LockClassStatistics const& statistics, LockKind kind, LockRank rank, StringView name, FlatPtr site)
+{
+    return statistics.site == site && statistics.kind == kind && statistics.rank == rank && statistics.name() == name;
+}
+
+static LockClassStatistics* find_or_claim_lock_class(LockKind kind, LockRank rank, StringView name, FlatPtr site)
+{
+    name = name.substring_view(0, min(name.length(), sizeof(LockClassStatistics::name_buffer)));
+
+    auto hash = pair_int_hash(ptr_hash(site), string_hash(name.characters_without_null_termination(), name.length(), to_underlying(rank)));
+    for (size_t probe = 0; probe < lock_class_table_size; ++probe) {
+        auto& statistics = s_lock_classes[(hash + probe) % lock_class_table_size];
+
+        auto state = statistics.state.load(AK::memory_order_acquire);
+        if (state == LockClassStatistics::State::Unused) {
+            if (statistics.state.compare_exchange_strong(state, LockClassStatistics::State::Claimed, AK::memory_order_acq_rel)) {
+                statistics.kind = kind;
+                statistics.rank = rank;
+                statistics.site = site;
+                memcpy(statistics.name_buffer, name.characters_without_null_termination(), name.length());
+                statistics.name_length = name.length();
+                statistics.state.store(LockClassStatistics::State::Ready, AK::memory_order_release);
+                return &statistics;
+            }
+        }
+
+        // Another processor is filling in this entry, it might be the one we're looking for.
+        while (state == LockClassStatistics::State::Claimed) {
+            Processor::pause();
+            state = statistics.state.load(AK::memory_order_acquire);
+        }
+
+        if (lock_class_matches(statistics, kind, rank, name, site))
+            return &statistics;
+    }
+
+    s_overflow_count.fetch_add(1, AK::memory_order_relaxed);
+    return nullptr;
+}
+
+static void update_maximum(Atomic<u64>& maximum, u64 value)
+{
+    auto current = maximum.load(AK::memory_order_relaxed);
+    while (value > current && !maximum.compare_exchange_strong(current, value, AK::memory_order_relaxed))
+        ;
+}
+
+LockContentionTracker::LockContentionTracker(LockKind kind, LockRank rank, StringView name, FlatPtr site)
+{
+    if (s_enabled.load(AK::memory_order_relaxed))
+        m_statistics = find_or_claim_lock_class(kind, rank, name, site);
+}
+
+void LockContentionTracker::start_waiting()
+{
+    m_waited = true;
+    m_wait_start_time = TimeManagement::scheduler_current_time();
+}
+
+u64 LockContentionTracker::did_acquire()
+{
+    if (!m_statistics)
+        return 0;
+
+    m_acquire_time = TimeManagement::scheduler_current_time();
+    m_statistics->acquire_count.fetch_add(1, AK::memory_order_relaxed);
+    if (!m_waited)
+        return 0;
+
+    auto wait_time = m_acquire_time - m_wait_start_time;
+    m_statistics->contended_count.fetch_add(1, AK::memory_order_relaxed);
+    m_statistics->total_wait_time.fetch_add(wait_time, AK::memory_order_relaxed);
+    update_maximum(m_statistics->max_wait_time, wait_time);
+
+    size_t bucket = wait_time == 0 ? 0 : count_required_bits(wait_time) - 1;
+    m_statistics->wait_time_histogram[min(bucket, LockClassStatistics::wait_time_histogram_size - 1)].fetch_add(1, AK::memory_order_relaxed);
+    return wait_time;
+}
+
+void LockContentionTracker::did_release()
+{
+    if (!m_statistics)
+        return;
+
+    auto hold_time = TimeManagement::scheduler_current_time() - m_acquire_time;
+    m_statistics->total_hold_time.fetch_add(hold_time, AK::memory_order_relaxed);
+    update_maximum(m_statistics->max_hold_time, hold_time);
+}
+
+}
+
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Span.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <Kernel/Debug.h>
+#include <Kernel/Locking/LockRank.h>
+
+// When LOCK_CONTENTION_PROFILING is enabled, every Mutex and Spinlock acquisition is
+// accounted to its lock class: the kind of lock, its name (for Mutexes) or rank (for
+// Spinlocks), and the address it was acquired from. The statistics are exposed in
+// /sys/kernel/lock_contention, and a PERF_EVENT_LOCK_CONTENTION is emitted whenever a
+// thread had to block on a Mutex.
+//
+// All times are in TimeManagement::scheduler_current_time() units.
+
+// Locks use __builtin_return_address(0) in their lock() as the acquisition site, which is
+// only the code that takes the lock if lock() is not inlined into it.
+#if LOCK_CONTENTION_PROFILING
+#    define LOCK_CONTENTION_SITE NEVER_INLINE
+#else
+#    define LOCK_CONTENTION_SITE
+#endif
+
+namespace Kernel {
+
+enum class LockKind : u8 {
+    Mutex,
+    Spinlock,
+};
+
+#if LOCK_CONTENTION_PROFILING
+
+struct LockClassStatistics {
+    // Bucket i counts the contended acquisitions that waited for [2^i, 2^(i + 1)) time units.
+    static constexpr size_t wait_time_histogram_size = 32;
+
+    enum class State : u8 {
+        Unused,
+        Claimed,
+        Ready,
+    };
+
+    bool is_ready() const { return state.load(AK::memory_order_acquire) == State::Ready; }
+    StringView name() const { return { name_buffer, name_length }; }
+
+    Atomic<State> state { State::Unused };
+    LockKind kind { LockKind::Mutex };
+    LockRank rank { LockRank::None };
+    FlatPtr site { 0 };
+
+    // Mutex names aren't guaranteed to outlive the Mutex, so we keep a (truncated) copy.
+    char name_buffer[32] {};
+    size_t name_length { 0 };
+
+    Atomic<u64> acquire_count { 0 };
+    Atomic<u64> contended_count { 0 };
+    Atomic<u64> total_wait_time { 0 };
+    Atomic<u64> max_wait_time { 0 };
+    Atomic<u64> total_hold_time { 0 };
+    Atomic<u64> max_hold_time { 0 };
+    Atomic<u64> wait_time_histogram[wait_time_histogram_size] {};
+};
+
+// Tracks a single acquisition of a lock. Locks keep the tracker of their current holder
+// around, so its hold time can be accounted when the lock is released.
+class LockContentionTracker {
+public:
+    LockContentionTracker() = default;
+    LockContentionTracker(LockKind, LockRank, StringView name, FlatPtr site);
+
+    // Must be called every time the lock couldn't be acquired right away.
+    void will_wait()
+    {
+        if (m_statistics && !m_waited)
+            start_waiting();
+    }
+
+    // Returns how long we had to wait for the lock.
+    u64 did_acquire();
+    void did_release();
+
+    FlatPtr site() const { return m_statistics ? m_statistics->site : 0; }
+
+private:
+    void start_waiting();
+
+    LockClassStatistics* m_statistics { nullptr };
+    u64 m_wait_start_time { 0 };
+    u64 m_acquire_time { 0 };
+    bool m_waited { false };
+};
+
+void lock_contention_profiling_initialize();
+
+ReadonlySpan<LockClassStatistics> lock_class_statistics_table();
+
+// The number of acquisitions that weren't accounted because the table was full.
+u64 lock_class_overflow_count();
+
+template<typename Callback>
+void for_each_lock_class(Callback callback)
+{
+    for (auto const& statistics : lock_class_statistics_table()) {
+        if (statistics.is_ready())
+            callback(statistics);
+    }
+}
+
+#endif
+
+}
@@ -5,12 +5,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <AK/SetOnce.h>
 #include <Kernel/Debug.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Locking/LockLocation.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Thread.h>
 
 extern SetOnce g_not_in_early_boot;
@@ -30,6 +32,12 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
     VERIFY(mode != Mode::Unlocked);
     auto* current_thread = Thread::current();
 
+#if LOCK_CONTENTION_PROFILING
+    LockContentionTracker contention_tracker { LockKind::Mutex, LockRank::None, m_name, bit_cast<FlatPtr>(__builtin_return_address(0)) };
+    // NOTE: This is declared before the SpinlockLocker, so it runs after m_lock has been released.
+    ScopeGuard account_contention = [&] { did_acquire_for_contention_profiling(contention_tracker, mode, 1); };
+#endif
+
     SpinlockLocker lock(m_lock);
     bool did_block = false;
     Mode current_mode = m_mode;
@@ -61,6 +69,9 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
     case Mode::Exclusive: {
         VERIFY(m_holder);
         if (m_holder != bit_cast<uintptr_t>(current_thread)) {
+#if LOCK_CONTENTION_PROFILING
+            contention_tracker.will_wait();
+#endif
             block(*current_thread, mode, lock, 1);
             did_block = true;
             // If we blocked then m_mode should have been updated to what we requested
@@ -107,6 +118,9 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
             // and is asking to upgrade the lock to be exclusive without first releasing the shared lock. We have no
             // allocation-free way to detect such a scenario, so if you suspect that this is the cause of your deadlock,
             // try turning on LOCK_SHARED_UPGRADE_DEBUG.
+#if LOCK_CONTENTION_PROFILING
+            contention_tracker.will_wait();
+#endif
             block(*current_thread, mode, lock, 1);
             did_block = true;
             VERIFY(m_mode == mode);
@@ -203,6 +217,11 @@ void Mutex::unlock()
     if (m_times_locked == 0) {
         VERIFY(current_mode == Mode::Exclusive ? !m_holder : m_shared_holders == 0);
 
+#if LOCK_CONTENTION_PROFILING
+        m_contention_tracker.did_release();
+        m_contention_tracker = {};
+#endif
+
         m_mode = Mode::Unlocked;
         unblock_waiters(current_mode);
     }
@@ -313,6 +332,10 @@ auto Mutex::force_unlock_exclusive_if_locked(u32& lock_count_to_restore) -> Mode
         VERIFY(m_times_locked > 0);
         lock_count_to_restore = m_times_locked;
         m_times_locked = 0;
+#if LOCK_CONTENTION_PROFILING
+        m_contention_tracker.did_release();
+        m_contention_tracker = {};
+#endif
         m_mode = Mode::Unlocked;
         unblock_waiters(Mode::Exclusive);
         break;
@@ -335,9 +358,16 @@ void Mutex::restore_exclusive_lock(u32 lock_count, [[maybe_unused]] LockLocation
 
     auto* current_thread = Thread::current();
     bool did_block = false;
+#if LOCK_CONTENTION_PROFILING
+    LockContentionTracker contention_tracker { LockKind::Mutex, LockRank::None, m_name, bit_cast<FlatPtr>(__builtin_return_address(0)) };
+    ScopeGuard account_contention = [&] { did_acquire_for_contention_profiling(contention_tracker, Mode::Exclusive, lock_count); };
+#endif
     SpinlockLocker lock(m_lock);
     [[maybe_unused]] auto previous_mode = m_mode;
     if (m_mode == Mode::Exclusive && m_holder != bit_cast<uintptr_t>(current_thread)) {
+#if LOCK_CONTENTION_PROFILING
+        contention_tracker.will_wait();
+#endif
         block(*current_thread, Mode::Exclusive, lock, lock_count);
         did_block = true;
         // If we blocked then m_mode should have been updated to what we requested
@@ -371,4 +401,20 @@ void Mutex::restore_exclusive_lock(u32 lock_count, [[maybe_unused]] LockLocation
 #endif
 }
 
+#if LOCK_CONTENTION_PROFILING
+void Mutex::did_acquire_for_contention_profiling(LockContentionTracker& contention_tracker, Mode mode, u32 lock_count)
+{
+    auto wait_time = contention_tracker.did_acquire();
+
+    // If we just became the exclusive holder, nobody else will touch m_contention_tracker until we release the lock.
+    if (mode == Mode::Exclusive && m_times_locked == lock_count)
+        m_contention_tracker = contention_tracker;
+
+    if (wait_time == 0)
+        return;
+    if (auto* current_thread = Thread::current())
+        PerformanceManager::add_lock_contention_perf_event(*current_thread, m_name, contention_tracker.site(), wait_time);
+}
+#endif
+
 }
@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <AK/Types.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Locking/LockContention.h>
 #include <Kernel/Locking/LockLocation.h>
 #include <Kernel/Locking/LockMode.h>
 #include <Kernel/Tasks/WaitQueue.h>
@@ -125,6 +126,13 @@ private:
 #if LOCK_SHARED_UPGRADE_DEBUG
     HashMap<uintptr_t, u32> m_shared_holders_map;
 #endif
+
+#if LOCK_CONTENTION_PROFILING
+    void did_acquire_for_contention_profiling(LockContentionTracker&, Mode, u32 lock_count);
+
+    // Only tracks the hold time of exclusive locks, as shared locks don't have a single holder.
+    LockContentionTracker m_contention_tracker;
+#endif
 };
 
 class MutexLocker {
@@ -9,6 +9,7 @@
 #include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/Processor.h>
+#include <Kernel/Locking/LockContention.h>
 #include <Kernel/Locking/LockRank.h>
 
 namespace Kernel {
@@ -21,13 +22,23 @@ class Spinlock {
 public:
     Spinlock() = default;
 
-    InterruptsState lock()
+    LOCK_CONTENTION_SITE InterruptsState lock()
     {
         InterruptsState previous_interrupts_state = Processor::interrupts_state();
         Processor::enter_critical();
         Processor::disable_interrupts();
+#if LOCK_CONTENTION_PROFILING
+        LockContentionTracker contention_tracker { LockKind::Spinlock, m_rank, {}, bit_cast<FlatPtr>(__builtin_return_address(0)) };
+        while (m_lock.exchange(1, AK::memory_order_acquire) != 0) {
+            contention_tracker.will_wait();
+            Processor::wait_check();
+        }
+        contention_tracker.did_acquire();
+        m_contention_tracker = contention_tracker;
+#else
         while (m_lock.exchange(1, AK::memory_order_acquire) != 0)
             Processor::wait_check();
+#endif
         track_lock_acquire(m_rank);
         return previous_interrupts_state;
     }
@@ -36,6 +47,9 @@ public:
     {
         VERIFY(is_locked());
         track_lock_release(m_rank);
+#if LOCK_CONTENTION_PROFILING
+        m_contention_tracker.did_release();
+#endif
         m_lock.store(0, AK::memory_order_release);
 
         Processor::leave_critical();
@@ -55,6 +69,9 @@ public:
 private:
     Atomic<u8> m_lock { 0 };
     static constexpr LockRank const m_rank { Rank };
+#if LOCK_CONTENTION_PROFILING
+    LockContentionTracker m_contention_tracker;
+#endif
 };
 
 template<LockRank Rank>
@@ -65,7 +82,7 @@ class RecursiveSpinlock {
 public:
     RecursiveSpinlock() = default;
 
-    InterruptsState lock()
+    LOCK_CONTENTION_SITE InterruptsState lock()
     {
         InterruptsState previous_interrupts_state = Processor::interrupts_state();
         Processor::disable_interrupts();
@@ -73,14 +90,25 @@ public:
         auto& proc = Processor::current();
         FlatPtr cpu = FlatPtr(&proc);
         FlatPtr expected = 0;
+#if LOCK_CONTENTION_PROFILING
+        LockContentionTracker contention_tracker { LockKind::Spinlock, m_rank, {}, bit_cast<FlatPtr>(__builtin_return_address(0)) };
+#endif
         while (!m_lock.compare_exchange_strong(expected, cpu, AK::memory_order_acq_rel)) {
             if (expected == cpu)
                 break;
+#if LOCK_CONTENTION_PROFILING
+            contention_tracker.will_wait();
+#endif
             Processor::wait_check();
             expected = 0;
         }
-        if (m_recursions == 0)
+        if (m_recursions == 0) {
             track_lock_acquire(m_rank);
+#if LOCK_CONTENTION_PROFILING
+            contention_tracker.did_acquire();
+            m_contention_tracker = contention_tracker;
+#endif
+        }
         m_recursions++;
         return previous_interrupts_state;
     }
@@ -92,6 +120,9 @@ public:
         VERIFY(m_lock.load(AK::memory_order_relaxed) == FlatPtr(&Processor::current()));
         if (--m_recursions == 0) {
             track_lock_release(m_rank);
+#if LOCK_CONTENTION_PROFILING
+            m_contention_tracker.did_release();
+#endif
             m_lock.store(0, AK::memory_order_release);
         }
 
@@ -118,6 +149,9 @@ private:
     Atomic<FlatPtr> m_lock { 0 };
     u32 m_recursions { 0 };
     static constexpr LockRank const m_rank { Rank };
+#if LOCK_CONTENTION_PROFILING
+    LockContentionTracker m_contention_tracker;
+#endif
 };
 
 template<typename LockType>
@@ -128,7 +162,7 @@ public:
     SpinlockLocker() = delete;
     SpinlockLocker& operator=(SpinlockLocker&&) = delete;
 
-    SpinlockLocker(LockType& lock)
+    ALWAYS_INLINE SpinlockLocker(LockType& lock)
         : m_lock(&lock)
     {
         VERIFY(m_lock);
@@ -929,6 +929,7 @@ UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     dmesgln("Initialize MMU");
     ProcessorSpecific<MemoryManagerData>::initialize();
+    kmalloc_init_processor_caches();
 
     if (cpu == 0) {
         new MemoryManager;
@@ -38,7 +38,9 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         if (g_global_perf_events) {
             g_global_perf_events->clear();
         } else {
-            g_global_perf_events = PerformanceEventBuffer::try_create_with_size(32 * MiB).leak_ptr();
+            // Every processor gets a ring of its own, so that they don't contend for slots.
+            auto processor_count = Processor::count();
+            g_global_perf_events = PerformanceEventBuffer::try_create_with_size(max(32 * MiB, processor_count * 4 * MiB), processor_count).leak_ptr();
             if (!g_global_perf_events) {
                 g_profiling_event_mask = 0;
                 return ENOMEM;
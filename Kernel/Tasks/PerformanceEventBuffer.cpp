@@ -5,8 +5,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/JsonArraySerializer.h>
-#include <AK/JsonObjectSerializer.h>
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StackUnwinder.h>
 #include <Kernel/Arch/RegisterState.h>
@@ -19,9 +20,17 @@
 
 namespace Kernel {
 
-PerformanceEventBuffer::PerformanceEventBuffer(NonnullOwnPtr<KBuffer> buffer)
+PerformanceEventBuffer::PerformanceEventBuffer(NonnullOwnPtr<KBuffer> buffer, size_t ring_count)
     : m_buffer(move(buffer))
 {
+    auto* rings = reinterpret_cast<Ring*>(m_buffer->data());
+    auto slot_count = (m_buffer->size() - ring_count * sizeof(Ring)) / sizeof(PerformanceEvent);
+    for (size_t i = 0; i < ring_count; ++i) {
+        auto* ring = new (&rings[i]) Ring;
+        ring->capacity = slot_count / ring_count;
+        ring->first_slot = i * ring->capacity;
+    }
+    m_rings = { rings, ring_count };
 }
 
 NEVER_INLINE ErrorOr<void> PerformanceEventBuffer::append(int type, FlatPtr arg1, FlatPtr arg2, StringView arg3, Thread* current_thread, FilesystemEvent filesystem_event)
@@ -84,12 +93,15 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
 ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, ThreadID tid,
     FlatPtr ip, FlatPtr bp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FilesystemEvent filesystem_event)
 {
-    if (count() >= capacity())
-        return ENOBUFS;
-
     if ((g_profiling_event_mask & type) == 0)
         return EINVAL;
 
+    auto& ring = current_ring();
+    if (ring.head.load(AK::memory_order_relaxed) - ring.tail.load(AK::memory_order_relaxed) >= ring.capacity) {
+        m_dropped_event_count.fetch_add(1, AK::memory_order_relaxed);
+        return ENOBUFS;
+    }
+
     auto* current_thread = Thread::current();
     u32 enter_count = 0;
     if (current_thread)
@@ -101,8 +113,8 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     if (enter_count > 0)
         return EINVAL;
 
+    // The type is only stored once the rest of the event has been written, see below.
     PerformanceEvent event;
-    event.type = type;
     event.lost_samples = lost_samples;
 
     switch (type) {
@@ -171,6 +183,17 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     case PERF_EVENT_FILESYSTEM:
         event.data.filesystem = filesystem_event;
         break;
+    case PERF_EVENT_LOCK_CONTENTION:
+        event.data.lock_contention.site = arg1;
+        event.data.lock_contention.wait_time = arg2;
+        memset(event.data.lock_contention.name, 0, sizeof(event.data.lock_contention.name));
+        if (!arg3.is_empty())
+            memcpy(event.data.lock_contention.name, arg3.characters_without_null_termination(), min(arg3.length(), sizeof(event.data.lock_contention.name) - 1));
+        break;
+    case PERF_EVENT_OFF_CPU:
+        event.data.off_cpu.reason = static_cast<OffCPUReason>(arg1);
+        event.data.off_cpu.duration_ns = arg2;
+        break;
     default:
         return EINVAL;
     }
@@ -181,204 +204,369 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
 
     event.pid = pid.value();
     event.tid = tid.value();
-    event.timestamp = TimeManagement::the().uptime_ms();
-    at(m_count++) = event;
+    // Readers merge the rings of all processors by timestamp, so it has to be precise enough to keep events in order.
+    event.timestamp_ns = TimeManagement::the().monotonic_time(TimePrecision::Precise).nanoseconds();
+
+    auto index = ring.head.load(AK::memory_order_relaxed);
+    do {
+        // The acquire pairs with the release in drain_to_perfcore(), which is done reading the slot by then.
+        if (index - ring.tail.load(AK::memory_order_acquire) >= ring.capacity) {
+            m_dropped_event_count.fetch_add(1, AK::memory_order_relaxed);
+            return ENOBUFS;
+        }
+    } while (!ring.head.compare_exchange_strong(index, index + 1, AK::memory_order_acq_rel));
+
+    auto& event_slot = slot(ring, index);
+    event_slot = event;
+    AK::atomic_store(&event_slot.type, static_cast<u32>(type), AK::memory_order_release);
     return {};
 }
 
-PerformanceEvent& PerformanceEventBuffer::at(size_t index)
+PerformanceEventBuffer::Ring& PerformanceEventBuffer::current_ring()
+{
+    return m_rings[Processor::current_id() % m_rings.size()];
+}
+
+PerformanceEvent& PerformanceEventBuffer::slot(Ring const& ring, u64 index)
 {
-    VERIFY(index < capacity());
-    auto* events = reinterpret_cast<PerformanceEvent*>(m_buffer->data());
-    return events[index];
+    auto* events = reinterpret_cast<PerformanceEvent*>(m_buffer->data() + m_rings.size() * sizeof(Ring));
+    return events[ring.first_slot + index % ring.capacity];
 }
 
-template<typename Serializer>
-ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
+void PerformanceEventBuffer::clear()
 {
-    {
-        auto strings_object = TRY(object.add_array("strings"sv));
-        Vector<KString*> strings_sorted_by_index;
+    for (auto& ring : m_rings) {
+        // Slots that are reserved but not written yet must not look like events from before.
+        auto head = ring.head.load(AK::memory_order_relaxed);
+        for (auto index = ring.tail.load(AK::memory_order_relaxed); index < head; ++index)
+            AK::atomic_store(&slot(ring, index).type, 0u, AK::memory_order_relaxed);
+        ring.head.store(0, AK::memory_order_relaxed);
+        ring.tail.store(0, AK::memory_order_relaxed);
+    }
+    m_dropped_event_count.store(0, AK::memory_order_relaxed);
+    m_seen_first_sample = false;
+}
 
-        TRY(m_strings.with([&](auto& strings) -> ErrorOr<void> {
-            TRY(strings_sorted_by_index.try_resize(strings.size()));
+struct PerformanceEventBuffer::PendingEvents {
+    struct Entry {
+        PerformanceEvent const* event { nullptr };
+        u32 type { 0 };
+    };
 
-            for (auto& entry : strings) {
-                strings_sorted_by_index[entry.value] = const_cast<Kernel::KString*>(entry.key.ptr());
-            }
+    // The events of all rings, ordered by their timestamps.
+    Vector<Entry> events;
+    // For every ring, the index after its last pending event.
+    Vector<u64> ring_ends;
+};
 
-            for (size_t i = 0; i < strings.size(); i++) {
-                TRY(strings_object.add(strings_sorted_by_index[i]->view()));
-            }
+ErrorOr<PerformanceEventBuffer::PendingEvents> PerformanceEventBuffer::pending_events() const
+{
+    VERIFY(m_read_lock.is_exclusively_locked_by_current_thread());
+
+    PendingEvents pending;
+    TRY(pending.ring_ends.try_ensure_capacity(m_rings.size()));
+
+    for (auto const& ring : m_rings) {
+        // Events that are appended while we're reading are left for the next read.
+        // The types are loaded once, so that everything after this agrees on which events were published.
+        auto index = ring.tail.load(AK::memory_order_relaxed);
+        auto head = ring.head.load(AK::memory_order_acquire);
+        for (; index < head; ++index) {
+            auto const& event = slot(ring, index);
+            auto type = AK::atomic_load(&event.type, AK::memory_order_acquire);
+            // This event is still being written, so it and everything after it are left for the next read as well.
+            if (type == 0)
+                break;
+            TRY(pending.events.try_append({ &event, type }));
+        }
+        pending.ring_ends.unchecked_append(index);
+    }
 
-            return {};
-        }));
+    if (m_rings.size() > 1) {
+        quick_sort(pending.events, [](auto const& a, auto const& b) {
+            if (a.event->timestamp_ns != b.event->timestamp_ns)
+                return a.event->timestamp_ns < b.event->timestamp_ns;
+            return a.event < b.event;
+        });
+    }
 
-        TRY(strings_object.finish());
+    return pending;
+}
+
+template<typename Payload>
+static ReadonlyBytes payload_bytes(Payload const& payload)
+{
+    return { &payload, sizeof(payload) };
+}
+
+ErrorOr<void> PerformanceEventBuffer::to_perfcore(KBufferBuilder& builder) const
+{
+    MutexLocker locker(m_read_lock);
+    auto pending = TRY(pending_events());
+    return serialize(builder, pending, dropped_event_count());
+}
+
+ErrorOr<void> PerformanceEventBuffer::drain_to_perfcore(KBufferBuilder& builder)
+{
+    MutexLocker locker(m_read_lock);
+    auto pending = TRY(pending_events());
+    auto dropped_event_count = m_dropped_event_count.exchange(0, AK::memory_order_relaxed);
+    if (auto result = serialize(builder, pending, dropped_event_count); result.is_error()) {
+        m_dropped_event_count.fetch_add(dropped_event_count, AK::memory_order_relaxed);
+        return result.release_error();
+    }
+
+    for (auto const& entry : pending.events) {
+        if (entry.type == PERF_EVENT_SAMPLE)
+            m_seen_first_sample = true;
+    }
+
+    for (size_t i = 0; i < m_rings.size(); ++i) {
+        auto& ring = m_rings[i];
+        auto end = pending.ring_ends[i];
+        for (auto index = ring.tail.load(AK::memory_order_relaxed); index < end; ++index)
+            AK::atomic_store(&slot(ring, index).type, 0u, AK::memory_order_relaxed);
+        // This hands the slots back to append_with_ip_and_bp().
+        ring.tail.store(end, AK::memory_order_release);
     }
 
+    return {};
+}
+
+ErrorOr<void> PerformanceEventBuffer::serialize(KBufferBuilder& builder, PendingEvents const& pending, u32 dropped_event_count) const
+{
+    // Strings registered with register_string() keep their index, the names of mappings
+    // and executables are interned after them.
+    Vector<StringView> strings;
+    HashMap<StringView, u32> string_indices;
+
+    TRY(m_strings.with([&](auto& registered_strings) -> ErrorOr<void> {
+        TRY(strings.try_resize(registered_strings.size()));
+        for (auto& entry : registered_strings)
+            strings[entry.value] = entry.key->view();
+        return {};
+    }));
+    for (size_t i = 0; i < strings.size(); ++i)
+        TRY(string_indices.try_set(strings[i], i));
+
+    auto intern_string = [&](char const* characters) -> ErrorOr<u32> {
+        StringView string { characters, strlen(characters) };
+        if (auto index = string_indices.get(string); index.has_value())
+            return index.value();
+        u32 index = strings.size();
+        TRY(strings.try_append(string));
+        TRY(string_indices.try_set(string, index));
+        return index;
+    };
+
     auto current_process_credentials = Process::current().credentials();
     bool show_kernel_addresses = current_process_credentials->is_superuser();
-    auto array = TRY(object.add_array("events"sv));
-    bool seen_first_sample = false;
-    for (size_t i = 0; i < m_count; ++i) {
-        auto const& event = at(i);
+
+    u32 event_count = 0;
+    for (auto const& [event, type] : pending.events) {
+        if (!show_kernel_addresses && (type == PERF_EVENT_KMALLOC || type == PERF_EVENT_KFREE))
+            continue;
+        ++event_count;
+        if (type == PERF_EVENT_MMAP)
+            TRY(intern_string(event->data.mmap.name));
+        else if (type == PERF_EVENT_PROCESS_CREATE)
+            TRY(intern_string(event->data.process_create.executable));
+        else if (type == PERF_EVENT_PROCESS_EXEC)
+            TRY(intern_string(event->data.process_exec.executable));
+        else if (type == PERF_EVENT_LOCK_CONTENTION)
+            TRY(intern_string(event->data.lock_contention.name));
+    }
+
+    PerfcoreHeader header;
+    header.string_count = strings.size();
+    header.dropped_event_count = dropped_event_count;
+    header.event_count = event_count;
+    TRY(builder.append_bytes(payload_bytes(header)));
+
+    for (auto string : strings) {
+        u32 length = string.length();
+        TRY(builder.append_bytes(payload_bytes(length)));
+        TRY(builder.append_bytes(string.bytes()));
+    }
+
+    // The first sample counts the samples that were lost before profiling started, so its count is dropped.
+    bool seen_first_sample = m_seen_first_sample;
+
+    auto append_event = [&](u32 type, PerformanceEvent const& event, ReadonlyBytes payload) -> ErrorOr<void> {
+        PerfcoreEvent record;
+        record.type = type;
+        record.pid = event.pid;
+        record.tid = event.tid;
+        record.timestamp = event.timestamp_ns / 1'000'000;
+        record.lost_samples = seen_first_sample ? event.lost_samples : 0;
+        record.payload_size = payload.size();
+        record.stack_size = event.stack_size;
+        if (type == PERF_EVENT_SAMPLE)
+            seen_first_sample = true;
+
+        Array<u64, PerformanceEvent::max_stack_frame_count> stack;
+        for (size_t i = 0; i < event.stack_size; ++i) {
+            auto address = event.stack[i];
+            if (!show_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
+                address = 0xdeadc0de;
+            stack[i] = address;
+        }
+
+        TRY(builder.append_bytes(payload_bytes(record)));
+        TRY(builder.append_bytes(payload));
+        return builder.append_bytes({ stack.data(), event.stack_size * sizeof(u64) });
+    };
+
+    for (auto const& [event_pointer, type] : pending.events) {
+        auto const& event = *event_pointer;
 
         if (!show_kernel_addresses) {
-            if (event.type == PERF_EVENT_KMALLOC || event.type == PERF_EVENT_KFREE)
+            if (type == PERF_EVENT_KMALLOC || type == PERF_EVENT_KFREE)
                 continue;
         }
 
-        auto event_object = TRY(array.add_object());
-        switch (event.type) {
+        switch (type) {
         case PERF_EVENT_SAMPLE:
-            TRY(event_object.add("type"sv, "sample"));
-            break;
-        case PERF_EVENT_MALLOC:
-            TRY(event_object.add("type"sv, "malloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.malloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.malloc.size)));
-            break;
-        case PERF_EVENT_FREE:
-            TRY(event_object.add("type"sv, "free"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.free.ptr)));
-            break;
-        case PERF_EVENT_MMAP:
-            TRY(event_object.add("type"sv, "mmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.mmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.mmap.size)));
-            TRY(event_object.add("name"sv, event.data.mmap.name));
-            break;
-        case PERF_EVENT_MUNMAP:
-            TRY(event_object.add("type"sv, "munmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.munmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.munmap.size)));
+        case PERF_EVENT_PROCESS_EXIT:
+        case PERF_EVENT_THREAD_EXIT:
+        case PERF_EVENT_PAGE_FAULT:
+        case PERF_EVENT_SYSCALL:
+            TRY(append_event(type, event, {}));
             break;
-        case PERF_EVENT_PROCESS_CREATE:
-            TRY(event_object.add("type"sv, "process_create"));
-            TRY(event_object.add("parent_pid"sv, static_cast<u64>(event.data.process_create.parent_pid)));
-            TRY(event_object.add("executable"sv, event.data.process_create.executable));
+        case PERF_EVENT_MALLOC: {
+            PerfcoreMemoryPayload payload { .ptr = event.data.malloc.ptr, .size = event.data.malloc.size };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_PROCESS_EXEC:
-            TRY(event_object.add("type"sv, "process_exec"));
-            TRY(event_object.add("executable"sv, event.data.process_exec.executable));
+        }
+        case PERF_EVENT_FREE: {
+            PerfcoreMemoryPayload payload { .ptr = event.data.free.ptr, .size = 0 };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_PROCESS_EXIT:
-            TRY(event_object.add("type"sv, "process_exit"));
+        }
+        case PERF_EVENT_MMAP: {
+            PerfcoreMmapPayload payload {
+                .ptr = event.data.mmap.ptr,
+                .size = event.data.mmap.size,
+                .name_index = TRY(intern_string(event.data.mmap.name)),
+            };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_THREAD_CREATE:
-            TRY(event_object.add("type"sv, "thread_create"));
-            TRY(event_object.add("parent_tid"sv, static_cast<u64>(event.data.thread_create.parent_tid)));
+        }
+        case PERF_EVENT_MUNMAP: {
+            PerfcoreMemoryPayload payload { .ptr = event.data.munmap.ptr, .size = event.data.munmap.size };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_THREAD_EXIT:
-            TRY(event_object.add("type"sv, "thread_exit"));
+        }
+        case PERF_EVENT_PROCESS_CREATE: {
+            PerfcoreProcessPayload payload {
+                .parent_pid = static_cast<u32>(event.data.process_create.parent_pid),
+                .executable_index = TRY(intern_string(event.data.process_create.executable)),
+            };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_CONTEXT_SWITCH:
-            TRY(event_object.add("type"sv, "context_switch"));
-            TRY(event_object.add("next_pid"sv, static_cast<u64>(event.data.context_switch.next_pid)));
-            TRY(event_object.add("next_tid"sv, static_cast<u64>(event.data.context_switch.next_tid)));
+        }
+        case PERF_EVENT_PROCESS_EXEC: {
+            PerfcoreProcessPayload payload {
+                .parent_pid = 0,
+                .executable_index = TRY(intern_string(event.data.process_exec.executable)),
+            };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_KMALLOC:
-            TRY(event_object.add("type"sv, "kmalloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kmalloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kmalloc.size)));
+        }
+        case PERF_EVENT_THREAD_CREATE: {
+            PerfcoreThreadCreatePayload payload { .parent_tid = static_cast<u32>(event.data.thread_create.parent_tid) };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_KFREE:
-            TRY(event_object.add("type"sv, "kfree"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kfree.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kfree.size)));
+        }
+        case PERF_EVENT_CONTEXT_SWITCH: {
+            PerfcoreContextSwitchPayload payload {
+                .next_pid = static_cast<u32>(event.data.context_switch.next_pid),
+                .next_tid = event.data.context_switch.next_tid,
+            };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_PAGE_FAULT:
-            TRY(event_object.add("type"sv, "page_fault"));
+        }
+        case PERF_EVENT_KMALLOC: {
+            PerfcoreMemoryPayload payload { .ptr = event.data.kmalloc.ptr, .size = event.data.kmalloc.size };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_SYSCALL:
-            TRY(event_object.add("type"sv, "syscall"));
+        }
+        case PERF_EVENT_KFREE: {
+            PerfcoreMemoryPayload payload { .ptr = event.data.kfree.ptr, .size = event.data.kfree.size };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_SIGNPOST:
-            TRY(event_object.add("type"sv, "signpost"sv));
-            TRY(event_object.add("arg1"sv, event.data.signpost.arg1));
-            TRY(event_object.add("arg2"sv, event.data.signpost.arg2));
+        }
+        case PERF_EVENT_SIGNPOST: {
+            PerfcoreSignpostPayload payload { .string_index = event.data.signpost.arg1, .arg = event.data.signpost.arg2 };
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
-        case PERF_EVENT_FILESYSTEM:
-            TRY(event_object.add("type"sv, "filesystem"sv));
-            TRY(event_object.add("durationNs"sv, event.data.filesystem.durationNs));
-            switch (event.data.filesystem.type) {
-            case FilesystemEventType::Open: {
-                auto const& open = event.data.filesystem.data.open;
-                TRY(event_object.add("fs_event_type"sv, "open"sv));
-                TRY(event_object.add("dirfd"sv, open.dirfd));
-                TRY(event_object.add("filename_index"sv, open.filename_index));
-                TRY(event_object.add("options"sv, open.options));
-                TRY(event_object.add("mode"sv, open.mode));
+        }
+        case PERF_EVENT_FILESYSTEM: {
+            auto const& filesystem = event.data.filesystem;
+            PerfcoreFilesystemPayload payload;
+            payload.type = filesystem.type;
+            payload.duration_ns = filesystem.durationNs;
+            switch (filesystem.type) {
+            case FilesystemEventType::Open:
+                payload.fd = filesystem.data.open.dirfd;
+                payload.filename_index = filesystem.data.open.filename_index;
+                payload.options = filesystem.data.open.options;
+                payload.mode = filesystem.data.open.mode;
                 break;
-            }
-            case FilesystemEventType::Close: {
-                auto const& close = event.data.filesystem.data.close;
-                TRY(event_object.add("fs_event_type"sv, "close"sv));
-                TRY(event_object.add("fd"sv, close.fd));
-                TRY(event_object.add("filename_index"sv, close.filename_index));
+            case FilesystemEventType::Close:
+                payload.fd = filesystem.data.close.fd;
+                payload.filename_index = filesystem.data.close.filename_index;
                 break;
-            }
-            case FilesystemEventType::Readv: {
-                auto const& readv = event.data.filesystem.data.readv;
-                TRY(event_object.add("fs_event_type"sv, "readv"sv));
-                TRY(event_object.add("fd"sv, readv.fd));
-                TRY(event_object.add("filename_index"sv, readv.filename_index));
+            case FilesystemEventType::Readv:
+                payload.fd = filesystem.data.readv.fd;
+                payload.filename_index = filesystem.data.readv.filename_index;
                 break;
-            }
-            case FilesystemEventType::Read: {
-                auto const& read = event.data.filesystem.data.read;
-                TRY(event_object.add("fs_event_type"sv, "read"sv));
-                TRY(event_object.add("fd"sv, read.fd));
-                TRY(event_object.add("filename_index"sv, read.filename_index));
+            case FilesystemEventType::Read:
+                payload.fd = filesystem.data.read.fd;
+                payload.filename_index = filesystem.data.read.filename_index;
                 break;
-            }
-            case FilesystemEventType::Pread: {
-                auto const& pread = event.data.filesystem.data.pread;
-                TRY(event_object.add("fs_event_type"sv, "pread"sv));
-                TRY(event_object.add("fd"sv, pread.fd));
-                TRY(event_object.add("filename_index"sv, pread.filename_index));
-                TRY(event_object.add("buffer_ptr"sv, pread.buffer_ptr));
-                TRY(event_object.add("size"sv, pread.size));
-                TRY(event_object.add("offset"sv, pread.offset));
+            case FilesystemEventType::Pread:
+                payload.fd = filesystem.data.pread.fd;
+                payload.filename_index = filesystem.data.pread.filename_index;
+                payload.buffer_ptr = filesystem.data.pread.buffer_ptr;
+                payload.size = filesystem.data.pread.size;
+                payload.offset = filesystem.data.pread.offset;
                 break;
             }
-            }
+            TRY(append_event(type, event, payload_bytes(payload)));
             break;
         }
-        TRY(event_object.add("pid"sv, event.pid));
-        TRY(event_object.add("tid"sv, event.tid));
-        TRY(event_object.add("timestamp"sv, event.timestamp));
-        TRY(event_object.add("lost_samples"sv, seen_first_sample ? event.lost_samples : 0));
-        if (event.type == PERF_EVENT_SAMPLE)
-            seen_first_sample = true;
-        auto stack_array = TRY(event_object.add_array("stack"sv));
-        for (size_t j = 0; j < event.stack_size; ++j) {
-            auto address = event.stack[j];
-            if (!show_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
-                address = 0xdeadc0de;
-            TRY(stack_array.add(address));
+        case PERF_EVENT_LOCK_CONTENTION: {
+            PerfcoreLockContentionPayload payload {
+                .site = show_kernel_addresses ? event.data.lock_contention.site : 0xdeadc0de,
+                .wait_time = event.data.lock_contention.wait_time,
+                .name_index = TRY(intern_string(event.data.lock_contention.name)),
+            };
+            TRY(append_event(type, event, payload_bytes(payload)));
+            break;
+        }
+        case PERF_EVENT_OFF_CPU: {
+            PerfcoreOffCPUPayload payload { .duration_ns = event.data.off_cpu.duration_ns, .reason = event.data.off_cpu.reason };
+            TRY(append_event(type, event, payload_bytes(payload)));
+            break;
+        }
+        default:
+            // append_with_ip_and_bp() doesn't accept any other types.
+            VERIFY_NOT_REACHED();
         }
-        TRY(stack_array.finish());
-        TRY(event_object.finish());
     }
-    TRY(array.finish());
-    TRY(object.finish());
-    return {};
-}
 
-ErrorOr<void> PerformanceEventBuffer::to_json(KBufferBuilder& builder) const
-{
-    auto object = TRY(JsonObjectSerializer<>::try_create(builder));
-    return to_json_impl(object);
+    return {};
 }
 
-OwnPtr<PerformanceEventBuffer> PerformanceEventBuffer::try_create_with_size(size_t buffer_size)
+OwnPtr<PerformanceEventBuffer> PerformanceEventBuffer::try_create_with_size(size_t buffer_size, size_t ring_count)
 {
+    VERIFY(ring_count > 0);
+    VERIFY(buffer_size >= ring_count * (sizeof(Ring) + sizeof(PerformanceEvent)));
     auto buffer_or_error = KBuffer::try_create_with_size("Performance events"sv, buffer_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
     if (buffer_or_error.is_error())
         return {};
-    return adopt_own_if_nonnull(new (nothrow) PerformanceEventBuffer(buffer_or_error.release_value()));
+    return adopt_own_if_nonnull(new (nothrow) PerformanceEventBuffer(buffer_or_error.release_value(), ring_count));
 }
 
 ErrorOr<void> PerformanceEventBuffer::add_process(Process const& process, ProcessEventType event_type)
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Error.h>
+#include <Kernel/API/Perfcore.h>
 #include <Kernel/Library/KBuffer.h>
+#include <Kernel/Locking/Mutex.h>
 
 namespace Kernel {
 
@@ -69,6 +72,17 @@ struct [[gnu::packed]] SignpostPerformanceEvent {
     FlatPtr arg2;
 };
 
+struct [[gnu::packed]] LockContentionPerformanceEvent {
+    FlatPtr site;
+    u64 wait_time;
+    char name[32];
+};
+
+struct [[gnu::packed]] OffCPUPerformanceEvent {
+    u64 duration_ns;
+    OffCPUReason reason;
+};
+
 struct [[gnu::packed]] ReadPerformanceEvent {
     int fd;
     size_t size;
@@ -77,14 +91,6 @@ struct [[gnu::packed]] ReadPerformanceEvent {
     bool success;
 };
 
-enum class FilesystemEventType : u8 {
-    Open,
-    Close,
-    Readv,
-    Read,
-    Pread
-};
-
 struct [[gnu::packed]] OpenEventData {
     int dirfd;
     size_t filename_index;
@@ -137,12 +143,13 @@ struct [[gnu::packed]] FilesystemEvent {
     } data;
 };
 
-struct [[gnu::packed]] PerformanceEvent {
+// Aligned so that the type, which is stored last to publish an event, can be accessed atomically.
+struct [[gnu::packed]] alignas(8) PerformanceEvent {
     u32 type { 0 };
     u8 stack_size { 0 };
     u32 pid { 0 };
     u32 tid { 0 };
-    u64 timestamp;
+    u64 timestamp_ns;
     u32 lost_samples;
     union {
         MallocPerformanceEvent malloc;
@@ -157,6 +164,8 @@ struct [[gnu::packed]] PerformanceEvent {
         KFreePerformanceEvent kfree;
         SignpostPerformanceEvent signpost;
         FilesystemEvent filesystem;
+        LockContentionPerformanceEvent lock_contention;
+        OffCPUPerformanceEvent off_cpu;
     } data;
     static constexpr size_t max_stack_frame_count = 64;
     FlatPtr stack[max_stack_frame_count];
@@ -169,7 +178,8 @@ enum class ProcessEventType {
 
 class PerformanceEventBuffer {
 public:
-    static OwnPtr<PerformanceEventBuffer> try_create_with_size(size_t buffer_size);
+    // With more than one ring, every processor appends to a ring of its own.
+    static OwnPtr<PerformanceEventBuffer> try_create_with_size(size_t buffer_size, size_t ring_count = 1);
 
     ErrorOr<void> append(int type, FlatPtr arg1, FlatPtr arg2, StringView arg3, Thread* current_thread = Thread::current(), FilesystemEvent filesystem_event = {});
     ErrorOr<void> append_with_ip_and_bp(ProcessID pid, ThreadID tid, FlatPtr eip, FlatPtr ebp,
@@ -177,35 +187,56 @@ public:
     ErrorOr<void> append_with_ip_and_bp(ProcessID pid, ThreadID tid, RegisterState const& regs,
         int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FilesystemEvent filesystem_event = {});
 
-    void clear()
-    {
-        m_count = 0;
-    }
+    void clear();
 
-    size_t capacity() const { return m_buffer->size() / sizeof(PerformanceEvent); }
-    size_t count() const { return m_count; }
-    PerformanceEvent const& at(size_t index) const
-    {
-        return const_cast<PerformanceEventBuffer&>(*this).at(index);
-    }
+    u32 dropped_event_count() const { return m_dropped_event_count.load(AK::memory_order_relaxed); }
 
-    ErrorOr<void> to_json(KBufferBuilder&) const;
+    // Serializes the events that haven't been drained yet, in the binary format described in Kernel/API/Perfcore.h.
+    ErrorOr<void> to_perfcore(KBufferBuilder&) const;
+
+    // Like to_perfcore(), but the serialized events are removed from the buffer, which makes room for new ones.
+    // A reader that keeps draining the buffer can record a profile of any length.
+    ErrorOr<void> drain_to_perfcore(KBufferBuilder&);
 
     ErrorOr<void> add_process(Process const&, ProcessEventType event_type);
 
     ErrorOr<FlatPtr> register_string(NonnullOwnPtr<KString>);
 
 private:
-    explicit PerformanceEventBuffer(NonnullOwnPtr<KBuffer>);
-
-    template<typename Serializer>
-    ErrorOr<void> to_json_impl(Serializer&) const;
+    // Event n of a ring is stored in slot n % capacity. Slots are reserved with a compare-and-swap on the head,
+    // so events can be appended without taking a lock, even when a thread moves to another processor while
+    // appending. An event is written with type 0 and its type is published last, so readers stop at slots that
+    // are still being written. Slots before the tail have been drained and can be reused.
+    // Rings live at the start of the (page-aligned) buffer, each in a cache line of its own.
+    struct alignas(64) Ring {
+        Atomic<u64> head { 0 };
+        Atomic<u64> tail { 0 };
+        size_t first_slot { 0 };
+        size_t capacity { 0 };
+    };
+
+    struct PendingEvents;
+
+    PerformanceEventBuffer(NonnullOwnPtr<KBuffer>, size_t ring_count);
+
+    Ring& current_ring();
+    PerformanceEvent& slot(Ring const&, u64 index);
+    PerformanceEvent const& slot(Ring const& ring, u64 index) const
+    {
+        return const_cast<PerformanceEventBuffer&>(*this).slot(ring, index);
+    }
 
-    PerformanceEvent& at(size_t index);
+    ErrorOr<PendingEvents> pending_events() const;
+    ErrorOr<void> serialize(KBufferBuilder&, PendingEvents const&, u32 dropped_event_count) const;
 
-    size_t m_count { 0 };
+    Span<Ring> m_rings;
+    Atomic<u32> m_dropped_event_count { 0 };
     NonnullOwnPtr<KBuffer> m_buffer;
 
+    // Readers are serialized, so that draining never frees slots while they're being read.
+    mutable Mutex m_read_lock { "PerformanceEventBuffer"sv };
+    mutable bool m_seen_first_sample { false };
+
     SpinlockProtected<HashMap<NonnullOwnPtr<KString>, size_t>, LockRank::None> m_strings;
 };
 
@@ -109,6 +109,32 @@ public:
         }
     }
 
+    static void add_lock_contention_perf_event(Thread& current_thread, StringView lock_name, FlatPtr site, u64 wait_time)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto res = event_buffer->append(PERF_EVENT_LOCK_CONTENTION, site, wait_time, lock_name, &current_thread);
+        }
+    }
+
+    // Blocking is a hot path, so callers only measure how long they were off the CPU if this returns true.
+    static bool is_off_cpu_profiling_enabled(Thread& current_thread)
+    {
+        if ((g_profiling_event_mask & PERF_EVENT_OFF_CPU) == 0 || current_thread.is_profiling_suppressed())
+            return false;
+        return current_thread.process().current_perf_events_buffer() != nullptr;
+    }
+
+    static void add_off_cpu_perf_event(Thread& current_thread, OffCPUReason reason, Duration duration)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto res = event_buffer->append(PERF_EVENT_OFF_CPU, to_underlying(reason), duration.to_nanoseconds(), {}, &current_thread);
+        }
+    }
+
     static void add_page_fault_event(Thread& thread, RegisterState const& regs)
     {
         if (thread.is_profiling_suppressed())
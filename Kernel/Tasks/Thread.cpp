@@ -22,6 +22,7 @@
 #include <Kernel/Memory/ScopedAddressSpaceSwitcher.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/PerformanceEventBuffer.h>
+#include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/PowerStateSwitchTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
@@ -105,6 +106,35 @@ Thread::~Thread()
     VERIFY(m_runnable_priority < 0);
 }
 
+static OffCPUReason off_cpu_reason(Thread::Blocker::Type type)
+{
+    switch (type) {
+    case Thread::Blocker::Type::Unknown:
+        return OffCPUReason::Unknown;
+    case Thread::Blocker::Type::File:
+        return OffCPUReason::File;
+    case Thread::Blocker::Type::Futex:
+        return OffCPUReason::Futex;
+    case Thread::Blocker::Type::Plan9FS:
+        return OffCPUReason::Plan9FS;
+    case Thread::Blocker::Type::Join:
+        return OffCPUReason::Join;
+    case Thread::Blocker::Type::Queue:
+        return OffCPUReason::Queue;
+    case Thread::Blocker::Type::Routing:
+        return OffCPUReason::Routing;
+    case Thread::Blocker::Type::Sleep:
+        return OffCPUReason::Sleep;
+    case Thread::Blocker::Type::Signal:
+        return OffCPUReason::Signal;
+    case Thread::Blocker::Type::Wait:
+        return OffCPUReason::Wait;
+    case Thread::Blocker::Type::Flock:
+        return OffCPUReason::Flock;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 Thread::BlockResult Thread::block_impl(BlockTimeout const& timeout, Blocker& blocker)
 {
     VERIFY(!Processor::current_in_irq());
@@ -172,6 +202,10 @@ Thread::BlockResult Thread::block_impl(BlockTimeout const& timeout, Blocker& blo
     block_lock.unlock();
     scheduler_lock.unlock();
 
+    Optional<MonotonicTime> off_cpu_start;
+    if (PerformanceManager::is_off_cpu_profiling_enabled(*this))
+        off_cpu_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+
     dbgln_if(THREAD_DEBUG, "Thread {} blocking on {} ({}) -->", *this, &blocker, blocker.state_string());
     bool did_timeout = false;
     u32 lock_count_to_restore = 0;
@@ -212,6 +246,10 @@ Thread::BlockResult Thread::block_impl(BlockTimeout const& timeout, Blocker& blo
         // (e.g. if it's on another processor)
         TimerQueue::the().cancel_timer(*m_block_timer);
     }
+    if (off_cpu_start.has_value()) {
+        auto off_cpu_time = TimeManagement::the().monotonic_time(TimePrecision::Precise) - off_cpu_start.value();
+        PerformanceManager::add_off_cpu_perf_event(*this, off_cpu_reason(blocker.blocker_type()), off_cpu_time);
+    }
     if (previous_locked != LockMode::Unlocked) {
         // NOTE: This may trigger another call to Thread::block().
         relock_process(previous_locked, lock_count_to_restore);
@@ -257,6 +295,10 @@ void Thread::block(Kernel::Mutex& lock, SpinlockLocker<Spinlock<LockRank::None>>
 
     lock_lock.unlock();
 
+    Optional<MonotonicTime> off_cpu_start;
+    if (PerformanceManager::is_off_cpu_profiling_enabled(*this))
+        off_cpu_start = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+
     dbgln_if(THREAD_DEBUG, "Thread {} blocking on Mutex {}", *this, &lock);
 
     for (;;) {
@@ -281,6 +323,11 @@ void Thread::block(Kernel::Mutex& lock, SpinlockLocker<Spinlock<LockRank::None>>
         break;
     }
 
+    if (off_cpu_start.has_value()) {
+        auto off_cpu_time = TimeManagement::the().monotonic_time(TimePrecision::Precise) - off_cpu_start.value();
+        PerformanceManager::add_off_cpu_perf_event(*this, OffCPUReason::Mutex, off_cpu_time);
+    }
+
     lock_lock.lock();
 }
 
@@ -107,6 +107,7 @@ set(LIBWEB_CSS_ANIMATION_DEBUG ON)
 set(LIBWEB_CSS_DEBUG ON)
 set(LINE_EDITOR_DEBUG ON)
 set(LOCAL_SOCKET_DEBUG ON)
+set(LOCK_CONTENTION_PROFILING ON)
 set(LOCK_DEBUG ON)
 set(LOCK_IN_CRITICAL_DEBUG ON)
 set(LOCK_RANK_ENFORCEMENT ON)
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+// Every iteration makes the kernel allocate and free a handful of small objects
+// (file descriptions, pipe buffers, sockets), so running it on several threads at
+// once makes the CPUs contend on the kernel heap.
+static bool run_iteration()
+{
+    int pipe_fds[2];
+    if (pipe(pipe_fds) < 0) {
+        perror("pipe");
+        return false;
+    }
+
+    char byte = 'x';
+    if (write(pipe_fds[1], &byte, 1) != 1 || read(pipe_fds[0], &byte, 1) != 1) {
+        perror("pipe write/read");
+        return false;
+    }
+
+    int duplicate_fd = dup(pipe_fds[0]);
+    if (duplicate_fd < 0) {
+        perror("dup");
+        return false;
+    }
+
+    int socket_fd = socket(AF_LOCAL, SOCK_STREAM, 0);
+    if (socket_fd < 0) {
+        perror("socket");
+        return false;
+    }
+
+    close(socket_fd);
+    close(duplicate_fd);
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    return true;
+}
+
+static Optional<JsonObject> read_memstat()
+{
+    auto file = Core::File::open("/sys/kernel/memstat"sv, Core::File::OpenMode::Read);
+    if (file.is_error())
+        return {};
+    auto contents = file.value()->read_until_eof();
+    if (contents.is_error())
+        return {};
+    auto json = JsonValue::from_string(contents.value());
+    if (json.is_error() || !json.value().is_object())
+        return {};
+    return json.value().as_object();
+}
+
+static void print_slabheap_statistics(JsonObject const& before, JsonObject const& after)
+{
+    auto slabheaps_before = before.get_array("kmalloc_slabheaps"sv);
+    auto slabheaps_after = after.get_array("kmalloc_slabheaps"sv);
+    if (!slabheaps_before.has_value() || !slabheaps_after.has_value() || slabheaps_before->size() != slabheaps_after->size())
+        return;
+
+    printf("%10s %12s %12s %12s %12s\n", "slab size", "cache hits", "refills", "flushes", "cached");
+    for (size_t i = 0; i < slabheaps_after->size(); ++i) {
+        auto const& slabheap_before = slabheaps_before->at(i).as_object();
+        auto const& slabheap_after = slabheaps_after->at(i).as_object();
+        auto delta = [&](StringView key) {
+            return slabheap_after.get_u64(key).value_or(0) - slabheap_before.get_u64(key).value_or(0);
+        };
+        printf("%10" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n",
+            slabheap_after.get_u64("slab_size"sv).value_or(0),
+            delta("cache_hit_count"sv),
+            delta("cache_refill_count"sv),
+            delta("cache_flush_count"sv),
+            slabheap_after.get_u64("cached"sv).value_or(0));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Vector<StringView> arguments;
+    arguments.ensure_capacity(argc);
+    for (auto i = 0; i < argc; ++i)
+        arguments.append({ argv[i], strlen(argv[i]) });
+
+    int thread_count = sysconf(_SC_NPROCESSORS_ONLN);
+    int iteration_count = 10000;
+
+    Core::ArgsParser args_parser;
+    args_parser.add_option(thread_count, "Number of threads to run (defaults to the number of CPUs)", "threads", 't', "number");
+    args_parser.add_option(iteration_count, "Number of iterations per thread", "number", 'n', "number");
+    args_parser.parse(arguments);
+
+    if (thread_count < 1) {
+        fprintf(stderr, "Need at least one thread\n");
+        return EXIT_FAILURE;
+    }
+
+    auto memstat_before = read_memstat();
+
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    Vector<pthread_t> threads;
+    for (int i = 0; i < thread_count; ++i) {
+        pthread_t thread;
+        int rc = pthread_create(
+            &thread, nullptr, [](void* argument) -> void* {
+                auto iteration_count = *static_cast<int*>(argument);
+                for (int i = 0; i < iteration_count; ++i) {
+                    if (!run_iteration())
+                        return reinterpret_cast<void*>(1);
+                }
+                return nullptr;
+            },
+            &iteration_count);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+            return EXIT_FAILURE;
+        }
+        threads.append(thread);
+    }
+
+    bool failed = false;
+    for (auto thread : threads) {
+        void* result = nullptr;
+        pthread_join(thread, &result);
+        if (result)
+            failed = true;
+    }
+
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (failed)
+        return EXIT_FAILURE;
+
+    auto elapsed_ns = (end.tv_sec - start.tv_sec) * 1'000'000'000ll + (end.tv_nsec - start.tv_nsec);
+    auto total_iterations = static_cast<long long>(thread_count) * iteration_count;
+    printf("%d threads, %lld iterations in %lld ms (%lld ns per iteration)\n", thread_count, total_iterations, elapsed_ns / 1'000'000, elapsed_ns / total_iterations);
+
+    if (auto memstat_after = read_memstat(); memstat_before.has_value() && memstat_after.has_value()) {
+        auto kmalloc_calls = memstat_after->get_u64("kmalloc_call_count"sv).value_or(0) - memstat_before->get_u64("kmalloc_call_count"sv).value_or(0);
+        printf("%" PRIu64 " kmalloc calls\n", kmalloc_calls);
+        print_slabheap_statistics(*memstat_before, *memstat_after);
+    }
+
+    return EXIT_SUCCESS;
+}
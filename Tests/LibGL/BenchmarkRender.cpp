@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGL/GL/gl.h>
+#include <LibGL/GLContext.h>
+#include <LibGfx/Bitmap.h>
+#include <LibTest/TestCase.h>
+
+static NonnullOwnPtr<GL::GLContext> create_benchmark_context()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 1024, 768 }));
+    auto context = MUST(GL::create_context(*bitmap));
+    GL::make_context_current(context);
+    glEnable(GL_DEPTH_TEST);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    return context;
+}
+
+// Draws a grid of cells x cells triangle pairs covering the whole viewport, with depth and colors varying per vertex.
+static void draw_triangle_grid(int cells, int layers)
+{
+    auto const cell_size = 2.f / cells;
+    glBegin(GL_TRIANGLES);
+    for (int layer = 0; layer < layers; ++layer) {
+        auto const depth = .9f - layer * (1.8f / layers);
+        for (int y = 0; y < cells; ++y) {
+            for (int x = 0; x < cells; ++x) {
+                auto const x0 = -1.f + x * cell_size;
+                auto const y0 = -1.f + y * cell_size;
+                glColor3f(static_cast<float>(x) / cells, static_cast<float>(y) / cells, .5f);
+                glVertex3f(x0, y0, depth);
+                glColor3f(1.f, static_cast<float>(y) / cells, static_cast<float>(layer) / layers);
+                glVertex3f(x0 + cell_size, y0, depth);
+                glColor3f(static_cast<float>(x) / cells, 1.f, .5f);
+                glVertex3f(x0 + cell_size, y0 + cell_size, depth);
+
+                glVertex3f(x0 + cell_size, y0 + cell_size, depth);
+                glColor3f(0.f, static_cast<float>(y) / cells, 1.f);
+                glVertex3f(x0, y0 + cell_size, depth);
+                glColor3f(static_cast<float>(x) / cells, static_cast<float>(y) / cells, .5f);
+                glVertex3f(x0, y0, depth);
+            }
+        }
+    }
+    glEnd();
+}
+
+// Lots of small triangles: dominated by triangle setup and binning.
+BENCHMARK_CASE(small_triangle_throughput)
+{
+    auto context = create_benchmark_context();
+    for (int i = 0; i < 10; ++i)
+        draw_triangle_grid(128, 1);
+    EXPECT_EQ(glGetError(), 0u);
+}
+
+// A few large, overlapping triangles: dominated by per-pixel depth testing and shading.
+BENCHMARK_CASE(large_triangle_fill_rate)
+{
+    auto context = create_benchmark_context();
+    for (int i = 0; i < 10; ++i)
+        draw_triangle_grid(4, 8);
+    EXPECT_EQ(glGetError(), 0u);
+}
@@ -376,3 +376,104 @@ TEST_CASE(0012_blend_equations)
     context->present();
     expect_bitmap_equals_reference(context->frontbuffer(), "0012_blend_equations"sv);
 }
+
+TEST_CASE(0013_many_triangles_draw_order)
+{
+    // Enough triangles in a single batch to be binned into screen tiles, on a framebuffer that is not a tile multiple
+    auto context = create_testing_context(200, 150);
+    glShadeModel(GL_FLAT);
+
+    auto expect_pixel = [&](int x, int y, Color expected) {
+        EXPECT_EQ(context->frontbuffer()->get_pixel(x, y).with_alpha(255), expected);
+    };
+
+    // Without depth testing, the last of all overlapping quads should win everywhere
+    glBegin(GL_QUADS);
+    for (int i = 0; i < 40; ++i) {
+        if (i == 39)
+            glColor3f(0, 1, 0);
+        else
+            glColor3f(1, 0, 0);
+        glVertex2i(-1, -1);
+        glVertex2i(1, -1);
+        glVertex2i(1, 1);
+        glVertex2i(-1, 1);
+    }
+    glEnd();
+
+    EXPECT_EQ(glGetError(), 0u);
+    context->present();
+    for (int y = 0; y < 150; y += 7) {
+        for (int x = 0; x < 200; x += 7)
+            expect_pixel(x, y, Color::Green);
+    }
+    expect_pixel(199, 149, Color::Green);
+
+    // With depth testing, a near quad drawn first should hide every later quad behind it
+    glEnable(GL_DEPTH_TEST);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glBegin(GL_QUADS);
+    glColor3f(1, 0, 0);
+    glVertex3f(-1, -1, -.5f);
+    glVertex3f(0, -1, -.5f);
+    glVertex3f(0, 1, -.5f);
+    glVertex3f(-1, 1, -.5f);
+    glColor3f(0, 0, 1);
+    for (int i = 0; i < 40; ++i) {
+        glVertex3f(-1, -1, .5f);
+        glVertex3f(1, -1, .5f);
+        glVertex3f(1, 1, .5f);
+        glVertex3f(-1, 1, .5f);
+    }
+    glEnd();
+
+    EXPECT_EQ(glGetError(), 0u);
+    context->present();
+    for (int y = 0; y < 150; y += 7) {
+        expect_pixel(0, y, Color::Red);
+        expect_pixel(63, y, Color::Red);
+        expect_pixel(98, y, Color::Red);
+        expect_pixel(102, y, Color::Blue);
+        expect_pixel(199, y, Color::Blue);
+    }
+}
+
+TEST_CASE(0014_many_textured_triangles)
+{
+    // Enough textured triangles in a single batch to be binned, so that texture sampling runs on several threads
+    auto context = create_testing_context(200, 150);
+
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    u8 texture_data[] = { 255, 0, 0, 255, 0, 255, 0, 255, 0, 0, 255, 255, 255, 255, 255, 255 };
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture_data);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+    glEnable(GL_TEXTURE_2D);
+    glBegin(GL_QUADS);
+    for (int i = 0; i < 40; ++i) {
+        glTexCoord2i(0, 0);
+        glVertex2i(-1, 1);
+        glTexCoord2i(0, 1);
+        glVertex2i(-1, -1);
+        glTexCoord2i(1, 1);
+        glVertex2i(1, -1);
+        glTexCoord2i(1, 0);
+        glVertex2i(1, 1);
+    }
+    glEnd();
+
+    EXPECT_EQ(glGetError(), 0u);
+    context->present();
+
+    // Each quarter of the framebuffer shows one texel
+    Array<Color, 4> const texels { Color::Red, Color::Green, Color::Blue, Color::White };
+    for (int y = 0; y < 150; y += 7) {
+        for (int x = 0; x < 200; x += 7) {
+            auto expected = texels[(y < 75 ? 0 : 2) + (x < 100 ? 0 : 1)];
+            EXPECT_EQ(context->frontbuffer()->get_pixel(x, y).with_alpha(255), expected);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibTest/TestCase.h>
+
+// Something that looks vaguely like a screenshot: flat areas, gradients and a bit of noise.
+static NonnullRefPtr<Gfx::Bitmap> create_screenshot_like_bitmap()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 1920, 1080 }));
+    u32 noise = 0x12345678;
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x) {
+            noise = noise * 1103515245 + 12345;
+            if (y < 300)
+                bitmap->set_pixel(x, y, Color(x * 255 / bitmap->width(), y * 255 / 300, 128));
+            else if ((x / 64 + y / 64) % 2)
+                bitmap->set_pixel(x, y, Color::White);
+            else
+                bitmap->set_pixel(x, y, Color(noise >> 24, (noise >> 16) & 0xff, 64));
+        }
+    }
+    return bitmap;
+}
+
+static auto bitmap = create_screenshot_like_bitmap();
+
+BENCHMARK_CASE(encode_none)
+{
+    MUST(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::None }));
+}
+
+BENCHMARK_CASE(encode_fast)
+{
+    MUST(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::Fast }));
+}
+
+BENCHMARK_CASE(encode_default)
+{
+    MUST(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::Default }));
+}
+
+BENCHMARK_CASE(encode_best)
+{
+    MUST(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::Best }));
+}
+
+BENCHMARK_CASE(encode_default_on_four_threads)
+{
+    MUST(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::Default, .compression_thread_count = 4 }));
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+#include <LibGfx/RasterizedPathCache.h>
+#include <LibTest/TestCase.h>
+
+static Gfx::Path create_star(Gfx::FloatPoint center, float radius, int points)
+{
+    Gfx::Path path;
+    for (int i = 0; i < points * 2; ++i) {
+        auto point_radius = i % 2 ? radius * 0.4f : radius;
+        auto angle = i * AK::Pi<float> / points;
+        Gfx::FloatPoint point { center.x() + point_radius * AK::cos(angle), center.y() + point_radius * AK::sin(angle) };
+        if (i == 0)
+            path.move_to(point);
+        else
+            path.line_to(point);
+    }
+    path.close();
+    return path;
+}
+
+// A thin frame around the bitmap: scanlines are almost entirely empty between the edges.
+static Gfx::Path create_frame(Gfx::FloatRect rect, float thickness)
+{
+    Gfx::Path path;
+    path.move_to(rect.top_left());
+    path.line_to(rect.top_right());
+    path.line_to(rect.bottom_right());
+    path.line_to(rect.bottom_left());
+    path.close();
+    auto inner = rect.shrunken(thickness * 2, thickness * 2);
+    path.move_to(inner.top_left());
+    path.line_to(inner.bottom_left());
+    path.line_to(inner.bottom_right());
+    path.line_to(inner.top_right());
+    path.close();
+    return path;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_bitmap()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 1000, 1000 }));
+    bitmap->fill(Gfx::Color::White);
+    return bitmap;
+}
+
+static auto bitmap = create_bitmap();
+
+BENCHMARK_CASE(fill_large_star)
+{
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = create_star({ 500, 500 }, 490, 7);
+    for (int i = 0; i < 100; ++i)
+        aa_painter.fill_path(path, Gfx::Color::Red, Gfx::Painter::WindingRule::Nonzero);
+}
+
+BENCHMARK_CASE(fill_large_star_translucent)
+{
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = create_star({ 500, 500 }, 490, 7);
+    for (int i = 0; i < 100; ++i)
+        aa_painter.fill_path(path, Gfx::Color(255, 0, 0, 100), Gfx::Painter::WindingRule::EvenOdd);
+}
+
+BENCHMARK_CASE(fill_sparse_frame)
+{
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = create_frame({ 10.5f, 10.5f, 980, 980 }, 2.5f);
+    for (int i = 0; i < 100; ++i) {
+        aa_painter.fill_path(path, Gfx::Color::Blue, Gfx::Painter::WindingRule::Nonzero);
+        aa_painter.fill_path(path, Gfx::Color::Blue, Gfx::Painter::WindingRule::EvenOdd);
+    }
+}
+
+BENCHMARK_CASE(fill_repeated_icons)
+{
+    Gfx::RasterizedPathCache::the().clear();
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    for (int i = 0; i < 10; ++i) {
+        for (int y = 0; y < 30; ++y) {
+            for (int x = 0; x < 30; ++x)
+                aa_painter.fill_path(create_star({ 16.5f + x * 33, 16.5f + y * 33 }, 15, 5), Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero);
+        }
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<Gfx::Bitmap> make_glyph_bitmap(int width, int height, Color color)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { width, height }));
+    bitmap->fill(color);
+    return bitmap;
+}
+
+TEST_CASE(cached_glyphs_are_not_rasterized_again)
+{
+    Gfx::GlyphAtlas atlas;
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    int rasterize_count = 0;
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        ++rasterize_count;
+        return make_glyph_bitmap(10, 12, Color::Red);
+    };
+
+    auto first = atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    auto second = atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 1);
+    EXPECT_EQ(first.bitmap.ptr(), second.bitmap.ptr());
+    EXPECT_EQ(first.rect, second.rect);
+    EXPECT_EQ(first.rect.size(), Gfx::IntSize(10, 12));
+    EXPECT_EQ(first.bitmap->get_pixel(first.rect.location()), Color::Red);
+    EXPECT_EQ(atlas.glyph_count(), 1u);
+}
+
+TEST_CASE(empty_glyphs_are_cached)
+{
+    Gfx::GlyphAtlas atlas;
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    int rasterize_count = 0;
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        ++rasterize_count;
+        return nullptr;
+    };
+
+    auto entry = atlas.get_or_rasterize({ font_id, 32, {} }, rasterize);
+    EXPECT(!entry.bitmap);
+    (void)atlas.get_or_rasterize({ font_id, 32, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 1);
+}
+
+TEST_CASE(least_recently_used_page_is_evicted)
+{
+    Gfx::GlyphAtlas atlas { 2 };
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    int rasterize_count = 0;
+    auto glyph_size = Gfx::GlyphAtlas::page_size - 2;
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        ++rasterize_count;
+        return make_glyph_bitmap(glyph_size, glyph_size, Color::Blue);
+    };
+
+    // Each glyph fills a whole page.
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    (void)atlas.get_or_rasterize({ font_id, 2, {} }, rasterize);
+    EXPECT_EQ(atlas.page_count(), 2u);
+
+    // Touch glyph 1 so that glyph 2's page is the one to go.
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    (void)atlas.get_or_rasterize({ font_id, 3, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 3);
+    EXPECT_EQ(atlas.page_count(), 2u);
+
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 3);
+    (void)atlas.get_or_rasterize({ font_id, 2, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 4);
+}
+
+TEST_CASE(reused_pages_are_cleared)
+{
+    Gfx::GlyphAtlas atlas { 1 };
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    auto glyph_size = Gfx::GlyphAtlas::page_size - 2;
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, [&]() -> RefPtr<Gfx::Bitmap> {
+        return make_glyph_bitmap(glyph_size, glyph_size, Color::Red);
+    });
+
+    // The first glyph's page is evicted and reused for this one.
+    auto entry = atlas.get_or_rasterize({ font_id, 2, {} }, [&]() -> RefPtr<Gfx::Bitmap> {
+        return make_glyph_bitmap(10, 10, Color::Blue);
+    });
+    EXPECT_EQ(atlas.page_count(), 1u);
+    EXPECT_EQ(entry.bitmap->get_pixel(entry.rect.location()), Color::Blue);
+    EXPECT_EQ(entry.bitmap->get_pixel(entry.rect.top_right()), Color::Transparent);
+    EXPECT_EQ(entry.bitmap->get_pixel(entry.rect.bottom_left()), Color::Transparent);
+}
+
+TEST_CASE(glyphs_larger_than_a_page_are_cached_separately)
+{
+    Gfx::GlyphAtlas atlas;
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    int rasterize_count = 0;
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        ++rasterize_count;
+        return make_glyph_bitmap(Gfx::GlyphAtlas::page_size + 1, 10, Color::Green);
+    };
+
+    auto first = atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    auto second = atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 1);
+    EXPECT_EQ(atlas.page_count(), 0u);
+    EXPECT_EQ(atlas.standalone_glyph_count(), 1u);
+    EXPECT_EQ(first.bitmap.ptr(), second.bitmap.ptr());
+    EXPECT_EQ(second.rect, first.bitmap->rect());
+}
+
+TEST_CASE(least_recently_used_standalone_glyph_is_evicted)
+{
+    Gfx::GlyphAtlas atlas { Gfx::GlyphAtlas::default_max_page_count, 2 };
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    int rasterize_count = 0;
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        ++rasterize_count;
+        return nullptr;
+    };
+
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    (void)atlas.get_or_rasterize({ font_id, 2, {} }, rasterize);
+
+    // Touch glyph 1 so that glyph 2 is the one to go.
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    (void)atlas.get_or_rasterize({ font_id, 3, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 3);
+    EXPECT_EQ(atlas.standalone_glyph_count(), 2u);
+
+    (void)atlas.get_or_rasterize({ font_id, 1, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 3);
+    (void)atlas.get_or_rasterize({ font_id, 2, {} }, rasterize);
+    EXPECT_EQ(rasterize_count, 4);
+}
+
+TEST_CASE(standalone_glyphs_are_bounded_by_size)
+{
+    auto glyph_size = Gfx::GlyphAtlas::page_size + 1;
+    auto glyph_bytes = make_glyph_bitmap(glyph_size, glyph_size, Color::Black)->size_in_bytes();
+    Gfx::GlyphAtlas atlas { Gfx::GlyphAtlas::default_max_page_count, Gfx::GlyphAtlas::default_max_standalone_glyph_count, glyph_bytes * 2 };
+    auto font_id = Gfx::GlyphAtlas::allocate_font_id();
+    Function<RefPtr<Gfx::Bitmap>()> rasterize = [&]() -> RefPtr<Gfx::Bitmap> {
+        return make_glyph_bitmap(glyph_size, glyph_size, Color::Black);
+    };
+
+    for (u32 glyph_id = 0; glyph_id < 5; ++glyph_id)
+        (void)atlas.get_or_rasterize({ font_id, glyph_id, {} }, rasterize);
+    EXPECT_EQ(atlas.standalone_glyph_count(), 2u);
+}
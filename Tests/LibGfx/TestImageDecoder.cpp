@@ -553,6 +553,62 @@ TEST_CASE(test_jpeg_grayscale_with_weird_mcu_and_reset_marker)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 320, 240 }));
 }
 
+// Compares each pixel of the reduced bitmap to the alpha-weighted average of the corresponding factor x factor box of the full one.
+static double mean_difference_from_box_average(Gfx::Bitmap const& full, Gfx::Bitmap const& reduced, int factor)
+{
+    double difference = 0;
+    int compared_pixels = 0;
+    for (int y = 0; y < reduced.height(); ++y) {
+        for (int x = 0; x < reduced.width(); ++x) {
+            int red = 0, green = 0, blue = 0, alpha = 0;
+            for (int full_y = y * factor; full_y < min(full.height(), (y + 1) * factor); ++full_y) {
+                for (int full_x = x * factor; full_x < min(full.width(), (x + 1) * factor); ++full_x) {
+                    auto color = full.get_pixel(full_x, full_y);
+                    red += color.red() * color.alpha();
+                    green += color.green() * color.alpha();
+                    blue += color.blue() * color.alpha();
+                    alpha += color.alpha();
+                }
+            }
+            if (alpha == 0)
+                continue;
+            auto color = reduced.get_pixel(x, y);
+            difference += abs(color.red() - red / alpha) + abs(color.green() - green / alpha) + abs(color.blue() - blue / alpha);
+            ++compared_pixels;
+        }
+    }
+    return difference / (compared_pixels * 3);
+}
+
+TEST_CASE(test_jpeg_reduced_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb_components.jpg"sv)));
+    auto full_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto full_frame = TRY_OR_FAIL(full_decoder->frame(0));
+
+    struct TestCase {
+        Gfx::IntSize ideal_size;
+        Gfx::IntSize expected_size;
+        int factor;
+    };
+    Array test_cases = {
+        TestCase { { 600, 400 }, { 592, 800 }, 1 },
+        TestCase { { 296, 400 }, { 296, 400 }, 2 },
+        TestCase { { 100, 100 }, { 148, 200 }, 4 },
+        TestCase { { 1, 1 }, { 74, 100 }, 8 },
+    };
+
+    for (auto const& test_case : test_cases) {
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, test_case.ideal_size));
+        EXPECT_EQ(frame.image->size(), test_case.expected_size);
+        EXPECT(mean_difference_from_box_average(*full_frame.image, *frame.image, test_case.factor) < 2);
+
+        // Asking for the natural size afterwards decodes the image again.
+        EXPECT_EQ(TRY_OR_FAIL(plugin_decoder->frame(0)).image->size(), Gfx::IntSize(592, 800));
+    }
+}
+
 TEST_CASE(test_jpeg_malformed_header)
 {
     Array test_inputs = {
@@ -781,6 +837,88 @@ TEST_CASE(test_exif)
     EXPECT_EQ(*exif_metadata.orientation(), Gfx::TIFF::Orientation::Rotate90Clockwise);
 }
 
+TEST_CASE(test_png_partial_frame)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto full_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto full_frame = TRY_OR_FAIL(full_decoder->frame(0));
+
+    // Cut the file off in the middle of its image data.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() / 2)));
+    auto partial_frame = TRY_OR_FAIL(plugin_decoder->partial_frame(0));
+    EXPECT_EQ(partial_frame.image->size(), full_frame.image->size());
+
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < partial_frame.image->width(); ++x)
+            EXPECT_EQ(partial_frame.image->get_pixel(x, y), full_frame.image->get_pixel(x, y));
+    }
+    auto last_row = partial_frame.image->height() - 1;
+    for (int x = 0; x < partial_frame.image->width(); ++x)
+        EXPECT_EQ(partial_frame.image->get_pixel(x, last_row), Color(Color::Transparent));
+
+    // The complete image can't be decoded from the truncated data.
+    EXPECT(plugin_decoder->frame(0).is_error());
+
+    // A failed attempt to decode the complete image doesn't get in the way of decoding what's there.
+    auto retrying_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes().trim(file->bytes().size() / 2)));
+    EXPECT(retrying_decoder->frame(0).is_error());
+    auto retried_frame = TRY_OR_FAIL(retrying_decoder->partial_frame(0));
+    EXPECT_EQ(retried_frame.image->get_pixel(0, 0), full_frame.image->get_pixel(0, 0));
+}
+
+TEST_CASE(test_png_wrong_image_data_checksum)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto full_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto full_frame = TRY_OR_FAIL(full_decoder->frame(0));
+
+    // The Adler-32 checksum of the image data ends right before the CRC of the last IDAT chunk, which is followed by the IEND chunk.
+    auto data = TRY_OR_FAIL(ByteBuffer::copy(file->bytes()));
+    data[data.size() - 12 - 4 - 1] ^= 1;
+
+    // Like browsers, we still show the image.
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(data));
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    for (int y = 0; y < frame.image->height(); ++y) {
+        for (int x = 0; x < frame.image->width(); ++x)
+            EXPECT_EQ(frame.image->get_pixel(x, y), full_frame.image->get_pixel(x, y));
+    }
+}
+
+TEST_CASE(test_png_reduced_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto full_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto full_frame = TRY_OR_FAIL(full_decoder->frame(0));
+
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 16, 16 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(16, 35));
+    EXPECT(mean_difference_from_box_average(*full_frame.image, *frame.image, 4) < 2);
+
+    EXPECT_EQ(TRY_OR_FAIL(plugin_decoder->frame(0)).image->size(), Gfx::IntSize(64, 138));
+}
+
+TEST_CASE(test_png_adam7_reduced_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/adam7.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto full_frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 67, 45 }));
+    EXPECT_EQ(full_frame.image->get_pixel(5, 7), Color(20, 35, 6, 255));
+    EXPECT_EQ(full_frame.image->get_pixel(5, 2), Color(20, 10, 21, 128));
+
+    // Only the first passes of the interlaced image are decoded, which hold every 2nd, 4th or 8th pixel.
+    for (int factor = 2; factor <= 8; factor *= 2) {
+        auto reduced_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(reduced_decoder->frame(0, Gfx::IntSize { 67 / factor, 45 / factor }));
+        EXPECT_EQ(frame.image->size(), Gfx::IntSize(ceil_div(67, factor), ceil_div(45, factor)));
+        for (int y = 0; y < frame.image->height(); ++y) {
+            for (int x = 0; x < frame.image->width(); ++x)
+                EXPECT_EQ(frame.image->get_pixel(x, y), full_frame.image->get_pixel(x * factor, y * factor));
+        }
+    }
+}
+
 TEST_CASE(test_png_malformed_frame)
 {
     Array test_inputs = {
@@ -174,6 +174,24 @@ TEST_CASE(test_png)
     TRY_OR_FAIL((test_roundtrip<Gfx::PNGWriter, Gfx::PNGImageDecoderPlugin>(TRY_OR_FAIL(create_test_rgba_bitmap()))));
 }
 
+TEST_CASE(test_png_compression_levels)
+{
+    // Large enough to be split into several pieces when compressing on multiple threads.
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 512, 768 }));
+    for (int y = 0; y < bitmap->height(); ++y)
+        for (int x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, Gfx::Color(x, y, x ^ y, 255 - (x + y) % 256));
+
+    using CompressionLevel = Gfx::PNGWriter::Options::CompressionLevel;
+    for (auto compression_level : { CompressionLevel::None, CompressionLevel::Fast, CompressionLevel::Default, CompressionLevel::Best }) {
+        for (size_t thread_count : { 1, 4 }) {
+            auto encoded_data = TRY_OR_FAIL(encode_bitmap<Gfx::PNGWriter>(*bitmap, Gfx::PNGWriter::Options { .compression_level = compression_level, .compression_thread_count = thread_count }));
+            auto decoded = TRY_OR_FAIL(expect_single_frame_of_size(*TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(encoded_data)), bitmap->size()));
+            expect_bitmaps_equal(*decoded, *bitmap);
+        }
+    }
+}
+
 TEST_CASE(test_qoi)
 {
     TRY_OR_FAIL((test_roundtrip<Gfx::QOIWriter, Gfx::QOIImageDecoderPlugin>(TRY_OR_FAIL(create_test_rgb_bitmap()))));
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/AntiAliasingPainter.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/EdgeFlagPathRasterizer.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/RasterizedPathCache.h>
+
+static Gfx::Path create_icon_path(Gfx::FloatPoint origin)
+{
+    Gfx::Path path;
+    path.move_to(origin + Gfx::FloatPoint { 10.f, 0.5f });
+    path.line_to(origin + Gfx::FloatPoint { 19.5f, 18.25f });
+    path.line_to(origin + Gfx::FloatPoint { 0.25f, 7.f });
+    path.line_to(origin + Gfx::FloatPoint { 19.75f, 7.f });
+    path.line_to(origin + Gfx::FloatPoint { 0.5f, 18.5f });
+    path.close();
+    return path;
+}
+
+static void expect_bitmaps_equal(Gfx::Bitmap const& a, Gfx::Bitmap const& b)
+{
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x)
+            EXPECT_EQ(a.get_pixel(x, y), b.get_pixel(x, y));
+    }
+}
+
+TEST_CASE(cached_fill_matches_rasterizer)
+{
+    auto expected = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 100, 60 }));
+    auto actual = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 100, 60 }));
+    expected->fill(Gfx::Color::White);
+    actual->fill(Gfx::Color::White);
+    Gfx::Painter expected_painter(expected);
+    Gfx::Painter actual_painter(actual);
+    Gfx::RasterizedPathCache cache;
+
+    // The same shape at three whole-pixel translations (and once more at a fractional one), in two colors.
+    Array<Gfx::FloatPoint, 4> const origins { Gfx::FloatPoint { 3.25f, 4.5f }, { 40.25f, 4.5f }, { 70.25f, 35.5f }, { 40.5f, 35.5f } };
+    for (auto color : { Gfx::Color(Gfx::Color::Blue), Gfx::Color(200, 20, 20, 100) }) {
+        for (auto origin : origins) {
+            auto path = create_icon_path(origin);
+            Gfx::EdgeFlagPathRasterizer<32> rasterizer(enclosing_int_rect(path.bounding_box()).size());
+            rasterizer.fill(expected_painter, path, color, Gfx::Painter::WindingRule::Nonzero);
+            if (!cache.fill(actual_painter, path, color, Gfx::Painter::WindingRule::Nonzero))
+                Gfx::EdgeFlagPathRasterizer<32>(enclosing_int_rect(path.bounding_box()).size()).fill(actual_painter, path, color, Gfx::Painter::WindingRule::Nonzero);
+        }
+    }
+    expect_bitmaps_equal(*expected, *actual);
+
+    // One mask for the shared subpixel offset, one for the fractional one that was only seen twice.
+    EXPECT_EQ(cache.entry_count(), 2u);
+}
+
+TEST_CASE(paths_are_cached_on_second_use)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 64, 64 }));
+    Gfx::Painter painter(bitmap);
+    Gfx::RasterizedPathCache cache;
+
+    auto path = create_icon_path({ 1, 1 });
+    EXPECT(!cache.fill(painter, path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero));
+    EXPECT_EQ(cache.entry_count(), 0u);
+    EXPECT(cache.fill(painter, path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero));
+    EXPECT_EQ(cache.entry_count(), 1u);
+
+    // The winding rule is part of the key.
+    EXPECT(!cache.fill(painter, path, Gfx::Color::Black, Gfx::Painter::WindingRule::EvenOdd));
+
+    // Large paths are never cached.
+    Gfx::Path large_path;
+    large_path.move_to({ 0, 0 });
+    large_path.line_to({ 1000, 0 });
+    large_path.line_to({ 0, 1000 });
+    large_path.close();
+    EXPECT(!cache.fill(painter, large_path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero));
+    EXPECT(!cache.fill(painter, large_path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero));
+}
+
+TEST_CASE(cache_size_is_bounded)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 64, 64 }));
+    Gfx::Painter painter(bitmap);
+    Gfx::RasterizedPathCache cache(16 * KiB);
+
+    for (int i = 0; i < 100; ++i) {
+        auto path = create_icon_path({ 1 + i / 100.f, 1 });
+        (void)cache.fill(painter, path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero);
+        (void)cache.fill(painter, path, Gfx::Color::Black, Gfx::Painter::WindingRule::Nonzero);
+        EXPECT(cache.size_in_bytes() <= 16 * KiB);
+    }
+    EXPECT(cache.entry_count() > 0u);
+    EXPECT(cache.entry_count() < 100u);
+}
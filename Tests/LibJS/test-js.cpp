@@ -6,7 +6,9 @@
  */
 
 #include <LibCore/Environment.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
+#include <LibJS/Script.h>
 #include <LibTest/JavaScriptTestRunner.h>
 #include <stdlib.h>
 #include <time.h>
@@ -28,6 +30,15 @@ TESTJS_GLOBAL_FUNCTION(can_parse_source, canParseSource)
     return JS::Value(!parser.has_errors());
 }
 
+TESTJS_GLOBAL_FUNCTION(evaluate_script, evaluateScript)
+{
+    auto source = TRY(vm.argument(0).to_byte_string(vm));
+    auto script = JS::Script::parse(source, *vm.current_realm());
+    if (script.is_error())
+        return vm.throw_completion<JS::SyntaxError>(script.error()[0].to_string());
+    return vm.bytecode_interpreter().run(script.value());
+}
+
 TESTJS_GLOBAL_FUNCTION(run_queued_promise_jobs, runQueuedPromiseJobs)
 {
     vm.run_queued_promise_jobs();
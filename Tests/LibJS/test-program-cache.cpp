@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<JS::Program> parse(StringView source_text, StringView filename = "test.js"sv)
+{
+    auto parser = JS::Parser(JS::Lexer(source_text, filename));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+TEST_CASE(identical_source_is_a_hit)
+{
+    JS::ProgramCache cache;
+    auto source = "let a = 1;"sv;
+    auto program = parse(source);
+    cache.set(source, "test.js"sv, 0, program);
+
+    auto cached_program = cache.get(source, "test.js"sv, 0, JS::Program::Type::Script);
+    EXPECT_EQ(cached_program.ptr(), program.ptr());
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 0u);
+}
+
+TEST_CASE(different_source_or_origin_is_a_miss)
+{
+    JS::ProgramCache cache;
+    auto source = "let a = 1;"sv;
+    cache.set(source, "test.js"sv, 0, parse(source));
+
+    EXPECT(!cache.get("let a = 2;"sv, "test.js"sv, 0, JS::Program::Type::Script));
+    EXPECT(!cache.get(source, "other.js"sv, 0, JS::Program::Type::Script));
+    EXPECT(!cache.get(source, "test.js"sv, 1, JS::Program::Type::Script));
+    EXPECT(!cache.get(source, "test.js"sv, 0, JS::Program::Type::Module));
+    EXPECT_EQ(cache.hit_count(), 0u);
+    EXPECT_EQ(cache.miss_count(), 4u);
+}
+
+TEST_CASE(size_includes_parse_nodes)
+{
+    JS::ProgramCache cache;
+    auto source = "let a = 1;"sv;
+    cache.set(source, "test.js"sv, 0, parse(source));
+    EXPECT_EQ(cache.size_in_bytes(), source.length() * (1 + JS::ProgramCache::estimated_ast_size_per_source_byte));
+}
+
+TEST_CASE(least_recently_used_program_is_evicted)
+{
+    auto first_source = "let a = 1;"sv;
+    auto second_source = "let b = 2;"sv;
+    auto third_source = "let c = 3;"sv;
+    auto program_size = JS::ProgramCache::size_in_bytes_of(parse(first_source));
+    JS::ProgramCache cache { program_size * 2 };
+
+    cache.set(first_source, "test.js"sv, 0, parse(first_source));
+    cache.set(second_source, "test.js"sv, 0, parse(second_source));
+    EXPECT_EQ(cache.program_count(), 2u);
+
+    // Use the first program so that the second one is the one to go.
+    EXPECT(cache.get(first_source, "test.js"sv, 0, JS::Program::Type::Script));
+    cache.set(third_source, "test.js"sv, 0, parse(third_source));
+    EXPECT_EQ(cache.program_count(), 2u);
+    EXPECT_EQ(cache.size_in_bytes(), program_size * 2);
+
+    EXPECT(cache.get(first_source, "test.js"sv, 0, JS::Program::Type::Script));
+    EXPECT(!cache.get(second_source, "test.js"sv, 0, JS::Program::Type::Script));
+    EXPECT(cache.get(third_source, "test.js"sv, 0, JS::Program::Type::Script));
+}
+
+TEST_CASE(programs_larger_than_the_cache_are_not_cached)
+{
+    auto source = "let a = 1;"sv;
+    JS::ProgramCache cache { source.length() };
+    cache.set(source, "test.js"sv, 0, parse(source));
+    EXPECT_EQ(cache.program_count(), 0u);
+    EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
+
+TEST_CASE(scripts_share_parse_nodes_and_bytecode)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = MUST(JS::Realm::initialize_host_defined_realm(*vm, nullptr, nullptr));
+    auto& realm = *root_execution_context->realm;
+    auto& program_cache = vm->program_cache();
+    auto source = "var counter = (globalThis.counter ?? 0) + 1;"sv;
+
+    auto first_script = MUST(JS::Script::parse(source, realm, "test.js"sv));
+    auto size_before_running = program_cache.size_in_bytes();
+    MUST(vm->bytecode_interpreter().run(first_script));
+    auto* executable = first_script->parse_node().bytecode_executable();
+    EXPECT_NE(executable, nullptr);
+
+    // The second script gets the same parse node, and with it the bytecode of the first run.
+    auto second_script = MUST(JS::Script::parse(source, realm, "test.js"sv));
+    EXPECT_EQ(&second_script->parse_node(), &first_script->parse_node());
+    EXPECT_EQ(program_cache.hit_count(), 1u);
+    EXPECT_EQ(program_cache.size_in_bytes(), size_before_running + executable->size_in_bytes());
+
+    MUST(vm->bytecode_interpreter().run(second_script));
+    EXPECT_EQ(second_script->parse_node().bytecode_executable(), executable);
+    EXPECT_EQ(MUST(realm.global_object().get("counter"_fly_string)), JS::Value(2));
+}
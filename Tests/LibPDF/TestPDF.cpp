@@ -342,3 +342,52 @@ TEST_CASE(render)
     // MyCalGray
     EXPECT_EQ(bitmap->get_pixel(270, 370 - 320), Gfx::Color::NamedColor::Black);
 }
+
+TEST_CASE(render_reuses_document_resources)
+{
+#if !defined(AK_OS_SERENITY)
+    // Get from Build/lagom/bin/TestPDF to Build/lagom/Root/res.
+    auto source_root = LexicalPath(MUST(Core::System::current_executable_path())).parent().parent().string();
+    Core::ResourceImplementation::install(make<Core::ResourceImplementationFile>(MUST(String::formatted("{}/Root/res", source_root))));
+#endif
+
+    auto file = MUST(Core::MappedFile::map("text.pdf"sv));
+    auto document = MUST(PDF::Document::create(file->bytes()));
+    MUST(document->initialize());
+
+    auto page = MUST(document->get_page(0));
+    auto page_size = Gfx::IntSize { 525, 250 };
+    auto first_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, page_size));
+    MUST(PDF::Renderer::render(document, page, first_bitmap, Color::White, PDF::RenderingPreferences {}));
+
+    auto& resource_cache = document->resource_cache();
+    EXPECT_EQ(resource_cache.content_stream_count(), 1u);
+    auto font_count = resource_cache.font_count();
+    EXPECT(font_count > 0);
+
+    // A second render finds everything in the cache, and draws the same page.
+    auto second_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, page_size));
+    MUST(PDF::Renderer::render(document, page, second_bitmap, Color::White, PDF::RenderingPreferences {}));
+    EXPECT_EQ(resource_cache.content_stream_count(), 1u);
+    EXPECT_EQ(resource_cache.font_count(), font_count);
+    for (int y = 0; y < page_size.height(); ++y) {
+        for (int x = 0; x < page_size.width(); ++x)
+            EXPECT_EQ(first_bitmap->get_pixel(x, y), second_bitmap->get_pixel(x, y));
+    }
+}
+
+TEST_CASE(page_contents_are_loaded_on_demand)
+{
+    auto file = MUST(Core::MappedFile::map("text.pdf"sv));
+    auto document = MUST(PDF::Document::create(file->bytes()));
+    MUST(document->initialize());
+
+    // Getting a page only looks at its dictionary, the content stream is loaded when the page is drawn.
+    auto page = MUST(document->get_page(0));
+    EXPECT(page.contents.has<PDF::Reference>());
+    EXPECT(document->get_value(page.contents.as_ref_index()).has<Empty>());
+
+    auto contents = MUST(page.contents_object(*document)).release_nonnull();
+    EXPECT(contents->is<PDF::StreamObject>());
+    EXPECT(MUST(page.page_contents(*document)).bytes().starts_with("0.9 0 0 0.9 0 0 cm"sv.bytes()));
+}
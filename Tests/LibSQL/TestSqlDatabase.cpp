@@ -15,6 +15,7 @@
 #include <LibSQL/Heap.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
+#include <LibSQL/RowSorter.h>
 #include <LibSQL/Value.h>
 #include <LibTest/TestCase.h>
 
@@ -235,3 +236,73 @@ TEST_CASE(reuse_row_storage)
     auto size_in_bytes_after_reinsertion = MUST(db->file_size_in_bytes());
     EXPECT(size_in_bytes_after_reinsertion <= original_size_in_bytes);
 }
+
+static void sort_rows(SQL::Database& db, Optional<size_t> max_rows_needed, size_t expected_run_count)
+{
+    auto sort_descriptor = adopt_ref(*new SQL::TupleDescriptor);
+    sort_descriptor->append({ .type = SQL::SQLType::Integer, .order = SQL::Order::Descending });
+
+    SQL::RowSorter sorter(db, max_rows_needed);
+    for (int i = 0; i < 100; ++i) {
+        SQL::Tuple row;
+        row.append(SQL::Value { i });
+
+        SQL::Tuple sort_key(sort_descriptor);
+        sort_key[0] = (i * 37) % 10;
+
+        TRY_OR_FAIL(sorter.add(row, sort_key));
+    }
+    TRY_OR_FAIL(sorter.finish());
+    EXPECT_EQ(sorter.run_count(), expected_run_count);
+
+    // Rows are sorted by descending key, and rows with equal keys keep their original order.
+    Optional<int> previous_key;
+    Optional<int> previous_value;
+    size_t row_count = 0;
+    while (true) {
+        auto row = TRY_OR_FAIL(sorter.next());
+        if (!row.has_value())
+            break;
+        ++row_count;
+
+        auto value = (*row)[0].to_int<int>().value();
+        auto key = (value * 37) % 10;
+        if (previous_key.has_value()) {
+            EXPECT(key <= *previous_key);
+            if (key == *previous_key)
+                EXPECT(value > *previous_value);
+        }
+        previous_key = key;
+        previous_value = value;
+    }
+    EXPECT_EQ(row_count, max_rows_needed.value_or(100));
+}
+
+TEST_CASE(sort_rows_in_memory)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto db = MUST(SQL::Database::create("/tmp/test.db"));
+    MUST(db->open());
+    sort_rows(db, {}, 0);
+}
+
+TEST_CASE(sort_top_rows)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto db = MUST(SQL::Database::create("/tmp/test.db"));
+    MUST(db->open());
+    db->set_max_sort_rows_in_memory(16);
+    sort_rows(db, 15, 0);
+}
+
+TEST_CASE(sort_rows_with_spilling)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto db = MUST(SQL::Database::create("/tmp/test.db"));
+    MUST(db->open());
+    db->set_max_sort_rows_in_memory(16);
+    sort_rows(db, {}, 7);
+
+    // The scratch heap is removed once the sorter is destroyed.
+    EXPECT(Core::System::stat("/tmp/test.db.scratch-0"sv).is_error());
+}
@@ -6,6 +6,7 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibTest/TestCase.h>
@@ -192,3 +193,26 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_read_storage_with_corrupt_block_size)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+
+    SQL::Block::Index storage_block_id = 0;
+    {
+        auto heap = create_heap();
+        storage_block_id = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(storage_block_id, "data"sv.bytes()));
+        MUST(heap->flush());
+    }
+
+    // Claim that the block holds more data than fits into it.
+    {
+        auto file = TRY_OR_FAIL(Core::File::open(db_path, Core::File::OpenMode::ReadWrite));
+        TRY_OR_FAIL(file->seek(storage_block_id * SQL::Block::SIZE, SeekMode::SetPosition));
+        TRY_OR_FAIL(file->write_value<u32>(SQL::Block::SIZE * 16));
+    }
+
+    auto heap = create_heap();
+    EXPECT(heap->read_storage(storage_block_id).is_error());
+}
@@ -12,6 +12,7 @@
 #include <LibSQL/AST/Parser.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
+#include <LibSQL/ResultCursor.h>
 #include <LibSQL/ResultSet.h>
 #include <LibSQL/Row.h>
 #include <LibSQL/Value.h>
@@ -130,6 +131,20 @@ TEST_CASE(insert_into_table_multiple_tuples_wrong_data_types)
     EXPECT(result.release_error().error() == SQL::SQLErrorCode::InvalidValueType);
 }
 
+TEST_CASE(insert_multiple_tuples_with_error_inserts_nothing)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    auto result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES ('Test_1', 42), ('Test_2', 43), (44, 'Test_3');");
+    EXPECT(result.is_error());
+
+    auto table = MUST(database->get_table("TESTSCHEMA", "TESTTABLE"));
+    auto rows = TRY_OR_FAIL(database->select_all(*table));
+    EXPECT(rows.is_empty());
+}
+
 TEST_CASE(insert_wrong_number_of_values)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -188,19 +203,19 @@ TEST_CASE(insert_with_placeholders)
     {
         auto result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES (?, ?);");
         EXPECT(result.is_error());
-        EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues);
+        EXPECT(result.error().error() == SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues);
 
         result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES (?, ?);", placeholders("Test_1"sv));
         EXPECT(result.is_error());
-        EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues);
+        EXPECT(result.error().error() == SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues);
 
         result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES (?, ?);", placeholders(42, 42));
         EXPECT(result.is_error());
-        EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::InvalidValueType);
+        EXPECT(result.error().error() == SQL::SQLErrorCode::InvalidValueType);
 
         result = try_execute(database, "INSERT INTO TestSchema.TestTable VALUES (?, ?);", placeholders("Test_1"sv, "Test_2"sv));
         EXPECT(result.is_error());
-        EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::InvalidValueType);
+        EXPECT(result.error().error() == SQL::SQLErrorCode::InvalidValueType);
     }
     {
         auto result = execute(database, "INSERT INTO TestSchema.TestTable VALUES (?, ?);", placeholders("Test_1"sv, 42));
@@ -318,6 +333,42 @@ TEST_CASE(select_with_where)
     }
 }
 
+TEST_CASE(select_with_column_comparisons)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 45 ), "
+        "( 'Test_5', 46 );");
+    EXPECT(result.size() == 5);
+
+    auto count = [&](StringView sql, Vector<SQL::Value> placeholder_values = {}) {
+        return execute(database, sql, move(placeholder_values)).size();
+    };
+
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE IntColumn = 44;"sv), 1u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE IntColumn != 44;"sv), 4u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE IntColumn < 44;"sv), 2u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE IntColumn <= 44;"sv), 3u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE IntColumn >= 44.5;"sv), 2u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE TextColumn = 'Test_2';"sv), 1u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE TextColumn > 'Test_2';"sv), 3u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE TestTable.TextColumn = ?;"sv, placeholders("Test_5"sv)), 1u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE (IntColumn > ?) AND (TextColumn < ?);"sv, placeholders(42, "Test_4"sv)), 2u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE (IntColumn > 42) AND ((IntColumn + 1) = 45);"sv), 1u);
+    EXPECT_EQ(count("SELECT * FROM TestSchema.TestTable WHERE 44 < IntColumn;"sv), 2u);
+
+    auto missing_placeholder = try_execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = ?;");
+    EXPECT(missing_placeholder.is_error());
+    EXPECT(missing_placeholder.release_error().error() == SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues);
+}
+
 TEST_CASE(select_cross_join)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -384,6 +435,81 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_filters)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 42 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 45 );");
+    EXPECT(result.size() == 4);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 42 ), "
+        "( 'Test_11', 44 ), "
+        "( 'Test_12', 44 ), "
+        "( 'Test_13', 47 );");
+    EXPECT(result.size() == 4);
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn2 != 'Test_12') "
+        "ORDER BY TextColumn1;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "Test_1");
+    EXPECT_EQ(result[0].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "Test_2");
+    EXPECT_EQ(result[1].row[1].to_byte_string(), "Test_10");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "Test_3");
+    EXPECT_EQ(result[2].row[1].to_byte_string(), "Test_11");
+
+    result = execute(database,
+        "SELECT TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn < TestTable2.IntColumn) AND (TextColumn1 = 'Test_1');");
+    EXPECT_EQ(result.size(), 3u);
+    for (auto& row : result) {
+        EXPECT_EQ(row.row[0].to_byte_string(), "Test_1");
+        EXPECT_NE(row.row[1].to_byte_string(), "Test_10");
+    }
+}
+
+TEST_CASE(explain_select)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+
+    auto result = execute(database,
+        "EXPLAIN SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn1 = 'Test_1');");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "HASH JOIN ON TESTTABLE1.INTCOLUMN = TESTTABLE2.INTCOLUMN");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "  SCAN TESTSCHEMA.TESTTABLE1 WHERE TEXTCOLUMN1 = 'Test_1'");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "  SCAN TESTSCHEMA.TESTTABLE2");
+
+    result = execute(database,
+        "EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn < TestTable2.IntColumn;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "NESTED LOOP JOIN ON TESTTABLE1.INTCOLUMN < TESTTABLE2.INTCOLUMN");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "  SCAN TESTSCHEMA.TESTTABLE1");
+    EXPECT_EQ(result[2].row[0].to_byte_string(), "  SCAN TESTSCHEMA.TESTTABLE2");
+
+    result = execute(database, "EXPLAIN SELECT 'Test' WHERE 'a' = 'a';");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0].to_byte_string(), "FILTER 'a' = 'a'");
+    EXPECT_EQ(result[1].row[0].to_byte_string(), "  SINGLE ROW");
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -634,6 +760,133 @@ TEST_CASE(select_with_order_limit_and_offset)
     EXPECT_EQ(result[9].row[1].to_int<i32>(), 19);
 }
 
+TEST_CASE(select_with_order_larger_than_memory)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    database->set_max_sort_rows_in_memory(8);
+    create_table(database);
+    for (auto count = 0; count < 50; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, (count * 17) % 50));
+        EXPECT(result.size() == 1);
+    }
+
+    auto result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn DESC;");
+    EXPECT_EQ(result.size(), 50u);
+    for (auto i = 0u; i < result.size(); ++i)
+        EXPECT_EQ(result[i].row[1].to_int<i32>(), 49 - static_cast<i32>(i));
+
+    // The first 12 rows don't fit in memory, so these are sorted the same way.
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn LIMIT 2 OFFSET 10;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[1].to_int<i32>(), 10);
+    EXPECT_EQ(result[1].row[1].to_int<i32>(), 11);
+
+    // The first 6 rows do fit in memory, so only those are kept while sorting.
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn LIMIT 3 OFFSET 3;");
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0].row[1].to_int<i32>(), 3);
+    EXPECT_EQ(result[1].row[1].to_int<i32>(), 4);
+    EXPECT_EQ(result[2].row[1].to_int<i32>(), 5);
+}
+
+TEST_CASE(select_with_cursor)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    for (auto count = 0; count < 10; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer("SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn >= ? LIMIT 3 OFFSET 2;"sv));
+    auto statement = parser.next_statement();
+    EXPECT(!parser.has_errors());
+    EXPECT(is<SQL::AST::Select>(*statement));
+
+    auto cursor = MUST(static_cast<SQL::AST::Select const&>(*statement).open_cursor(database, placeholders(5)));
+    EXPECT_EQ(cursor->command(), SQL::SQLCommand::Select);
+    EXPECT_EQ(cursor->column_names(), Vector<ByteString> { "INTCOLUMN" });
+
+    Vector<i32> values;
+    while (true) {
+        auto row = MUST(cursor->next());
+        if (!row.has_value())
+            break;
+        values.append((*row)[0].to_int<i32>().value());
+    }
+    quick_sort(values);
+    EXPECT_EQ(values.size(), 3u);
+    for (auto value : values) {
+        EXPECT(value >= 5);
+        EXPECT(value < 10);
+    }
+
+    EXPECT(!MUST(cursor->next()).has_value());
+}
+
+static NonnullOwnPtr<SQL::ResultCursor> open_cursor(NonnullRefPtr<SQL::Database> database, StringView sql)
+{
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+    auto statement = parser.next_statement();
+    VERIFY(!parser.has_errors());
+    VERIFY(is<SQL::AST::Select>(*statement));
+    return MUST(static_cast<SQL::AST::Select const&>(*statement).open_cursor(move(database), {}));
+}
+
+static size_t count_remaining_rows(SQL::ResultCursor& cursor)
+{
+    size_t row_count = 0;
+    while (MUST(cursor.next()).has_value())
+        ++row_count;
+    return row_count;
+}
+
+TEST_CASE(select_with_cursor_and_interleaved_delete)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    for (auto count = 0; count < 10; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+        result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+
+    // This is what SQLServer does when a client deletes rows while another client is still fetching a result.
+    auto cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1;"sv);
+    auto sorted_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1 ORDER BY IntColumn;"sv);
+    auto other_table_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable2;"sv);
+    for (auto i = 0; i < 3; ++i)
+        EXPECT(MUST(cursor->next()).has_value());
+    EXPECT(MUST(sorted_cursor->next()).has_value());
+    EXPECT(MUST(other_table_cursor->next()).has_value());
+
+    auto result = execute(database, "DELETE FROM TestSchema.TestTable1 WHERE IntColumn < 5;");
+    EXPECT_EQ(result.size(), 5u);
+
+    // The blocks the cursor was about to read may have been freed, so it refuses to go on.
+    auto row = cursor->next();
+    EXPECT(row.is_error());
+    EXPECT_EQ(row.error().error(), SQL::SQLErrorCode::TableModified);
+
+    // A sorted result was fully read before the modification, and other tables weren't modified.
+    EXPECT_EQ(count_remaining_rows(*sorted_cursor), 9u);
+    EXPECT_EQ(count_remaining_rows(*other_table_cursor), 9u);
+
+    auto new_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1;"sv);
+    EXPECT_EQ(count_remaining_rows(*new_cursor), 5u);
+}
+
 TEST_CASE(select_with_limit_out_of_bounds)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -1060,4 +1313,182 @@ TEST_CASE(update_all_rows)
     }
 }
 
+TEST_CASE(insert_batch_of_rows)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+        create_table(database);
+
+        StringBuilder builder;
+        builder.append("INSERT INTO TestSchema.TestTable VALUES "sv);
+        for (auto count = 0; count < 1000; ++count)
+            builder.appendff("{}('T{}', {})", count == 0 ? "" : ", ", count, count);
+        builder.append(';');
+
+        auto result = execute(database, builder.to_byte_string());
+        EXPECT_EQ(result.size(), 1000u);
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        auto result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn;");
+        EXPECT_EQ(result.size(), 1000u);
+
+        for (auto i = 0u; i < 1000; ++i) {
+            EXPECT_EQ(result[i].row[0].to_byte_string(), ByteString::formatted("T{}", i));
+            EXPECT_EQ(result[i].row[1], static_cast<int>(i));
+        }
+    }
+}
+
+TEST_CASE(commit_transaction)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+        create_table(database);
+
+        auto result = execute(database, "BEGIN TRANSACTION;");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Begin);
+        EXPECT(database->in_transaction());
+
+        for (auto count = 0; count < 10; ++count)
+            execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+        execute(database, "UPDATE TestSchema.TestTable SET IntColumn=42 WHERE IntColumn=3;");
+
+        result = execute(database, "COMMIT;");
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Commit);
+        EXPECT(!database->in_transaction());
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable WHERE IntColumn=42;");
+        EXPECT_EQ(result.size(), 1u);
+
+        result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable;");
+        EXPECT_EQ(result.size(), 10u);
+    }
+}
+
+TEST_CASE(rollback_transaction)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'Test_1', 42 );");
+
+    execute(database, "BEGIN;");
+    for (auto count = 100; count < 200; ++count)
+        execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable VALUES ( 'T{}', {} );", count, count));
+    execute(database, "DELETE FROM TestSchema.TestTable WHERE IntColumn=42;");
+    execute(database, "CREATE TABLE TestSchema.OtherTable ( IntColumn integer );");
+
+    auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable;");
+    EXPECT_EQ(result.size(), 100u);
+
+    result = execute(database, "ROLLBACK TRANSACTION;");
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Rollback);
+    EXPECT(!database->in_transaction());
+
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable;");
+    EXPECT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].row[0], "Test_1"sv);
+    EXPECT_EQ(result[0].row[1], 42);
+
+    auto other_table = try_execute(database, "SELECT IntColumn FROM TestSchema.OtherTable;");
+    EXPECT(other_table.is_error());
+    EXPECT(other_table.release_error().error() == SQL::SQLErrorCode::TableDoesNotExist);
+
+    // The blocks of the discarded rows are handed out again.
+    execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'Test_2', 43 );");
+    result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable ORDER BY IntColumn;");
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].row[0], 42);
+    EXPECT_EQ(result[1].row[0], 43);
+}
+
+TEST_CASE(rollback_transaction_with_open_cursors)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    execute(database, "INSERT INTO TestSchema.TestTable2 VALUES ( 'Test_1', 42 );");
+
+    execute(database, "BEGIN;");
+    for (auto count = 0; count < 10; ++count)
+        execute(database, ByteString::formatted("INSERT INTO TestSchema.TestTable1 VALUES ( 'T{}', {} );", count, count));
+
+    auto cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1;"sv);
+    auto sorted_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1 ORDER BY IntColumn;"sv);
+    auto other_table_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable2;"sv);
+    EXPECT(MUST(cursor->next()).has_value());
+    EXPECT(MUST(sorted_cursor->next()).has_value());
+
+    execute(database, "ROLLBACK;");
+
+    // The rollback discarded the blocks the cursors point into, and the rows they have read, so none of them go on.
+    for (auto* open_cursor : { cursor.ptr(), sorted_cursor.ptr(), other_table_cursor.ptr() }) {
+        auto row = open_cursor->next();
+        EXPECT(row.is_error());
+        EXPECT_EQ(row.error().error(), SQL::SQLErrorCode::TransactionRolledBack);
+    }
+
+    auto new_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable1;"sv);
+    EXPECT_EQ(count_remaining_rows(*new_cursor), 0u);
+    new_cursor = open_cursor(database, "SELECT IntColumn FROM TestSchema.TestTable2;"sv);
+    EXPECT_EQ(count_remaining_rows(*new_cursor), 1u);
+}
+
+TEST_CASE(unfinished_transaction_is_not_committed)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+        create_table(database);
+
+        execute(database, "BEGIN;");
+        execute(database, "INSERT INTO TestSchema.TestTable VALUES ( 'Test_1', 42 );");
+    }
+    {
+        auto database = MUST(SQL::Database::create(db_name));
+        MUST(database->open());
+
+        auto result = execute(database, "SELECT IntColumn FROM TestSchema.TestTable;");
+        EXPECT(result.is_empty());
+    }
+}
+
+TEST_CASE(transaction_errors)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+
+    auto commit_result = try_execute(database, "COMMIT;");
+    EXPECT(commit_result.is_error());
+    EXPECT(commit_result.release_error().error() == SQL::SQLErrorCode::NoActiveTransaction);
+
+    auto rollback_result = try_execute(database, "ROLLBACK;");
+    EXPECT(rollback_result.is_error());
+    EXPECT(rollback_result.release_error().error() == SQL::SQLErrorCode::NoActiveTransaction);
+
+    execute(database, "BEGIN;");
+    auto begin_result = try_execute(database, "BEGIN;");
+    EXPECT(begin_result.is_error());
+    EXPECT(begin_result.release_error().error() == SQL::SQLErrorCode::TransactionActive);
+    EXPECT(database->in_transaction());
+
+    execute(database, "END TRANSACTION;");
+    EXPECT(!database->in_transaction());
+}
+
 }
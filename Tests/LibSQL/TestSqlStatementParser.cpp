@@ -783,3 +783,54 @@ TEST_CASE(describe_table)
     validate("DESCRIBE TABLE TableName;"sv, {}, "TABLENAME"sv);
     validate("DESCRIBE TABLE SchemaName.TableName;"sv, "SCHEMANAME"sv, "TABLENAME"sv);
 }
+
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN"sv).is_error());
+    EXPECT(parse("EXPLAIN;"sv).is_error());
+    EXPECT(parse("EXPLAIN QUERY SELECT * FROM table_name;"sv).is_error());
+    EXPECT(parse("EXPLAIN DELETE FROM table_name;"sv).is_error());
+
+    auto validate = [](StringView sql, StringView expected_table) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::Explain>(*statement));
+
+        auto const& explain_statement = static_cast<const SQL::AST::Explain&>(*statement);
+        auto const& table_or_subquery_list = explain_statement.select_statement()->table_or_subquery_list();
+        EXPECT_EQ(table_or_subquery_list.size(), 1u);
+        EXPECT_EQ(table_or_subquery_list[0]->table_name(), expected_table);
+    };
+
+    validate("EXPLAIN SELECT * FROM TableName;"sv, "TABLENAME"sv);
+    validate("EXPLAIN QUERY PLAN SELECT * FROM TableName WHERE ColumnName = 1;"sv, "TABLENAME"sv);
+    validate("EXPLAIN WITH CommonTable AS (SELECT * FROM TableName) SELECT * FROM TableName;"sv, "TABLENAME"sv);
+}
+
+TEST_CASE(transaction)
+{
+    EXPECT(parse("BEGIN"sv).is_error());
+    EXPECT(parse("BEGIN TABLE;"sv).is_error());
+    EXPECT(parse("COMMIT TABLE;"sv).is_error());
+    EXPECT(parse("ROLLBACK"sv).is_error());
+
+    auto validate = [](StringView sql, auto type_check) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(type_check(*statement));
+    };
+
+    auto is_begin = [](auto const& statement) { return is<SQL::AST::BeginTransaction>(statement); };
+    auto is_commit = [](auto const& statement) { return is<SQL::AST::CommitTransaction>(statement); };
+    auto is_rollback = [](auto const& statement) { return is<SQL::AST::RollbackTransaction>(statement); };
+
+    validate("BEGIN;"sv, is_begin);
+    validate("BEGIN TRANSACTION;"sv, is_begin);
+    validate("BEGIN DEFERRED TRANSACTION;"sv, is_begin);
+    validate("BEGIN IMMEDIATE;"sv, is_begin);
+    validate("BEGIN EXCLUSIVE TRANSACTION;"sv, is_begin);
+    validate("COMMIT;"sv, is_commit);
+    validate("COMMIT TRANSACTION;"sv, is_commit);
+    validate("END;"sv, is_commit);
+    validate("END TRANSACTION;"sv, is_commit);
+    validate("ROLLBACK;"sv, is_rollback);
+    validate("ROLLBACK TRANSACTION;"sv, is_rollback);
+}
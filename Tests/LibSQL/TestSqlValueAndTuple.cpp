@@ -11,6 +11,7 @@
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
 #include <LibSQL/Tuple.h>
+#include <LibSQL/TupleView.h>
 #include <LibSQL/Value.h>
 #include <LibTest/TestCase.h>
 
@@ -668,6 +669,81 @@ TEST_CASE(serialize_tuple)
     EXPECT_EQ(tuple2[1], 42);
 }
 
+TEST_CASE(value_view)
+{
+    auto descriptor = adopt_ref(*new SQL::TupleDescriptor);
+    descriptor->append({ "schema", "table", "col1", SQL::SQLType::Text, SQL::Order::Ascending });
+    auto tuple_value = MUST(SQL::Value::create_tuple(move(descriptor)));
+    MUST(tuple_value.assign_tuple(Vector { SQL::Value { "Test"sv } }));
+
+    Vector<SQL::Value> values;
+    values.empend(SQL::SQLType::Null);
+    values.empend(SQL::SQLType::Integer);
+    values.empend("Test"sv);
+    values.empend(""sv);
+    values.empend(-3);
+    values.empend(1234);
+    values.empend(NumericLimits<i64>::min());
+    values.empend(200u);
+    values.empend(NumericLimits<u64>::max());
+    values.empend(3.5);
+    values.empend(true);
+    values.append(tuple_value);
+
+    SQL::Serializer serializer;
+    for (auto const& value : values)
+        serializer.serialize<SQL::Value>(value);
+
+    serializer.rewind();
+    for (auto const& value : values) {
+        auto view = serializer.deserialize<SQL::ValueView>();
+        EXPECT_EQ(view.type(), value.type());
+        EXPECT_EQ(view.is_null(), value.is_null());
+
+        auto materialized = view.to_value();
+        EXPECT_EQ(materialized.type(), value.type());
+        EXPECT_EQ(materialized.is_null(), value.is_null());
+        if (!value.is_null())
+            EXPECT_EQ(materialized, value);
+
+        for (auto const& other : values)
+            EXPECT_EQ(view.compare(other), value.compare(other));
+    }
+}
+
+TEST_CASE(tuple_view)
+{
+    NonnullRefPtr<SQL::TupleDescriptor> descriptor = adopt_ref(*new SQL::TupleDescriptor);
+    descriptor->append({ "schema", "table", "col1", SQL::SQLType::Text, SQL::Order::Ascending });
+    descriptor->append({ "schema", "table", "col2", SQL::SQLType::Integer, SQL::Order::Descending });
+
+    SQL::Tuple tuple(descriptor, 7);
+    tuple["col1"] = "Test";
+    tuple["col2"] = 42;
+
+    SQL::Serializer serializer;
+    serializer.serialize<SQL::Tuple>(tuple);
+    serializer.serialize<u32>(1234);
+
+    serializer.rewind();
+    SQL::TupleView view { serializer };
+    EXPECT_EQ(view.block_index(), 7u);
+    EXPECT_EQ(view.size(), 2u);
+    EXPECT_EQ(view[0].compare(SQL::Value { "Test"sv }), 0);
+    EXPECT(view[0].compare(SQL::Value { "Text"sv }) < 0);
+    EXPECT_EQ(view[1].compare(SQL::Value { 42 }), 0);
+    EXPECT(view[1].compare(SQL::Value { 41 }) > 0);
+
+    // Materializing the tuple leaves the serializer after the tuple.
+    auto tuple2 = view.to_tuple(descriptor);
+    EXPECT_EQ(serializer.deserialize<u32>(), 1234u);
+
+    EXPECT_EQ(tuple2.descriptor(), descriptor);
+    EXPECT_EQ(tuple2.block_index(), 7u);
+    EXPECT_EQ(tuple2["col1"], "Test"sv);
+    EXPECT_EQ(tuple2["col2"], 42);
+}
+
 TEST_CASE(copy_tuple)
 {
     NonnullRefPtr<SQL::TupleDescriptor> descriptor = adopt_ref(*new SQL::TupleDescriptor);
@@ -1305,3 +1381,55 @@ TEST_CASE(shift_right_error)
         EXPECT_EQ(result.error().error(), SQL::SQLErrorCode::NumericOperatorTypeMismatch);
     }
 }
+
+static SQL::Serializer serialize_rows_for_benchmark(size_t count)
+{
+    NonnullRefPtr<SQL::TupleDescriptor> descriptor = adopt_ref(*new SQL::TupleDescriptor);
+    descriptor->append({ "schema", "table", "name", SQL::SQLType::Text, SQL::Order::Ascending });
+    descriptor->append({ "schema", "table", "description", SQL::SQLType::Text, SQL::Order::Ascending });
+    descriptor->append({ "schema", "table", "count", SQL::SQLType::Integer, SQL::Order::Ascending });
+
+    SQL::Serializer serializer;
+    for (size_t i = 0; i < count; ++i) {
+        SQL::Tuple tuple(descriptor);
+        tuple[0] = ByteString::formatted("Name {}", i);
+        tuple[1] = ByteString::formatted("A description that is long enough not to fit inline {}", i);
+        tuple[2] = i;
+        serializer.serialize<SQL::Tuple>(tuple);
+    }
+
+    return serializer;
+}
+
+static constexpr size_t benchmark_row_count = 10'000;
+
+BENCHMARK_CASE(compare_materialized_rows)
+{
+    auto serializer = serialize_rows_for_benchmark(benchmark_row_count);
+    auto descriptor = adopt_ref(*new SQL::TupleDescriptor);
+    SQL::Value value { "Name 5000"sv };
+
+    size_t matches = 0;
+    serializer.rewind();
+    for (size_t i = 0; i < benchmark_row_count; ++i) {
+        SQL::Tuple tuple { descriptor, serializer };
+        if (tuple[0].compare(value) == 0)
+            ++matches;
+    }
+    EXPECT_EQ(matches, 1u);
+}
+
+BENCHMARK_CASE(compare_row_views)
+{
+    auto serializer = serialize_rows_for_benchmark(benchmark_row_count);
+    SQL::Value value { "Name 5000"sv };
+
+    size_t matches = 0;
+    serializer.rewind();
+    for (size_t i = 0; i < benchmark_row_count; ++i) {
+        SQL::TupleView view { serializer };
+        if (view[0].compare(value) == 0)
+            ++matches;
+    }
+    EXPECT_EQ(matches, 1u);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/Benchmark.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(statistics_of_odd_sample_count)
+{
+    auto statistics = Test::BenchmarkStatistics::from_samples({ 5, 1, 4, 2, 3 }, 8);
+    EXPECT_EQ(statistics.sample_count, 5u);
+    EXPECT_EQ(statistics.iterations_per_sample, 8u);
+    EXPECT_EQ(statistics.min, 1.0);
+    EXPECT_EQ(statistics.median, 3.0);
+    EXPECT_EQ(statistics.p95, 5.0);
+    EXPECT_EQ(statistics.mean, 3.0);
+    EXPECT_APPROXIMATE(statistics.standard_deviation, 1.5811388);
+}
+
+TEST_CASE(statistics_of_even_sample_count)
+{
+    Vector<double> samples;
+    for (size_t i = 1; i <= 20; ++i)
+        samples.append(static_cast<double>(i));
+
+    auto statistics = Test::BenchmarkStatistics::from_samples(move(samples), 1);
+    EXPECT_EQ(statistics.median, 10.5);
+    EXPECT_EQ(statistics.p95, 19.0);
+    EXPECT_EQ(statistics.mean, 10.5);
+}
+
+TEST_CASE(statistics_of_single_sample)
+{
+    auto statistics = Test::BenchmarkStatistics::from_samples({ 42 }, 1);
+    EXPECT_EQ(statistics.min, 42.0);
+    EXPECT_EQ(statistics.median, 42.0);
+    EXPECT_EQ(statistics.p95, 42.0);
+    EXPECT_EQ(statistics.standard_deviation, 0.0);
+}
+
+TEST_CASE(compare_against_baseline)
+{
+    Test::BenchmarkStatistics baseline;
+    baseline.median = 100;
+    baseline.standard_deviation = 2;
+
+    Test::BenchmarkStatistics current;
+    current.median = 105;
+    current.standard_deviation = 2;
+    auto comparison = Test::compare_benchmark_statistics(baseline, current, 10);
+    EXPECT_APPROXIMATE(comparison.change_in_percent, 5.0);
+    EXPECT(!comparison.is_regression);
+
+    current.median = 120;
+    comparison = Test::compare_benchmark_statistics(baseline, current, 10);
+    EXPECT(comparison.is_regression);
+
+    // A slowdown that is within the noise of the measurements isn't a regression.
+    current.standard_deviation = 30;
+    comparison = Test::compare_benchmark_statistics(baseline, current, 10);
+    EXPECT(!comparison.is_regression);
+
+    current.median = 80;
+    current.standard_deviation = 2;
+    comparison = Test::compare_benchmark_statistics(baseline, current, 10);
+    EXPECT_APPROXIMATE(comparison.change_in_percent, -20.0);
+    EXPECT(!comparison.is_regression);
+}
+
+BENCHMARK_CASE_WITH_SIZES(sum_of_vector, 16, 1024, 65536)
+{
+    Vector<u64> values;
+    values.resize(size);
+    for (size_t i = 0; i < size; ++i)
+        values[i] = i;
+
+    u64 sum = 0;
+    for (auto value : values)
+        sum += value;
+    Test::do_not_optimize(sum);
+}
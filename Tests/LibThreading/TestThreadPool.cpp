@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+
+TEST_CASE(wait_for_all_waits_for_submitted_work)
+{
+    Atomic<size_t> completed { 0 };
+    Threading::ThreadPool<size_t> pool { [&](size_t) { completed++; }, 4 };
+
+    for (size_t round = 0; round < 100; ++round) {
+        for (size_t i = 0; i < 16; ++i)
+            pool.submit(i);
+        pool.wait_for_all();
+        EXPECT_EQ(completed.load(), (round + 1) * 16);
+    }
+}
+
+TEST_CASE(wait_for_all_without_work_returns_immediately)
+{
+    Threading::ThreadPool<size_t> pool { [](size_t) {}, 2 };
+    pool.wait_for_all();
+}
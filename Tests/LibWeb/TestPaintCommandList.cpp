@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Painting/CommandExecutorCPU.h>
+#include <LibWeb/Painting/CommandList.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+static constexpr Gfx::IntSize viewport_size { 800, 600 };
+
+// Records something shaped like a long page: rows of boxes, every fourth of them inside a translucent stacking context.
+static void record_long_page(Web::Painting::RecordingPainter& painter, int row_count)
+{
+    painter.fill_rect({ 0, 0, viewport_size.width(), row_count * 40 }, Color::White);
+    for (int row = 0; row < row_count; ++row) {
+        Gfx::IntRect row_rect { 8, row * 40 + 4, viewport_size.width() - 16, 32 };
+        bool translucent = row % 4 == 0;
+        if (translucent) {
+            painter.push_stacking_context({
+                .opacity = 0.5f,
+                .is_fixed_position = false,
+                .source_paintable_rect = row_rect,
+                .image_rendering = Web::CSS::ImageRendering::Auto,
+                .transform = { .origin = {}, .matrix = Gfx::FloatMatrix4x4::identity() },
+            });
+        }
+        painter.fill_rect(row_rect, Color::from_rgb(0x3366cc));
+        painter.draw_rect(row_rect, Color::Black);
+        if (translucent)
+            painter.pop_stacking_context();
+    }
+}
+
+TEST_CASE(culling_offscreen_stacking_contexts_keeps_visible_ones)
+{
+    Web::Painting::CommandList commands;
+    Web::Painting::RecordingPainter painter(commands);
+    record_long_page(painter, 100);
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, viewport_size));
+    Web::Painting::CommandExecutorCPU executor(*bitmap);
+    commands.execute(executor);
+
+    auto box_color = Color::from_rgb(0x3366cc);
+    // Rows 0 and 12 are translucent, so they are blended with the white page background.
+    for (auto y : { 20, 500 }) {
+        auto pixel = bitmap->get_pixel(100, y);
+        EXPECT_NE(pixel, box_color);
+        EXPECT_NE(pixel, Color::White);
+    }
+    // Row 1 is opaque.
+    EXPECT_EQ(bitmap->get_pixel(100, 60), box_color);
+}
+
+BENCHMARK_CASE(execute_long_page)
+{
+    Web::Painting::CommandList commands;
+    Web::Painting::RecordingPainter painter(commands);
+    record_long_page(painter, 10'000);
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, viewport_size));
+    for (size_t i = 0; i < 100; ++i) {
+        Web::Painting::CommandExecutorCPU executor(*bitmap);
+        commands.execute(executor);
+    }
+}
@@ -78,8 +78,7 @@ ViewWidget::ViewWidget()
 
 void ViewWidget::clear()
 {
-    m_timer->stop();
-    m_animation.clear();
+    release_animation();
     m_image = nullptr;
     if (on_image_change)
         on_image_change(m_image);
@@ -222,6 +221,8 @@ ErrorOr<void> ViewWidget::try_open_file(String const& path, Core::File& file)
     bool is_animated = false;
     size_t loop_count = 0;
     Vector<Animation::Frame> frames;
+    Optional<i64> on_demand_image_id;
+    Gfx::FloatPoint scale { 1, 1 };
     // Note: Doing this check only requires reading the header of images
     // (so if the image is not vector graphics it can be still be decoded OOP).
     if (auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(file_data)); decoder && decoder->natural_frame_format() == Gfx::NaturalFrameFormat::Vector) {
@@ -235,23 +236,38 @@ ErrorOr<void> ViewWidget::try_open_file(String const& path, Core::File& file)
         }
     } else {
         // Use out-of-process decoding for raster formats.
-        auto client = TRY(ImageDecoderClient::Client::try_create());
+        if (!m_image_decoder_client) {
+            m_image_decoder_client = TRY(ImageDecoderClient::Client::try_create());
+            m_image_decoder_client->on_death = [this] {
+                m_image_decoder_client = nullptr;
+            };
+        }
         auto mime_type = Core::guess_mime_type_based_on_filename(path);
 
         // FIXME: Refactor file opening to be more async-aware, and don't await this promise
-        auto decoded_image = TRY(client->decode_image(file_data, {}, {}, OptionalNone {}, mime_type)->await());
+        auto decoded_image = TRY(m_image_decoder_client->decode_image(file_data, {}, {}, OptionalNone {}, mime_type, ImageDecoderClient::FrameDecoding::OnDemand)->await());
         is_animated = decoded_image.is_animated;
         loop_count = decoded_image.loop_count;
-        frames.ensure_capacity(decoded_image.frames.size());
+        scale = decoded_image.scale;
+        TRY(frames.try_resize(decoded_image.frame_count));
         for (u32 i = 0; i < decoded_image.frames.size(); i++) {
             auto& frame_data = decoded_image.frames[i];
-            frames.unchecked_append({ BitmapImage::create(frame_data.bitmap, decoded_image.scale), int(frame_data.duration) });
+            frames[i] = { BitmapImage::create(frame_data.bitmap, decoded_image.scale), int(frame_data.duration) };
         }
+        if (decoded_image.frames.size() < decoded_image.frame_count)
+            on_demand_image_id = decoded_image.image_id;
     }
 
+    release_animation();
+    m_current_frame_index = 0;
+    m_loops_completed = 0;
+
     m_image = frames[0].image;
     if (is_animated && frames.size() > 1) {
-        m_animation = Animation { loop_count, move(frames) };
+        m_animation = Animation { loop_count, move(frames), on_demand_image_id, scale, {} };
+    } else if (on_demand_image_id.has_value() && m_image_decoder_client) {
+        // Only the first frame of an image that isn't animated is ever shown.
+        m_image_decoder_client->release_image(*on_demand_image_id);
     }
 
     set_original_rect(m_image->rect());
@@ -261,8 +277,7 @@ ErrorOr<void> ViewWidget::try_open_file(String const& path, Core::File& file)
         m_timer->set_interval(first_frame.duration);
         m_timer->on_timeout = [this] { animate(); };
         m_timer->start();
-    } else {
-        m_timer->stop();
+        request_animation_frame(1);
     }
 
     set_path(path);
@@ -351,7 +366,17 @@ void ViewWidget::animate()
     if (!m_animation.has_value())
         return;
 
-    m_current_frame_index = (m_current_frame_index + 1) % m_animation->frames.size();
+    auto next_frame_index = (m_current_frame_index + 1) % m_animation->frames.size();
+
+    // A frame that is decoded on demand may not have arrived yet, in which case the current one stays up a little longer.
+    if (!m_animation->frames[next_frame_index].image) {
+        request_animation_frame(next_frame_index);
+        return;
+    }
+
+    if (m_animation->image_id.has_value())
+        m_animation->frames[m_current_frame_index].image = nullptr;
+    m_current_frame_index = next_frame_index;
 
     auto const& current_frame = m_animation->frames[m_current_frame_index];
     set_image(current_frame.image);
@@ -364,8 +389,57 @@ void ViewWidget::animate()
         ++m_loops_completed;
         if (m_loops_completed > 0 && m_loops_completed == m_animation->loop_count) {
             m_timer->stop();
+            return;
         }
     }
+
+    // Ask for the frame after this one now, so that it's ready by the time it's due.
+    request_animation_frame((m_current_frame_index + 1) % m_animation->frames.size());
+}
+
+void ViewWidget::request_animation_frame(size_t frame_index)
+{
+    if (!m_animation.has_value() || !m_animation->image_id.has_value())
+        return;
+    if (m_animation->frames[frame_index].image || m_animation->requested_frame_index == frame_index)
+        return;
+
+    if (!m_image_decoder_client) {
+        // ImageDecoder went away, so there is no way to get the rest of the animation.
+        m_timer->stop();
+        return;
+    }
+
+    auto image_id = *m_animation->image_id;
+    m_animation->requested_frame_index = frame_index;
+
+    auto promise = m_image_decoder_client->request_animation_frame(image_id, frame_index);
+    promise->on_resolution = [this, image_id, frame_index](ImageDecoderClient::Frame& frame) -> ErrorOr<void> {
+        // Another image may have been opened in the meantime.
+        if (!m_animation.has_value() || m_animation->image_id != image_id)
+            return {};
+        m_animation->requested_frame_index.clear();
+        m_animation->frames[frame_index] = { BitmapImage::create(frame.bitmap, m_animation->scale), int(frame.duration) };
+        return {};
+    };
+    promise->on_rejection = [this, image_id](Error& error) {
+        if (!m_animation.has_value() || m_animation->image_id != image_id)
+            return;
+        dbgln("ImageViewer: Failed to decode animation frame: {}", error);
+        m_timer->stop();
+    };
+}
+
+void ViewWidget::release_animation()
+{
+    m_timer->stop();
+    if (!m_animation.has_value())
+        return;
+
+    // Releasing the image rejects its pending frame request, which must not be mistaken for a decoding error.
+    auto image_id = m_animation.release_value().image_id;
+    if (image_id.has_value() && m_image_decoder_client)
+        m_image_decoder_client->release_image(*image_id);
 }
 
 void ViewWidget::set_scaling_mode(Gfx::Painter::ScalingMode scaling_mode)
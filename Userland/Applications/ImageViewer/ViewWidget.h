@@ -16,6 +16,7 @@
 #include <LibGUI/AbstractZoomPanWidget.h>
 #include <LibGUI/Painter.h>
 #include <LibGfx/VectorGraphic.h>
+#include <LibImageDecoderClient/Client.h>
 
 namespace ImageViewer {
 
@@ -140,6 +141,8 @@ private:
 
     void set_image(Image const* image);
     void animate();
+    void request_animation_frame(size_t frame_index);
+    void release_animation();
     Vector<ByteString> load_files_from_directory(ByteString const& path) const;
     ErrorOr<void> try_open_file(String const&, Core::File&);
 
@@ -154,8 +157,14 @@ private:
 
         size_t loop_count { 0 };
         Vector<Frame> frames;
+
+        // Raster animations are decoded by ImageDecoder one frame at a time, and only the current and the next frame are kept.
+        Optional<i64> image_id;
+        Gfx::FloatPoint scale { 1, 1 };
+        Optional<size_t> requested_frame_index;
     };
 
+    RefPtr<ImageDecoderClient::Client> m_image_decoder_client;
     Optional<Animation> m_animation;
 
     size_t m_current_frame_index { 0 };
@@ -17,6 +17,11 @@
 
 static constexpr int PAGE_PADDING = 10;
 
+// How many pages after the current one are rendered ahead of time, and how long the viewer has to be idle before
+// that starts.
+static constexpr u32 PREFETCH_PAGE_COUNT = 2;
+static constexpr int PREFETCH_DELAY_MS = 100;
+
 static constexpr Array zoom_levels = {
     17,
     21,
@@ -45,6 +50,8 @@ PDFViewer::PDFViewer()
 
     start_timer(30'000);
 
+    m_prefetch_timer = Core::Timer::create_single_shot(PREFETCH_DELAY_MS, [this] { prefetch_next_page(); }, this);
+
     m_page_view_mode = static_cast<PageViewMode>(Config::read_i32("PDFViewer"sv, "Display"sv, "PageMode"sv, 0));
     m_rendering_preferences.show_clipping_paths = Config::read_bool("PDFViewer"sv, "Rendering"sv, "ShowClippingPaths"sv, false);
     m_rendering_preferences.show_images = Config::read_bool("PDFViewer"sv, "Rendering"sv, "ShowImages"sv, true);
@@ -72,19 +79,46 @@ PDF::PDFErrorOr<void> PDFViewer::set_document(RefPtr<PDF::Document> document)
     return {};
 }
 
+u32 PDFViewer::rendered_page_key() const
+{
+    return pair_int_hash(m_rendering_preferences.hash(), m_zoom_level);
+}
+
+bool PDFViewer::has_rendered_page(u32 index) const
+{
+    auto existing_rendered_page = m_rendered_page_list[index].get(rendered_page_key());
+    return existing_rendered_page.has_value() && existing_rendered_page.value().rotation == m_rotations;
+}
+
 PDF::PDFErrorOr<NonnullRefPtr<Gfx::Bitmap>> PDFViewer::get_rendered_page(u32 index)
 {
-    auto key = pair_int_hash(m_rendering_preferences.hash(), m_zoom_level);
+    auto key = rendered_page_key();
     auto& rendered_page_map = m_rendered_page_list[index];
-    auto existing_rendered_page = rendered_page_map.get(key);
-    if (existing_rendered_page.has_value() && existing_rendered_page.value().rotation == m_rotations)
-        return existing_rendered_page.value().bitmap;
+    if (has_rendered_page(index))
+        return rendered_page_map.get(key).value().bitmap;
 
     auto rendered_page = TRY(render_page(index));
     rendered_page_map.set(key, { rendered_page, m_rotations });
     return rendered_page;
 }
 
+void PDFViewer::prefetch_next_page()
+{
+    if (!m_document || m_document->get_page_count() == 0)
+        return;
+
+    // Render one page per timer shot, so that input is handled in between pages.
+    auto last_page_index = min(m_current_page_index + PREFETCH_PAGE_COUNT, m_document->get_page_count() - 1);
+    for (u32 page_index = m_current_page_index + 1; page_index <= last_page_index; ++page_index) {
+        if (has_rendered_page(page_index))
+            continue;
+        if (get_rendered_page(page_index).is_error())
+            return;
+        m_prefetch_timer->restart();
+        return;
+    }
+}
+
 void PDFViewer::paint_event(GUI::PaintEvent& event)
 {
     GUI::Frame::paint_event(event);
@@ -97,6 +131,9 @@ void PDFViewer::paint_event(GUI::PaintEvent& event)
     if (!m_document)
         return;
 
+    // Once the user stops interacting with the viewer, render the next pages ahead of time.
+    m_prefetch_timer->restart();
+
     auto handle_error = [&](PDF::Error& error) {
         warnln("{}", error.message());
         GUI::MessageBox::show_error(nullptr, "Failed to render the page."sv);
@@ -307,9 +344,9 @@ void PDFViewer::mousemove_event(GUI::MouseEvent& event)
 
 void PDFViewer::timer_event(Core::TimerEvent&)
 {
-    // Clear the bitmap vector of all pages except the current page
+    // Clear the bitmap vector of all pages except the current page and the ones that were rendered ahead of it
     for (size_t i = 0; i < m_rendered_page_list.size(); i++) {
-        if (i != m_current_page_index)
+        if (i < m_current_page_index || i > m_current_page_index + PREFETCH_PAGE_COUNT)
             m_rendered_page_list[i].clear();
     }
 }
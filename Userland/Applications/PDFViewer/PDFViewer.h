@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <LibCore/Timer.h>
 #include <LibGUI/AbstractScrollableWidget.h>
 #include <LibGfx/Bitmap.h>
 #include <LibPDF/Document.h>
@@ -94,7 +95,10 @@ private:
         int rotation;
     };
 
+    u32 rendered_page_key() const;
+    bool has_rendered_page(u32 index) const;
     PDF::PDFErrorOr<NonnullRefPtr<Gfx::Bitmap>> get_rendered_page(u32 index);
+    void prefetch_next_page();
     PDF::PDFErrorOr<NonnullRefPtr<Gfx::Bitmap>> render_page(u32 page_index);
     PDF::PDFErrorOr<void> cache_page_dimensions(bool recalculate_fixed_info = false);
     void change_page(u32 new_page);
@@ -102,6 +106,7 @@ private:
     RefPtr<PDF::Document> m_document;
     u32 m_current_page_index { 0 };
     Vector<HashMap<u32, RenderedPage>> m_rendered_page_list;
+    RefPtr<Core::Timer> m_prefetch_timer;
 
     u8 m_zoom_level { initial_zoom_level };
     PageDimensionCache m_page_dimension_cache;
@@ -21,7 +21,7 @@ struct InstructionData {
     ByteString disassembly;
     StringView bytes;
     FlatPtr address { 0 };
-    u32 event_count { 0 };
+    u64 event_count { 0 };
     float percent { 0 };
     Debug::DebugInfo::SourcePositionWithInlines source_position_with_inlines;
 };
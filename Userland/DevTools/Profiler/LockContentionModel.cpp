@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "LockContentionModel.h"
+#include "Profile.h"
+#include <LibSymbolication/Symbolication.h>
+
+namespace Profiler {
+
+LockContentionModel::LockContentionModel(Profile& profile)
+    : m_profile(profile)
+{
+}
+
+static ByteString symbolicate_site(FlatPtr site)
+{
+    auto kernel_base = Symbolication::kernel_base();
+    if (!kernel_base.has_value() || site < kernel_base.value() || !g_kernel_debuginfo_object.has_value())
+        return ByteString::formatted("{:p}", site);
+
+    u32 offset = 0;
+    auto symbol = g_kernel_debuginfo_object->elf.symbolicate(site - kernel_base.value(), &offset);
+    return ByteString::formatted("{}+{:#x}", symbol, offset);
+}
+
+int LockContentionModel::row_count(GUI::ModelIndex const&) const
+{
+    return m_profile.filtered_lock_contention_indices().size();
+}
+
+int LockContentionModel::column_count(GUI::ModelIndex const&) const
+{
+    return Column::__Count;
+}
+
+ErrorOr<String> LockContentionModel::column_name(int column) const
+{
+    switch (column) {
+    case Column::EventIndex:
+        return "#"_string;
+    case Column::Timestamp:
+        return "Timestamp"_string;
+    case Column::ProcessID:
+        return "PID"_string;
+    case Column::ThreadID:
+        return "TID"_string;
+    case Column::ExecutableName:
+        return "Executable"_string;
+    case Column::LockName:
+        return "Lock"_string;
+    case Column::Site:
+        return "Site"_string;
+    case Column::WaitTime:
+        return "Wait Time"_string;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+GUI::Variant LockContentionModel::data(GUI::ModelIndex const& index, GUI::ModelRole role) const
+{
+    u32 event_index = m_profile.filtered_lock_contention_indices()[index.row()];
+    auto const& event = m_profile.events().at(event_index);
+    auto const& lock_contention = event.data.get<Profile::Event::LockContentionData>();
+
+    if (role == GUI::ModelRole::Custom) {
+        return event_index;
+    }
+
+    if (role == GUI::ModelRole::TextAlignment) {
+        if (index.column() == Column::WaitTime)
+            return Gfx::TextAlignment::CenterRight;
+        return {};
+    }
+
+    if (role == GUI::ModelRole::Display) {
+        switch (index.column()) {
+        case Column::EventIndex:
+            return event_index;
+        case Column::Timestamp:
+            return (u32)event.timestamp;
+        case Column::ProcessID:
+            return event.pid;
+        case Column::ThreadID:
+            return event.tid;
+        case Column::ExecutableName:
+            if (auto const* process = m_profile.find_process(event.pid, event.serial))
+                return process->executable;
+            return "";
+        case Column::LockName:
+            return lock_contention.name;
+        case Column::Site:
+            return symbolicate_site(lock_contention.site);
+        case Column::WaitTime:
+            return lock_contention.wait_time;
+        }
+        return {};
+    }
+    return {};
+}
+
+}
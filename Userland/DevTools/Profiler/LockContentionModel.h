@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGUI/Model.h>
+
+namespace Profiler {
+
+class Profile;
+
+class LockContentionModel final : public GUI::Model {
+public:
+    static NonnullRefPtr<LockContentionModel> create(Profile& profile)
+    {
+        return adopt_ref(*new LockContentionModel(profile));
+    }
+
+    enum Column {
+        EventIndex,
+        Timestamp,
+        ProcessID,
+        ThreadID,
+        ExecutableName,
+        LockName,
+        Site,
+        WaitTime,
+        __Count
+    };
+
+    virtual ~LockContentionModel() override = default;
+
+    virtual int row_count(GUI::ModelIndex const& = GUI::ModelIndex()) const override;
+    virtual int column_count(GUI::ModelIndex const& = GUI::ModelIndex()) const override;
+    virtual ErrorOr<String> column_name(int) const override;
+    virtual GUI::Variant data(GUI::ModelIndex const&, GUI::ModelRole) const override;
+    virtual bool is_column_sortable(int column) const override { return column != Column::Site; }
+
+private:
+    explicit LockContentionModel(Profile&);
+
+    Profile& m_profile;
+};
+
+}
@@ -15,9 +15,12 @@
 #include <AK/QuickSort.h>
 #include <AK/RefPtr.h>
 #include <AK/Try.h>
+#include <Kernel/API/Perfcore.h>
+#include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibELF/Image.h>
 #include <LibSymbolication/Symbolication.h>
+#include <serenity.h>
 #include <sys/stat.h>
 
 namespace Profiler {
@@ -48,6 +51,7 @@ Profile::Profile(Vector<Process> processes, Vector<Event> events)
     m_model = ProfileModel::create(*this);
     m_samples_model = SamplesModel::create(*this);
     m_signposts_model = SignpostsModel::create(*this);
+    m_lock_contention_model = LockContentionModel::create(*this);
     m_file_event_model = FileEventModel::create(*this);
 
     rebuild_tree();
@@ -68,6 +72,11 @@ GUI::Model& Profile::signposts_model()
     return *m_signposts_model;
 }
 
+GUI::Model& Profile::lock_contention_model()
+{
+    return *m_lock_contention_model;
+}
+
 void Profile::rebuild_tree()
 {
     Vector<NonnullRefPtr<ProfileNode>> roots;
@@ -101,7 +110,9 @@ void Profile::rebuild_tree()
     });
 
     m_filtered_event_indices.clear();
+    m_filtered_event_weight = 0;
     m_filtered_signpost_indices.clear();
+    m_filtered_lock_contention_indices.clear();
     m_file_event_nodes->children().clear();
 
     for (size_t event_index = 0; event_index < m_events.size(); ++event_index) {
@@ -121,7 +132,21 @@ void Profile::rebuild_tree()
             continue;
         }
 
+        // Lock contention events carry the backtrace of a blocked thread, so they don't belong in the sample tree.
+        if (event.data.has<Event::LockContentionData>()) {
+            m_filtered_lock_contention_indices.append(event_index);
+            continue;
+        }
+
+        // When showing off-CPU time, the tree is made of off-CPU events only, each weighted by
+        // how long (in microseconds) the thread was blocked. Otherwise we leave them out.
+        auto const* off_cpu_data = event.data.get_pointer<Event::OffCPUData>();
+        if (m_show_off_cpu_time != (off_cpu_data != nullptr))
+            continue;
+        u64 weight = off_cpu_data ? max<u64>(off_cpu_data->duration_ns / 1000, 1) : 1;
+
         m_filtered_event_indices.append(event_index);
+        m_filtered_event_weight += weight;
 
         if (auto* malloc_data = event.data.get_pointer<Event::MallocData>(); malloc_data && !live_allocations.contains(malloc_data->ptr))
             continue;
@@ -146,7 +171,7 @@ void Profile::rebuild_tree()
         if (!m_show_top_functions) {
             ProfileNode* node = nullptr;
             auto& process_node = find_or_create_process_node(event.pid, event.serial);
-            process_node.increment_event_count();
+            process_node.increment_event_count(weight);
             for_each_frame([&](Frame const& frame, bool is_innermost_frame) {
                 auto const& object_name = frame.object_name;
                 auto const& symbol = frame.symbol;
@@ -161,16 +186,16 @@ void Profile::rebuild_tree()
                     node = &process_node;
                 node = &node->find_or_create_child(object_name, symbol, address, offset, event.timestamp, event.pid);
 
-                node->increment_event_count();
+                node->increment_event_count(weight);
                 if (is_innermost_frame) {
-                    node->add_event_address(address);
-                    node->increment_self_count();
+                    node->add_event_address(address, weight);
+                    node->increment_self_count(weight);
                 }
                 return IterationDecision::Continue;
             });
         } else {
             auto& process_node = find_or_create_process_node(event.pid, event.serial);
-            process_node.increment_event_count();
+            process_node.increment_event_count(weight);
             for (size_t i = 0; i < event.frames.size(); ++i) {
                 ProfileNode* node = nullptr;
                 ProfileNode* root = nullptr;
@@ -195,14 +220,14 @@ void Profile::rebuild_tree()
 
                     if (!root->has_seen_event(event_index)) {
                         root->did_see_event(event_index);
-                        root->increment_event_count();
+                        root->increment_event_count(weight);
                     } else if (node != root) {
-                        node->increment_event_count();
+                        node->increment_event_count(weight);
                     }
 
                     if (j == event.frames.size() - 1) {
-                        node->add_event_address(address);
-                        node->increment_self_count();
+                        node->add_event_address(address, weight);
+                        node->increment_self_count(weight);
                     }
                 }
             }
@@ -265,15 +290,30 @@ void Profile::rebuild_tree()
 Optional<MappedObject> g_kernel_debuginfo_object;
 OwnPtr<Debug::DebugInfo> g_kernel_debug_info;
 
-ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+// Reads as much of a value as the stream has left. Returns false if the stream ended before the value started.
+template<typename T>
+static ErrorOr<bool> read_perfcore_value(Stream& stream, T& value)
 {
-    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    Bytes bytes { &value, sizeof(value) };
+    auto read_bytes = TRY(stream.read_some(bytes));
+    if (read_bytes.is_empty())
+        return false;
+    TRY(stream.read_until_filled(bytes.slice(read_bytes.size())));
+    return true;
+}
 
-    auto json = JsonValue::from_string(TRY(file->read_until_eof()));
-    if (json.is_error() || !json.value().is_object())
-        return Error::from_string_literal("Invalid perfcore format (not a JSON object)");
+// Payloads may be larger than the structs we know about (newer kernels) or smaller (older kernels).
+template<typename Payload>
+static Payload perfcore_payload(ReadonlyBytes bytes)
+{
+    Payload payload;
+    memcpy(&payload, bytes.data(), min(bytes.size(), sizeof(payload)));
+    return payload;
+}
 
-    auto const& object = json.value().as_object();
+ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+{
+    auto file = TRY(Core::InputBufferedFile::create(TRY(Core::File::open(path, Core::File::OpenMode::Read))));
 
     if (!g_kernel_debuginfo_object.has_value()) {
         auto debuginfo_file_or_error = Core::MappedFile::map("/boot/Kernel.debug"sv);
@@ -284,62 +324,128 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         }
     }
 
-    auto strings_value = object.get_array("strings"sv);
-    if (!strings_value.has_value())
-        return Error::from_string_literal("Malformed profile (strings is not an array)");
-    auto const& strings = strings_value.value();
+    Vector<ByteString> profile_strings;
+    u32 events_left_in_perfcore = 0;
+    u64 dropped_event_count = 0;
+
+    // A profile drained from /sys/kernel/profile_stream is several perfcores back to back,
+    // each with its own string table.
+    auto read_perfcore_header = [&]() -> ErrorOr<bool> {
+        Kernel::PerfcoreHeader header;
+        if (!TRY(read_perfcore_value(*file, header)))
+            return false;
+        if (header.magic != Kernel::perfcore_magic)
+            return Error::from_string_literal("Invalid perfcore format (bad magic)");
+        if (header.version != Kernel::perfcore_version)
+            return Error::from_string_literal("Unsupported perfcore version");
+
+        dropped_event_count += header.dropped_event_count;
+        events_left_in_perfcore = header.event_count;
+
+        profile_strings.clear_with_capacity();
+        TRY(profile_strings.try_ensure_capacity(header.string_count));
+        for (u32 i = 0; i < header.string_count; ++i) {
+            auto length = TRY(file->read_value<u32>());
+            auto buffer = TRY(ByteBuffer::create_uninitialized(length));
+            TRY(file->read_until_filled(buffer));
+            profile_strings.unchecked_append(ByteString { buffer.bytes() });
+        }
+        return true;
+    };
 
-    HashMap<FlatPtr, ByteString> profile_strings;
-    for (FlatPtr string_id = 0; string_id < strings.size(); ++string_id) {
-        auto const& value = strings.at(string_id);
-        profile_strings.set(string_id, value.as_string());
-    }
+    if (!TRY(read_perfcore_header()))
+        return Error::from_string_literal("Invalid perfcore format (bad magic)");
 
-    auto events_value = object.get_array("events"sv);
-    if (!events_value.has_value())
-        return Error::from_string_literal("Malformed profile (events is not an array)");
-    auto const& perf_events = events_value.value();
+    auto profile_string = [&](u64 index) -> Optional<ByteString> {
+        if (index >= profile_strings.size())
+            return {};
+        return profile_strings[index];
+    };
 
     Vector<NonnullOwnPtr<Process>> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
     EventSerialNumber next_serial;
 
-    for (auto const& perf_event_value : perf_events.values()) {
-        auto const& perf_event = perf_event_value.as_object();
+    ByteBuffer payload;
+    Vector<u64, 64> stack;
+
+    while (true) {
+        if (events_left_in_perfcore == 0) {
+            if (!TRY(read_perfcore_header()))
+                break;
+            continue;
+        }
+        --events_left_in_perfcore;
+
+        Kernel::PerfcoreEvent perf_event;
+        if (!TRY(read_perfcore_value(*file, perf_event)))
+            return Error::from_string_literal("Invalid perfcore format (truncated)");
+
+        TRY(payload.try_resize(perf_event.payload_size));
+        TRY(file->read_until_filled(payload));
+        TRY(stack.try_resize(perf_event.stack_size));
+        TRY(file->read_until_filled({ stack.data(), stack.size() * sizeof(u64) }));
 
         Event event;
 
         event.serial = next_serial;
         next_serial.increment();
-        event.timestamp = perf_event.get_u64("timestamp"sv).value_or(0);
-        event.lost_samples = perf_event.get_u32("lost_samples"sv).value_or(0);
-        event.pid = perf_event.get_i32("pid"sv).value_or(0);
-        event.tid = perf_event.get_i32("tid"sv).value_or(0);
-
-        auto type_string = perf_event.get_byte_string("type"sv).value_or({});
+        event.timestamp = perf_event.timestamp;
+        event.lost_samples = perf_event.lost_samples;
+        event.pid = perf_event.pid;
+        event.tid = perf_event.tid;
 
-        if (type_string == "sample"sv) {
+        switch (perf_event.type) {
+        case PERF_EVENT_SAMPLE:
             event.data = Event::SampleData {};
-        } else if (type_string == "kmalloc"sv) {
+            break;
+        case PERF_EVENT_KMALLOC: {
+            auto memory = perfcore_payload<Kernel::PerfcoreMemoryPayload>(payload);
             event.data = Event::MallocData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = static_cast<FlatPtr>(memory.ptr),
+                .size = static_cast<size_t>(memory.size),
             };
-        } else if (type_string == "kfree"sv) {
+            break;
+        }
+        case PERF_EVENT_KFREE: {
+            auto memory = perfcore_payload<Kernel::PerfcoreMemoryPayload>(payload);
             event.data = Event::FreeData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
+                .ptr = static_cast<FlatPtr>(memory.ptr),
             };
-        } else if (type_string == "signpost"sv) {
-            auto string_id = perf_event.get_addr("arg1"sv).value_or(0);
+            break;
+        }
+        case PERF_EVENT_SIGNPOST: {
+            auto signpost = perfcore_payload<Kernel::PerfcoreSignpostPayload>(payload);
+            auto string_id = signpost.string_index;
             event.data = Event::SignpostData {
-                .string = profile_strings.get(string_id).value_or(ByteString::formatted("Signpost #{}", string_id)),
-                .arg = perf_event.get_addr("arg2"sv).value_or(0),
+                .string = profile_string(string_id).value_or(ByteString::formatted("Signpost #{}", string_id)),
+                .arg = static_cast<FlatPtr>(signpost.arg),
+            };
+            break;
+        }
+        case PERF_EVENT_LOCK_CONTENTION: {
+            auto lock_contention = perfcore_payload<Kernel::PerfcoreLockContentionPayload>(payload);
+            event.data = Event::LockContentionData {
+                .name = profile_string(lock_contention.name_index).value_or({}),
+                .site = static_cast<FlatPtr>(lock_contention.site),
+                .wait_time = lock_contention.wait_time,
+            };
+            break;
+        }
+        case PERF_EVENT_OFF_CPU: {
+            auto off_cpu = perfcore_payload<Kernel::PerfcoreOffCPUPayload>(payload);
+            event.data = Event::OffCPUData {
+                .reason = off_cpu.reason,
+                .duration_ns = off_cpu.duration_ns,
             };
-        } else if (type_string == "mmap"sv) {
-            auto ptr = perf_event.get_addr("ptr"sv).value_or(0);
-            auto size = perf_event.get_integer<size_t>("size"sv).value_or(0);
-            auto name = perf_event.get_byte_string("name"sv).value_or({});
+            break;
+        }
+        case PERF_EVENT_MMAP: {
+            auto mmap = perfcore_payload<Kernel::PerfcoreMmapPayload>(payload);
+            auto ptr = static_cast<FlatPtr>(mmap.ptr);
+            auto size = static_cast<size_t>(mmap.size);
+            auto name = profile_string(mmap.name_index).value_or({});
 
             event.data = Event::MmapData {
                 .ptr = ptr,
@@ -351,15 +457,19 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             if (it != current_processes.end())
                 it->value->library_metadata.handle_mmap(ptr, size, name);
             continue;
-        } else if (type_string == "munmap"sv) {
+        }
+        case PERF_EVENT_MUNMAP: {
+            auto memory = perfcore_payload<Kernel::PerfcoreMemoryPayload>(payload);
             event.data = Event::MunmapData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = static_cast<FlatPtr>(memory.ptr),
+                .size = static_cast<size_t>(memory.size),
             };
             continue;
-        } else if (type_string == "process_create"sv) {
-            auto parent_pid = perf_event.get_integer<pid_t>("parent_pid"sv).value_or(0);
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        }
+        case PERF_EVENT_PROCESS_CREATE: {
+            auto process = perfcore_payload<Kernel::PerfcoreProcessPayload>(payload);
+            auto parent_pid = static_cast<pid_t>(process.parent_pid);
+            auto executable = profile_string(process.executable_index).value_or({});
             event.data = Event::ProcessCreateData {
                 .parent_pid = parent_pid,
                 .executable = executable,
@@ -376,14 +486,17 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
             continue;
-        } else if (type_string == "process_exec"sv) {
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        }
+        case PERF_EVENT_PROCESS_EXEC: {
+            auto process = perfcore_payload<Kernel::PerfcoreProcessPayload>(payload);
+            auto executable = profile_string(process.executable_index).value_or({});
             event.data = Event::ProcessExecData {
                 .executable = executable,
             };
 
-            auto* old_process = current_processes.get(event.pid).value();
-            old_process->end_valid = event.serial;
+            // The process may have been created before profiling started.
+            if (auto* old_process = current_processes.get(event.pid).value_or(nullptr))
+                old_process->end_valid = event.serial;
 
             current_processes.remove(event.pid);
 
@@ -398,88 +511,87 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
             continue;
-        } else if (type_string == "process_exit"sv) {
-            auto* old_process = current_processes.get(event.pid).value();
-            old_process->end_valid = event.serial;
+        }
+        case PERF_EVENT_PROCESS_EXIT: {
+            if (auto* old_process = current_processes.get(event.pid).value_or(nullptr))
+                old_process->end_valid = event.serial;
 
             current_processes.remove(event.pid);
             continue;
-        } else if (type_string == "thread_create"sv) {
-            auto parent_tid = perf_event.get_integer<pid_t>("parent_tid"sv).value_or(0);
+        }
+        case PERF_EVENT_THREAD_CREATE: {
+            auto thread_create = perfcore_payload<Kernel::PerfcoreThreadCreatePayload>(payload);
             event.data = Event::ThreadCreateData {
-                .parent_tid = parent_tid,
+                .parent_tid = static_cast<pid_t>(thread_create.parent_tid),
             };
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_create(event.tid, event.serial);
             continue;
-        } else if (type_string == "thread_exit"sv) {
+        }
+        case PERF_EVENT_THREAD_EXIT: {
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.serial);
             continue;
-        } else if (type_string == "filesystem"sv) {
+        }
+        case PERF_EVENT_FILESYSTEM: {
+            auto filesystem = perfcore_payload<Kernel::PerfcoreFilesystemPayload>(payload);
+            auto filename = profile_string(filesystem.filename_index).value_or({});
             Event::FilesystemEventData fsdata {
-                .duration = Duration::from_nanoseconds(perf_event.get_integer<u64>("durationNs"sv).value_or(0)),
+                .duration = Duration::from_nanoseconds(filesystem.duration_ns),
                 .data = Event::OpenEventData {},
             };
-            auto const filesystem_event_type = perf_event.get("fs_event_type"sv).value_or("").as_string();
-            if (filesystem_event_type == "open"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+            switch (filesystem.type) {
+            case Kernel::FilesystemEventType::Open:
                 fsdata.data = Event::OpenEventData {
-                    .dirfd = perf_event.get_integer<int>("dirfd"sv).value_or(0),
+                    .dirfd = filesystem.fd,
                     .path = filename,
-                    .options = perf_event.get_integer<int>("options"sv).value_or(0),
-                    .mode = perf_event.get_integer<u64>("mode"sv).value_or(0),
+                    .options = filesystem.options,
+                    .mode = filesystem.mode,
                 };
-            } else if (filesystem_event_type == "close"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+                break;
+            case Kernel::FilesystemEventType::Close:
                 fsdata.data = Event::CloseEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "readv"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Kernel::FilesystemEventType::Readv:
                 fsdata.data = Event::ReadvEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "read"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Kernel::FilesystemEventType::Read:
                 fsdata.data = Event::ReadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "pread"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case Kernel::FilesystemEventType::Pread:
                 fsdata.data = Event::PreadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem.fd,
                     .path = filename,
-                    .buffer_ptr = perf_event.get_integer<FlatPtr>("buffer_ptr"sv).value_or(0),
-                    .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
-                    .offset = perf_event.get_integer<off_t>("offset"sv).value_or(0),
+                    .buffer_ptr = static_cast<FlatPtr>(filesystem.buffer_ptr),
+                    .size = static_cast<size_t>(filesystem.size),
+                    .offset = static_cast<off_t>(filesystem.offset),
                 };
+                break;
             }
 
             event.data = fsdata;
-        } else {
-            dbgln("Unknown event type '{}'", type_string);
-            VERIFY_NOT_REACHED();
+            break;
+        }
+        default:
+            dbgln("Unknown event type {}", perf_event.type);
+            continue;
         }
 
         auto maybe_kernel_base = Symbolication::kernel_base();
 
-        auto stack = perf_event.get_array("stack"sv);
-        VERIFY(stack.has_value());
-        auto const& stack_array = stack.value();
-        for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
-            auto const& frame = stack_array.at(i);
-            auto ptr = frame.as_integer<u64>();
+        for (ssize_t i = stack.size() - 1; i >= 0; --i) {
+            auto ptr = stack[i];
             u32 offset = 0;
             DeprecatedFlyString object_name;
             ByteString symbol;
@@ -516,6 +628,9 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
         events.append(move(event));
     }
 
+    if (dropped_event_count != 0)
+        dbgln("Profile is missing {} events that didn't fit in the kernel's buffer", dropped_event_count);
+
     if (events.is_empty())
         return Error::from_string_literal("No events captured (targeted process was never on CPU)");
 
@@ -550,6 +665,7 @@ void Profile::set_timestamp_filter_range(u64 start, u64 end)
     rebuild_tree();
     m_samples_model->invalidate();
     m_signposts_model->invalidate();
+    m_lock_contention_model->invalidate();
 }
 
 void Profile::clear_timestamp_filter_range()
@@ -560,6 +676,7 @@ void Profile::clear_timestamp_filter_range()
     rebuild_tree();
     m_samples_model->invalidate();
     m_signposts_model->invalidate();
+    m_lock_contention_model->invalidate();
 }
 
 void Profile::add_process_filter(pid_t pid, EventSerialNumber start_valid, EventSerialNumber end_valid)
@@ -574,6 +691,7 @@ void Profile::add_process_filter(pid_t pid, EventSerialNumber start_valid, Event
         m_disassembly_model->invalidate();
     m_samples_model->invalidate();
     m_signposts_model->invalidate();
+    m_lock_contention_model->invalidate();
 }
 
 void Profile::remove_process_filter(pid_t pid, EventSerialNumber start_valid, EventSerialNumber end_valid)
@@ -590,6 +708,7 @@ void Profile::remove_process_filter(pid_t pid, EventSerialNumber start_valid, Ev
         m_disassembly_model->invalidate();
     m_samples_model->invalidate();
     m_signposts_model->invalidate();
+    m_lock_contention_model->invalidate();
 }
 
 void Profile::clear_process_filter()
@@ -602,6 +721,7 @@ void Profile::clear_process_filter()
         m_disassembly_model->invalidate();
     m_samples_model->invalidate();
     m_signposts_model->invalidate();
+    m_lock_contention_model->invalidate();
 }
 
 bool Profile::process_filter_contains(pid_t pid, EventSerialNumber serial)
@@ -636,6 +756,14 @@ void Profile::set_show_percentages(bool show_percentages)
     m_show_percentages = show_percentages;
 }
 
+void Profile::set_show_off_cpu_time(bool show)
+{
+    if (m_show_off_cpu_time == show)
+        return;
+    m_show_off_cpu_time = show;
+    rebuild_tree();
+}
+
 void Profile::set_disassembly_index(GUI::ModelIndex const& index)
 {
     if (m_disassembly_index == index)
@@ -9,6 +9,7 @@
 
 #include "DisassemblyModel.h"
 #include "FilesystemEventModel.h"
+#include "LockContentionModel.h"
 #include "Process.h"
 #include "Profile.h"
 #include "ProfileModel.h"
@@ -23,6 +24,7 @@
 #include <AK/OwnPtr.h>
 #include <AK/Time.h>
 #include <AK/Variant.h>
+#include <Kernel/API/Perfcore.h>
 #include <LibCore/MappedFile.h>
 #include <LibELF/Image.h>
 #include <LibGUI/Forward.h>
@@ -60,8 +62,8 @@ public:
     u32 offset() const { return m_offset; }
     u64 timestamp() const { return m_timestamp; }
 
-    u32 event_count() const { return m_event_count; }
-    u32 self_count() const { return m_self_count; }
+    u64 event_count() const { return m_event_count; }
+    u64 self_count() const { return m_self_count; }
 
     int child_count() const { return m_children.size(); }
     Vector<NonnullRefPtr<ProfileNode>> const& children() const { return m_children; }
@@ -91,19 +93,19 @@ public:
     ProfileNode* parent() { return m_parent; }
     ProfileNode const* parent() const { return m_parent; }
 
-    void increment_event_count() { ++m_event_count; }
-    void increment_self_count() { ++m_self_count; }
+    void increment_event_count(u64 weight = 1) { m_event_count += weight; }
+    void increment_self_count(u64 weight = 1) { m_self_count += weight; }
 
     void sort_children();
 
-    HashMap<FlatPtr, size_t> const& events_per_address() const { return m_events_per_address; }
-    void add_event_address(FlatPtr address)
+    HashMap<FlatPtr, u64> const& events_per_address() const { return m_events_per_address; }
+    void add_event_address(FlatPtr address, u64 weight = 1)
     {
         auto it = m_events_per_address.find(address);
         if (it == m_events_per_address.end())
-            m_events_per_address.set(address, 1);
+            m_events_per_address.set(address, weight);
         else
-            m_events_per_address.set(address, it->value + 1);
+            m_events_per_address.set(address, it->value + weight);
     }
 
     pid_t pid() const { return m_pid; }
@@ -123,11 +125,11 @@ private:
     pid_t m_pid { 0 };
     FlatPtr m_address { 0 };
     u32 m_offset { 0 };
-    u32 m_event_count { 0 };
-    u32 m_self_count { 0 };
+    u64 m_event_count { 0 };
+    u64 m_self_count { 0 };
     u64 m_timestamp { 0 };
     Vector<NonnullRefPtr<ProfileNode>> m_children;
-    HashMap<FlatPtr, size_t> m_events_per_address;
+    HashMap<FlatPtr, u64> m_events_per_address;
     Bitmap m_seen_events;
 };
 
@@ -149,6 +151,7 @@ public:
     GUI::Model& model();
     GUI::Model& samples_model();
     GUI::Model& signposts_model();
+    GUI::Model& lock_contention_model();
     GUI::Model* disassembly_model();
     GUI::Model* source_model();
     GUI::Model* file_event_model();
@@ -200,6 +203,17 @@ public:
             FlatPtr arg {};
         };
 
+        struct LockContentionData {
+            ByteString name;
+            FlatPtr site {};
+            u64 wait_time {};
+        };
+
+        struct OffCPUData {
+            Kernel::OffCPUReason reason { Kernel::OffCPUReason::Unknown };
+            u64 duration_ns {};
+        };
+
         struct MmapData {
             FlatPtr ptr {};
             size_t size {};
@@ -262,12 +276,15 @@ public:
             Variant<OpenEventData, CloseEventData, ReadvEventData, ReadEventData, PreadEventData> data;
         };
 
-        Variant<nullptr_t, SampleData, MallocData, FreeData, SignpostData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
+        Variant<nullptr_t, SampleData, MallocData, FreeData, SignpostData, LockContentionData, OffCPUData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
     };
 
     Vector<Event> const& events() const { return m_events; }
     Vector<size_t> const& filtered_event_indices() const { return m_filtered_event_indices; }
+    // The total weight of the filtered events, i.e. their count, or the off-CPU time in microseconds.
+    u64 filtered_event_weight() const { return m_filtered_event_weight; }
     Vector<size_t> const& filtered_signpost_indices() const { return m_filtered_signpost_indices; }
+    Vector<size_t> const& filtered_lock_contention_indices() const { return m_filtered_lock_contention_indices; }
     NonnullRefPtr<FileEventNode> const& file_event_nodes() { return m_file_event_nodes; }
 
     u64 length_in_ms() const { return m_last_timestamp - m_first_timestamp; }
@@ -292,6 +309,9 @@ public:
     bool show_percentages() const { return m_show_percentages; }
     void set_show_percentages(bool);
 
+    bool show_off_cpu_time() const { return m_show_off_cpu_time; }
+    void set_show_off_cpu_time(bool);
+
     Vector<Process> const& processes() const { return m_processes; }
 
     template<typename Callback>
@@ -325,6 +345,7 @@ private:
     RefPtr<ProfileModel> m_model;
     RefPtr<SamplesModel> m_samples_model;
     RefPtr<SignpostsModel> m_signposts_model;
+    RefPtr<LockContentionModel> m_lock_contention_model;
     RefPtr<DisassemblyModel> m_disassembly_model;
     RefPtr<SourceModel> m_source_model;
     RefPtr<FileEventModel> m_file_event_model;
@@ -334,6 +355,7 @@ private:
 
     Vector<NonnullRefPtr<ProfileNode>> m_roots;
     Vector<size_t> m_filtered_event_indices;
+    u64 m_filtered_event_weight { 0 };
     u64 m_first_timestamp { 0 };
     u64 m_last_timestamp { 0 };
 
@@ -341,6 +363,7 @@ private:
     Vector<Event> m_events;
     Vector<size_t> m_signpost_indices;
     Vector<size_t> m_filtered_signpost_indices;
+    Vector<size_t> m_filtered_lock_contention_indices;
 
     bool m_has_timestamp_filter_range { false };
     u64 m_timestamp_filter_range_start { 0 };
@@ -353,6 +376,7 @@ private:
     bool m_inverted { false };
     bool m_show_top_functions { false };
     bool m_show_percentages { false };
+    bool m_show_off_cpu_time { false };
 };
 
 }
@@ -78,8 +78,12 @@ ErrorOr<String> ProfileModel::column_name(int column) const
 {
     switch (column) {
     case Column::SampleCount:
+        if (m_profile.show_off_cpu_time())
+            return m_profile.show_percentages() ? "% Off-CPU"_string : "Off-CPU (µs)"_string;
         return m_profile.show_percentages() ? "% Samples"_string : "# Samples"_string;
     case Column::SelfCount:
+        if (m_profile.show_off_cpu_time())
+            return m_profile.show_percentages() ? "% Self"_string : "Self (µs)"_string;
         return m_profile.show_percentages() ? "% Self"_string : "# Self"_string;
     case Column::ObjectName:
         return "Object"_string;
@@ -114,12 +118,12 @@ GUI::Variant ProfileModel::data(GUI::ModelIndex const& index, GUI::ModelRole rol
     if (role == GUI::ModelRole::Display) {
         if (index.column() == Column::SampleCount) {
             if (m_profile.show_percentages())
-                return format_percentage(node->event_count(), m_profile.filtered_event_indices().size());
+                return format_percentage(node->event_count(), m_profile.filtered_event_weight());
             return node->event_count();
         }
         if (index.column() == Column::SelfCount) {
             if (m_profile.show_percentages())
-                return format_percentage(node->self_count(), m_profile.filtered_event_indices().size());
+                return format_percentage(node->self_count(), m_profile.filtered_event_weight());
             return node->self_count();
         }
         if (index.column() == Column::ObjectName)
@@ -18,7 +18,7 @@ class SourceFile final {
 public:
     struct Line {
         ByteString content;
-        size_t num_samples { 0 };
+        u64 num_samples { 0 };
     };
 
     static constexpr StringView source_root_path = "/usr/src/serenity/"sv;
@@ -45,7 +45,7 @@ public:
         }
     }
 
-    void try_add_samples(size_t line, size_t samples)
+    void try_add_samples(size_t line, u64 samples)
     {
         if (line < 1 || line - 1 >= m_lines.size())
             return;
@@ -107,7 +107,7 @@ SourceModel::SourceModel(Profile& profile, ProfileNode& node)
             line_number++;
 
             m_source_lines.append({
-                (u32)line_iterator.num_samples,
+                line_iterator.num_samples,
                 line_iterator.num_samples * 100.0f / node.event_count(),
                 file_iterator.key,
                 line_number,
@@ -210,6 +210,20 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         individual_signpost_view.set_model(move(model));
     };
 
+    auto& lock_contention_tab = tab_widget.add_tab<GUI::Widget>("Lock Contention"_string);
+    lock_contention_tab.set_layout<GUI::VerticalBoxLayout>(4);
+
+    auto& lock_contention_splitter = lock_contention_tab.add<GUI::HorizontalSplitter>();
+    auto& lock_contention_table_view = lock_contention_splitter.add<GUI::TableView>();
+    lock_contention_table_view.set_model(profile->lock_contention_model());
+
+    auto& individual_lock_contention_view = lock_contention_splitter.add<GUI::TableView>();
+    lock_contention_table_view.on_selection_change = [&] {
+        auto const& index = lock_contention_table_view.selection().first();
+        auto model = IndividualSampleModel::create(*profile, index.data(GUI::ModelRole::Custom).to_integer<size_t>());
+        individual_lock_contention_view.set_model(move(model));
+    };
+
     auto& flamegraph_tab = tab_widget.add_tab<GUI::Widget>("Flame Graph"_string);
     flamegraph_tab.set_layout<GUI::VerticalBoxLayout>(GUI::Margins { 4, 4, 4, 4 });
 
@@ -225,7 +239,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto const format_sample_count = [&profile](auto const sample_count) {
         if (profile->show_percentages())
             return ByteString::formatted("{}%", sample_count.as_string());
-        return ByteString::formatted("{} Samples", sample_count.to_i32());
+        if (profile->show_off_cpu_time())
+            return ByteString::formatted("{} µs", sample_count.to_i64());
+        return ByteString::formatted("{} Samples", sample_count.to_i64());
     };
 
     auto& statusbar = main_widget->add<GUI::Statusbar>();
@@ -239,7 +255,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             auto sample_count = profile->model().data(flamegraph_hovered_index.sibling_at_column(ProfileModel::Column::SampleCount));
             auto self_count = profile->model().data(flamegraph_hovered_index.sibling_at_column(ProfileModel::Column::SelfCount));
             builder.appendff("{}, ", stack);
-            builder.appendff("Samples: {}, ", format_sample_count(sample_count));
+            builder.appendff("{}: {}, ", profile->show_off_cpu_time() ? "Off-CPU"sv : "Samples"sv, format_sample_count(sample_count));
             builder.appendff("Self: {}", format_sample_count(self_count));
         } else {
             u64 normalized_start_time = clamp_timestamp(min(view.select_start_time(), view.select_end_time()));
@@ -298,6 +314,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     percent_action->set_checked(false);
     view_menu->add_action(percent_action);
 
+    auto off_cpu_action = GUI::Action::create_checkable("Show &Off-CPU Time", [&](auto& action) {
+        profile->set_show_off_cpu_time(action.is_checked());
+        tree_view.update();
+    });
+    off_cpu_action->set_checked(false);
+    view_menu->add_action(off_cpu_action);
+
     view_menu->add_action(disassembly_action);
     view_menu->add_action(source_action);
 
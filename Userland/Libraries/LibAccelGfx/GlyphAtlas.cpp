@@ -18,63 +18,67 @@ GlyphAtlas& GlyphAtlas::the()
     return *s_the;
 }
 
-void GlyphAtlas::update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs)
+ErrorOr<void> GlyphAtlas::update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs)
 {
+    // The glyph may live in a page of the shared CPU glyph atlas, so only its own part of the bitmap is copied over.
+    struct GlyphBitmap {
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+        Gfx::IntRect rect;
+    };
+
     auto need_to_rebuild_texture = false;
-    HashMap<GlyphsTextureKey, NonnullRefPtr<Gfx::Bitmap>> glyph_bitmaps;
+    HashMap<GlyphsTextureKey, GlyphBitmap> glyph_bitmaps;
     for (auto const& [font, code_points] : unique_glyphs) {
         for (auto const& code_point : code_points) {
             auto glyph = font->glyph(code_point);
             auto atlas_key = GlyphsTextureKey { font, code_point };
             if (!m_glyphs_texture_map.contains(atlas_key))
                 need_to_rebuild_texture = true;
-            if (glyph.bitmap()) {
-                glyph_bitmaps.set(atlas_key, *glyph.bitmap());
-            }
+            if (glyph.bitmap())
+                glyph_bitmaps.set(atlas_key, { *glyph.bitmap(), glyph.bitmap_rect() });
         }
     }
 
     if (!need_to_rebuild_texture || glyph_bitmaps.is_empty())
-        return;
-
-    m_glyphs_texture_map.clear();
+        return {};
 
     Vector<GlyphsTextureKey> glyphs_sorted_by_height;
-    glyphs_sorted_by_height.ensure_capacity(glyph_bitmaps.size());
+    TRY(glyphs_sorted_by_height.try_ensure_capacity(glyph_bitmaps.size()));
     for (auto const& [atlas_key, bitmap] : glyph_bitmaps) {
-        glyphs_sorted_by_height.append(atlas_key);
+        glyphs_sorted_by_height.unchecked_append(atlas_key);
     }
     quick_sort(glyphs_sorted_by_height, [&](auto const& a, auto const& b) {
-        auto const* bitmap_a = *glyph_bitmaps.get(a);
-        auto const* bitmap_b = *glyph_bitmaps.get(b);
-        return bitmap_a->height() > bitmap_b->height();
+        return glyph_bitmaps.get(a)->rect.height() > glyph_bitmaps.get(b)->rect.height();
     });
 
+    HashMap<GlyphsTextureKey, Gfx::IntRect> glyphs_texture_map;
     int current_x = 0;
     int current_y = 0;
     int row_height = 0;
     int const texture_width = 512;
     int const padding = 1;
     for (auto const& glyphs_texture_key : glyphs_sorted_by_height) {
-        auto const* bitmap = *glyph_bitmaps.get(glyphs_texture_key);
-        if (current_x + bitmap->width() > texture_width) {
+        auto const& rect = glyph_bitmaps.get(glyphs_texture_key)->rect;
+        if (current_x + rect.width() > texture_width) {
             current_x = 0;
             current_y += row_height + padding;
             row_height = 0;
         }
-        m_glyphs_texture_map.set(glyphs_texture_key, { current_x, current_y, bitmap->width(), bitmap->height() });
-        current_x += bitmap->width() + padding;
-        row_height = max(row_height, bitmap->height());
+        TRY(glyphs_texture_map.try_set(glyphs_texture_key, { current_x, current_y, rect.width(), rect.height() }));
+        current_x += rect.width() + padding;
+        row_height = max(row_height, rect.height());
     }
 
-    auto glyphs_texture_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { texture_width, current_y + row_height }));
+    auto glyphs_texture_bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { texture_width, current_y + row_height }));
     auto glyphs_texture_painter = Gfx::Painter(*glyphs_texture_bitmap);
     for (auto const& [glyphs_texture_key, glyph_bitmap] : glyph_bitmaps) {
-        auto rect = m_glyphs_texture_map.get(glyphs_texture_key).value();
-        glyphs_texture_painter.blit({ rect.x(), rect.y() }, glyph_bitmap, glyph_bitmap->rect());
+        auto rect = glyphs_texture_map.get(glyphs_texture_key).value();
+        glyphs_texture_painter.blit({ rect.x(), rect.y() }, glyph_bitmap.bitmap, glyph_bitmap.rect);
     }
 
     GL::upload_texture_data(m_texture, *glyphs_texture_bitmap);
+    m_glyphs_texture_map = move(glyphs_texture_map);
+    return {};
 }
 
 Optional<Gfx::IntRect> GlyphAtlas::get_glyph_rect(Gfx::Font const* font, u32 code_point) const
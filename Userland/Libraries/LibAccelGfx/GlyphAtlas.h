@@ -39,7 +39,7 @@ public:
         }
     };
 
-    void update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs);
+    ErrorOr<void> update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs);
     Optional<Gfx::IntRect> get_glyph_rect(Gfx::Font const*, u32 code_point) const;
 
     GL::Texture const& texture() const { return m_texture; }
@@ -959,13 +959,34 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
-ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
+ErrorOr<void> DeflateCompressor::sync_flush_and_finish()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size > 0)
+        TRY(flush());
+
+    // An empty, non-final stored block, which leaves the output aligned to a byte boundary (like zlib's Z_SYNC_FLUSH).
+    TRY(m_output_stream->write_bits(0b0u, 1));
+    TRY(m_output_stream->write_bits(0b00u, 2));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_finished = true;
+    return {};
+}
+
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level, EndOfStream end_of_stream)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
     auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
 
     TRY(deflate_stream->write_until_depleted(bytes));
-    TRY(deflate_stream->final_flush());
+    if (end_of_stream == EndOfStream::Yes)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->sync_flush_and_finish());
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
     TRY(output_stream->read_until_filled(buffer));
@@ -174,7 +174,15 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
-    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
+    // Like final_flush(), but doesn't end the deflate stream. Instead, the output is padded to a byte boundary,
+    // so that it can be followed by data from another compressor (as long as that one ends with final_flush()).
+    ErrorOr<void> sync_flush_and_finish();
+
+    enum class EndOfStream {
+        No,
+        Yes,
+    };
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD, EndOfStream = EndOfStream::Yes);
 
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
@@ -15,7 +15,7 @@
 
 namespace Compress {
 
-ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream)
+ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream, VerifyChecksum verify_checksum)
 {
     auto header = TRY(stream->read_value<ZlibHeader>());
 
@@ -28,21 +28,37 @@ ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Str
     if (header.as_u16 % 31 != 0)
         return Error::from_string_literal("Zlib error correction code does not match");
 
+    // The bit stream is shared with the deflate stream, so that the checksum following the compressed data can be read from it.
     auto bit_stream = make<LittleEndianInputBitStream>(move(stream));
-    auto deflate_stream = TRY(Compress::DeflateDecompressor::construct(move(bit_stream)));
+    auto deflate_stream = TRY(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(*bit_stream)));
 
-    return adopt_nonnull_own_or_enomem(new (nothrow) ZlibDecompressor(header, move(deflate_stream)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZlibDecompressor(header, move(bit_stream), move(deflate_stream), verify_checksum));
 }
 
-ZlibDecompressor::ZlibDecompressor(ZlibHeader header, NonnullOwnPtr<Stream> stream)
+ZlibDecompressor::ZlibDecompressor(ZlibHeader header, NonnullOwnPtr<LittleEndianInputBitStream> input_stream, NonnullOwnPtr<Stream> stream, VerifyChecksum verify_checksum)
     : m_header(header)
+    , m_input_stream(move(input_stream))
     , m_stream(move(stream))
+    , m_verify_checksum(verify_checksum)
 {
 }
 
 ErrorOr<Bytes> ZlibDecompressor::read_some(Bytes bytes)
 {
-    return m_stream->read_some(bytes);
+    auto decompressed = TRY(m_stream->read_some(bytes));
+    if (m_verify_checksum == VerifyChecksum::No)
+        return decompressed;
+
+    m_adler32_checksum.update(decompressed);
+
+    // A mismatch is only recorded, it's up to the caller whether the data is still usable.
+    if (m_stream->is_eof() && !m_read_checksum) {
+        m_read_checksum = true;
+        if (auto checksum = m_input_stream->read_value<NetworkOrdered<u32>>(); !checksum.is_error())
+            m_checksum_matches = checksum.value() == m_adler32_checksum.digest();
+    }
+
+    return decompressed;
 }
 
 ErrorOr<size_t> ZlibDecompressor::write_some(ReadonlyBytes)
@@ -73,7 +89,7 @@ ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stre
     auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), static_cast<DeflateCompressor::CompressionLevel>(compression_level)));
 
     auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), move(compressor_stream))));
-    TRY(zlib_compressor->write_header(compression_method, compression_level));
+    TRY(write_header(*zlib_compressor->m_output_stream, compression_method, compression_level));
 
     return zlib_compressor;
 }
@@ -89,7 +105,7 @@ ZlibCompressor::~ZlibCompressor()
     VERIFY(m_finished);
 }
 
-ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+ErrorOr<void> ZlibCompressor::write_header(Stream& stream, ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
 {
     u8 compression_info = 0;
     if (compression_method == ZlibCompressionMethod::Deflate) {
@@ -108,7 +124,7 @@ ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_met
 
     // FIXME: Support pre-defined dictionaries.
 
-    TRY(m_output_stream->write_value(header.as_u16));
+    TRY(stream.write_value(header.as_u16));
 
     return {};
 }
@@ -171,4 +187,16 @@ ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompre
     return buffer;
 }
 
+ErrorOr<ByteBuffer> ZlibCompressor::wrap_deflate_data(ReadonlyBytes deflate_data, u32 adler32_checksum, ZlibCompressionLevel compression_level)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(sizeof(ZlibHeader) + deflate_data.size() + sizeof(u32)));
+    FixedMemoryStream stream { buffer.bytes() };
+
+    TRY(write_header(stream, ZlibCompressionMethod::Deflate, compression_level));
+    TRY(stream.write_until_depleted(deflate_data));
+    TRY(stream.write_value(NetworkOrdered<u32> { adler32_checksum }));
+
+    return buffer;
+}
+
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BitStream.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Endian.h>
 #include <AK/MaybeOwned.h>
@@ -46,7 +47,16 @@ static_assert(sizeof(ZlibHeader) == sizeof(u16));
 
 class ZlibDecompressor : public Stream {
 public:
-    static ErrorOr<NonnullOwnPtr<ZlibDecompressor>> create(MaybeOwned<Stream>);
+    enum class VerifyChecksum {
+        No,
+        Yes,
+    };
+
+    static ErrorOr<NonnullOwnPtr<ZlibDecompressor>> create(MaybeOwned<Stream>, VerifyChecksum = VerifyChecksum::No);
+
+    // Whether the Adler-32 checksum following the compressed data matches the decompressed data. Only known if it was
+    // asked to be verified, and only once all of the data has been read. A missing checksum leaves it unknown.
+    Optional<bool> checksum_matches() const { return m_checksum_matches; }
 
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
@@ -55,10 +65,15 @@ public:
     virtual void close() override;
 
 private:
-    ZlibDecompressor(ZlibHeader, NonnullOwnPtr<Stream>);
+    ZlibDecompressor(ZlibHeader, NonnullOwnPtr<LittleEndianInputBitStream>, NonnullOwnPtr<Stream>, VerifyChecksum);
 
     ZlibHeader m_header;
+    NonnullOwnPtr<LittleEndianInputBitStream> m_input_stream;
     NonnullOwnPtr<Stream> m_stream;
+    VerifyChecksum m_verify_checksum { VerifyChecksum::No };
+    Crypto::Checksum::Adler32 m_adler32_checksum;
+    bool m_read_checksum { false };
+    Optional<bool> m_checksum_matches;
 };
 
 class ZlibCompressor : public Stream {
@@ -75,9 +90,13 @@ public:
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
 
+    // Wraps deflate data that was produced without a ZlibCompressor (e.g. by compressing several pieces in parallel) in a zlib stream.
+    // The checksum is the Adler-32 checksum of the uncompressed data.
+    static ErrorOr<ByteBuffer> wrap_deflate_data(ReadonlyBytes deflate_data, u32 adler32_checksum, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+
 private:
     ZlibCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<Stream> compressor_stream);
-    ErrorOr<void> write_header(ZlibCompressionMethod, ZlibCompressionLevel);
+    static ErrorOr<void> write_header(Stream&, ZlibCompressionMethod, ZlibCompressionLevel);
 
     bool m_finished { false };
     MaybeOwned<Stream> m_output_stream;
@@ -7,9 +7,11 @@
 #include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/IntegralMath.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Types.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/EdgeFlagPathRasterizer.h>
+#include <LibGfx/RasterizedPathCache.h>
 
 #if defined(AK_COMPILER_GCC)
 #    pragma GCC optimize("O3")
@@ -305,28 +307,55 @@ __attribute__((hot)) Detail::Edge* EdgeFlagPathRasterizer<SamplesPerPixel>::plot
     return active_edges;
 }
 
+// Returns the index of the first non-zero sample in [start, end], or end + 1 if there is none.
+// Scanlines of sparse paths are mostly empty between edges, so this checks 16 bytes worth of samples at a time.
+template<typename SampleType>
+ALWAYS_INLINE static int find_next_edge(SampleType const* samples, int start, int end)
+{
+    constexpr int samples_per_vector = sizeof(AK::SIMD::u32x4) / sizeof(SampleType);
+    int x = start;
+    for (; x + samples_per_vector - 1 <= end; x += samples_per_vector) {
+        AK::SIMD::u32x4 vector;
+        __builtin_memcpy(&vector, samples + x, sizeof(vector));
+        if (AK::SIMD::any(vector != 0))
+            break;
+    }
+    for (; x <= end; x++) {
+        if (samples[x])
+            return x;
+    }
+    return end + 1;
+}
+
 template<unsigned SamplesPerPixel>
-auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_even_odd_scanline(EdgeExtent edge_extent, auto init, auto sample_callback)
+auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_even_odd_scanline(EdgeExtent edge_extent, auto init, auto span_callback)
 {
     SampleType sample = init;
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
-    for (int x = edge_extent.min_x; x <= edge_extent.max_x; x += 1) {
-        sample ^= m_scanline.data()[x];
-        sample_callback(x, sample);
-        m_scanline.data()[x] = 0;
+    auto* samples = m_scanline.data();
+    int x = edge_extent.min_x;
+    while (x <= edge_extent.max_x) {
+        sample ^= samples[x];
+        // Every pixel up to the next edge has the same coverage as this one.
+        auto span_end = find_next_edge(samples, x + 1, edge_extent.max_x);
+        span_callback(x, span_end - 1, sample);
+        x = span_end;
     }
+    edge_extent.memset_extent(samples, 0);
     return sample;
 }
 
 template<unsigned SamplesPerPixel>
-auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_non_zero_scanline(EdgeExtent edge_extent, auto init, auto sample_callback)
+auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_non_zero_scanline(EdgeExtent edge_extent, auto init, auto span_callback)
 {
     NonZeroAcc acc = init;
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
-    for (int x = edge_extent.min_x; x <= edge_extent.max_x; x += 1) {
-        if (auto edges = m_scanline.data()[x]) {
+    auto* samples = m_scanline.data();
+    int x = edge_extent.min_x;
+    while (x <= edge_extent.max_x) {
+        if (auto edges = samples[x]) {
             // We only need to process the windings when we hit some edges.
             for (auto y_sub = 0u; y_sub < SamplesPerPixel; y_sub++) {
                 auto subpixel_bit = 1 << y_sub;
@@ -340,10 +369,12 @@ auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_non_zero_scanline(EdgeE
                 }
             }
         }
-        sample_callback(x, acc.sample);
-        m_scanline.data()[x] = 0;
-        m_windings.data()[x] = {};
+        auto span_end = find_next_edge(samples, x + 1, edge_extent.max_x);
+        span_callback(x, span_end - 1, acc.sample);
+        x = span_end;
     }
+    edge_extent.memset_extent(samples, 0);
+    edge_extent.memset_extent(m_windings.data(), 0);
     return acc;
 }
 
@@ -357,15 +388,63 @@ auto EdgeFlagPathRasterizer<SamplesPerPixel>::accumulate_scanline(EdgeExtent edg
         return accumulate_non_zero_scanline(edge_extent, init, callback);
 }
 
+// Blends a single color into a span of pixels. For opaque destination pixels, Color::blend() reduces to
+// (destination * (255 - alpha) + source * alpha) / 255 per channel, which is done for four pixels at a time.
+static void blend_color_into_span(BitmapFormat format, ARGB32* pixels, int count, Color color)
+{
+    using AK::SIMD::expand4;
+    using AK::SIMD::u32x4;
+
+    auto const inverse_alpha = expand4(255u - color.alpha());
+    auto const source_red = expand4(static_cast<u32>(color.red() * color.alpha()));
+    auto const source_green = expand4(static_cast<u32>(color.green() * color.alpha()));
+    auto const source_blue = expand4(static_cast<u32>(color.blue() * color.alpha()));
+    // Exact for all values up to 255 * 255.
+    auto divide_by_255 = [](u32x4 value) {
+        return (value + 1 + (value >> 8)) >> 8;
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        u32x4 destination;
+        __builtin_memcpy(&destination, pixels + i, sizeof(destination));
+        if (format == BitmapFormat::BGRA8888 && AK::SIMD::any((destination >> 24) != expand4(255u))) {
+            for (int j = i; j < i + 4; j++)
+                pixels[j] = color_for_format(format, pixels[j]).blend(color).value();
+            continue;
+        }
+        auto red = divide_by_255(((destination >> 16) & 0xff) * inverse_alpha + source_red);
+        auto green = divide_by_255(((destination >> 8) & 0xff) * inverse_alpha + source_green);
+        auto blue = divide_by_255((destination & 0xff) * inverse_alpha + source_blue);
+        u32x4 result = expand4(0xff000000u) | (red << 16) | (green << 8) | blue;
+        __builtin_memcpy(pixels + i, &result, sizeof(result));
+    }
+    for (; i < count; i++)
+        pixels[i] = color_for_format(format, pixels[i]).blend(color).value();
+}
+
 template<unsigned SamplesPerPixel>
-void EdgeFlagPathRasterizer<SamplesPerPixel>::write_pixel(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int offset, SampleType sample, auto& color_or_function)
+void EdgeFlagPathRasterizer<SamplesPerPixel>::write_span(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int start, int end, SampleType sample, auto& color_or_function)
 {
     if (!sample)
         return;
-    auto dest_x = offset + m_blit_origin.x();
-    auto coverage = SubpixelSample::compute_coverage(sample);
-    auto paint_color = scanline_color(scanline, offset, coverage_to_alpha(coverage), color_or_function);
-    scanline_ptr[dest_x] = color_for_format(format, scanline_ptr[dest_x]).blend(paint_color).value();
+    auto alpha = coverage_to_alpha(SubpixelSample::compute_coverage(sample));
+    switch_on_color_or_function(
+        color_or_function,
+        [&](Color color) {
+            // The whole span shares a single color, so only compute it once.
+            auto paint_color = scanline_color(scanline, start, alpha, color);
+            if (paint_color.alpha() == 255)
+                return fast_fill_solid_color_span(scanline_ptr, start, end, paint_color);
+            blend_color_into_span(format, scanline_ptr + start + m_blit_origin.x(), end - start + 1, paint_color);
+        },
+        [&](auto& function) {
+            for (int x = start; x <= end; x++) {
+                auto dest_x = x + m_blit_origin.x();
+                auto paint_color = scanline_color(scanline, x, alpha, function);
+                scanline_ptr[dest_x] = color_for_format(format, scanline_ptr[dest_x]).blend(paint_color).value();
+            }
+        });
 }
 
 template<unsigned SamplesPerPixel>
@@ -392,7 +471,7 @@ FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SamplesPerPixel>::write
     }
 
     // Accumulate non-visible section (without plotting pixels).
-    auto acc = accumulate_scanline<WindingRule>(EdgeExtent { edge_extent.min_x, left_clip - 1 }, initial_acc<WindingRule>(), [](int, SampleType) {
+    auto acc = accumulate_scanline<WindingRule>(EdgeExtent { edge_extent.min_x, left_clip - 1 }, initial_acc<WindingRule>(), [](int, int, SampleType) {
         // Do nothing!
     });
 
@@ -400,37 +479,10 @@ FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SamplesPerPixel>::write
     auto dest_format = painter.target()->format();
     auto dest_ptr = painter.target()->scanline(scanline + m_blit_origin.y());
 
-    // Simple case: Handle each pixel individually.
-    // Used for PaintStyle fills and semi-transparent colors.
-    auto write_scanline_pixelwise = [&](auto& color_or_function) {
-        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
-            write_pixel(dest_format, dest_ptr, scanline, x, sample, color_or_function);
-        });
-    };
-    // Fast fill case: Track spans of solid color and set the entire span via a fast_u32_fill().
-    // Used for opaque colors (i.e. alpha == 255).
-    auto write_scanline_with_fast_fills = [&](Color color) {
-        if (color.alpha() != 255)
-            return write_scanline_pixelwise(color);
-        constexpr SampleType full_converage = NumericLimits<SampleType>::max();
-        int full_converage_count = 0;
-        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
-            if (sample == full_converage) {
-                full_converage_count++;
-                return;
-            } else {
-                write_pixel(dest_format, dest_ptr, scanline, x, sample, color);
-            }
-            if (full_converage_count > 0) {
-                fast_fill_solid_color_span(dest_ptr, x - full_converage_count, x - 1, color);
-                full_converage_count = 0;
-            }
-        });
-        if (full_converage_count > 0)
-            fast_fill_solid_color_span(dest_ptr, clipped_extent.max_x - full_converage_count + 1, clipped_extent.max_x, color);
-    };
-    switch_on_color_or_function(
-        color_or_function, write_scanline_with_fast_fills, write_scanline_pixelwise);
+    // Spans of pixels between edges share the same coverage. Fully covered spans of opaque colors are set via a fast_u32_fill().
+    accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int start, int end, SampleType sample) {
+        write_span(dest_format, dest_ptr, scanline, start, end, sample, color_or_function);
+    });
 }
 
 static IntSize path_bounds(Gfx::Path const& path)
@@ -456,6 +508,8 @@ void Painter::fill_path(Path const& path, PaintStyle const& paint_style, float o
 
 void AntiAliasingPainter::fill_path(Path const& path, Color color, Painter::WindingRule winding_rule)
 {
+    if (RasterizedPathCache::the().fill(m_underlying_painter, path, color, winding_rule, m_transform.translation()))
+        return;
     EdgeFlagPathRasterizer<32> rasterizer(path_bounds(path));
     rasterizer.fill(m_underlying_painter, path, color, winding_rule, m_transform.translation());
 }
@@ -63,7 +63,14 @@ public:
     }
 
     Glyph(RefPtr<Bitmap> bitmap, float left_bearing, float advance, float ascent, bool is_color_bitmap)
-        : m_bitmap(bitmap)
+        : Glyph(bitmap, bitmap ? bitmap->rect() : IntRect {}, left_bearing, advance, ascent, is_color_bitmap)
+    {
+    }
+
+    // The glyph only occupies bitmap_rect of the bitmap, e.g. when it lives in a GlyphAtlas page.
+    Glyph(RefPtr<Bitmap> bitmap, IntRect bitmap_rect, float left_bearing, float advance, float ascent, bool is_color_bitmap)
+        : m_bitmap(move(bitmap))
+        , m_bitmap_rect(bitmap_rect)
         , m_left_bearing(left_bearing)
         , m_advance(advance)
         , m_ascent(ascent)
@@ -76,6 +83,7 @@ public:
     bool is_glyph_bitmap() const { return !m_bitmap; }
     GlyphBitmap glyph_bitmap() const { return m_glyph_bitmap; }
     RefPtr<Bitmap> bitmap() const { return m_bitmap; }
+    IntRect bitmap_rect() const { return m_bitmap_rect; }
     float left_bearing() const { return m_left_bearing; }
     float advance() const { return m_advance; }
     float ascent() const { return m_ascent; }
@@ -83,6 +91,7 @@ public:
 private:
     GlyphBitmap m_glyph_bitmap;
     RefPtr<Bitmap> m_bitmap;
+    IntRect m_bitmap_rect;
     float m_left_bearing;
     float m_advance;
     float m_ascent;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibGfx/Font/GlyphAtlas.h>
+
+namespace Gfx {
+
+// Glyphs are packed with a gap between them, so that bilinear sampling never bleeds into a neighbor.
+static constexpr int glyph_padding = 1;
+
+GlyphAtlas& GlyphAtlas::the()
+{
+    // Each painting thread gets its own atlas, so that looking up glyphs never needs a lock.
+    static thread_local GlyphAtlas s_the;
+    return s_the;
+}
+
+GlyphAtlas::GlyphAtlas(size_t max_page_count, size_t max_standalone_glyph_count, size_t max_standalone_glyph_bytes)
+    : m_max_page_count(max_page_count)
+    , m_max_standalone_glyph_count(max_standalone_glyph_count)
+    , m_max_standalone_glyph_bytes(max_standalone_glyph_bytes)
+{
+    VERIFY(m_max_page_count > 0);
+}
+
+u64 GlyphAtlas::allocate_font_id()
+{
+    static Atomic<u64> s_next_font_id { 1 };
+    return s_next_font_id.fetch_add(1);
+}
+
+GlyphAtlas::Entry GlyphAtlas::get_or_rasterize(Key const& key, Function<RefPtr<Bitmap>()> const& rasterize)
+{
+    if (auto location = m_entries.get(key); location.has_value())
+        return entry_for(*location);
+    if (auto entry = get_standalone_glyph(key); entry.has_value())
+        return entry.release_value();
+
+    auto glyph_bitmap = rasterize();
+    if (!glyph_bitmap || glyph_bitmap->rect().is_empty())
+        return add_standalone_glyph(key, nullptr);
+
+    Optional<Location> location;
+    if (glyph_bitmap->format() == BitmapFormat::BGRA8888 && glyph_bitmap->scale() == 1)
+        location = allocate(glyph_bitmap->size());
+    if (!location.has_value()) {
+        // The glyph is larger than a page, in an unusual format, or we're out of memory.
+        return add_standalone_glyph(key, move(glyph_bitmap));
+    }
+
+    auto& page = m_pages[location->page_index];
+    auto const& rect = location->rect;
+    for (int y = 0; y < rect.height(); ++y)
+        __builtin_memcpy(page.bitmap->scanline(rect.y() + y) + rect.x(), glyph_bitmap->scanline(y), rect.width() * sizeof(ARGB32));
+
+    page.keys.append(key);
+    m_entries.set(key, *location);
+    return entry_for(*location);
+}
+
+GlyphAtlas::Entry GlyphAtlas::entry_for(Location const& location)
+{
+    auto& page = m_pages[location.page_index];
+    page.last_used = ++m_use_counter;
+    return { page.bitmap, location.rect };
+}
+
+Optional<GlyphAtlas::Entry> GlyphAtlas::get_standalone_glyph(Key const& key)
+{
+    auto bitmap = m_standalone_glyphs.take(key);
+    if (!bitmap.has_value())
+        return {};
+
+    // Move the glyph to the back, where the most recently used glyphs are.
+    Entry entry { *bitmap, *bitmap ? (*bitmap)->rect() : IntRect {} };
+    m_standalone_glyphs.set(key, bitmap.release_value());
+    return entry;
+}
+
+GlyphAtlas::Entry GlyphAtlas::add_standalone_glyph(Key const& key, RefPtr<Bitmap> bitmap)
+{
+    Entry entry { bitmap, bitmap ? bitmap->rect() : IntRect {} };
+    auto size_in_bytes = bitmap ? bitmap->size_in_bytes() : 0;
+    if (size_in_bytes > m_max_standalone_glyph_bytes)
+        return entry;
+
+    while (!m_standalone_glyphs.is_empty()
+        && (m_standalone_glyphs.size() >= m_max_standalone_glyph_count || m_standalone_glyph_bytes + size_in_bytes > m_max_standalone_glyph_bytes)) {
+        auto least_recently_used = m_standalone_glyphs.begin();
+        if (least_recently_used->value)
+            m_standalone_glyph_bytes -= least_recently_used->value->size_in_bytes();
+        m_standalone_glyphs.remove(least_recently_used);
+    }
+    if (m_standalone_glyphs.size() >= m_max_standalone_glyph_count)
+        return entry;
+
+    m_standalone_glyph_bytes += size_in_bytes;
+    m_standalone_glyphs.set(key, move(bitmap));
+    return entry;
+}
+
+Optional<IntPoint> GlyphAtlas::allocate_in_page(Page& page, IntSize size)
+{
+    auto padded_width = size.width() + glyph_padding;
+    auto padded_height = size.height() + glyph_padding;
+
+    // Prefer an existing shelf that is tall enough without wasting too much space.
+    for (auto& shelf : page.shelves) {
+        if (shelf.height < padded_height || shelf.height > padded_height + padded_height / 4 + 2)
+            continue;
+        if (shelf.next_x + padded_width > page_size)
+            continue;
+        IntPoint position { shelf.next_x, shelf.y };
+        shelf.next_x += padded_width;
+        return position;
+    }
+
+    auto next_shelf_y = page.shelves.is_empty() ? 0 : page.shelves.last().y + page.shelves.last().height;
+    if (next_shelf_y + padded_height > page_size)
+        return {};
+    page.shelves.append({ .y = next_shelf_y, .height = padded_height, .next_x = padded_width });
+    return IntPoint { 0, next_shelf_y };
+}
+
+Optional<GlyphAtlas::Location> GlyphAtlas::allocate(IntSize size)
+{
+    if (size.width() + glyph_padding > page_size || size.height() + glyph_padding > page_size)
+        return {};
+
+    for (size_t i = 0; i < m_pages.size(); ++i) {
+        if (auto position = allocate_in_page(m_pages[i], size); position.has_value())
+            return Location { static_cast<int>(i), { *position, size } };
+    }
+
+    size_t page_index;
+    if (m_pages.size() < m_max_page_count) {
+        auto bitmap_or_error = Bitmap::create(BitmapFormat::BGRA8888, { page_size, page_size });
+        if (bitmap_or_error.is_error())
+            return {};
+        m_pages.append({ .bitmap = bitmap_or_error.release_value(), .shelves = {}, .keys = {}, .last_used = 0 });
+        page_index = m_pages.size() - 1;
+    } else {
+        auto page_index_or_error = evict_least_recently_used_page();
+        if (page_index_or_error.is_error())
+            return {};
+        page_index = page_index_or_error.release_value();
+    }
+
+    // The page is empty now, so any glyph that fits into a page at all will fit.
+    auto position = allocate_in_page(m_pages[page_index], size);
+    VERIFY(position.has_value());
+    return Location { static_cast<int>(page_index), { *position, size } };
+}
+
+ErrorOr<size_t> GlyphAtlas::evict_least_recently_used_page()
+{
+    VERIFY(!m_pages.is_empty());
+    size_t page_index = 0;
+    for (size_t i = 1; i < m_pages.size(); ++i) {
+        if (m_pages[i].last_used < m_pages[page_index].last_used)
+            page_index = i;
+    }
+
+    auto& page = m_pages[page_index];
+    // Someone is still holding on to glyphs from this page, so we can't overwrite its pixels.
+    // Otherwise, clear it, so that the padding around new glyphs doesn't pick up pixels of evicted ones.
+    if (page.bitmap->ref_count() > 1)
+        page.bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, { page_size, page_size }));
+    else
+        page.bitmap->fill(Color::Transparent);
+
+    for (auto const& key : page.keys)
+        m_entries.remove(key);
+    page.keys.clear_with_capacity();
+    page.shelves.clear_with_capacity();
+    page.last_used = 0;
+    return page_index;
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// A per-thread cache of rasterized glyphs, packed into a bounded number of atlas pages.
+// When every page is full, the least recently used page is evicted as a whole.
+// Glyphs that can't be packed into a page, as well as glyphs without visible pixels, are
+// kept apart in a bounded cache that evicts the least recently used glyph.
+class GlyphAtlas {
+    AK_MAKE_NONCOPYABLE(GlyphAtlas);
+    AK_MAKE_NONMOVABLE(GlyphAtlas);
+
+public:
+    static constexpr int page_size = 512;
+    static constexpr size_t default_max_page_count = 16;
+    static constexpr size_t default_max_standalone_glyph_count = 1024;
+    static constexpr size_t default_max_standalone_glyph_bytes = 4 * MiB;
+
+    static GlyphAtlas& the();
+
+    explicit GlyphAtlas(size_t max_page_count = default_max_page_count, size_t max_standalone_glyph_count = default_max_standalone_glyph_count, size_t max_standalone_glyph_bytes = default_max_standalone_glyph_bytes);
+
+    struct Key {
+        u64 font_id;
+        u32 glyph_id;
+        GlyphSubpixelOffset subpixel_offset;
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct Entry {
+        // Null if the glyph has no visible pixels.
+        RefPtr<Bitmap> bitmap;
+        IntRect rect;
+    };
+
+    // Returns the cached glyph for the key, calling the rasterizer on a miss.
+    Entry get_or_rasterize(Key const&, Function<RefPtr<Bitmap>()> const& rasterize);
+
+    // Every font that puts glyphs into the atlas needs its own ID, as IDs are never reused.
+    static u64 allocate_font_id();
+
+    size_t page_count() const { return m_pages.size(); }
+    size_t max_page_count() const { return m_max_page_count; }
+    size_t glyph_count() const { return m_entries.size() + m_standalone_glyphs.size(); }
+    size_t standalone_glyph_count() const { return m_standalone_glyphs.size(); }
+
+private:
+    struct Shelf {
+        int y { 0 };
+        int height { 0 };
+        int next_x { 0 };
+    };
+
+    struct Page {
+        NonnullRefPtr<Bitmap> bitmap;
+        Vector<Shelf> shelves;
+        Vector<Key> keys;
+        u64 last_used { 0 };
+    };
+
+    struct Location {
+        // Index into m_pages.
+        int page_index { 0 };
+        IntRect rect;
+    };
+
+    Optional<IntPoint> allocate_in_page(Page&, IntSize);
+    Optional<Location> allocate(IntSize);
+    ErrorOr<size_t> evict_least_recently_used_page();
+    Entry entry_for(Location const&);
+
+    Optional<Entry> get_standalone_glyph(Key const&);
+    Entry add_standalone_glyph(Key const&, RefPtr<Bitmap>);
+
+    size_t m_max_page_count { default_max_page_count };
+    Vector<Page> m_pages;
+    HashMap<Key, Location> m_entries;
+    u64 m_use_counter { 0 };
+
+    // Null bitmaps stand for glyphs without visible pixels. The map is kept in order of use,
+    // so the least recently used glyph is always the first one.
+    size_t m_max_standalone_glyph_count { default_max_standalone_glyph_count };
+    size_t m_max_standalone_glyph_bytes { default_max_standalone_glyph_bytes };
+    size_t m_standalone_glyph_bytes { 0 };
+    OrderedHashMap<Key, RefPtr<Bitmap>> m_standalone_glyphs;
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::GlyphAtlas::Key> : public DefaultTraits<Gfx::GlyphAtlas::Key> {
+    static unsigned hash(Gfx::GlyphAtlas::Key const& key)
+    {
+        return pair_int_hash(u64_hash(key.font_id), pair_int_hash(key.glyph_id, (key.subpixel_offset.x << 8) | key.subpixel_offset.y));
+    }
+};
+
+}
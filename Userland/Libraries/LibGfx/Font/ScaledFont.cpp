@@ -7,6 +7,7 @@
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/Font/Emoji.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Font/ScaledFont.h>
 
 namespace Gfx {
@@ -15,6 +16,7 @@ ScaledFont::ScaledFont(NonnullRefPtr<VectorFont> font, float point_width, float
     : m_font(move(font))
     , m_point_width(point_width)
     , m_point_height(point_height)
+    , m_atlas_font_id(GlyphAtlas::allocate_font_id())
 {
     float units_per_em = m_font->units_per_em();
     m_x_scale = (point_width * dpi_x) / (POINTS_PER_INCH * units_per_em);
@@ -73,14 +75,7 @@ ALWAYS_INLINE float ScaledFont::unicode_view_width(T const& view) const
 
 RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const
 {
-    GlyphIndexWithSubpixelOffset index { glyph_id, subpixel_offset };
-    auto glyph_iterator = m_cached_glyph_bitmaps.find(index);
-    if (glyph_iterator != m_cached_glyph_bitmaps.end())
-        return glyph_iterator->value;
-
-    auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, subpixel_offset);
-    m_cached_glyph_bitmaps.set(index, glyph_bitmap);
-    return glyph_bitmap;
+    return m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, subpixel_offset);
 }
 
 bool ScaledFont::append_glyph_path_to(Gfx::Path& path, u32 glyph_id) const
@@ -107,9 +102,11 @@ Gfx::Glyph ScaledFont::glyph(u32 code_point) const
 Gfx::Glyph ScaledFont::glyph(u32 code_point, GlyphSubpixelOffset subpixel_offset) const
 {
     auto id = glyph_id_for_code_point(code_point);
-    auto bitmap = rasterize_glyph(id, subpixel_offset);
+    auto cached_glyph = GlyphAtlas::the().get_or_rasterize({ m_atlas_font_id, id, subpixel_offset }, [&] {
+        return rasterize_glyph(id, subpixel_offset);
+    });
     auto metrics = glyph_metrics(id);
-    return Gfx::Glyph(bitmap, metrics.left_side_bearing, metrics.advance_width, metrics.ascender, m_font->has_color_bitmaps());
+    return Gfx::Glyph(move(cached_glyph.bitmap), cached_glyph.rect, metrics.left_side_bearing, metrics.advance_width, metrics.ascender, m_font->has_color_bitmaps());
 }
 
 float ScaledFont::glyph_left_bearing(u32 code_point) const
@@ -14,13 +14,6 @@
 
 namespace Gfx {
 
-struct GlyphIndexWithSubpixelOffset {
-    u32 glyph_id;
-    GlyphSubpixelOffset subpixel_offset;
-
-    bool operator==(GlyphIndexWithSubpixelOffset const&) const = default;
-};
-
 class ScaledFont final : public Gfx::Font {
 public:
     ScaledFont(NonnullRefPtr<VectorFont>, float point_width, float point_height, unsigned dpi_x = DEFAULT_DPI, unsigned dpi_y = DEFAULT_DPI);
@@ -82,7 +75,8 @@ private:
     float m_point_height { 0.0f };
 
     mutable HashMap<u32, Gfx::Path> m_glyph_cache;
-    mutable HashMap<GlyphIndexWithSubpixelOffset, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
+    // Identifies this font's glyph bitmaps in the shared GlyphAtlas.
+    u64 m_atlas_font_id { 0 };
     Gfx::FontPixelMetrics m_pixel_metrics;
 
     float m_pixel_size { 0.0f };
@@ -93,15 +87,3 @@ private:
 };
 
 }
-
-namespace AK {
-
-template<>
-struct Traits<Gfx::GlyphIndexWithSubpixelOffset> : public DefaultTraits<Gfx::GlyphIndexWithSubpixelOffset> {
-    static unsigned hash(Gfx::GlyphIndexWithSubpixelOffset const& index)
-    {
-        return pair_int_hash(index.glyph_id, (index.subpixel_offset.x << 8) | index.subpixel_offset.y);
-    }
-};
-
-}
@@ -101,6 +101,19 @@ ErrorOr<RefPtr<ImageDecoder>> ImageDecoder::try_create_for_raw_bytes(ReadonlyByt
     return RefPtr<ImageDecoder> {};
 }
 
+int ImageDecoderPlugin::reduction_factor_for_ideal_size(IntSize size, Optional<IntSize> ideal_size, int max_factor)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty())
+        return 1;
+
+    int factor = 1;
+    while (factor < max_factor
+        && ceil_div(size.width(), factor * 2) >= ideal_size->width()
+        && ceil_div(size.height(), factor * 2) >= ideal_size->height())
+        factor *= 2;
+    return factor;
+}
+
 ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
     : m_plugin(move(plugin))
 {
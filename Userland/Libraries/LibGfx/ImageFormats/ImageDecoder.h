@@ -82,8 +82,15 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // Raster plugins may use ideal_size to decode a smaller version of the frame, but the returned
+    // bitmap is never smaller than ideal_size in either dimension (or than the natural size).
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if the format can be decoded progressively. This decodes as much of the frame as the data
+    // that has been received so far allows, e.g. while the image is still being downloaded. The parts of the
+    // frame that there is no data for yet are transparent. This must also work after frame() failed on the same data.
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame(size_t index) { return frame(index); }
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() { return OptionalNone {}; }
@@ -94,6 +101,10 @@ public:
 
 protected:
     ImageDecoderPlugin() = default;
+
+    // Returns the largest power of two, up to max_factor, by which an image of the given size can be
+    // shrunk without either of its dimensions becoming smaller than ideal_size. Returns 1 without an ideal size.
+    static int reduction_factor_for_ideal_size(IntSize, Optional<IntSize> ideal_size, int max_factor = 8);
 };
 
 class ImageDecoder : public RefCounted<ImageDecoder> {
@@ -110,6 +121,7 @@ public:
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    ErrorOr<ImageFrameDescriptor> partial_frame(size_t index) const { return m_plugin->partial_frame(index); }
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -472,6 +473,16 @@ struct JPEGLoadingContext {
     HashMap<u8, HuffmanTable> ac_tables;
     Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
+
+    // Number of pixels along each side of a decoded block. Below 8, the image is decoded
+    // at a reduced size of block_size / 8 by only evaluating the lowest frequencies of each block.
+    u8 block_size { 8 };
+
+    IntSize decoded_size() const
+    {
+        return { ceil_div(frame.width * block_size, 8), ceil_div(frame.height * block_size, 8) };
+    }
+
     JPEGStream stream;
     JPEGDecoderOptions options;
 
@@ -1421,8 +1432,11 @@ static void dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblo
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
+                        // When decoding at a reduced size, the higher frequencies are never looked at.
+                        for (u32 row = 0; row < context.block_size; row++) {
+                            for (u32 column = 0; column < context.block_size; column++)
+                                block_component[row * 8 + column] *= table[row * 8 + column];
+                        }
                     }
                 }
             }
@@ -1585,6 +1599,61 @@ static void inverse_dct_8x8(i16* block_component)
     }
 }
 
+// Computes a scaled-down N x N version of the block directly from its N x N lowest frequency coefficients,
+// by evaluating an N-point IDCT in both directions. This is the approach of libjpeg's jidctred.c.
+template<u8 N>
+static void inverse_dct_reduced(i16* block_component)
+{
+    static_assert(N == 1 || N == 2 || N == 4);
+
+    // factors[x * N + u] = C(u) / 2 * cos((2x + 1) * u * pi / 2N), with C(0) = 1 / sqrt(2) and C(u) = 1 otherwise.
+    static auto const factors = [] {
+        Array<float, N * N> factors;
+        for (u8 x = 0; x < N; ++x) {
+            for (u8 u = 0; u < N; ++u) {
+                float const c = u == 0 ? AK::sqrt(0.5f) : 1.0f;
+                factors[x * N + u] = c / 2.0f * AK::cos((2 * x + 1) * u * AK::Pi<float> / (2 * N));
+            }
+        }
+        return factors;
+    }();
+
+    Array<float, N * N> columns;
+    for (u8 u = 0; u < N; ++u) {
+        for (u8 y = 0; y < N; ++y) {
+            float sum = 0;
+            for (u8 v = 0; v < N; ++v)
+                sum += factors[y * N + v] * block_component[v * 8 + u];
+            columns[y * N + u] = sum;
+        }
+    }
+
+    for (u8 y = 0; y < N; ++y) {
+        for (u8 x = 0; x < N; ++x) {
+            float sum = 0;
+            for (u8 u = 0; u < N; ++u)
+                sum += factors[x * N + u] * columns[y * N + u];
+            block_component[y * 8 + x] = sum;
+        }
+    }
+}
+
+static void inverse_dct_block(u8 block_size, i16* block_component)
+{
+    switch (block_size) {
+    case 1:
+        return inverse_dct_reduced<1>(block_component);
+    case 2:
+        return inverse_dct_reduced<2>(block_component);
+    case 4:
+        return inverse_dct_reduced<4>(block_component);
+    case 8:
+        return inverse_dct_8x8(block_component);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
@@ -1596,7 +1665,7 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component = get_component(block, component_i);
-                        inverse_dct_8x8(block_component);
+                        inverse_dct_block(context.block_size, block_component);
                     }
                 }
             }
@@ -1611,8 +1680,8 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
             for (u8 vfactor_i = 0; vfactor_i < context.sampling_factors.vertical; ++vfactor_i) {
                 for (u8 hfactor_i = 0; hfactor_i < context.sampling_factors.horizontal; ++hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
+                    for (u8 i = 0; i < context.block_size; ++i) {
+                        for (u8 j = 0; j < context.block_size; ++j) {
 
                             // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
                             //        12 bits JPEGs without rewriting all color transformations.
@@ -1639,6 +1708,7 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     // The first component has sampling factors of context.sampling_factors, while the others
     // divide the first component's sampling factors. This is enforced by read_start_of_frame().
     // This function undoes the subsampling by duplicating the values of the smaller components.
+    // When decoding at a reduced size, only the top-left block_size x block_size pixels of each block are used.
     // See https://www.w3.org/Graphics/JPEG/itu-t81.pdf, A.2 Order of source image data encoding.
     //
     // FIXME: Allow more combinations of sampling factors.
@@ -1661,12 +1731,12 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
+                        for (u8 i = context.block_size - 1; i < context.block_size; --i) {
+                            for (u8 j = context.block_size - 1; j < context.block_size; --j) {
                                 u8 const pixel = i * 8 + j;
                                 // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
+                                u32 const component_pxrow = (i + context.block_size * vfactor_i) / context.sampling_factors.vertical;
+                                u32 const component_pxcol = (j + context.block_size * hfactor_i) / context.sampling_factors.horizontal;
                                 u32 const component_pixel = component_pxrow * 8 + component_pxcol;
                                 block_component_destination[pixel] = block_component_source[component_pixel];
                             }
@@ -1678,7 +1748,7 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     }
 }
 
-static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
+static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks, u8 block_size)
 {
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
@@ -1687,13 +1757,15 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
         auto* y = macroblock.y;
         auto* cb = macroblock.cb;
         auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
-            int r = y[i] + 1.402f * (cr[i] - 128);
-            int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
-            int b = y[i] + 1.772f * (cb[i] - 128);
-            y[i] = clamp(r, 0, 255);
-            cb[i] = clamp(g, 0, 255);
-            cr[i] = clamp(b, 0, 255);
+        for (u8 row = 0; row < block_size; ++row) {
+            for (u8 i = row * 8; i < row * 8 + block_size; ++i) {
+                int r = y[i] + 1.402f * (cr[i] - 128);
+                int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
+                int b = y[i] + 1.772f * (cb[i] - 128);
+                y[i] = clamp(r, 0, 255);
+                cb[i] = clamp(g, 0, 255);
+                cr[i] = clamp(b, 0, 255);
+            }
         }
     }
 }
@@ -1719,13 +1791,13 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     }
 }
 
-static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
+static void ycck_to_cmyk(Vector<Macroblock>& macroblocks, u8 block_size)
 {
     // 7 - Conversions between colour encodings
     // YCCK is obtained from CMYK by converting the CMY channels to YCC channel.
 
     // To convert back into RGB, we only need the 3 first components, which are baseline YCbCr
-    ycbcr_to_rgb(macroblocks);
+    ycbcr_to_rgb(macroblocks, block_size);
 
     // RGB to CMY, as mentioned in https://www.smcm.iqfr.csic.es/docs/intel/ipp/ipp_manual/IPPI/ippi_ch15/functn_YCCKToCMYK_JPEG.htm#functn_YCCKToCMYK_JPEG
     for (auto& macroblock : macroblocks) {
@@ -1756,10 +1828,10 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
             }
             break;
         case ColorTransform::YCbCr:
-            ycbcr_to_rgb(macroblocks);
+            ycbcr_to_rgb(macroblocks, context.block_size);
             break;
         case ColorTransform::YCCK:
-            ycck_to_cmyk(macroblocks);
+            ycck_to_cmyk(macroblocks, context.block_size);
             break;
         }
 
@@ -1771,13 +1843,13 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
     //      - 3 components means YCbCr
     //      - 4 components means CMYK (Nothing to do here).
     if (context.components.size() == 3)
-        ycbcr_to_rgb(macroblocks);
+        ycbcr_to_rgb(macroblocks, context.block_size);
 
     if (context.components.size() == 1) {
         // With Cb and Cr being equal to zero, this function assign the Y
         // value (luminosity) to R, G and B. Providing a proper conversion
         // from grayscale to RGB.
-        ycbcr_to_rgb(macroblocks);
+        ycbcr_to_rgb(macroblocks, context.block_size);
     }
 
     return {};
@@ -1785,15 +1857,18 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
 
 static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
-
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    auto const size = context.decoded_size();
+    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, size));
+
+    u32 const block_shift = count_trailing_zeroes(context.block_size);
+    u32 const block_mask = context.block_size - 1;
+    for (u32 y = size.height() - 1; y < static_cast<u32>(size.height()); y--) {
+        u32 const block_row = y >> block_shift;
+        u32 const pixel_row = y & block_mask;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x >> block_shift;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
+            u32 const pixel_column = x & block_mask;
             u32 const pixel_index = pixel_row * 8 + pixel_column;
             Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
             context.bitmap->set_pixel(x, y, color);
@@ -1808,15 +1883,18 @@ static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Mac
     if (context.options.cmyk == JPEGDecoderOptions::CMYK::Normal)
         invert_colors_for_adobe_images(context, macroblocks);
 
-    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
+    auto const size = context.decoded_size();
+    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size(size));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    u32 const block_shift = count_trailing_zeroes(context.block_size);
+    u32 const block_mask = context.block_size - 1;
+    for (u32 y = size.height() - 1; y < static_cast<u32>(size.height()); y--) {
+        u32 const block_row = y >> block_shift;
+        u32 const pixel_row = y & block_mask;
+        for (u32 x = 0; x < static_cast<u32>(size.width()); x++) {
+            u32 const block_column = x >> block_shift;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
+            u32 const pixel_column = x & block_mask;
             u32 const pixel_index = pixel_row * 8 + pixel_column;
             context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
         }
@@ -1982,8 +2060,9 @@ static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
     return {};
 }
 
-JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
-    : m_context(move(context))
+JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(ReadonlyBytes data, NonnullOwnPtr<JPEGLoadingContext> context)
+    : m_data(data)
+    , m_context(move(context))
 {
 }
 
@@ -2011,12 +2090,36 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_o
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
     auto context = TRY(JPEGLoadingContext::create(move(stream), options));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(data, move(context))));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<void> JPEGImageDecoderPlugin::decode(u8 block_size)
+{
+    if (m_context->state == JPEGLoadingContext::State::BitmapDecoded) {
+        if (m_context->block_size >= block_size)
+            return {};
+
+        // Only a smaller version of the image was decoded so far, so start over from the header.
+        auto stream = TRY(try_make<FixedMemoryStream>(m_data));
+        m_context = TRY(JPEGLoadingContext::create(move(stream), m_context->options));
+        if (auto result = decode_header(*m_context); result.is_error()) {
+            m_context->state = JPEGLoadingContext::State::Error;
+            return result.release_error();
+        }
+    }
+
+    m_context->block_size = block_size;
+    if (auto result = decode_jpeg(*m_context); result.is_error()) {
+        m_context->state = JPEGLoadingContext::State::Error;
+        return result.release_error();
+    }
+    m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -2024,13 +2127,8 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    // Small renditions are decoded straight from the lowest DCT frequencies, at 1/2, 1/4 or 1/8 of the size.
+    TRY(decode(8 / reduction_factor_for_ideal_size(size(), ideal_size)));
 
     if (m_context->cmyk_bitmap && !m_context->bitmap)
         return ImageFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), 0 };
@@ -2068,13 +2166,7 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
     VERIFY(natural_frame_format() == NaturalFrameFormat::CMYK);
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    TRY(decode(8));
 
     return *m_context->cmyk_bitmap;
 }
@@ -46,8 +46,11 @@ public:
     virtual ErrorOr<NonnullRefPtr<CMYKBitmap>> cmyk_frame() override;
 
 private:
-    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
+    JPEGImageDecoderPlugin(ReadonlyBytes, NonnullOwnPtr<JPEGLoadingContext>);
 
+    ErrorOr<void> decode(u8 block_size);
+
+    ReadonlyBytes m_data;
     NonnullOwnPtr<JPEGLoadingContext> m_context;
 };
 
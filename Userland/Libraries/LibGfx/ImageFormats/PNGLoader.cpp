@@ -82,11 +82,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -185,8 +180,10 @@ struct PNGLoadingContext {
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
+    bool allow_truncated_image_data { false };
+    bool image_data_was_truncated { false };
+    // The default image is decoded shrunk by this power of two, see PNGImageDecoderPlugin::frame().
+    int reduction_factor { 1 };
     RefPtr<Gfx::Bitmap> bitmap;
     ByteBuffer compressed_data;
     Vector<PaletteEntry> palette_data;
@@ -272,6 +269,7 @@ public:
     }
 
     u8 const* current_data_ptr() const { return m_data_ptr; }
+    size_t size_remaining() const { return m_size_remaining; }
     bool at_end() const { return !m_size_remaining; }
 
 private:
@@ -293,13 +291,101 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+template<size_t bytes_per_pixel>
+ALWAYS_INLINE static AK::SIMD::u8x4 load_pixel(u8 const* data)
+{
+    AK::SIMD::u8x4 pixel {};
+    __builtin_memcpy(&pixel, data, bytes_per_pixel);
+    return pixel;
+}
+
+template<size_t bytes_per_pixel>
+ALWAYS_INLINE static void store_pixel(u8* data, AK::SIMD::u8x4 pixel)
+{
+    __builtin_memcpy(data, &pixel, bytes_per_pixel);
+}
+
+// Sub, Average and Paeth depend on the already unfiltered pixel to the left, so instead of going
+// byte by byte, these unfilter all channels of a 3 or 4 byte pixel at once.
+template<size_t bytes_per_pixel, typename Predictor>
+ALWAYS_INLINE static void unfilter_pixels(Bytes scanline_data, ReadonlyBytes previous_scanlines_data, Predictor predictor)
+{
+    AK::SIMD::u8x4 left {};
+    AK::SIMD::u8x4 upper_left {};
+    for (size_t i = 0; i < scanline_data.size(); i += bytes_per_pixel) {
+        auto above = load_pixel<bytes_per_pixel>(previous_scanlines_data.offset_pointer(i));
+        left = load_pixel<bytes_per_pixel>(scanline_data.offset_pointer(i)) + predictor(left, above, upper_left);
+        store_pixel<bytes_per_pixel>(scanline_data.offset_pointer(i), left);
+        upper_left = above;
+    }
+}
+
+template<size_t bytes_per_pixel>
+static void unfilter_scanline_with_pixel_size(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    using AK::SIMD::u16x4;
+    using AK::SIMD::u8x4;
+
+    switch (filter) {
+    case PNG::FilterType::Sub:
+        unfilter_pixels<bytes_per_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4, u8x4) {
+            return left;
+        });
+        break;
+    case PNG::FilterType::Average:
+        unfilter_pixels<bytes_per_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4 above, u8x4) {
+            return __builtin_convertvector((__builtin_convertvector(left, u16x4) + __builtin_convertvector(above, u16x4)) >> 1, u8x4);
+        });
+        break;
+    case PNG::FilterType::Paeth:
+        unfilter_pixels<bytes_per_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4 above, u8x4 upper_left) {
+            return PNG::paeth_predictor(left, above, upper_left);
+        });
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
 void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     // https://www.w3.org/TR/png-3/#9Filter-types
     // "Filters are applied to bytes, not to pixels, regardless of the bit depth or colour type of the image."
     switch (filter) {
     case PNG::FilterType::None:
+        return;
+    case PNG::FilterType::Up: {
+        size_t i = 0;
+        for (; i + sizeof(AK::SIMD::u8x16) <= scanline_data.size(); i += sizeof(AK::SIMD::u8x16)) {
+            AK::SIMD::u8x16 current;
+            AK::SIMD::u8x16 above;
+            __builtin_memcpy(&current, scanline_data.offset_pointer(i), sizeof(current));
+            __builtin_memcpy(&above, previous_scanlines_data.offset_pointer(i), sizeof(above));
+            current += above;
+            __builtin_memcpy(scanline_data.offset_pointer(i), &current, sizeof(current));
+        }
+        for (; i < scanline_data.size(); ++i)
+            scanline_data[i] += previous_scanlines_data[i];
+        return;
+    }
+    default:
         break;
+    }
+
+    // RGB and RGBA with 8 bits per channel (and grayscale with alpha at 16 bits) are by far the most common,
+    // so those get a vectorized path that handles one whole pixel per step.
+    if (scanline_data.size() % bytes_per_complete_pixel == 0) {
+        if (bytes_per_complete_pixel == 3) {
+            unfilter_scanline_with_pixel_size<3>(filter, scanline_data, previous_scanlines_data);
+            return;
+        }
+        if (bytes_per_complete_pixel == 4) {
+            unfilter_scanline_with_pixel_size<4>(filter, scanline_data, previous_scanlines_data);
+            return;
+        }
+    }
+
+    switch (filter) {
     case PNG::FilterType::Sub:
         // This loop starts at bytes_per_complete_pixel because all bytes before that are
         // guaranteed to have no valid byte at index (i - bytes_per_complete pixel).
@@ -311,12 +397,6 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
             scanline_data[i] += left;
         }
         break;
-    case PNG::FilterType::Up:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
-            u8 above = previous_scanlines_data[i];
-            scanline_data[i] += above;
-        }
-        break;
     case PNG::FilterType::Average:
         for (size_t i = 0; i < scanline_data.size(); ++i) {
             u32 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
@@ -333,136 +413,90 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
             scanline_data[i] += PNG::paeth_predictor(left, above, upper_left);
         }
         break;
+    default:
+        VERIFY_NOT_REACHED();
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline, int width, Pixel* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<T const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline, int width, Pixel* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline, int width, Pixel* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline, int width, Pixel* pixels, Triplet<T> transparency_value)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < width; ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+// Converts one unfiltered scanline of `width` pixels to BGRA and writes it to `destination`.
+static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, int width, ARGB32* destination)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
+    auto* pixels = reinterpret_cast<Pixel*>(destination);
 
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
-
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
-    }
-
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline, width, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline, width, pixels);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline.data();
+            for (int x = 0; x < width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +504,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline, width, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline, width, pixels);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,39 +514,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline, width, pixels, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline, width, pixels, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline, width, pixels);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline, width, pixels);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels, scanline.data(), width * sizeof(Pixel));
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -520,42 +550,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline.data();
+            for (int i = 0; i < width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -567,14 +593,57 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
+    for (int i = 0; i < width; ++i)
+        swap(pixels[i].r, pixels[i].b);
+
+    return {};
+}
+
+// Inflates, unfilters and unpacks the image data one scanline at a time, so that only the current
+// and the previous scanline are ever held in memory rather than the whole decompressed image.
+template<typename Callback>
+static ErrorOr<void> decode_scanlines(PNGLoadingContext& context, Stream& stream, int width, int height, Callback on_scanline)
+{
+    auto row_size = context.compute_row_size_for_width(width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+
+    // Each scanline is prefixed by its filter type byte. The previous scanline of the first one is all zeroes.
+    size_t const bytes_per_scanline = row_size.value() + 1;
+    auto buffer = TRY(ByteBuffer::create_zeroed(bytes_per_scanline * 2));
+    auto previous_scanline = buffer.bytes().slice(0, bytes_per_scanline);
+    auto current_scanline = buffer.bytes().slice(bytes_per_scanline, bytes_per_scanline);
+
+    for (int y = 0; y < height; ++y) {
+        if (stream.read_until_filled(current_scanline).is_error()) {
+            if (context.allow_truncated_image_data) {
+                context.image_data_was_truncated = true;
+                return {};
+            }
+            context.state = PNGLoadingContext::State::Error;
+            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
         }
-    }
 
+        auto filter_or_error = PNG::filter_type(current_scanline[0]);
+        if (filter_or_error.is_error()) {
+            context.state = PNGLoadingContext::State::Error;
+            return filter_or_error.release_error();
+        }
+
+        auto scanline_data = current_scanline.slice(1);
+        PNGImageDecoderPlugin::unfilter_scanline(filter_or_error.value(), scanline_data, previous_scanline.slice(1), bytes_per_complete_pixel);
+        TRY(on_scanline(y, scanline_data));
+
+        swap(previous_scanline, current_scanline);
+    }
     return {};
 }
 
@@ -696,36 +765,75 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<NonnullRefPtr<Bitmap>> create_bitmap_for_decoding(PNGLoadingContext const& context, int width, int height)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
+    if (!context.allow_truncated_image_data)
+        return Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { width, height });
 
-    for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    // Parts of the image that we don't have the data for yet are shown as transparent.
+    auto bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, { width, height }));
+    bitmap->fill(Color::Transparent);
+    return bitmap;
+}
 
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Stream& stream)
+{
+    context.bitmap = TRY(create_bitmap_for_decoding(context, context.width, context.height));
+    return decode_scanlines(context, stream, context.width, context.height, [&](int y, ReadonlyBytes scanline) {
+        return unpack_scanline(context, scanline, context.width, context.bitmap->scanline(y));
+    });
+}
+
+// Averages each reduction_factor x reduction_factor box of pixels as the scanlines come in,
+// so that the full-size image never has to be allocated.
+static ErrorOr<void> decode_png_bitmap_downscaled(PNGLoadingContext& context, Stream& stream)
+{
+    int const factor = context.reduction_factor;
+    int const width = ceil_div(context.width, factor);
+    context.bitmap = TRY(create_bitmap_for_decoding(context, width, ceil_div(context.height, factor)));
+
+    Vector<ARGB32> scanline_pixels;
+    TRY(scanline_pixels.try_resize(context.width));
+
+    // The color channels are weighted by alpha, so that the color of transparent pixels doesn't bleed into their neighbors.
+    struct BoxSum {
+        u32 red { 0 };
+        u32 green { 0 };
+        u32 blue { 0 };
+        u32 alpha { 0 };
+        u32 pixel_count { 0 };
+    };
+    Vector<BoxSum> box_sums;
+    TRY(box_sums.try_resize(width));
+
+    return decode_scanlines(context, stream, context.width, context.height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, context.width, scanline_pixels.data()));
+        for (int x = 0; x < context.width; ++x) {
+            auto const color = Color::from_argb(scanline_pixels[x]);
+            auto& sum = box_sums[x / factor];
+            sum.red += color.red() * color.alpha();
+            sum.green += color.green() * color.alpha();
+            sum.blue += color.blue() * color.alpha();
+            sum.alpha += color.alpha();
+            ++sum.pixel_count;
         }
 
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+        if ((y + 1) % factor != 0 && y + 1 != context.height)
+            return {};
 
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+        auto* destination = context.bitmap->scanline(y / factor);
+        for (int x = 0; x < width; ++x) {
+            auto& sum = box_sums[x];
+            if (sum.alpha == 0) {
+                destination[x] = Color(Color::Transparent).value();
+            } else {
+                auto const rounding = sum.alpha / 2;
+                destination[x] = Color((sum.red + rounding) / sum.alpha, (sum.green + rounding) / sum.alpha, (sum.blue + rounding) / sum.alpha, sum.alpha / sum.pixel_count).value();
+            }
+            sum = {};
         }
-    }
-
-    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+        return {};
+    });
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -778,56 +886,70 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Stream& stream, int pass, Vector<ARGB32>& pass_scanline)
 {
-    auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
+    auto pass_width = adam7_width(context, pass);
+    auto pass_height = adam7_height(context, pass);
 
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!pass_width || !pass_height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    TRY(pass_scanline.try_resize(pass_width));
 
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+    // Scatter each scanline of the pass into the main image according to the pass pattern
+    return decode_scanlines(context, stream, pass_width, pass_height, [&](int y, ReadonlyBytes scanline) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline, pass_width, pass_scanline.data()));
 
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
+        int dy = adam7_starty[pass] + y * adam7_stepy[pass];
+        if (dy >= context.height)
+            return {};
+        // With a reduction factor, only passes with pixels on multiples of the factor are decoded, see decode_png_adam7().
+        auto* destination = context.bitmap->scanline(dy / context.reduction_factor);
+        for (int x = 0, dx = adam7_startx[pass]; x < pass_width && dx < context.width; ++x, dx += adam7_stepx[pass])
+            destination[dx / context.reduction_factor] = pass_scanline[x];
+        return {};
+    });
+}
 
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+static int adam7_last_pass_for_reduction_factor(int reduction_factor)
+{
+    // Pass 1 holds every 8th pixel in both directions, passes 1 to 3 every 4th and passes 1 to 5 every other one.
+    switch (reduction_factor) {
+    case 1:
+        return 7;
+    case 2:
+        return 5;
+    case 4:
+        return 3;
+    case 8:
+        return 1;
+    default:
+        VERIFY_NOT_REACHED();
     }
+}
 
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
-
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
-        }
+// Like browsers, we still show an image whose data doesn't match its checksum, since the pixels are usually fine.
+// The checksum follows the last scanline, so the rest of the zlib stream has to be read before it's known.
+static void check_image_data_checksum(Compress::ZlibDecompressor& decompressor)
+{
+    Array<u8, 256> trailing_data;
+    while (!decompressor.is_eof()) {
+        if (decompressor.read_some(trailing_data).is_error())
+            return;
     }
-    return {};
+    if (decompressor.checksum_matches() == false)
+        dbgln_if(PNG_DEBUG, "PNGImageDecoderPlugin: Image data doesn't match its Adler-32 checksum");
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Stream& stream)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+    auto const factor = context.reduction_factor;
+    context.bitmap = TRY(create_bitmap_for_decoding(context, ceil_div(context.width, factor), ceil_div(context.height, factor)));
+    Vector<ARGB32> pass_scanline;
+    auto const last_pass = adam7_last_pass_for_reduction_factor(factor);
+    for (int pass = 1; pass <= last_pass && !context.image_data_was_truncated; ++pass)
+        TRY(decode_adam7_pass(context, stream, pass, pass_scanline));
     return {};
 }
 
@@ -845,33 +967,43 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
     auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
-    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
+    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream), Compress::ZlibDecompressor::VerifyChecksum::Yes);
     if (decompressor_or_error.is_error()) {
         context.state = PNGLoadingContext::State::Error;
         return decompressor_or_error.release_error();
     }
     auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
-    }
-    auto decompression_buffer = result_or_error.release_value();
-    context.compressed_data.clear();
 
-    context.scanlines.ensure_capacity(context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
+        if (context.reduction_factor > 1)
+            TRY(decode_png_bitmap_downscaled(context, *decompressor));
+        else
+            TRY(decode_png_bitmap_simple(context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
+        TRY(decode_png_adam7(context, *decompressor));
         break;
     default:
         context.state = PNGLoadingContext::State::Error;
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
 
+    // A reduced-size interlaced image skips the last passes, so its checksum can't be checked without inflating them anyway.
+    bool const decoded_all_image_data = context.interlace_method == PngInterlaceMethod::Null || context.reduction_factor == 1;
+    if (decoded_all_image_data && !context.image_data_was_truncated)
+        check_image_data_checksum(*decompressor);
+
+    // A reduced-size bitmap may have to be replaced by the full one later on, so keep the data around for that.
+    if (context.reduction_factor == 1)
+        context.compressed_data.clear();
+
+    // The image is incomplete, so hand out what we have this time, but don't pretend that decoding succeeded.
+    if (context.image_data_was_truncated) {
+        context.state = PNGLoadingContext::State::Error;
+        return {};
+    }
+
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
 }
@@ -887,21 +1019,20 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
     auto frame_context = context.create_subimage_context(frame_rect.width(), frame_rect.height());
 
     auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
-    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
+    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream), Compress::ZlibDecompressor::VerifyChecksum::Yes));
 
-    frame_context.scanlines.ensure_capacity(frame_context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
+        TRY(decode_png_bitmap_simple(frame_context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
+        TRY(decode_png_adam7(frame_context, *decompressor));
         break;
     default:
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
+    if (!frame_context.image_data_was_truncated)
+        check_image_data_checksum(*decompressor);
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return move(frame_context.bitmap);
@@ -1203,6 +1334,11 @@ static ErrorOr<void> process_chunk(Streamer& streamer, PNGLoadingContext& contex
     }
     ReadonlyBytes chunk_data;
     if (!streamer.wrap_bytes(chunk_data, chunk_size)) {
+        // When decoding a partially received image, whatever part of the image data has arrived so far is still useful.
+        if (context.allow_truncated_image_data && chunk_type == "IDAT"sv && context.state >= PNGLoadingContext::IHDRDecoded) {
+            (void)streamer.wrap_bytes(chunk_data, streamer.size_remaining());
+            return process_IDAT(chunk_data, context);
+        }
         dbgln_if(PNG_DEBUG, "Bail at chunk_data");
         return Error::from_string_literal("Error while reading from Streamer");
     }
@@ -1380,7 +1516,7 @@ static ErrorOr<RefPtr<Bitmap>> render_animation_frame(AnimationFrame const& prev
     return rendered_bitmap;
 }
 
-ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (m_context->state == PNGLoadingContext::State::Error)
         return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
@@ -1393,9 +1529,14 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
         if (descriptor.duration < 0)
             descriptor.duration = NumericLimits<int>::min();
     };
-    auto load_default_image = [&]() -> ErrorOr<void> {
+    auto load_default_image = [&](int reduction_factor = 1) -> ErrorOr<void> {
+        // Only a smaller version of the image was decoded so far, so decode it again.
+        if (m_context->state == PNGLoadingContext::State::BitmapDecoded && m_context->reduction_factor > reduction_factor)
+            m_context->state = PNGLoadingContext::State::ChunksDecoded;
+
         if (m_context->state < PNGLoadingContext::State::BitmapDecoded) {
             // NOTE: This forces the chunk decoding to happen.
+            m_context->reduction_factor = reduction_factor;
             TRY(decode_png_bitmap(*m_context));
         }
 
@@ -1404,7 +1545,8 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     };
 
     if (index == 0) {
-        TRY(load_default_image());
+        // Animation frames are composited onto the default image at full size, so only still images are shrunk.
+        TRY(load_default_image(m_context->has_seen_actl_chunk_before_idat ? 1 : reduction_factor_for_ideal_size(size(), ideal_size)));
 
         ImageFrameDescriptor descriptor { m_context->bitmap };
         if (m_context->has_seen_actl_chunk_before_idat && m_context->is_first_idat_part_of_animation)
@@ -1450,6 +1592,33 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     return descriptor;
 }
 
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::partial_frame(size_t index)
+{
+    if (index != 0)
+        return frame(index);
+
+    if (m_context->state == PNGLoadingContext::State::Error) {
+        // We've already given out everything that could be decoded from the truncated data.
+        if (m_context->image_data_was_truncated)
+            return ImageFrameDescriptor { m_context->bitmap };
+
+        // frame() gave up on the truncated data, so start over and accept it this time.
+        auto const* data = m_context->data;
+        auto data_size = m_context->data_size;
+        m_context = make<PNGLoadingContext>();
+        m_context->data = m_context->data_current_ptr = data;
+        m_context->data_size = data_size;
+        if (!decode_png_header(*m_context))
+            return Error::from_string_literal("Invalid header for a PNG file");
+        TRY(decode_png_ihdr(*m_context));
+    }
+
+    m_context->allow_truncated_image_data = true;
+    auto descriptor = frame(index);
+    m_context->allow_truncated_image_data = false;
+    return descriptor;
+}
+
 Optional<Metadata const&> PNGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
@@ -56,12 +56,24 @@ ALWAYS_INLINE u8 paeth_predictor(u8 a, u8 b, u8 c)
 
 ALWAYS_INLINE AK::SIMD::u8x4 paeth_predictor(AK::SIMD::u8x4 a, AK::SIMD::u8x4 b, AK::SIMD::u8x4 c)
 {
-    return AK::SIMD::u8x4 {
-        paeth_predictor(a[0], b[0], c[0]),
-        paeth_predictor(a[1], b[1], c[1]),
-        paeth_predictor(a[2], b[2], c[2]),
-        paeth_predictor(a[3], b[3], c[3]),
+    // Branchless version of the above, using p - a = b - c, p - b = a - c and p - c = a + b - 2c.
+    using AK::SIMD::i16x4;
+    auto abs = [](i16x4 value) {
+        auto sign = value >> 15;
+        return (value ^ sign) - sign;
     };
+
+    auto wide_a = __builtin_convertvector(a, i16x4);
+    auto wide_b = __builtin_convertvector(b, i16x4);
+    auto wide_c = __builtin_convertvector(c, i16x4);
+    auto pa = abs(wide_b - wide_c);
+    auto pb = abs(wide_a - wide_c);
+    auto pc = abs(wide_a + wide_b - wide_c - wide_c);
+
+    i16x4 use_a = (pa <= pb) & (pa <= pc);
+    i16x4 use_b = ~use_a & (pb <= pc);
+    i16x4 use_c = ~(use_a | use_b);
+    return __builtin_convertvector((wide_a & use_a) | (wide_b & use_b) | (wide_c & use_c), AK::SIMD::u8x4);
 }
 
 };
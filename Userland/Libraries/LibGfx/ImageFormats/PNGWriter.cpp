@@ -10,10 +10,13 @@
 #include <AK/FixedArray.h>
 #include <AK/SIMDExtras.h>
 #include <AK/String.h>
+#include <LibCompress/Deflate.h>
 #include <LibCompress/Zlib.h>
+#include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibThreading/ThreadPool.h>
 
 #pragma GCC diagnostic ignored "-Wpsabi"
 
@@ -33,7 +36,7 @@ public:
 
     ErrorOr<void> add_u8(u8);
 
-    ErrorOr<void> compress_and_add(ReadonlyBytes);
+    ErrorOr<void> compress_and_add(ReadonlyBytes, Compress::ZlibCompressionLevel = Compress::ZlibCompressionLevel::Best, size_t thread_count = 1);
     ErrorOr<void> add(ReadonlyBytes);
 
     ErrorOr<void> store_type();
@@ -73,9 +76,49 @@ u32 PNGChunk::crc()
     return crc;
 }
 
-ErrorOr<void> PNGChunk::compress_and_add(ReadonlyBytes uncompressed_bytes)
+// Every piece is compressed on its own, so matches can't reach back into the previous piece.
+// Keep the pieces large enough for that not to hurt the compression ratio much.
+static constexpr size_t min_compression_piece_size = 256 * KiB;
+
+static ErrorOr<ByteBuffer> compress_in_parallel(ReadonlyBytes uncompressed_bytes, Compress::ZlibCompressionLevel compression_level, size_t thread_count)
+{
+    auto piece_count = min(thread_count, uncompressed_bytes.size() / min_compression_piece_size);
+    if (piece_count <= 1)
+        return Compress::ZlibCompressor::compress_all(uncompressed_bytes, compression_level);
+
+    auto piece_size = ceil_div(uncompressed_bytes.size(), piece_count);
+    Vector<Optional<ErrorOr<ByteBuffer>>> compressed_pieces;
+    TRY(compressed_pieces.try_resize(piece_count));
+
+    // NOTE: This is the same mapping that ZlibCompressor uses.
+    auto deflate_compression_level = static_cast<Compress::DeflateCompressor::CompressionLevel>(compression_level);
+
+    {
+        Threading::ThreadPool<size_t> thread_pool {
+            [&](size_t index) {
+                auto offset = index * piece_size;
+                auto piece = uncompressed_bytes.slice(offset, min(piece_size, uncompressed_bytes.size() - offset));
+                auto end_of_stream = index == piece_count - 1 ? Compress::DeflateCompressor::EndOfStream::Yes : Compress::DeflateCompressor::EndOfStream::No;
+                compressed_pieces[index] = Compress::DeflateCompressor::compress_all(piece, deflate_compression_level, end_of_stream);
+            },
+            piece_count
+        };
+        for (size_t i = 0; i < piece_count; ++i)
+            thread_pool.submit(i);
+        thread_pool.wait_for_all();
+    }
+
+    ByteBuffer deflate_data;
+    for (auto& compressed_piece : compressed_pieces)
+        TRY(deflate_data.try_append(TRY(compressed_piece.release_value())));
+
+    auto adler32_checksum = Crypto::Checksum::Adler32(uncompressed_bytes).digest();
+    return Compress::ZlibCompressor::wrap_deflate_data(deflate_data, adler32_checksum, compression_level);
+}
+
+ErrorOr<void> PNGChunk::compress_and_add(ReadonlyBytes uncompressed_bytes, Compress::ZlibCompressionLevel compression_level, size_t thread_count)
 {
-    return add(TRY(Compress::ZlibCompressor::compress_all(uncompressed_bytes, Compress::ZlibCompressionLevel::Best)));
+    return add(TRY(compress_in_parallel(uncompressed_bytes, compression_level, thread_count)));
 }
 
 ErrorOr<void> PNGChunk::add(ReadonlyBytes bytes)
@@ -167,7 +210,46 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
-ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap)
+static Compress::ZlibCompressionLevel zlib_compression_level(PNGWriterOptions::CompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case PNGWriterOptions::CompressionLevel::None:
+        return Compress::ZlibCompressionLevel::Fastest; // This only stores the data.
+    case PNGWriterOptions::CompressionLevel::Fast:
+        return Compress::ZlibCompressionLevel::Fast;
+    case PNGWriterOptions::CompressionLevel::Default:
+        return Compress::ZlibCompressionLevel::Default;
+    case PNGWriterOptions::CompressionLevel::Best:
+        return Compress::ZlibCompressionLevel::Best;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Filters a scanline with a single filter type, instead of trying all of them to find the best one.
+static ErrorOr<void> append_scanline_with_filter(ByteBuffer& output, PNG::FilterType filter_type, Pixel const* scanline, Pixel const* scanline_minus_1, int width)
+{
+    VERIFY(filter_type == PNG::FilterType::None || filter_type == PNG::FilterType::Paeth);
+
+    TRY(output.try_append(to_underlying(filter_type)));
+    auto filtered_bytes = TRY(output.get_bytes_for_writing(width * sizeof(Pixel)));
+
+    AK::SIMD::u8x4 pixel_x_minus_1 {};
+    AK::SIMD::u8x4 pixel_xy_minus_1 {};
+    for (int x = 0; x < width; ++x) {
+        auto pixel = Pixel::gfx_to_png(scanline[x]);
+        auto filtered_pixel = pixel;
+        if (filter_type == PNG::FilterType::Paeth) {
+            auto pixel_y_minus_1 = Pixel::gfx_to_png(scanline_minus_1[x]);
+            filtered_pixel = pixel - PNG::paeth_predictor(pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1);
+            pixel_xy_minus_1 = pixel_y_minus_1;
+        }
+        __builtin_memcpy(filtered_bytes.offset_pointer(x * sizeof(Pixel)), &filtered_pixel, sizeof(Pixel));
+        pixel_x_minus_1 = pixel;
+    }
+    return {};
+}
+
+ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap, Options const& options)
 {
     PNGChunk png_chunk { "IDAT"_string };
     TRY(png_chunk.reserve(bitmap.size_in_bytes()));
@@ -181,6 +263,13 @@ ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap)
     for (int y = 0; y < bitmap.height(); ++y) {
         auto* scanline = reinterpret_cast<Pixel const*>(bitmap.scanline(y));
 
+        if (options.compression_level == Options::CompressionLevel::None || options.compression_level == Options::CompressionLevel::Fast) {
+            auto filter_type = options.compression_level == Options::CompressionLevel::None ? PNG::FilterType::None : PNG::FilterType::Paeth;
+            TRY(append_scanline_with_filter(uncompressed_block_data, filter_type, scanline, scanline_minus_1, bitmap.width()));
+            scanline_minus_1 = scanline;
+            continue;
+        }
+
         struct Filter {
             PNG::FilterType type;
             ByteBuffer buffer {};
@@ -264,7 +353,7 @@ ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap)
         TRY(uncompressed_block_data.try_append(best_filter.buffer));
     }
 
-    TRY(png_chunk.compress_and_add(uncompressed_block_data));
+    TRY(png_chunk.compress_and_add(uncompressed_block_data, zlib_compression_level(options.compression_level), options.compression_thread_count));
     TRY(add_chunk(png_chunk));
     return {};
 }
@@ -276,7 +365,7 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
     TRY(writer.add_IHDR_chunk(bitmap.width(), bitmap.height(), 8, PNG::ColorType::TruecolorWithAlpha, 0, 0, 0));
     if (options.icc_data.has_value())
         TRY(writer.add_iCCP_chunk(options.icc_data.value()));
-    TRY(writer.add_IDAT_chunk(bitmap));
+    TRY(writer.add_IDAT_chunk(bitmap, options));
     TRY(writer.add_IEND_chunk());
     return ByteBuffer::copy(writer.m_data);
 }
@@ -18,9 +18,25 @@ class PNGChunk;
 
 // This is not a nested struct to work around https://llvm.org/PR36684
 struct PNGWriterOptions {
+    enum class CompressionLevel {
+        // Store the image data without filtering or compressing it. This is by far the fastest, but produces huge files.
+        None,
+        // Filter every scanline with the Paeth predictor, and compress with Deflate's fastest settings.
+        Fast,
+        // Pick the best filter for every scanline, and compress with Deflate's default settings.
+        Default,
+        // Pick the best filter for every scanline, and compress as well as we can. This is the slowest.
+        Best,
+    };
+    CompressionLevel compression_level { CompressionLevel::Best };
+
+    // The image data is split into this many pieces, which are compressed on separate threads. This makes large images
+    // much faster to encode at the cost of slightly larger files. Small images are always compressed on a single thread.
+    size_t compression_thread_count { 1 };
+
     // Data for the iCCP chunk.
     // FIXME: Allow writing cICP, sRGB, or gAMA instead too.
-    Optional<ReadonlyBytes> icc_data;
+    Optional<ReadonlyBytes> icc_data {};
 };
 
 class PNGWriter {
@@ -37,7 +53,7 @@ private:
     ErrorOr<void> add_png_header();
     ErrorOr<void> add_IHDR_chunk(u32 width, u32 height, u8 bit_depth, PNG::ColorType color_type, u8 compression_method, u8 filter_method, u8 interlace_method);
     ErrorOr<void> add_iCCP_chunk(ReadonlyBytes icc_data);
-    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&);
+    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&, Options const&);
     ErrorOr<void> add_IEND_chunk();
 };
 
@@ -1369,20 +1369,87 @@ FLATTEN void Painter::draw_glyph(FloatPoint point, u32 code_point, Font const& f
     if (glyph.is_glyph_bitmap()) {
         draw_bitmap(top_left.to_type<int>(), glyph.glyph_bitmap(), color);
     } else if (glyph.is_color_bitmap()) {
+        auto bitmap_rect = glyph.bitmap_rect();
         float scaled_width = glyph.advance();
-        float ratio = static_cast<float>(glyph.bitmap()->height()) / static_cast<float>(glyph.bitmap()->width());
+        float ratio = static_cast<float>(bitmap_rect.height()) / static_cast<float>(bitmap_rect.width());
         float scaled_height = scaled_width * ratio;
 
         FloatRect rect(point.x(), point.y(), scaled_width, scaled_height);
-        draw_scaled_bitmap(rect.to_rounded<int>(), *glyph.bitmap(), glyph.bitmap()->rect(), 1.0f, ScalingMode::BilinearBlend);
-    } else if (color.alpha() != 255) {
-        blit_filtered(glyph_position.blit_position, *glyph.bitmap(), glyph.bitmap()->rect(), [color](Color pixel) -> Color {
-            return pixel.multiply(color);
-        });
-    } else {
-        blit_filtered(glyph_position.blit_position, *glyph.bitmap(), glyph.bitmap()->rect(), [color](Color pixel) -> Color {
-            return color.with_alpha(pixel.alpha());
-        });
+        draw_scaled_bitmap(rect.to_rounded<int>(), *glyph.bitmap(), bitmap_rect, 1.0f, ScalingMode::BilinearBlend);
+    } else if (glyph.bitmap()) {
+        blit_glyph_mask(glyph_position.blit_position, *glyph.bitmap(), glyph.bitmap_rect(), color);
+    }
+}
+
+void Painter::blit_glyph_mask(IntPoint position, Gfx::Bitmap const& source, IntRect const& src_rect, Color color)
+{
+    if (scale() != 1 || source.scale() != 1) {
+        if (color.alpha() != 255) {
+            blit_filtered(position, source, src_rect, [color](Color pixel) -> Color {
+                return pixel.multiply(color);
+            });
+        } else {
+            blit_filtered(position, source, src_rect, [color](Color pixel) -> Color {
+                return color.with_alpha(pixel.alpha());
+            });
+        }
+        return;
+    }
+
+    // Glyph masks are the hottest blit in text-heavy content, so avoid going through
+    // blit_filtered()'s per-pixel Function call when no scaling is involved.
+    auto safe_src_rect = src_rect.intersected(source.rect());
+    auto dst_rect = IntRect(position, safe_src_rect.size()).translated(translation());
+    auto clipped_rect = dst_rect.intersected(clip_rect());
+    if (clipped_rect.is_empty())
+        return;
+
+    int const first_row = clipped_rect.top() - dst_rect.top();
+    int const first_column = clipped_rect.left() - dst_rect.left();
+    auto const src_format = source.format();
+    auto const dst_format = target()->format();
+    bool const color_is_opaque = color.alpha() == 255;
+
+    for (int row = 0; row < clipped_rect.height(); ++row) {
+        auto const* src = source.scanline(safe_src_rect.top() + first_row + row) + safe_src_rect.left() + first_column;
+        auto* dst = m_target->scanline(clipped_rect.top() + row) + clipped_rect.left();
+        for (int x = 0; x < clipped_rect.width(); ++x) {
+            auto pixel = color_for_format(src_format, src[x]);
+            if (pixel.alpha() == 0)
+                continue;
+            auto glyph_color = color_is_opaque ? color.with_alpha(pixel.alpha()) : pixel.multiply(color);
+            if (glyph_color.alpha() == 255)
+                dst[x] = glyph_color.value();
+            else
+                dst[x] = color_for_format(dst_format, dst[x]).blend(glyph_color).value();
+        }
+    }
+}
+
+void Painter::draw_glyph_run(ReadonlySpan<DrawGlyphOrEmoji> glyph_run, Color color, FloatPoint translation, float scale)
+{
+    // Runs are almost always made up of a single font, so only look up the scaled
+    // font again when it actually changes.
+    Font const* last_font = nullptr;
+    RefPtr<Font const> last_scaled_font;
+    auto scaled_font_for = [&](Font const& font) -> Font const& {
+        if (scale == 1.0f)
+            return font;
+        if (&font != last_font) {
+            last_font = &font;
+            last_scaled_font = font.with_size(font.point_size() * scale);
+        }
+        return *last_scaled_font;
+    };
+
+    for (auto const& glyph_or_emoji : glyph_run) {
+        glyph_or_emoji.visit(
+            [&](DrawGlyph const& glyph) {
+                draw_glyph(glyph.position.scaled(scale).translated(translation), glyph.code_point, scaled_font_for(*glyph.font), color);
+            },
+            [&](DrawEmoji const& emoji) {
+                draw_emoji(emoji.position.scaled(scale).translated(translation).to_type<int>(), *emoji.emoji, scaled_font_for(*emoji.font));
+            });
     }
 }
 
@@ -23,6 +23,7 @@
 #include <LibGfx/TextAlignment.h>
 #include <LibGfx/TextDirection.h>
 #include <LibGfx/TextElision.h>
+#include <LibGfx/TextLayout.h>
 #include <LibGfx/TextWrapping.h>
 
 namespace Gfx {
@@ -126,6 +127,7 @@ public:
     void draw_glyph(FloatPoint, u32, Font const&, Color);
     void draw_glyph_or_emoji(FloatPoint, u32, Font const&, Color);
     void draw_glyph_or_emoji(FloatPoint, Utf8CodePointIterator&, Font const&, Color);
+    void draw_glyph_run(ReadonlySpan<DrawGlyphOrEmoji>, Color, FloatPoint translation = {}, float scale = 1.0f);
     void draw_circle_arc_intersecting(IntRect const&, IntPoint, int radius, Color, int thickness);
     void draw_signed_distance_field(IntRect const& dst_rect, Color, Gfx::GrayscaleBitmap const&, float smoothing);
 
@@ -230,6 +232,8 @@ protected:
     Vector<State, 4> m_state_stack;
 
 private:
+    void blit_glyph_mask(IntPoint, Gfx::Bitmap const&, IntRect const& src_rect, Color);
+
     Vector<DirectionalRun> split_text_into_directional_runs(Utf8View const&, TextDirection initial_direction);
     bool text_contains_bidirectional_text(Utf8View const&, TextDirection);
     template<typename DrawGlyphFunction>
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/HashFunctions.h>
+#include <AK/QuickSort.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/EdgeFlagPathRasterizer.h>
+#include <LibGfx/RasterizedPathCache.h>
+
+namespace Gfx {
+
+// Once this many distinct paths have been seen only once, we start over.
+static constexpr size_t max_seen_hash_count = 4096;
+
+RasterizedPathCache& RasterizedPathCache::the()
+{
+    static thread_local RasterizedPathCache s_the;
+    return s_the;
+}
+
+RasterizedPathCache::RasterizedPathCache(size_t max_size_in_bytes)
+    : m_max_size_in_bytes(max_size_in_bytes)
+{
+}
+
+bool RasterizedPathCache::Key::operator==(Key const& other) const
+{
+    if (hash != other.hash || winding_rule != other.winding_rule || lines.size() != other.lines.size())
+        return false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines[i].a() != other.lines[i].a() || lines[i].b() != other.lines[i].b())
+            return false;
+    }
+    return true;
+}
+
+void RasterizedPathCache::clear()
+{
+    m_entries.clear();
+    m_seen_hashes.clear();
+    m_size_in_bytes = 0;
+}
+
+ErrorOr<RasterizedPathCache::Entry> RasterizedPathCache::rasterize(Path const& path, Painter::WindingRule winding_rule, FloatPoint offset, IntRect bounding_box)
+{
+    // Rasterize with the exact same inputs as a direct fill would use, just translated by whole pixels into the mask.
+    auto bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, bounding_box.size()));
+    Painter painter { bitmap };
+    painter.translate(-bounding_box.top_left());
+    EdgeFlagPathRasterizer<32> rasterizer(enclosing_int_rect(path.bounding_box()).size());
+    rasterizer.fill(painter, path, Color::White, winding_rule, offset);
+
+    Entry entry;
+    entry.size = bounding_box.size();
+    TRY(entry.coverage.try_resize(bounding_box.width() * bounding_box.height()));
+    for (int y = 0; y < bitmap->height(); ++y) {
+        auto const* scanline = bitmap->scanline(y);
+        for (int x = 0; x < bitmap->width(); ++x)
+            entry.coverage[y * bitmap->width() + x] = scanline[x] >> 24;
+    }
+    return entry;
+}
+
+void RasterizedPathCache::evict_least_recently_used_entries()
+{
+    // Evict down to three quarters of the budget, so that we don't have to do this again for every new path.
+    Vector<Key const*> keys;
+    keys.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        keys.unchecked_append(&it.key);
+    quick_sort(keys, [&](auto const* a, auto const* b) {
+        return m_entries.get(*a)->last_used < m_entries.get(*b)->last_used;
+    });
+
+    Vector<Key> keys_to_remove;
+    for (auto const* key : keys) {
+        if (m_size_in_bytes <= m_max_size_in_bytes / 4 * 3)
+            break;
+        m_size_in_bytes -= m_entries.get(*key)->size_in_bytes;
+        keys_to_remove.append(*key);
+    }
+    for (auto const& key : keys_to_remove)
+        m_entries.remove(key);
+}
+
+static void blit_coverage(Painter& painter, Vector<u8> const& coverage, IntSize size, IntRect const& dest_rect, IntRect const& visible_rect, Color color)
+{
+    auto& target = *painter.target();
+    auto format = target.format();
+    for (int y = visible_rect.top(); y < visible_rect.bottom(); ++y) {
+        auto const* mask_row = coverage.data() + (y - dest_rect.y()) * size.width() - dest_rect.x();
+        auto* dest_row = target.scanline(y);
+        for (int x = visible_rect.left(); x < visible_rect.right(); ++x) {
+            auto alpha = mask_row[x];
+            if (!alpha)
+                continue;
+            // This matches how EdgeFlagPathRasterizer applies coverage to a color.
+            auto paint_color = color.alpha() == 255 ? color.with_alpha(alpha) : color.with_alpha(color.alpha() * alpha / 255);
+            if (paint_color.alpha() == 255)
+                dest_row[x] = paint_color.value();
+            else
+                dest_row[x] = color_for_format(format, dest_row[x]).blend(paint_color).value();
+        }
+    }
+}
+
+bool RasterizedPathCache::fill(Painter& painter, Path const& path, Color color, Painter::WindingRule winding_rule, FloatPoint offset)
+{
+    if (painter.scale() != 1)
+        return false;
+    if (!first_is_one_of(painter.target()->format(), BitmapFormat::BGRA8888, BitmapFormat::BGRx8888))
+        return false;
+
+    auto bounding_box = enclosing_int_rect(path.bounding_box().translated(offset));
+    if (bounding_box.is_empty() || bounding_box.width() > max_path_dimension || bounding_box.height() > max_path_dimension)
+        return false;
+
+    auto dest_rect = bounding_box.translated(painter.translation());
+    auto visible_rect = dest_rect.intersected(painter.clip_rect());
+    if (visible_rect.is_empty())
+        return true;
+
+    // Describe the path relative to the top left pixel of its bounds, exactly as the rasterizer sees it.
+    auto origin = bounding_box.top_left().to_type<float>() - offset;
+    auto lines = path.split_lines();
+    Key key;
+    key.winding_rule = winding_rule;
+    if (key.lines.try_ensure_capacity(lines.size()).is_error())
+        return false;
+    unsigned hash = int_hash(to_underlying(winding_rule));
+    for (auto const& line : lines) {
+        FloatLine relative_line { line.a() - origin, line.b() - origin };
+        hash = pair_int_hash(hash, pair_int_hash(bit_cast<u32>(relative_line.a().x()), bit_cast<u32>(relative_line.a().y())));
+        hash = pair_int_hash(hash, pair_int_hash(bit_cast<u32>(relative_line.b().x()), bit_cast<u32>(relative_line.b().y())));
+        key.lines.unchecked_append(relative_line);
+    }
+    key.hash = hash;
+
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        it->value.last_used = ++m_use_counter;
+        blit_coverage(painter, it->value.coverage, it->value.size, dest_rect, visible_rect, color);
+        return true;
+    }
+
+    if (m_seen_hashes.size() >= max_seen_hash_count)
+        m_seen_hashes.clear();
+    if (m_seen_hashes.set(hash) == HashSetResult::InsertedNewEntry)
+        return false;
+
+    auto entry_or_error = rasterize(path, winding_rule, offset, bounding_box);
+    if (entry_or_error.is_error())
+        return false;
+    auto entry = entry_or_error.release_value();
+    entry.last_used = ++m_use_counter;
+    entry.size_in_bytes = sizeof(Entry) + sizeof(Key) + entry.coverage.size() + key.lines.size() * sizeof(FloatLine);
+    blit_coverage(painter, entry.coverage, entry.size, dest_rect, visible_rect, color);
+
+    if (entry.size_in_bytes > m_max_size_in_bytes)
+        return true;
+    m_size_in_bytes += entry.size_in_bytes;
+    m_entries.set(move(key), move(entry));
+    if (m_size_in_bytes > m_max_size_in_bytes)
+        evict_least_recently_used_entries();
+    return true;
+}
+
+}
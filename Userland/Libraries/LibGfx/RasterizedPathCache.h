@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
+#include <AK/Vector.h>
+#include <LibGfx/Line.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
+
+namespace Gfx {
+
+// A per-thread cache of small, anti-aliased path fills, stored as coverage masks. Painting the same shape over and
+// over again (e.g. an SVG icon that is used many times on a page) then only rasterizes it once.
+// Paths are keyed by their geometry relative to the pixel grid, i.e. by their transform minus any whole-pixel
+// translation, so a cached mask is reused wherever the same shape lands on the same subpixel offset.
+class RasterizedPathCache {
+    AK_MAKE_NONCOPYABLE(RasterizedPathCache);
+    AK_MAKE_NONMOVABLE(RasterizedPathCache);
+
+public:
+    static constexpr int max_path_dimension = 256;
+    static constexpr size_t default_max_size_in_bytes = 4 * MiB;
+
+    static RasterizedPathCache& the();
+
+    explicit RasterizedPathCache(size_t max_size_in_bytes = default_max_size_in_bytes);
+
+    // Fills the path using a cached coverage mask. Paths are only cached once they have been seen twice, so
+    // one-off paths don't pay for building a mask. Returns false if the caller has to rasterize the path itself.
+    bool fill(Painter&, Path const&, Color, Painter::WindingRule, FloatPoint offset = {});
+
+    void clear();
+
+    size_t entry_count() const { return m_entries.size(); }
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+    struct Key {
+        unsigned hash { 0 };
+        Painter::WindingRule winding_rule { Painter::WindingRule::Nonzero };
+        Vector<FloatLine> lines;
+
+        bool operator==(Key const&) const;
+    };
+
+private:
+    struct Entry {
+        IntSize size;
+        Vector<u8> coverage;
+        size_t size_in_bytes { 0 };
+        u64 last_used { 0 };
+    };
+
+    ErrorOr<Entry> rasterize(Path const&, Painter::WindingRule, FloatPoint offset, IntRect bounding_box);
+    void evict_least_recently_used_entries();
+
+    size_t m_max_size_in_bytes { default_max_size_in_bytes };
+    size_t m_size_in_bytes { 0 };
+    HashMap<Key, Entry> m_entries;
+    HashTable<unsigned> m_seen_hashes;
+    u64 m_use_counter { 0 };
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Gfx::RasterizedPathCache::Key> : public DefaultTraits<Gfx::RasterizedPathCache::Key> {
+    static unsigned hash(Gfx::RasterizedPathCache::Key const& key) { return key.hash; }
+};
+
+}
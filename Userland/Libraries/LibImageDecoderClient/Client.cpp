@@ -21,11 +21,15 @@ void Client::die()
     }
     m_pending_decoded_images.clear();
 
+    for (auto& pending_frame : m_pending_animation_frames)
+        pending_frame.promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
+    m_pending_animation_frames.clear();
+
     if (on_death)
         on_death();
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, FrameDecoding frame_decoding)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -48,7 +52,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
 
-    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type);
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type, frame_decoding == FrameDecoding::OnDemand);
     if (!response) {
         dbgln("ImageDecoder disconnected trying to decode image");
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
@@ -60,7 +64,36 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale)
+NonnullRefPtr<Core::Promise<Frame>> Client::request_animation_frame(i64 image_id, u32 frame_index)
+{
+    auto promise = Core::Promise<Frame>::construct();
+    m_pending_animation_frames.append({ image_id, frame_index, promise });
+    async_request_animation_frame(image_id, frame_index);
+    return promise;
+}
+
+void Client::release_image(i64 image_id)
+{
+    m_pending_animation_frames.remove_all_matching([&](auto& pending_frame) {
+        if (pending_frame.image_id != image_id)
+            return false;
+        pending_frame.promise->reject(Error::from_string_literal("Image was released"));
+        return true;
+    });
+    async_release_image(image_id);
+}
+
+Optional<NonnullRefPtr<Core::Promise<Frame>>> Client::take_pending_animation_frame(i64 image_id, u32 frame_index)
+{
+    auto index = m_pending_animation_frames.find_first_index_if([&](auto const& pending_frame) {
+        return pending_frame.image_id == image_id && pending_frame.frame_index == frame_index;
+    });
+    if (!index.has_value())
+        return {};
+    return m_pending_animation_frames.take(*index).promise;
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale)
 {
     VERIFY(!bitmaps.is_empty());
 
@@ -72,8 +105,10 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Ve
     auto promise = maybe_promise.release_value();
 
     DecodedImage image;
+    image.image_id = image_id;
     image.is_animated = is_animated;
     image.loop_count = loop_count;
+    image.frame_count = frame_count;
     image.scale = scale;
     image.frames.ensure_capacity(bitmaps.size());
     for (size_t i = 0; i < bitmaps.size(); ++i) {
@@ -103,4 +138,35 @@ void Client::did_fail_to_decode_image(i64 image_id, String const& error_message)
     promise->reject(Error::from_string_literal("Image decoding failed or aborted"));
 }
 
+void Client::did_decode_animation_frame(i64 image_id, u32 frame_index, Gfx::ShareableBitmap const& bitmap, u32 duration)
+{
+    auto maybe_promise = take_pending_animation_frame(image_id, frame_index);
+    if (!maybe_promise.has_value()) {
+        dbgln("ImageDecoderClient: No pending frame {} of image with ID {}", frame_index, image_id);
+        return;
+    }
+    auto promise = maybe_promise.release_value();
+
+    if (!bitmap.is_valid()) {
+        dbgln("ImageDecoderClient: Invalid bitmap for frame {} of image with ID {}", frame_index, image_id);
+        promise->reject(Error::from_string_literal("Invalid bitmap"));
+        return;
+    }
+
+    promise->resolve({ *bitmap.bitmap(), duration });
+}
+
+void Client::did_fail_to_decode_animation_frame(i64 image_id, u32 frame_index, String const& error_message)
+{
+    auto maybe_promise = take_pending_animation_frame(image_id, frame_index);
+    if (!maybe_promise.has_value()) {
+        dbgln("ImageDecoderClient: No pending frame {} of image with ID {}", frame_index, image_id);
+        return;
+    }
+    auto promise = maybe_promise.release_value();
+
+    dbgln("ImageDecoderClient: Failed to decode frame {} of image with ID {}: {}", frame_index, image_id, error_message);
+    promise->reject(Error::from_string_literal("Frame decoding failed or aborted"));
+}
+
 }
@@ -20,12 +20,22 @@ struct Frame {
 };
 
 struct DecodedImage {
+    i64 image_id { 0 };
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
+    // With FrameDecoding::OnDemand, this only holds the first frame of an animated image.
     Vector<Frame> frames;
 };
 
+enum class FrameDecoding {
+    All,
+    // The other frames of an animated image are decoded when asked for with request_animation_frame(),
+    // until the image is released with release_image().
+    OnDemand,
+};
+
 class Client final
     : public IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>
     , public ImageDecoderClientEndpoint {
@@ -34,17 +44,31 @@ class Client final
 public:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, FrameDecoding = FrameDecoding::All);
+
+    NonnullRefPtr<Core::Promise<Frame>> request_animation_frame(i64 image_id, u32 frame_index);
+    void release_image(i64 image_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
     virtual void did_fail_to_decode_image(i64 image_id, String const& error_message) override;
+    virtual void did_decode_animation_frame(i64 image_id, u32 frame_index, Gfx::ShareableBitmap const& bitmap, u32 duration) override;
+    virtual void did_fail_to_decode_animation_frame(i64 image_id, u32 frame_index, String const& error_message) override;
+
+    Optional<NonnullRefPtr<Core::Promise<Frame>>> take_pending_animation_frame(i64 image_id, u32 frame_index);
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+
+    struct PendingAnimationFrame {
+        i64 image_id { 0 };
+        u32 frame_index { 0 };
+        NonnullRefPtr<Core::Promise<Frame>> promise;
+    };
+    Vector<PendingAnimationFrame> m_pending_animation_frames;
 };
 
 }
@@ -17,6 +17,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Heap/ConservativeVector.h>
 #include <LibJS/Heap/MarkedVector.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -1499,6 +1500,47 @@ void ScopeNode::add_hoisted_function(NonnullRefPtr<FunctionDeclaration const> de
     m_functions_hoistable_with_annexB_extension.append(move(declaration));
 }
 
+void ScopeNode::clear_statements_and_declarations()
+{
+    m_children.clear();
+    m_lexical_declarations.clear();
+    m_var_declarations.clear();
+    m_functions_hoistable_with_annexB_extension.clear();
+}
+
+void ScopeNode::take_statements_and_declarations_from(ScopeNode& other)
+{
+    VERIFY(m_local_variables_names == other.m_local_variables_names);
+    m_children = move(other.m_children);
+    m_lexical_declarations = move(other.m_lexical_declarations);
+    m_var_declarations = move(other.m_var_declarations);
+    m_functions_hoistable_with_annexB_extension = move(other.m_functions_hoistable_with_annexB_extension);
+}
+
+void FunctionBody::drop_contents(DroppedContents dropped_contents)
+{
+    VERIFY(!m_dropped_contents);
+    clear_statements_and_declarations();
+    m_dropped_contents = make<DroppedContents>(move(dropped_contents));
+}
+
+void FunctionBody::ensure_contents_are_parsed() const
+{
+    if (!m_dropped_contents)
+        return;
+
+    auto function_body = Parser::parse_dropped_function_body(*this);
+    auto& self = const_cast<FunctionBody&>(*this);
+    self.take_statements_and_declarations_from(const_cast<FunctionBody&>(*function_body));
+    self.m_dropped_contents = nullptr;
+}
+
+void FunctionBody::dump(int indent) const
+{
+    ensure_contents_are_parsed();
+    ScopeNode::dump(indent);
+}
+
 DeprecatedFlyString ExportStatement::local_name_for_default = "*default*";
 
 static void dump_assert_clauses(ModuleRequest const& request)
@@ -159,11 +159,12 @@ public:
     {
     }
 
+    // The bytecode is generated lazily and cached with the statement, which is otherwise immutable once parsed.
     Bytecode::Executable* bytecode_executable() const { return m_bytecode_executable; }
-    void set_bytecode_executable(Bytecode::Executable* bytecode_executable) { m_bytecode_executable = make_handle(bytecode_executable); }
+    void set_bytecode_executable(Bytecode::Executable* bytecode_executable) const { m_bytecode_executable = make_handle(bytecode_executable); }
 
 private:
-    Handle<Bytecode::Executable> m_bytecode_executable;
+    mutable Handle<Bytecode::Executable> m_bytecode_executable;
 };
 
 // 14.13 Labelled Statements, https://tc39.es/ecma262/#sec-labelled-statements
@@ -334,6 +335,11 @@ public:
         return index;
     }
 
+    // These are used to drop the statements and declarations of a function body until they are needed, see FunctionBody.
+    // The local variables stay, as they are part of the function's interface to the code around it.
+    void clear_statements_and_declarations();
+    void take_statements_and_declarations_from(ScopeNode&);
+
 protected:
     explicit ScopeNode(SourceRange source_range)
         : Statement(move(source_range))
@@ -584,8 +590,45 @@ public:
 
     bool in_strict_mode() const { return m_in_strict_mode; }
 
+    // What the parser needs to parse the functions of a program again on their own.
+    struct LazyParsingContext : public RefCounted<LazyParsingContext> {
+        ByteString source;
+        Program::Type program_type { Program::Type::Script };
+
+        // Identifiers are only resolved to global variables once the whole program has been parsed. These are the
+        // (sorted) source offsets of all identifiers that were.
+        Vector<u32> global_identifier_offsets;
+    };
+
+    // The state of the parser at the start of the function that a body with dropped contents belongs to.
+    struct ParsingState {
+        Position function_start;
+        u16 parse_options { 0 };
+        bool is_function_declaration { false };
+        bool strict_mode { false };
+        bool in_function_context { false };
+        bool in_arrow_function_context { false };
+        bool in_generator_function_context { false };
+        bool await_expression_is_valid { false };
+    };
+
+    struct DroppedContents {
+        NonnullRefPtr<LazyParsingContext const> context;
+        ParsingState state;
+    };
+
+    // Most functions of large scripts never run, so the parser drops the contents of function bodies that can be parsed
+    // again on their own once the program has been parsed. They are restored when the function is first called.
+    bool has_dropped_contents() const { return m_dropped_contents; }
+    DroppedContents const& dropped_contents() const { return *m_dropped_contents; }
+    void drop_contents(DroppedContents);
+    void ensure_contents_are_parsed() const;
+
+    virtual void dump(int indent) const override;
+
 private:
     bool m_in_strict_mode { false };
+    OwnPtr<DroppedContents> m_dropped_contents;
 };
 
 class Expression : public ASTNode {
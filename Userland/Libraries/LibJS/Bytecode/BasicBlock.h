@@ -30,6 +30,7 @@ public:
     ~BasicBlock();
 
     u32 index() const { return m_index; }
+    void set_index(u32 index) { m_index = index; }
 
     ReadonlyBytes instruction_stream() const { return m_buffer.span(); }
     u8* data() { return m_buffer.data(); }
@@ -64,6 +65,10 @@ public:
     [[nodiscard]] size_t last_instruction_start_offset() const { return m_last_instruction_start_offset; }
     void set_last_instruction_start_offset(size_t offset) { m_last_instruction_start_offset = offset; }
 
+    // NOTE: The instructions in the current stream are dropped without being destroyed, the caller is expected
+    //       to have either moved them into the new stream or destroyed them already.
+    void set_instruction_stream(Vector<u8> buffer, HashMap<size_t, SourceRecord> source_map, size_t last_instruction_start_offset, bool terminated);
+
 private:
     explicit BasicBlock(u32 index, String name);
 
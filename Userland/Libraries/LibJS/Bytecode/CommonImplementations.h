@@ -103,6 +103,57 @@ ALWAYS_INLINE ThrowCompletionOr<NonnullGCPtr<Object>> base_object_for_get(VM& vm
     return throw_null_or_undefined_property_access(vm, base_value, base_identifier, property_identifier);
 }
 
+// Returns the entry that was filled in for the given shape, either by the site itself or, if the site has become
+// megamorphic, in the interpreter-wide cache.
+inline PropertyLookupCache::Entry const* find_property_lookup_cache_entry(MegamorphicPropertyCache& megamorphic_cache, PropertyLookupCache const& cache, Shape& shape, DeprecatedFlyString const& property)
+{
+    for (auto const& entry : cache.entries) {
+        if (&shape == entry.shape)
+            return &entry;
+    }
+    if (cache.is_megamorphic) {
+        auto const& megamorphic_entry = megamorphic_cache.entry_for(shape, property);
+        if (&shape == megamorphic_entry.cached.shape && megamorphic_entry.property_name == property)
+            return &megamorphic_entry.cached;
+    }
+    return nullptr;
+}
+
+// Returns the entry that should remember the property offset for a new shape: the one for the same shape, or an
+// unused one, or one whose shape has since been garbage collected. If the site already remembers as many live shapes
+// as it can, it becomes megamorphic and the entry is taken from the interpreter-wide cache instead.
+inline PropertyLookupCache::Entry& property_lookup_cache_entry_to_fill(MegamorphicPropertyCache& megamorphic_cache, PropertyLookupCache& cache, Shape& shape, DeprecatedFlyString const& property)
+{
+    if (!cache.is_megamorphic) {
+        for (auto& entry : cache.entries) {
+            if (&shape == entry.shape)
+                return entry;
+        }
+        for (auto& entry : cache.entries) {
+            if (!entry.shape)
+                return entry;
+        }
+        cache.is_megamorphic = true;
+        for (auto& entry : cache.entries)
+            entry = {};
+    }
+    auto& megamorphic_entry = megamorphic_cache.entry_for(shape, property);
+    megamorphic_entry.property_name = property;
+    return megamorphic_entry.cached;
+}
+
+inline Optional<Value> get_from_property_lookup_cache_entry(Object const& object, PropertyLookupCache::Entry const& entry)
+{
+    if (entry.prototype) {
+        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+        if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+            return {};
+        return entry.prototype->get_direct(entry.property_offset.value());
+    }
+    // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+    return object.get_direct(entry.property_offset.value());
+}
+
 enum class GetByIdMode {
     Normal,
     Length,
@@ -113,7 +164,7 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString c
 {
     if constexpr (mode == GetByIdMode::Length) {
         if (base_value.is_string()) {
-            return Value(base_value.as_string().utf16_string().length_in_code_units());
+            return Value(base_value.as_string().length_in_utf16_code_units());
         }
     }
 
@@ -127,38 +178,31 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString c
     }
 
     auto& shape = base_obj->shape();
+    auto& megamorphic_cache = vm.bytecode_interpreter().megamorphic_get_cache();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache)
-            return cache.prototype->get_direct(cache.property_offset.value());
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        return base_obj->get_direct(cache.property_offset.value());
+    if (auto const* entry = find_property_lookup_cache_entry(megamorphic_cache, cache, shape, property)) {
+        if (auto value = get_from_property_lookup_cache_entry(*base_obj, *entry); value.has_value()) {
+            ++cache.hit_count;
+            return value.release_value();
+        }
     }
+    ++cache.miss_count;
 
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(property, this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        auto& entry = property_lookup_cache_entry_to_fill(megamorphic_cache, cache, shape, property);
+        entry = {};
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        auto& entry = property_lookup_cache_entry_to_fill(megamorphic_cache, cache, base_obj->shape(), property);
+        entry = {};
+        entry.shape = &base_obj->shape();
+        entry.property_offset = cacheable_metadata.property_offset.value();
+        entry.prototype = *cacheable_metadata.prototype;
+        entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
     }
 
     return value;
@@ -245,17 +289,25 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     auto& binding_object = interpreter.global_object();
     auto& declarative_record = interpreter.global_declarative_environment();
 
+    auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
+    auto& megamorphic_cache = interpreter.megamorphic_global_cache(declarative_record);
+
     // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
     auto& shape = binding_object.shape();
-    if (cache.environment_serial_number == declarative_record.environment_serial_number()
-        && &shape == cache.shape) {
-        return binding_object.get_direct(cache.property_offset.value());
+    if (cache.environment_serial_number == declarative_record.environment_serial_number()) {
+        if (auto const* entry = find_property_lookup_cache_entry(megamorphic_cache, cache, shape, identifier)) {
+            ++cache.hit_count;
+            return binding_object.get_direct(entry->property_offset.value());
+        }
+    } else {
+        // A new declarative binding may shadow what we've cached, so start over.
+        for (auto& entry : cache.entries)
+            entry = {};
     }
+    ++cache.miss_count;
 
     cache.environment_serial_number = declarative_record.environment_serial_number();
 
-    auto& identifier = interpreter.current_executable().get_identifier(identifier_index);
-
     if (vm.running_execution_context().script_or_module.has<NonnullGCPtr<Module>>()) {
         // NOTE: GetGlobal is used to access variables stored in the module environment and global environment.
         //       The module environment is checked first since it precedes the global environment in the environment chain.
@@ -275,8 +327,10 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
         CacheablePropertyMetadata cacheable_metadata;
         auto value = TRY(binding_object.internal_get(identifier, js_undefined(), &cacheable_metadata));
         if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache.shape = shape;
-            cache.property_offset = cacheable_metadata.property_offset.value();
+            auto& entry = property_lookup_cache_entry_to_fill(megamorphic_cache, cache, shape, identifier);
+            entry = {};
+            entry.shape = shape;
+            entry.property_offset = cacheable_metadata.property_offset.value();
         }
         return value;
     }
@@ -316,17 +370,28 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        // NOTE: Sites that access properties by identifier always have a string key, anything else isn't cached.
+        if (!name.is_string())
+            cache = nullptr;
+        auto& megamorphic_cache = vm.bytecode_interpreter().megamorphic_put_cache();
+
+        if (cache) {
+            if (auto const* entry = find_property_lookup_cache_entry(megamorphic_cache, *cache, object->shape(), name.as_string())) {
+                ++cache->hit_count;
+                object->put_direct(*entry->property_offset, value);
+                return {};
+            }
+            ++cache->miss_count;
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            auto& entry = property_lookup_cache_entry_to_fill(megamorphic_cache, *cache, object->shape(), name.as_string());
+            entry = {};
+            entry.shape = object->shape();
+            entry.property_offset = cacheable_metadata.property_offset.value();
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -7,7 +7,9 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -83,6 +85,68 @@ void Executable::dump() const
     warnln("");
 }
 
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    Vector<ByteString> lines;
+    auto add_line = [&](size_t offset, Instruction const& instruction, PropertyLookupCache const& cache) {
+        if (!cache.hit_count && !cache.miss_count)
+            return;
+        ByteString state;
+        if (cache.is_megamorphic) {
+            state = "megamorphic"sv;
+        } else {
+            size_t number_of_shapes = 0;
+            for (auto const& entry : cache.entries) {
+                if (entry.shape)
+                    ++number_of_shapes;
+            }
+            state = ByteString::formatted("{} shape(s)", number_of_shapes);
+        }
+        lines.append(ByteString::formatted("[{:4x}] {:8} hits {:8} misses  {:14}  {}", offset, cache.hit_count, cache.miss_count, state, instruction.to_byte_string(*this)));
+    };
+
+    InstructionStreamIterator it(bytecode, this);
+    while (!it.at_end()) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#define __CACHED_PROPERTY_ACCESS_OP(op)                                                                                    \
+    case Instruction::Type::op:                                                                                            \
+        add_line(it.offset(), instruction, property_lookup_caches[static_cast<Op::op const&>(instruction).cache_index()]); \
+        break;
+            __CACHED_PROPERTY_ACCESS_OP(GetById)
+            __CACHED_PROPERTY_ACCESS_OP(GetByIdWithThis)
+            __CACHED_PROPERTY_ACCESS_OP(GetLength)
+            __CACHED_PROPERTY_ACCESS_OP(GetLengthWithThis)
+            __CACHED_PROPERTY_ACCESS_OP(PutById)
+            __CACHED_PROPERTY_ACCESS_OP(PutByIdWithThis)
+#undef __CACHED_PROPERTY_ACCESS_OP
+        case Instruction::Type::GetGlobal:
+            add_line(it.offset(), instruction, global_variable_caches[static_cast<Op::GetGlobal const&>(instruction).cache_index()]);
+            break;
+        default:
+            break;
+        }
+        ++it;
+    }
+
+    if (lines.is_empty())
+        return;
+    warnln("\033[37;1mProperty lookup caches\033[0m \"{}\"", name);
+    for (auto const& line : lines)
+        warnln("{}", line);
+    warnln("");
+}
+
+void Executable::for_each_live_executable(Function<void(Executable const&)> callback)
+{
+    cell_allocator.allocator->for_each_block([&](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            callback(static_cast<Executable const&>(*cell));
+        });
+        return IterationDecision::Continue;
+    });
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -98,6 +162,18 @@ Optional<Executable::ExceptionHandlers const&> Executable::exception_handlers_fo
     return {};
 }
 
+size_t Executable::size_in_bytes() const
+{
+    return sizeof(Executable)
+        + bytecode.size()
+        + property_lookup_caches.size() * sizeof(PropertyLookupCache)
+        + global_variable_caches.size() * sizeof(GlobalVariableCache)
+        + constants.size() * sizeof(Value)
+        + exception_handlers.size() * sizeof(ExceptionHandlers)
+        + basic_block_start_offsets.size() * sizeof(size_t)
+        + source_map.size() * (sizeof(size_t) + sizeof(SourceRecord));
+}
+
 UnrealizedSourceRange Executable::source_range_at(size_t offset) const
 {
     if (offset >= bytecode.size())
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -22,17 +23,56 @@
 
 namespace JS::Bytecode {
 
+// An inline cache for a single property access site. It remembers the property offsets for up to
+// max_number_of_shapes different shapes. Once a site has seen more shapes than that, it becomes megamorphic
+// and falls back to the interpreter-wide MegamorphicPropertyCache instead.
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    AK::Array<Entry, max_number_of_shapes> entries;
+    bool is_megamorphic { false };
+
+    u32 hit_count { 0 };
+    u32 miss_count { 0 };
 };
 
 struct GlobalVariableCache : public PropertyLookupCache {
     u64 environment_serial_number { 0 };
 };
 
+// A shape and property name keyed cache shared by all megamorphic property access sites.
+// Each (shape, name) pair maps to a single slot, and a new pair simply replaces whatever was there before.
+class MegamorphicPropertyCache {
+public:
+    static constexpr size_t number_of_entries = 1024;
+
+    struct Entry {
+        DeprecatedFlyString property_name;
+        PropertyLookupCache::Entry cached;
+    };
+
+    Entry& entry_for(Shape const& shape, DeprecatedFlyString const& property_name)
+    {
+        return m_entries[pair_int_hash(ptr_hash(&shape), property_name.hash()) % number_of_entries];
+    }
+
+    void clear()
+    {
+        for (auto& entry : m_entries)
+            entry = {};
+    }
+
+private:
+    AK::Array<Entry, number_of_entries> m_entries;
+};
+
 struct SourceRecord {
     u32 source_start_offset {};
     u32 source_end_offset {};
@@ -99,7 +139,13 @@ public:
 
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
+    // The memory taken up by the bytecode and its tables, not counting the strings they refer to.
+    [[nodiscard]] size_t size_in_bytes() const;
+
     void dump() const;
+    void dump_property_lookup_cache_statistics() const;
+
+    static void for_each_live_executable(Function<void(Executable const&)>);
 
 private:
     virtual void visit_edges(Visitor&) override;
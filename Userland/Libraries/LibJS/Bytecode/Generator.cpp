@@ -10,7 +10,9 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
@@ -251,6 +253,13 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     else if (is<FunctionDeclaration>(node))
         is_strict_mode = static_cast<FunctionDeclaration const&>(node).is_strict_mode();
 
+    if (g_optimize_bytecode) {
+        PassManager pass_manager(generator);
+        pass_manager.run();
+        if (g_dump_bytecode)
+            pass_manager.dump_statistics();
+    }
+
     size_t size_needed = 0;
     for (auto& block : generator.m_root_basic_blocks) {
         size_needed += block->size();
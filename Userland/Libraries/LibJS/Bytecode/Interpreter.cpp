@@ -38,6 +38,7 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_optimize_bytecode = true;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -229,7 +230,15 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
+        // NOTE: The parse node may be shared with other scripts of the same source text (see ProgramCache), so the
+        //       bytecode is kept with it, just like the bytecode of functions.
+        auto executable_result = [&]() -> Bytecode::CodeGenerationErrorOr<NonnullGCPtr<Executable>> {
+            if (auto* executable = script.bytecode_executable())
+                return NonnullGCPtr { *executable };
+            auto executable = TRY(JS::Bytecode::Generator::generate_from_ast_node(vm, script, {}));
+            script.set_bytecode_executable(executable.ptr());
+            return executable;
+        }();
 
         if (executable_result.is_error()) {
             if (auto error_string = executable_result.error().to_string(); error_string.is_error())
@@ -808,6 +817,17 @@ void Interpreter::enter_object_environment(Object& object)
     running_execution_context().lexical_environment = new_object_environment(object, true, old_environment);
 }
 
+MegamorphicPropertyCache& Interpreter::megamorphic_global_cache(DeclarativeEnvironment const& global_declarative_environment)
+{
+    auto environment_serial_number = global_declarative_environment.environment_serial_number();
+    if (m_megamorphic_global_cache_environment != &global_declarative_environment || m_megamorphic_global_cache_environment_serial_number != environment_serial_number) {
+        m_megamorphic_global_cache.clear();
+        m_megamorphic_global_cache_environment = &global_declarative_environment;
+        m_megamorphic_global_cache_environment_serial_number = environment_serial_number;
+    }
+    return m_megamorphic_global_cache;
+}
+
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM& vm, ASTNode const& node, FunctionKind kind, DeprecatedFlyString const& name)
 {
     auto executable_result = Bytecode::Generator::generate_from_ast_node(vm, node, kind);
@@ -80,6 +80,13 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    MegamorphicPropertyCache& megamorphic_get_cache() { return m_megamorphic_get_cache; }
+    MegamorphicPropertyCache& megamorphic_put_cache() { return m_megamorphic_put_cache; }
+
+    // GetGlobal only caches the global object's own properties, and only until a new binding in the global declarative
+    // environment may shadow them, so its entries are kept apart from those of other gets.
+    MegamorphicPropertyCache& megamorphic_global_cache(DeclarativeEnvironment const& global_declarative_environment);
+
 private:
     void run_bytecode(size_t entry_point);
 
@@ -99,9 +106,17 @@ private:
     Span<Value> m_arguments;
     Span<Value> m_registers_and_constants_and_locals;
     ExecutionContext* m_running_execution_context { nullptr };
+
+    // NOTE: Gets and puts use separate caches, as a cached get doesn't tell us whether the property is writable.
+    MegamorphicPropertyCache m_megamorphic_get_cache;
+    MegamorphicPropertyCache m_megamorphic_put_cache;
+    MegamorphicPropertyCache m_megamorphic_global_cache;
+    DeclarativeEnvironment const* m_megamorphic_global_cache_environment { nullptr };
+    u64 m_megamorphic_global_cache_environment_serial_number { 0 };
 };
 
 extern bool g_dump_bytecode;
+extern bool g_optimize_bytecode;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, DeprecatedFlyString const& name);
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
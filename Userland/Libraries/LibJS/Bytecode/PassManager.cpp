@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Generator.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode {
+
+// Builds a new instruction stream for a block out of (relocated) instructions from existing blocks.
+class InstructionStreamBuilder {
+public:
+    void append(BasicBlock const& from, InstructionStreamIterator const& it)
+    {
+        auto const& instruction = *it;
+        append_bytes({ reinterpret_cast<u8 const*>(&instruction), instruction.length() }, from.source_map().get(it.offset()));
+    }
+
+    template<typename OpType>
+    void append_replacement(BasicBlock const& from, InstructionStreamIterator const& it, OpType const& op)
+    {
+        append_bytes({ reinterpret_cast<u8 const*>(&op), op.length() }, from.source_map().get(it.offset()));
+    }
+
+    void finish(BasicBlock& block, bool terminated)
+    {
+        block.set_instruction_stream(move(m_buffer), move(m_source_map), m_last_instruction_start_offset, terminated);
+    }
+
+private:
+    void append_bytes(ReadonlyBytes bytes, Optional<SourceRecord> source_record)
+    {
+        m_last_instruction_start_offset = m_buffer.size();
+        if (source_record.has_value())
+            m_source_map.set(m_buffer.size(), source_record.value());
+        m_buffer.append(bytes.data(), bytes.size());
+    }
+
+    Vector<u8> m_buffer;
+    HashMap<size_t, SourceRecord> m_source_map;
+    size_t m_last_instruction_start_offset { 0 };
+};
+
+static Instruction& last_instruction(BasicBlock& block)
+{
+    VERIFY(block.size() > 0);
+    InstructionStreamIterator it(block.instruction_stream());
+    Instruction const* last = nullptr;
+    while (!it.at_end()) {
+        last = &*it;
+        ++it;
+    }
+    return const_cast<Instruction&>(*last);
+}
+
+template<typename Callback>
+static void for_each_instruction(BasicBlock& block, Callback callback)
+{
+    InstructionStreamIterator it(block.instruction_stream());
+    while (!it.at_end()) {
+        callback(const_cast<Instruction&>(*it));
+        ++it;
+    }
+}
+
+static bool is_non_reserved_register(Operand const& operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+PassManager::PassManager(Generator& generator)
+    : m_generator(generator)
+{
+}
+
+size_t PassManager::instruction_count() const
+{
+    size_t count = 0;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            ++count;
+            ++it;
+        }
+    }
+    return count;
+}
+
+void PassManager::record(StringView name)
+{
+    m_results.append({ name, instruction_count(), m_generator.m_next_register });
+}
+
+void PassManager::run()
+{
+    m_instruction_count_before = instruction_count();
+    m_block_count_before = m_generator.m_root_basic_blocks.size();
+    m_register_count_before = m_generator.m_next_register;
+
+    // Each of these can expose more work for the others (e.g. a folded branch makes a block unreachable, which in
+    // turn gives its successor a single predecessor to be merged into), so run them until nothing changes anymore.
+    static constexpr size_t max_iterations = 8;
+    for (size_t i = 0; i < max_iterations; ++i) {
+        bool changed = false;
+        if (thread_jumps()) {
+            changed = true;
+            record("thread-jumps"sv);
+        }
+        if (fold_constant_branches()) {
+            changed = true;
+            record("fold-constant-branches"sv);
+        }
+        if (eliminate_unreachable_blocks()) {
+            changed = true;
+            record("eliminate-unreachable-blocks"sv);
+        }
+        if (merge_blocks()) {
+            changed = true;
+            record("merge-blocks"sv);
+        }
+        if (!changed)
+            break;
+    }
+
+    if (eliminate_dead_moves())
+        record("eliminate-dead-moves"sv);
+    if (compact_registers())
+        record("compact-registers"sv);
+}
+
+void PassManager::dump_statistics() const
+{
+    warnln("Bytecode optimization: {} instructions in {} blocks, {} registers before", m_instruction_count_before, m_block_count_before, m_register_count_before);
+    for (auto const& result : m_results)
+        warnln("    {:30} -> {} instructions, {} registers", result.name, result.instruction_count_after, result.register_count_after);
+    warnln("");
+}
+
+bool PassManager::thread_jumps()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+
+    // Maps each block that does nothing but jump somewhere else to the block it jumps to.
+    Vector<Optional<size_t>> forwarded_to;
+    forwarded_to.resize(blocks.size());
+    for (auto& block : blocks) {
+        if (!block->is_terminated())
+            continue;
+        InstructionStreamIterator it(block->instruction_stream());
+        auto const& instruction = *it;
+        if (instruction.type() != Instruction::Type::Jump)
+            continue;
+        ++it;
+        if (!it.at_end())
+            continue;
+        forwarded_to[block->index()] = static_cast<Op::Jump const&>(instruction).target().basic_block_index();
+    }
+
+    bool changed = false;
+    for (auto& block : blocks) {
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            instruction.visit_labels([&](Label& label) {
+                auto target = label.basic_block_index();
+                // Bound the chain length so that a cycle of jump-only blocks can't keep us going forever.
+                for (size_t hops = 0; hops < blocks.size() && forwarded_to[target].has_value(); ++hops) {
+                    auto next = forwarded_to[target].value();
+                    if (next == target)
+                        break;
+                    target = next;
+                }
+                if (target != label.basic_block_index()) {
+                    label = Label { static_cast<u32>(target) };
+                    changed = true;
+                }
+            });
+        });
+    }
+    return changed;
+}
+
+bool PassManager::fold_constant_branches()
+{
+    auto const& constants = m_generator.m_constants;
+
+    // Only fold on values whose truthiness doesn't depend on anything but the value itself.
+    auto constant_value = [&](Operand const& operand) -> Optional<Value> {
+        if (!operand.is_constant())
+            return {};
+        auto value = constants[operand.index()];
+        if (value.is_empty() || value.is_cell())
+            return {};
+        return value;
+    };
+
+    bool changed = false;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        if (!block->is_terminated())
+            continue;
+
+        auto& terminator = last_instruction(*block);
+        Optional<Label> target;
+        switch (terminator.type()) {
+        case Instruction::Type::JumpIf: {
+            auto const& jump = static_cast<Op::JumpIf const&>(terminator);
+            if (auto value = constant_value(jump.condition()); value.has_value())
+                target = value->to_boolean() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        case Instruction::Type::JumpNullish: {
+            auto const& jump = static_cast<Op::JumpNullish const&>(terminator);
+            if (auto value = constant_value(jump.condition()); value.has_value())
+                target = value->is_nullish() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        case Instruction::Type::JumpUndefined: {
+            auto const& jump = static_cast<Op::JumpUndefined const&>(terminator);
+            if (auto value = constant_value(jump.condition()); value.has_value())
+                target = value->is_undefined() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        default:
+            break;
+        }
+        if (!target.has_value())
+            continue;
+
+        InstructionStreamBuilder builder;
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            if (&instruction == &terminator)
+                builder.append_replacement(*block, it, Op::Jump { *target });
+            else
+                builder.append(*block, it);
+            ++it;
+        }
+        Instruction::destroy(terminator);
+        builder.finish(*block, true);
+        changed = true;
+    }
+    return changed;
+}
+
+bool PassManager::eliminate_unreachable_blocks()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+
+    Vector<bool> reachable;
+    reachable.resize(blocks.size());
+    Vector<BasicBlock*> worklist;
+    reachable[0] = true;
+    worklist.append(blocks[0].ptr());
+
+    auto mark = [&](size_t index) {
+        if (reachable[index])
+            return;
+        reachable[index] = true;
+        worklist.append(blocks[index].ptr());
+    };
+
+    while (!worklist.is_empty()) {
+        auto& block = *worklist.take_last();
+        if (block.handler())
+            mark(block.handler()->index());
+        if (block.finalizer())
+            mark(block.finalizer()->index());
+        for_each_instruction(block, [&](Instruction& instruction) {
+            instruction.visit_labels([&](Label& label) {
+                mark(label.basic_block_index());
+            });
+        });
+    }
+
+    if (!reachable.contains_slow(false))
+        return false;
+
+    Vector<NonnullOwnPtr<BasicBlock>> remaining_blocks;
+    Vector<u32> new_index;
+    new_index.resize(blocks.size());
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!reachable[i])
+            continue;
+        new_index[i] = remaining_blocks.size();
+        remaining_blocks.append(move(blocks[i]));
+    }
+    // NOTE: Only the reachable blocks were moved out, the unreachable ones are destroyed along with the old list.
+    blocks = move(remaining_blocks);
+
+    for (auto& block : blocks) {
+        block->set_index(new_index[block->index()]);
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            instruction.visit_labels([&](Label& label) {
+                label = Label { new_index[label.basic_block_index()] };
+            });
+        });
+    }
+    return true;
+}
+
+bool PassManager::merge_blocks()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+
+    // Count how often each block is referenced. Exception handlers and finalizers are entered by the unwinding
+    // machinery rather than by a label, so they must stay blocks of their own.
+    Vector<size_t> reference_count;
+    reference_count.resize(blocks.size());
+    for (auto& block : blocks) {
+        if (block->handler())
+            reference_count[block->handler()->index()] += 2;
+        if (block->finalizer())
+            reference_count[block->finalizer()->index()] += 2;
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            instruction.visit_labels([&](Label& label) {
+                ++reference_count[label.basic_block_index()];
+            });
+        });
+    }
+
+    bool changed = false;
+    for (auto& block : blocks) {
+        // NOTE: Blocks that were already merged into a predecessor are left empty.
+        if (!block->is_terminated() || block->size() == 0)
+            continue;
+
+        // Keep appending successors until we run into one that can't be merged.
+        while (true) {
+            auto& terminator = last_instruction(*block);
+            if (terminator.type() != Instruction::Type::Jump)
+                break;
+            auto successor_index = static_cast<Op::Jump const&>(terminator).target().basic_block_index();
+            auto& successor = *blocks[successor_index];
+            if (&successor == block.ptr() || successor_index == 0 || reference_count[successor_index] != 1)
+                break;
+            // Instructions are covered by the exception handler of the block they're in, so we can't move them
+            // into a block with a different one.
+            if (successor.handler() != block->handler() || successor.finalizer() != block->finalizer())
+                break;
+
+            InstructionStreamBuilder builder;
+            InstructionStreamIterator it(block->instruction_stream());
+            while (!it.at_end()) {
+                if (&*it != &terminator)
+                    builder.append(*block, it);
+                ++it;
+            }
+            InstructionStreamIterator successor_it(successor.instruction_stream());
+            while (!successor_it.at_end()) {
+                builder.append(successor, successor_it);
+                ++successor_it;
+            }
+            Instruction::destroy(terminator);
+
+            auto terminated = successor.is_terminated();
+            // The successor's instructions now live in the merged block, so drop them without destroying them.
+            // The empty successor is no longer referenced and gets cleaned up by eliminate_unreachable_blocks().
+            successor.set_instruction_stream({}, {}, 0, true);
+            reference_count[successor_index] = 0;
+            builder.finish(*block, terminated);
+            changed = true;
+
+            if (!terminated)
+                break;
+        }
+    }
+
+    if (changed)
+        eliminate_unreachable_blocks();
+    return changed;
+}
+
+bool PassManager::eliminate_dead_moves()
+{
+    auto& blocks = m_generator.m_root_basic_blocks;
+
+    // A register is live if it is used by anything other than as the destination of a Mov.
+    HashTable<u32> live_registers;
+    for (auto& block : blocks) {
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            if (instruction.type() == Instruction::Type::Mov) {
+                auto const& mov = static_cast<Op::Mov const&>(instruction);
+                if (mov.src().is_register())
+                    live_registers.set(mov.src().index());
+                if (mov.dst().is_register() && !is_non_reserved_register(mov.dst()))
+                    live_registers.set(mov.dst().index());
+                return;
+            }
+            instruction.visit_operands([&](Operand& operand) {
+                if (operand.is_register())
+                    live_registers.set(operand.index());
+            });
+        });
+    }
+
+    auto is_dead = [&](Instruction const& instruction) {
+        if (instruction.type() != Instruction::Type::Mov)
+            return false;
+        auto const& mov = static_cast<Op::Mov const&>(instruction);
+        if (mov.dst() == mov.src())
+            return true;
+        return is_non_reserved_register(mov.dst()) && !live_registers.contains(mov.dst().index());
+    };
+
+    bool changed = false;
+    for (auto& block : blocks) {
+        bool has_dead_moves = false;
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            if (is_dead(instruction))
+                has_dead_moves = true;
+        });
+        if (!has_dead_moves)
+            continue;
+
+        InstructionStreamBuilder builder;
+        Vector<Instruction&> dead_moves;
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            if (is_dead(instruction))
+                dead_moves.append(instruction);
+            else
+                builder.append(*block, it);
+            ++it;
+        }
+        for (auto& instruction : dead_moves)
+            Instruction::destroy(instruction);
+        builder.finish(*block, block->is_terminated());
+        changed = true;
+    }
+    return changed;
+}
+
+bool PassManager::compact_registers()
+{
+    HashMap<u32, u32> new_register_index;
+    u32 next_register = Register::reserved_register_count;
+    bool changed = false;
+    for (auto& block : m_generator.m_root_basic_blocks) {
+        for_each_instruction(*block, [&](Instruction& instruction) {
+            instruction.visit_operands([&](Operand& operand) {
+                if (!is_non_reserved_register(operand))
+                    return;
+                auto index = new_register_index.ensure(operand.index(), [&] { return next_register++; });
+                if (index != operand.index()) {
+                    operand = Operand { Operand::Type::Register, index };
+                    changed = true;
+                }
+            });
+        });
+    }
+
+    if (next_register < m_generator.m_next_register) {
+        m_generator.m_next_register = next_register;
+        changed = true;
+    }
+    return changed;
+}
+
+}
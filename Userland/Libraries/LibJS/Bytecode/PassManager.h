@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+// Cleans up the basic blocks produced by the Generator before they are flattened into an Executable.
+// Every pass works on the unlinked blocks, i.e. labels still refer to block indices and operands have not yet
+// been shifted by the number of registers and constants.
+class PassManager {
+    AK_MAKE_NONCOPYABLE(PassManager);
+    AK_MAKE_NONMOVABLE(PassManager);
+
+public:
+    explicit PassManager(Generator&);
+
+    void run();
+
+    struct PassResult {
+        StringView name;
+        size_t instruction_count_after { 0 };
+        u32 register_count_after { 0 };
+    };
+
+    size_t instruction_count_before() const { return m_instruction_count_before; }
+    u32 register_count_before() const { return m_register_count_before; }
+    Vector<PassResult> const& results() const { return m_results; }
+
+    void dump_statistics() const;
+
+private:
+    // Redirects labels that point at a block consisting of nothing but an unconditional jump.
+    bool thread_jumps();
+
+    // Turns conditional jumps on a constant condition into unconditional jumps.
+    bool fold_constant_branches();
+
+    // Appends a block to its only predecessor if that predecessor unconditionally jumps to it.
+    bool merge_blocks();
+
+    // Drops blocks that can neither be jumped to nor unwound to, and renumbers the remaining ones.
+    bool eliminate_unreachable_blocks();
+
+    // Drops moves into registers that are never read.
+    bool eliminate_dead_moves();
+
+    // Renumbers the non-reserved registers that are still in use so the register file is as small as possible.
+    bool compact_registers();
+
+    void record(StringView name);
+    size_t instruction_count() const;
+
+    Generator& m_generator;
+    size_t m_instruction_count_before { 0 };
+    size_t m_block_count_before { 0 };
+    u32 m_register_count_before { 0 };
+    Vector<PassResult> m_results;
+};
+
+}
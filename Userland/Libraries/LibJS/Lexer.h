@@ -19,6 +19,9 @@ class Lexer {
 public:
     explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
 
+    // Starts lexing at the given offset into the source, which lies at the given line and column.
+    Lexer(ByteString source, StringView filename, size_t line_number, size_t line_column, size_t offset);
+
     Token next();
 
     ByteString const& source() const { return m_source; }
@@ -11,8 +11,10 @@
 
 #include "Parser.h"
 #include <AK/Array.h>
+#include <AK/BinarySearch.h>
 #include <AK/CharacterTypes.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StdLibExtras.h>
 #include <AK/TemporaryChange.h>
@@ -343,8 +345,10 @@ public:
             if (m_type == ScopeType::Program) {
                 auto can_use_global_for_identifier = !(identifier_group.used_inside_with_statement || identifier_group.might_be_variable_in_lexical_scope_in_named_function_assignment || identifier_group.used_inside_scope_with_eval || m_parser.m_state.initiated_by_eval);
                 if (can_use_global_for_identifier) {
-                    for (auto& identifier : identifier_group.identifiers)
+                    for (auto& identifier : identifier_group.identifiers) {
                         identifier->set_is_global();
+                        m_parser.m_global_identifier_offsets.append(identifier->start_offset());
+                    }
                 }
             } else if (scope_has_declaration) {
                 if (hoistable_function_declaration)
@@ -398,6 +402,12 @@ public:
                     } else {
                         m_parent_scope->m_identifier_groups.set(identifier_group_name, identifier_group);
                     }
+                } else if (auto const* global_identifier_offsets = m_parser.m_state.global_identifier_offsets) {
+                    // NOTE: This is a function body that is parsed on its own, so we have to replay what the program scope decided.
+                    for (auto& identifier : identifier_group.identifiers) {
+                        if (binary_search(*global_identifier_offsets, identifier->start_offset()))
+                            identifier->set_is_global();
+                    }
                 }
             }
         }
@@ -661,6 +671,13 @@ Parser::ParserState::ParserState(Lexer l, Program::Type program_type)
     current_token = lexer.next();
 }
 
+Parser::Parser(NonnullRefPtr<SourceCode const> source_code, Lexer lexer, Program::Type program_type)
+    : m_source_code(move(source_code))
+    , m_state(move(lexer), program_type)
+    , m_program_type(program_type)
+{
+}
+
 Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialState> initial_state_for_eval)
     : m_source_code(SourceCode::create(lexer.filename(), String::from_byte_string(lexer.source()).release_value_but_fixme_should_propagate_errors()))
     , m_state(move(lexer), program_type)
@@ -749,17 +766,49 @@ NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
     auto rule_start = push_start();
     auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
-    ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
+    {
+        ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
 
-    if (m_program_type == Program::Type::Script)
-        parse_script(program, starts_in_strict_mode);
-    else
-        parse_module(program);
+        if (m_program_type == Program::Type::Script)
+            parse_script(program, starts_in_strict_mode);
+        else
+            parse_module(program);
+    }
 
     program->set_end_offset({}, position().offset);
+
+    // NOTE: The program scope decides which identifiers are global when it goes away, so only now can function bodies be dropped.
+    if (!has_errors())
+        drop_function_bodies();
+    m_droppable_function_bodies.clear();
     return program;
 }
 
+void Parser::drop_function_bodies()
+{
+    if (m_droppable_function_bodies.is_empty())
+        return;
+
+    quick_sort(m_global_identifier_offsets);
+    auto context = adopt_ref(*new FunctionBody::LazyParsingContext);
+    context->source = m_state.lexer.source();
+    context->program_type = m_program_type;
+    context->global_identifier_offsets = move(m_global_identifier_offsets);
+
+    // Functions are recorded after the functions nested in them, so going backwards we see the outermost function first.
+    Optional<u32> dropped_start_offset;
+    u32 dropped_end_offset = 0;
+    for (auto i = m_droppable_function_bodies.size(); i > 0; --i) {
+        auto& droppable = m_droppable_function_bodies[i - 1];
+        auto start_offset = droppable.state.function_start.offset;
+        if (dropped_start_offset.has_value() && start_offset >= *dropped_start_offset && droppable.end_offset <= dropped_end_offset)
+            continue;
+        dropped_start_offset = start_offset;
+        dropped_end_offset = droppable.end_offset;
+        const_cast<FunctionBody&>(*droppable.body).drop_contents({ context, droppable.state });
+    }
+}
+
 void Parser::parse_script(Program& program, bool starts_in_strict_mode)
 {
     bool strict_before = m_state.strict_mode;
@@ -2882,6 +2931,35 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         : push_start();
     VERIFY(!(parse_options & FunctionNodeParseOptions::IsGetterFunction && parse_options & FunctionNodeParseOptions::IsSetterFunction));
 
+    // Only plain function declarations and expressions can be parsed again on their own later, as everything else depends
+    // on more of the surrounding code than we keep around.
+    constexpr u16 droppable_parse_options = FunctionNodeParseOptions::CheckForFunctionAndName
+        | FunctionNodeParseOptions::HasDefaultExportName
+        | FunctionNodeParseOptions::IsGeneratorFunction
+        | FunctionNodeParseOptions::IsAsyncFunction;
+    Optional<FunctionBody::ParsingState> droppable_parsing_state;
+    if ((parse_options & FunctionNodeParseOptions::CheckForFunctionAndName)
+        && (parse_options & ~droppable_parse_options) == 0
+        && !function_start.has_value()
+        && !m_state.initiated_by_eval
+        && !m_state.in_eval_function_context
+        && !m_state.in_formal_parameter_context
+        && !m_state.in_catch_parameter_context
+        && !m_state.in_class_field_initializer
+        && !m_state.in_class_static_init_block
+        && !m_state.referenced_private_names) {
+        droppable_parsing_state = FunctionBody::ParsingState {
+            .function_start = rule_start.position(),
+            .parse_options = parse_options,
+            .is_function_declaration = IsSame<FunctionNodeType, FunctionDeclaration>,
+            .strict_mode = m_state.strict_mode,
+            .in_function_context = m_state.in_function_context,
+            .in_arrow_function_context = m_state.in_arrow_function_context,
+            .in_generator_function_context = m_state.in_generator_function_context,
+            .await_expression_is_valid = m_state.await_expression_is_valid,
+        };
+    }
+
     TemporaryChange super_property_access_rollback(m_state.allow_super_property_lookup, !!(parse_options & FunctionNodeParseOptions::AllowSuperPropertyLookup));
     TemporaryChange super_constructor_call_rollback(m_state.allow_super_constructor_call, !!(parse_options & FunctionNodeParseOptions::AllowSuperConstructorCall));
     TemporaryChange break_context_rollback(m_state.in_break_context, false);
@@ -2970,6 +3048,11 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     auto local_variables_names = body->local_variables_names();
     consume(TokenType::CurlyClose);
 
+    // Small functions aren't worth parsing twice.
+    static constexpr size_t minimum_droppable_function_length = 256;
+    if (droppable_parsing_state.has_value() && position().offset - rule_start.position().offset >= minimum_droppable_function_length)
+        m_droppable_function_bodies.append({ body, droppable_parsing_state.release_value(), static_cast<u32>(position().offset) });
+
     auto has_strict_directive = body->in_strict_mode();
 
     if (has_strict_directive && name)
@@ -5167,6 +5250,34 @@ NonnullRefPtr<Identifier const> Parser::create_identifier_and_register_in_curren
     return id;
 }
 
+NonnullRefPtr<FunctionBody const> Parser::parse_dropped_function_body(FunctionBody const& function_body)
+{
+    auto const& [context, state] = function_body.dropped_contents();
+    auto const& source_code = function_body.source_code();
+
+    // NOTE: The lexer is set up to continue exactly where the function starts, so that all positions match the first parse.
+    Lexer lexer { context->source, source_code.filename(), state.function_start.line, state.function_start.column - 1, state.function_start.offset };
+    Parser parser { source_code, move(lexer), context->program_type };
+    parser.m_state.strict_mode = state.strict_mode;
+    parser.m_state.in_function_context = state.in_function_context;
+    parser.m_state.in_arrow_function_context = state.in_arrow_function_context;
+    parser.m_state.in_generator_function_context = state.in_generator_function_context;
+    parser.m_state.await_expression_is_valid = state.await_expression_is_valid;
+    parser.m_state.global_identifier_offsets = &context->global_identifier_offsets;
+
+    auto parse_body = [&]<typename FunctionNodeType>() -> NonnullRefPtr<FunctionBody const> {
+        auto function_node = parser.parse_function_node<FunctionNodeType>(state.parse_options);
+        return static_cast<FunctionBody const&>(function_node->body());
+    };
+    auto body = state.is_function_declaration
+        ? parse_body.operator()<FunctionDeclaration>()
+        : parse_body.operator()<FunctionExpression>();
+
+    // The function has been parsed successfully before, so there's no way for this to fail.
+    VERIFY(!parser.has_errors());
+    return body;
+}
+
 Parser Parser::parse_function_body_from_string(ByteString const& body_string, u16 parse_options, Vector<FunctionParameter> const& parameters, FunctionKind kind, FunctionParsingInsights& parsing_insights)
 {
     RefPtr<FunctionBody const> function_body;
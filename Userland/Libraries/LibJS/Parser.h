@@ -213,9 +213,16 @@ public:
 
     static Parser parse_function_body_from_string(ByteString const& body_string, u16 parse_options, Vector<FunctionParameter> const& parameters, FunctionKind kind, FunctionParsingInsights&);
 
+    // Parses the contents of a function body that were dropped after its program was parsed, see FunctionBody::drop_contents().
+    static NonnullRefPtr<FunctionBody const> parse_dropped_function_body(FunctionBody const&);
+
 private:
     friend class ScopePusher;
 
+    Parser(NonnullRefPtr<SourceCode const>, Lexer, Program::Type);
+
+    void drop_function_bodies();
+
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
 
@@ -331,6 +338,9 @@ private:
         bool in_class_static_init_block { false };
         bool function_might_need_arguments_object { false };
 
+        // Set when parsing a function body on its own, as the program it belongs to decided which identifiers are global.
+        Vector<u32> const* global_identifier_offsets { nullptr };
+
         ParserState(Lexer, Program::Type);
     };
 
@@ -356,5 +366,13 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<Position, TokenMemoization, PositionKeyTraits> m_token_memoizations;
     Program::Type m_program_type;
+
+    struct DroppableFunctionBody {
+        NonnullRefPtr<FunctionBody const> body;
+        FunctionBody::ParsingState state;
+        u32 end_offset { 0 };
+    };
+    Vector<DroppableFunctionBody> m_droppable_function_bodies;
+    Vector<u32> m_global_identifier_offsets;
 };
 }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/ProgramCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+ProgramCache::ProgramCache(size_t max_size_in_bytes)
+    : m_max_size_in_bytes(max_size_in_bytes)
+{
+}
+
+ProgramCache::~ProgramCache() = default;
+
+ProgramCache::Key ProgramCache::key_for(StringView source_text, StringView filename, size_t line_number_offset, Program::Type type)
+{
+    return Key { source_text.hash(), filename, line_number_offset, type };
+}
+
+size_t ProgramCache::size_in_bytes_of(Program const& program)
+{
+    auto source_size_in_bytes = program.source_code().code().bytes().size();
+    auto size_in_bytes = source_size_in_bytes + source_size_in_bytes * estimated_ast_size_per_source_byte;
+    if (auto* executable = program.bytecode_executable())
+        size_in_bytes += executable->size_in_bytes();
+    return size_in_bytes;
+}
+
+RefPtr<Program> ProgramCache::get(StringView source_text, StringView filename, size_t line_number_offset, Program::Type type)
+{
+    auto it = m_entries.find(key_for(source_text, filename, line_number_offset, type));
+
+    // The hash of the source text is only a hint, the source has to match exactly.
+    if (it == m_entries.end() || it->value.program->source_code().code().bytes_as_string_view() != source_text) {
+        ++m_miss_count;
+        return nullptr;
+    }
+
+    ++m_hit_count;
+    auto& entry = it->value;
+    entry.last_used = ++m_use_counter;
+    auto program = entry.program;
+
+    // The program may have grown since it was cached, as its bytecode is only generated when it first runs.
+    update_size_of(entry);
+    while (m_size_in_bytes > m_max_size_in_bytes)
+        evict_least_recently_used_entry();
+
+    return program;
+}
+
+void ProgramCache::set(StringView source_text, StringView filename, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    // A program can only be found again if the parser saw exactly the same source text.
+    if (program->source_code().code().bytes_as_string_view() != source_text)
+        return;
+
+    auto size_in_bytes = size_in_bytes_of(*program);
+    if (size_in_bytes > m_max_size_in_bytes)
+        return;
+
+    auto key = key_for(source_text, filename, line_number_offset, program->type());
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_size_in_bytes -= it->value.size_in_bytes;
+        m_entries.remove(it);
+    }
+
+    for (auto& it : m_entries)
+        update_size_of(it.value);
+    while (m_size_in_bytes + size_in_bytes > m_max_size_in_bytes)
+        evict_least_recently_used_entry();
+
+    m_size_in_bytes += size_in_bytes;
+    m_entries.set(move(key), Entry { move(program), size_in_bytes, ++m_use_counter });
+}
+
+void ProgramCache::update_size_of(Entry& entry)
+{
+    auto size_in_bytes = size_in_bytes_of(*entry.program);
+    m_size_in_bytes = m_size_in_bytes - entry.size_in_bytes + size_in_bytes;
+    entry.size_in_bytes = size_in_bytes;
+}
+
+void ProgramCache::evict_least_recently_used_entry()
+{
+    VERIFY(!m_entries.is_empty());
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->value.last_used < oldest->value.last_used)
+            oldest = it;
+    }
+    m_size_in_bytes -= oldest->value.size_in_bytes;
+    m_entries.remove(oldest);
+}
+
+void ProgramCache::clear()
+{
+    m_entries.clear();
+    m_size_in_bytes = 0;
+}
+
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Parsed programs of scripts and modules, keyed by their source text. Parse nodes are immutable once parsed, and the
+// bytecode of a program and of its functions is attached to the parse nodes when they are first compiled. Parsing
+// the same source again, e.g. when reloading a page or loading a shared library script in several documents, thus
+// skips both the parser and the bytecode generator. The cache belongs to a VM, as the attached bytecode lives on
+// its heap. It is bounded by the memory the cached programs take up, and the least recently used programs are
+// evicted first.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    static constexpr size_t default_max_size_in_bytes = 32 * MiB;
+
+    // Parse nodes are allocated one by one, so their size is estimated from the length of the source text instead.
+    static constexpr size_t estimated_ast_size_per_source_byte = 8;
+
+    explicit ProgramCache(size_t max_size_in_bytes = default_max_size_in_bytes);
+    ~ProgramCache();
+
+    RefPtr<Program> get(StringView source_text, StringView filename, size_t line_number_offset, Program::Type);
+    void set(StringView source_text, StringView filename, size_t line_number_offset, NonnullRefPtr<Program>);
+
+    void clear();
+
+    size_t program_count() const { return m_entries.size(); }
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+    // The source text, the estimated size of the parse nodes and, once generated, the top-level bytecode.
+    static size_t size_in_bytes_of(Program const&);
+    size_t hit_count() const { return m_hit_count; }
+    size_t miss_count() const { return m_miss_count; }
+
+private:
+    struct Key {
+        unsigned source_hash { 0 };
+        ByteString filename;
+        size_t line_number_offset { 0 };
+        Program::Type type { Program::Type::Script };
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key)
+        {
+            return pair_int_hash(pair_int_hash(key.source_hash, key.filename.hash()), pair_int_hash(key.line_number_offset, to_underlying(key.type)));
+        }
+    };
+
+    struct Entry {
+        NonnullRefPtr<Program> program;
+        // The size the entry is accounted for in m_size_in_bytes.
+        size_t size_in_bytes { 0 };
+        u64 last_used { 0 };
+    };
+
+    static Key key_for(StringView source_text, StringView filename, size_t line_number_offset, Program::Type);
+    void update_size_of(Entry&);
+    void evict_least_recently_used_entry();
+
+    HashMap<Key, Entry, KeyTraits> m_entries;
+    size_t m_max_size_in_bytes { 0 };
+    size_t m_size_in_bytes { 0 };
+    u64 m_use_counter { 0 };
+    size_t m_hit_count { 0 };
+    size_t m_miss_count { 0 };
+};
+
+}
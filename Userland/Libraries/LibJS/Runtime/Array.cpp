@@ -178,15 +178,38 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+SimpleIndexedPropertyStorage const* packed_element_storage(Object const& object)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (!simple_storage.is_packed())
+        return nullptr;
+    return &simple_storage;
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
 {
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
+    size_t k = 0;
+
+    // OPTIMIZATION: Reading the elements of a packed array can't have side effects, so copy them over directly.
+    if (auto const* storage = packed_element_storage(object)) {
+        auto const& elements = storage->elements();
+        items.ensure_capacity(length);
+        for (; k < length && k < storage->array_like_size() && !elements[k].is_accessor(); ++k)
+            items.unchecked_append(elements[k]);
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -63,6 +63,10 @@ enum class Holes {
     ReadThroughHoles,
 };
 
+// OPTIMIZATION: Returns the element storage of an ordinary array that has no holes. Every index below its length is then
+//               an own data property, so the elements can be read without going through [[HasProperty]] and [[Get]].
+SimpleIndexedPropertyStorage const* packed_element_storage(Object const&);
+
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
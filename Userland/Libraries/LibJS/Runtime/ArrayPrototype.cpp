@@ -9,6 +9,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -678,6 +679,23 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::flat_map)
     return array;
 }
 
+// Performs the HasProperty and Get steps of the iteration builtins for index k, returning an empty Optional for missing elements.
+static ThrowCompletionOr<Optional<Value>> get_element_if_present(Object& object, size_t k)
+{
+    // OPTIMIZATION: Every element of a packed array is present, so we can read it directly. The callback may change
+    //               the array between two elements, which is why this is checked again for every index.
+    if (auto const* storage = packed_element_storage(object); storage && k < storage->array_like_size()) {
+        auto value = storage->elements()[k];
+        if (!value.is_accessor())
+            return value;
+    }
+
+    auto property_key = PropertyKey { k };
+    if (!TRY(object.has_property(property_key)))
+        return Optional<Value> {};
+    return TRY(object.get(property_key));
+}
+
 // 23.1.3.15 Array.prototype.forEach ( callbackfn [ , thisArg ] ), https://tc39.es/ecma262/#sec-array.prototype.foreach
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
 {
@@ -698,18 +716,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
-
+        //     i. Let kValue be ? Get(O, Pk).
+        auto k_value = TRY(get_element_if_present(object, k));
+        if (k_value.has_value()) {
             // ii. Perform ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
         }
 
         // d. Set k to k + 1.
@@ -795,6 +808,26 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Nothing in the loop below can run user code for a packed array, so we can compare the elements
+    //               directly, and skip the search entirely if the element kind rules out a match.
+    if (auto const* storage = packed_element_storage(object)) {
+        auto const& elements = storage->elements();
+        auto end = min(length, storage->array_like_size());
+        if (storage->has_only_numbers() && !search_element.is_number()) {
+            k = max(k, end);
+        } else if (storage->has_only_int32s() && search_element.is_int32()) {
+            for (auto needle = search_element.as_i32(); k < end; ++k) {
+                if (elements[k].as_i32() == needle)
+                    return Value(k);
+            }
+        } else {
+            for (; k < end && !elements[k].is_accessor(); ++k) {
+                if (is_strictly_equal(search_element, elements[k]))
+                    return Value(k);
+            }
+        }
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -956,21 +989,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
     // 6. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
-        auto property_key = PropertyKey { k };
-
         // b. Let kPresent be ? HasProperty(O, Pk).
-        auto k_present = TRY(object->has_property(property_key));
-
         // c. If kPresent is true, then
-        if (k_present) {
-            // i. Let kValue be ? Get(O, Pk).
-            auto k_value = TRY(object->get(property_key));
-
+        //     i. Let kValue be ? Get(O, Pk).
+        auto k_value = TRY(get_element_if_present(object, k));
+        if (k_value.has_value()) {
             // ii. Let mappedValue be ? Call(callbackfn, thisArg, « kValue, 𝔽(k), O »).
-            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
 
             // iii. Perform ? CreateDataPropertyOrThrow(A, Pk, mappedValue).
-            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            TRY(array->create_data_property_or_throw(k, mapped_value));
         }
 
         // d. Set k to k + 1.
@@ -996,6 +1024,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::pop)
     return element;
 }
 
+static bool prototype_chain_has_indexed_properties(Object const& object)
+{
+    for (auto const* prototype = object.prototype(); prototype; prototype = prototype->prototype()) {
+        if (prototype->may_interfere_with_indexed_property_access() || !prototype->indexed_properties().is_empty())
+            return true;
+    }
+    return false;
+}
+
 // 23.1.3.23 Array.prototype.push ( ...items ), https://tc39.es/ecma262/#sec-array.prototype.push
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
 {
@@ -1005,6 +1042,18 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+
+    // OPTIMIZATION: Append straight to the storage of an ordinary array if nothing can observe the new elements being
+    //               defined, i.e. the array is extensible, its length is writable and no prototype has indexed properties.
+    if (is<Array>(*this_object) && new_length < NumericLimits<u32>::max()) {
+        auto& array = static_cast<Array&>(*this_object);
+        if (array.length_is_writable() && TRY(array.is_extensible()) && !prototype_chain_has_indexed_properties(array)) {
+            for (size_t i = 0; i < argument_count; ++i)
+                array.indexed_properties().append(vm.argument(i));
+            return Value(new_length);
+        }
+    }
+
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -1395,6 +1444,38 @@ ThrowCompletionOr<void> array_merge_sort(VM& vm, Function<ThrowCompletionOr<doub
     return {};
 }
 
+// Without a comparator, elements are ordered by their string representations. For a packed array of numbers, this
+// converts every element to a string once up front, rather than twice for every comparison.
+static Optional<MarkedVector<Value>> sort_packed_numbers_by_string_representation(VM& vm, Object const& object, size_t length)
+{
+    auto const* storage = packed_element_storage(object);
+    if (!storage || !storage->has_only_numbers() || storage->array_like_size() != length)
+        return {};
+
+    auto const& elements = storage->elements();
+    Vector<ByteString> strings;
+    Vector<size_t> order;
+    strings.ensure_capacity(length);
+    order.ensure_capacity(length);
+    for (size_t i = 0; i < length; ++i) {
+        strings.unchecked_append(MUST(elements[i].to_byte_string(vm)));
+        order.unchecked_append(i);
+    }
+
+    // Break ties by position, as the sort has to be stable.
+    quick_sort(order, [&](size_t a, size_t b) {
+        if (strings[a] != strings[b])
+            return strings[a] < strings[b];
+        return a < b;
+    });
+
+    MarkedVector<Value> sorted_list { vm.heap() };
+    sorted_list.ensure_capacity(length);
+    for (auto index : order)
+        sorted_list.unchecked_append(elements[index]);
+    return sorted_list;
+}
+
 // 23.1.3.30 Array.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-array.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
 {
@@ -1416,7 +1497,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::sort)
     };
 
     // 5. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, skip-holes).
-    auto sorted_list = TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
+    Optional<MarkedVector<Value>> sorted_numbers;
+    if (comparefn.is_undefined())
+        sorted_numbers = sort_packed_numbers_by_string_representation(vm, object, length);
+    auto sorted_list = sorted_numbers.has_value() ? sorted_numbers.release_value() : TRY(sort_indexed_properties(vm, object, length, sort_compare, Holes::SkipHoles));
 
     // 6. Let itemCount be the number of elements in sortedList.
     auto item_count = sorted_list.size();
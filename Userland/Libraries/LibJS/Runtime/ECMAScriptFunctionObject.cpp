@@ -73,6 +73,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
     , m_strict(strict)
     , m_might_need_arguments_object(parsing_insights.might_need_arguments_object)
     , m_contains_direct_call_to_eval(parsing_insights.contains_direct_call_to_eval)
+    , m_uses_this_from_environment(parsing_insights.uses_this_from_environment)
     , m_is_arrow_function(is_arrow_function)
     , m_kind(kind)
 {
@@ -102,6 +103,19 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         return true;
     });
 
+    m_uses_this = parsing_insights.uses_this;
+}
+
+void ECMAScriptFunctionObject::prepare_function_declaration_instantiation()
+{
+    if (m_function_declaration_instantiation_prepared)
+        return;
+    m_function_declaration_instantiation_prepared = true;
+
+    // NOTE: Functions that have never been called may not have their body parsed yet.
+    if (is<FunctionBody>(*m_ecmascript_code))
+        static_cast<FunctionBody const&>(*m_ecmascript_code).ensure_contents_are_parsed();
+
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
 
@@ -331,8 +345,7 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(DeprecatedFlyString name, Byt
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
-    m_uses_this = parsing_insights.uses_this;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
 }
 
 void ECMAScriptFunctionObject::initialize(Realm& realm)
@@ -379,6 +392,8 @@ ThrowCompletionOr<Value> ECMAScriptFunctionObject::internal_call(Value this_argu
 {
     auto& vm = this->vm();
 
+    prepare_function_declaration_instantiation();
+
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
@@ -443,6 +458,8 @@ ThrowCompletionOr<NonnullGCPtr<Object>> ECMAScriptFunctionObject::internal_const
 {
     auto& vm = this->vm();
 
+    prepare_function_declaration_instantiation();
+
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
@@ -114,6 +114,9 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    // The parts of FunctionDeclarationInstantiation that only depend on the code of the function, done on the first call.
+    void prepare_function_declaration_instantiation();
+
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
@@ -143,6 +146,7 @@ private:
 
     bool m_might_need_arguments_object : 1 { true };
     bool m_contains_direct_call_to_eval : 1 { true };
+    bool m_uses_this_from_environment : 1 { false };
     bool m_is_arrow_function : 1 { false };
     bool m_has_simple_parameter_list : 1 { false };
     FunctionKind m_kind : 3 { FunctionKind::Normal };
@@ -164,6 +168,7 @@ private:
     bool m_arguments_object_needed { false };
     bool m_is_module_wrapper { false };
     bool m_function_environment_needed { false };
+    bool m_function_declaration_instantiation_prepared { false };
     bool m_uses_this { false };
     Vector<VariableNameToInitialize> m_var_names_to_initialize_binding;
     Vector<DeprecatedFlyString> m_function_names_to_initialize_binding;
@@ -18,6 +18,63 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements) {
+        if (value.is_empty())
+            did_create_hole();
+        else
+            did_store_value(value);
+    }
+}
+
+void SimpleIndexedPropertyStorage::did_store_value(Value value)
+{
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        if (!value.is_int32())
+            m_element_kind = value.is_number() ? ElementKind::PackedNumber : ElementKind::PackedAny;
+        break;
+    case ElementKind::PackedNumber:
+        if (!value.is_number())
+            m_element_kind = ElementKind::PackedAny;
+        break;
+    case ElementKind::HoleyInt32:
+        if (!value.is_int32())
+            m_element_kind = value.is_number() ? ElementKind::HoleyNumber : ElementKind::HoleyAny;
+        break;
+    case ElementKind::HoleyNumber:
+        if (!value.is_number())
+            m_element_kind = ElementKind::HoleyAny;
+        break;
+    case ElementKind::PackedAny:
+    case ElementKind::HoleyAny:
+        break;
+    }
+}
+
+void SimpleIndexedPropertyStorage::did_create_hole()
+{
+    switch (m_element_kind) {
+    case ElementKind::PackedInt32:
+        m_element_kind = ElementKind::HoleyInt32;
+        break;
+    case ElementKind::PackedNumber:
+        m_element_kind = ElementKind::HoleyNumber;
+        break;
+    case ElementKind::PackedAny:
+        m_element_kind = ElementKind::HoleyAny;
+        break;
+    case ElementKind::HoleyInt32:
+    case ElementKind::HoleyNumber:
+    case ElementKind::HoleyAny:
+        break;
+    }
+}
+
+void SimpleIndexedPropertyStorage::did_change_array_size()
+{
+    // An empty storage can start over with the most specific kind.
+    if (m_array_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -48,27 +105,36 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            did_create_hole();
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    if (value.is_empty())
+        did_create_hole();
+    else
+        did_store_value(value);
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = {};
+    did_create_hole();
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
+    did_change_array_size();
     return { m_packed_elements.take_first(), default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
+    did_change_array_size();
     auto last_element = m_packed_elements[m_array_size];
     m_packed_elements[m_array_size] = {};
     return { last_element, default_attributes };
@@ -76,8 +142,11 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        did_create_hole();
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
+    did_change_array_size();
     return true;
 }
 
@@ -54,6 +54,18 @@ private:
     bool m_is_simple_storage { false };
 };
 
+// What the elements of a SimpleIndexedPropertyStorage are known to be. A packed storage has no holes below its
+// array-like size, and the Int32 and Number kinds only hold numbers. Builtins use this to skip per-element work.
+// Kinds only ever become more general as elements are stored or removed, until the storage becomes empty again.
+enum class ElementKind : u8 {
+    PackedInt32,
+    PackedNumber,
+    PackedAny,
+    HoleyInt32,
+    HoleyNumber,
+    HoleyAny,
+};
+
 class SimpleIndexedPropertyStorage final : public IndexedPropertyStorage {
 public:
     SimpleIndexedPropertyStorage()
@@ -74,6 +86,11 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind <= ElementKind::PackedAny; }
+    bool has_only_numbers() const { return m_element_kind != ElementKind::PackedAny && m_element_kind != ElementKind::HoleyAny; }
+    bool has_only_int32s() const { return m_element_kind == ElementKind::PackedInt32 || m_element_kind == ElementKind::HoleyInt32; }
+
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
         return index < m_array_size && !m_packed_elements.data()[index].is_empty();
@@ -91,8 +108,13 @@ private:
 
     void grow_storage_if_needed();
 
+    void did_store_value(Value);
+    void did_create_hole();
+    void did_change_array_size();
+
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
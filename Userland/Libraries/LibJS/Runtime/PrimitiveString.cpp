@@ -26,6 +26,8 @@ PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
+    if (lhs.m_length_in_utf16_code_units.has_value() && rhs.m_length_in_utf16_code_units.has_value())
+        m_length_in_utf16_code_units = *lhs.m_length_in_utf16_code_units + *rhs.m_length_in_utf16_code_units;
 }
 
 PrimitiveString::PrimitiveString(String string)
@@ -39,7 +41,8 @@ PrimitiveString::PrimitiveString(ByteString string)
 }
 
 PrimitiveString::PrimitiveString(Utf16String string)
-    : m_utf16_string(move(string))
+    : m_length_in_utf16_code_units(string.length_in_code_units())
+    , m_utf16_string(move(string))
 {
 }
 
@@ -125,6 +128,7 @@ Utf16String PrimitiveString::utf16_string() const
             VERIFY(has_byte_string());
             m_utf16_string = Utf16String::create(*m_byte_string);
         }
+        m_length_in_utf16_code_units = m_utf16_string->length_in_code_units();
     }
 
     return *m_utf16_string;
@@ -136,13 +140,49 @@ Utf16View PrimitiveString::utf16_string_view() const
     return m_utf16_string->view();
 }
 
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (m_length_in_utf16_code_units.has_value())
+        return *m_length_in_utf16_code_units;
+
+    size_t length = 0;
+
+    if (m_is_rope) {
+        // Concatenation never changes the number of UTF-16 code units, even when a surrogate pair is split
+        // across two pieces, so the length of a rope is the sum of the lengths of its pieces.
+        // NOTE: As in resolve_rope_if_needed(), we don't use recursion here. Subtrees whose length is known aren't entered.
+        Vector<PrimitiveString const*> stack;
+        stack.append(m_rhs);
+        stack.append(m_lhs);
+        while (!stack.is_empty()) {
+            auto const* current = stack.take_last();
+            if (current->m_is_rope && !current->m_length_in_utf16_code_units.has_value()) {
+                stack.append(current->m_rhs);
+                stack.append(current->m_lhs);
+                continue;
+            }
+            length += current->length_in_utf16_code_units();
+        }
+    } else {
+        VERIFY(has_utf8_string() || has_byte_string());
+        auto string = has_utf8_string() ? m_utf8_string->bytes_as_string_view() : m_byte_string->view();
+
+        // Count the code units that the UTF-16 conversion would produce, without performing it.
+        for (auto code_point : Utf8View { string })
+            length += code_point < 0x10000 ? 1 : 2;
+    }
+
+    m_length_in_utf16_code_units = length;
+    return length;
+}
+
 ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
@@ -243,9 +283,54 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& l
     if (rhs_empty)
         return lhs;
 
+    if (auto string = concatenate_short_strings(vm, lhs, rhs))
+        return *string;
+
+    // String-building loops keep appending short strings to a rope. If the rope already ends in a short string,
+    // we merge the two short strings instead of making the rope one level deeper.
+    if (lhs.m_is_rope && !rhs.m_is_rope) {
+        if (auto string = concatenate_short_strings(vm, *lhs.m_rhs, rhs))
+            return vm.heap().allocate_without_realm<PrimitiveString>(*lhs.m_lhs, *string);
+    }
+
+    // NOTE: Ropes may get arbitrarily deep here. Everything that walks them does so without recursion.
     return vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
 }
 
+GCPtr<PrimitiveString> PrimitiveString::concatenate_short_strings(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    if (lhs.m_is_rope || rhs.m_is_rope)
+        return nullptr;
+
+    if (lhs.has_utf16_string() && rhs.has_utf16_string()) {
+        auto lhs_view = lhs.m_utf16_string->view();
+        auto rhs_view = rhs.m_utf16_string->view();
+
+        auto length = lhs_view.length_in_code_units() + rhs_view.length_in_code_units();
+        if (length >= max_short_concatenation_length)
+            return nullptr;
+
+        Utf16Data code_units;
+        code_units.ensure_capacity(length);
+        code_units.unchecked_append(lhs_view.data(), lhs_view.length_in_code_units());
+        code_units.unchecked_append(rhs_view.data(), rhs_view.length_in_code_units());
+
+        return create(vm, Utf16String::create(move(code_units)));
+    }
+
+    if (lhs.has_utf8_string() && rhs.has_utf8_string()) {
+        if (lhs.m_utf8_string->bytes().size() + rhs.m_utf8_string->bytes().size() >= max_short_concatenation_length)
+            return nullptr;
+
+        // NOTE: The strings may end and begin with the two halves of a surrogate pair, which resolving the rope takes care of.
+        auto string = vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
+        string->resolve_rope_if_needed(EncodingPreference::UTF8);
+        return string;
+    }
+
+    return nullptr;
+}
+
 void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) const
 {
     if (!m_is_rope)
@@ -275,9 +360,24 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
         // into a UTF-16 code unit buffer and create a Utf16String from it.
 
         Utf16Data code_units;
-        for (auto const* current : pieces)
-            code_units.extend(current->utf16_string().string());
+        if (m_length_in_utf16_code_units.has_value())
+            code_units.ensure_capacity(*m_length_in_utf16_code_units);
+
+        for (auto const* current : pieces) {
+            if (current->has_utf16_string()) {
+                auto view = current->m_utf16_string->view();
+                code_units.append(view.data(), view.length_in_code_units());
+                continue;
+            }
+
+            // NOTE: We convert pieces without a UTF-16 string straight into the buffer, rather than giving every
+            //       piece a UTF-16 string of its own that would only be used once.
+            auto string = current->has_utf8_string() ? current->m_utf8_string->bytes_as_string_view() : current->m_byte_string->view();
+            for (auto code_point : Utf8View { string })
+                MUST(code_point_to_utf16(code_units, code_point));
+        }
 
+        m_length_in_utf16_code_units = code_units.size();
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
         m_lhs = nullptr;
@@ -51,6 +51,9 @@ public:
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
 
+    // Unlike utf16_string().length_in_code_units(), this does not resolve ropes.
+    size_t length_in_utf16_code_units() const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
 private:
@@ -67,7 +70,13 @@ private:
     };
     void resolve_rope_if_needed(EncodingPreference) const;
 
+    static GCPtr<PrimitiveString> concatenate_short_strings(VM&, PrimitiveString&, PrimitiveString&);
+
+    // Concatenations of flat strings shorter than this are resolved right away, instead of making a rope.
+    static constexpr size_t max_short_concatenation_length = 32;
+
     mutable bool m_is_rope { false };
+    mutable Optional<size_t> m_length_in_utf16_code_units;
 
     mutable GCPtr<PrimitiveString> m_lhs;
     mutable GCPtr<PrimitiveString> m_rhs;
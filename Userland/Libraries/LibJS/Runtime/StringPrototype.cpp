@@ -1056,7 +1056,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::slice)
         return PrimitiveString::create(vm, String {});
 
     // 13. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, string.substring(int_start, int_end - int_start));
 }
 
 // 22.1.3.23 String.prototype.split ( separator, limit ), https://tc39.es/ecma262/#sec-string.prototype.split
@@ -1134,10 +1134,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
             ++position;
             continue;
         }
-        auto segment = string.substring_view(start, position - start);
+        auto segment = string.substring(start, position - start);
 
         // b. Append T to substrings.
-        MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, Utf16String::create(segment))));
+        MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, move(segment))));
         ++array_length;
 
         // c. If the number of elements in substrings is lim, return CreateArrayFromList(substrings).
@@ -1152,10 +1152,10 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::split)
     }
 
     // 15. Let T be the substring of S from i.
-    auto rest = string.substring_view(start);
+    auto rest = string.substring(start);
 
     // 16. Append T to substrings.
-    MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, Utf16String::create(rest))));
+    MUST(array->create_data_property_or_throw(array_length, PrimitiveString::create(vm, move(rest))));
 
     // 17. Return CreateArrayFromList(substrings).
     return array;
@@ -1247,7 +1247,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substring)
     size_t to = max(final_start, final_end);
 
     // 10. Return the substring of S from from to to.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(from, to - from)));
+    return PrimitiveString::create(vm, string.substring(from, to - from));
 }
 
 enum class TargetCase {
@@ -1516,7 +1516,7 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::substr)
         return PrimitiveString::create(vm, String {});
 
     // 11. Return the substring of S from intStart to intEnd.
-    return PrimitiveString::create(vm, Utf16String::create(string.substring_view(int_start, int_end - int_start)));
+    return PrimitiveString::create(vm, string.substring(int_start, int_end - int_start));
 }
 
 // B.2.2.2.1 CreateHTML ( string, tag, attribute, value ), https://tc39.es/ecma262/#sec-createhtml
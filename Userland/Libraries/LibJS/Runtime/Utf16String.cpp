@@ -79,17 +79,20 @@ Utf16String Utf16String::create(Utf16View const& string)
 
 Utf16String::Utf16String(NonnullRefPtr<Detail::Utf16StringImpl> string)
     : m_string(move(string))
+    , m_code_unit_length(m_string->string().size())
 {
 }
 
-Utf16Data const& Utf16String::string() const
+Utf16String::Utf16String(NonnullRefPtr<Detail::Utf16StringImpl> string, size_t code_unit_offset, size_t code_unit_length)
+    : m_string(move(string))
+    , m_code_unit_offset(code_unit_offset)
+    , m_code_unit_length(code_unit_length)
 {
-    return m_string->string();
 }
 
 Utf16View Utf16String::view() const
 {
-    return m_string->view();
+    return m_string->view().substring_view(m_code_unit_offset, m_code_unit_length);
 }
 
 Utf16View Utf16String::substring_view(size_t code_unit_offset, size_t code_unit_length) const
@@ -102,6 +105,24 @@ Utf16View Utf16String::substring_view(size_t code_unit_offset) const
     return view().substring_view(code_unit_offset);
 }
 
+Utf16String Utf16String::substring(size_t code_unit_offset, size_t code_unit_length) const
+{
+    VERIFY(code_unit_offset + code_unit_length <= m_code_unit_length);
+
+    if (code_unit_offset == 0 && code_unit_length == m_code_unit_length)
+        return *this;
+    if (code_unit_length < min_shared_substring_length)
+        return create(substring_view(code_unit_offset, code_unit_length));
+
+    return Utf16String { m_string, m_code_unit_offset + code_unit_offset, code_unit_length };
+}
+
+Utf16String Utf16String::substring(size_t code_unit_offset) const
+{
+    VERIFY(code_unit_offset <= m_code_unit_length);
+    return substring(code_unit_offset, m_code_unit_length - code_unit_offset);
+}
+
 String Utf16String::to_utf8() const
 {
     return MUST(view().to_utf8(Utf16View::AllowInvalidCodeUnits::Yes));
@@ -119,12 +140,12 @@ u16 Utf16String::code_unit_at(size_t index) const
 
 size_t Utf16String::length_in_code_units() const
 {
-    return view().length_in_code_units();
+    return m_code_unit_length;
 }
 
 bool Utf16String::is_empty() const
 {
-    return view().is_empty();
+    return m_code_unit_length == 0;
 }
 
 }
@@ -45,11 +45,16 @@ public:
     [[nodiscard]] static Utf16String create(StringView);
     [[nodiscard]] static Utf16String create(Utf16View const&);
 
-    Utf16Data const& string() const;
     Utf16View view() const;
     Utf16View substring_view(size_t code_unit_offset, size_t code_unit_length) const;
     Utf16View substring_view(size_t code_unit_offset) const;
 
+    // Substrings of at least min_shared_substring_length code units share the code units of this string
+    // instead of copying them, at the cost of keeping the whole string alive.
+    static constexpr size_t min_shared_substring_length = 32;
+    [[nodiscard]] Utf16String substring(size_t code_unit_offset, size_t code_unit_length) const;
+    [[nodiscard]] Utf16String substring(size_t code_unit_offset) const;
+
     [[nodiscard]] String to_utf8() const;
     [[nodiscard]] ByteString to_byte_string() const;
     u16 code_unit_at(size_t index) const;
@@ -59,8 +64,11 @@ public:
 
 private:
     explicit Utf16String(NonnullRefPtr<Detail::Utf16StringImpl>);
+    Utf16String(NonnullRefPtr<Detail::Utf16StringImpl>, size_t code_unit_offset, size_t code_unit_length);
 
     NonnullRefPtr<Detail::Utf16StringImpl> m_string;
+    size_t m_code_unit_offset { 0 };
+    size_t m_code_unit_length { 0 };
 };
 
 }
@@ -9,6 +9,7 @@
 #include <AK/QuickSort.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
@@ -128,13 +129,23 @@ void SourceTextModule::visit_edges(Cell::Visitor& visitor)
 // 16.2.1.6.1 ParseModule ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parsemodule
 Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::parse(StringView source_text, Realm& realm, StringView filename, Script::HostDefined* host_defined)
 {
-    // 1. Let body be ParseText(sourceText, Module).
-    auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
-    auto body = parser.parse_program();
+    // OPTIMIZATION: If we've parsed the exact same source before, reuse its parse node (and the bytecode attached to it).
+    auto& program_cache = realm.vm().program_cache();
+    auto cached_body = program_cache.get(source_text, filename, 1, Program::Type::Module);
 
-    // 2. If body is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+    if (!cached_body) {
+        // 1. Let body be ParseText(sourceText, Module).
+        auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
+        auto parsed_body = parser.parse_program();
+
+        // 2. If body is a List of errors, return body.
+        if (parser.has_errors())
+            return parser.errors();
+
+        program_cache.set(source_text, filename, 1, parsed_body);
+        cached_body = move(parsed_body);
+    }
+    auto body = cached_body.release_nonnull();
 
     // 3. Let requestedModules be the ModuleRequests of body.
     auto requested_modules = module_requests(*body);
@@ -714,12 +725,17 @@ ThrowCompletionOr<void> SourceTextModule::execute_module(VM& vm, GCPtr<PromiseCa
         // c. Let result be the result of evaluating module.[[ECMAScriptCode]].
         Completion result;
 
-        auto maybe_executable = Bytecode::compile(vm, m_ecmascript_code, FunctionKind::Normal, "ShadowRealmEval"sv);
-        if (maybe_executable.is_error())
-            result = maybe_executable.release_error();
-        else {
-            auto executable = maybe_executable.release_value();
+        // NOTE: The parse node may be shared with other modules of the same source text (see ProgramCache), so the
+        //       bytecode is kept with it, just like the bytecode of functions.
+        if (!m_ecmascript_code->bytecode_executable()) {
+            auto maybe_executable = Bytecode::compile(vm, m_ecmascript_code, FunctionKind::Normal, "ShadowRealmEval"sv);
+            if (maybe_executable.is_error())
+                result = maybe_executable.release_error();
+            else
+                m_ecmascript_code->set_bytecode_executable(maybe_executable.value().ptr());
+        }
 
+        if (auto* executable = m_ecmascript_code->bytecode_executable()) {
             auto result_and_return_register = vm.bytecode_interpreter().run_executable(*executable, {});
             if (result_and_return_register.value.is_error()) {
                 result = result_and_return_register.value.release_error();
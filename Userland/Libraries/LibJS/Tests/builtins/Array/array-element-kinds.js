@@ -0,0 +1,164 @@
+describe("element kind transitions", () => {
+    test("indexOf on int32 arrays", () => {
+        const array = [1, 2, 3, 4];
+        expect(array.indexOf(3)).toBe(2);
+        expect(array.indexOf(3.0)).toBe(2);
+        expect(array.indexOf("3")).toBe(-1);
+        expect(array.indexOf(5)).toBe(-1);
+        expect(array.indexOf(1, 1)).toBe(-1);
+        expect(array.indexOf(4, -1)).toBe(3);
+    });
+
+    test("indexOf on number arrays", () => {
+        const array = [1, 2.5, NaN, -0];
+        expect(array.indexOf(2.5)).toBe(1);
+        expect(array.indexOf(NaN)).toBe(-1);
+        expect(array.indexOf(0)).toBe(3);
+        expect(array.indexOf("2.5")).toBe(-1);
+        expect(array.indexOf(undefined)).toBe(-1);
+    });
+
+    test("storing a different kind of value widens the array", () => {
+        const array = [1, 2, 3];
+        array[1] = 1.5;
+        expect(array.indexOf(1.5)).toBe(1);
+        array[2] = "foo";
+        expect(array.indexOf("foo")).toBe(2);
+        expect(array.indexOf(1)).toBe(0);
+    });
+
+    test("holes are not found and are inherited from the prototype", () => {
+        const array = [1, 2, 3];
+        array[5] = 6;
+        expect(array.indexOf(undefined)).toBe(-1);
+        delete array[0];
+        expect(array.indexOf(1)).toBe(-1);
+
+        Array.prototype[0] = 1;
+        try {
+            expect(array.indexOf(1)).toBe(0);
+            const seen = [];
+            array.forEach(value => seen.push(value));
+            expect(seen).toEqual([1, 2, 3, 6]);
+        } finally {
+            delete Array.prototype[0];
+        }
+    });
+
+    test("an emptied array starts over", () => {
+        const array = [1, "two"];
+        array.pop();
+        array.pop();
+        array.push(1, 2);
+        expect(array.indexOf(2)).toBe(1);
+        array.length = 4;
+        expect(array.indexOf(undefined)).toBe(-1);
+    });
+});
+
+describe("push", () => {
+    test("appends to arrays", () => {
+        const array = [];
+        expect(array.push(1, 2.5, "three")).toBe(3);
+        expect(array).toEqual([1, 2.5, "three"]);
+    });
+
+    test("respects setters on the prototype", () => {
+        let setterValue;
+        Object.defineProperty(Array.prototype, 2, {
+            set(value) {
+                setterValue = value;
+            },
+            configurable: true,
+        });
+        try {
+            const array = [1, 2];
+            array.push(3);
+            expect(setterValue).toBe(3);
+            expect(array.length).toBe(3);
+            expect(Object.hasOwn(array, 2)).toBeFalse();
+        } finally {
+            delete Array.prototype[2];
+        }
+    });
+
+    test("does not add elements to non-extensible arrays", () => {
+        const array = Object.preventExtensions([1, 2]);
+        expect(() => array.push(3)).toThrow(TypeError);
+        expect(array).toEqual([1, 2]);
+    });
+
+    test("does not change a non-writable length", () => {
+        const array = [1, 2];
+        Object.defineProperty(array, "length", { writable: false });
+        expect(() => array.push(3)).toThrow(TypeError);
+        expect(array.length).toBe(2);
+    });
+});
+
+describe("callbacks that modify the array", () => {
+    test("forEach sees appended and removed elements", () => {
+        const array = [1, 2, 3, 4];
+        const seen = [];
+        array.forEach((value, index) => {
+            seen.push(value);
+            if (index === 0) {
+                array.pop();
+                array[1] = "changed";
+            }
+        });
+        expect(seen).toEqual([1, "changed", 3]);
+    });
+
+    test("forEach skips elements deleted by the callback", () => {
+        const array = [1, 2, 3];
+        const seen = [];
+        array.forEach(value => {
+            seen.push(value);
+            delete array[1];
+        });
+        expect(seen).toEqual([1, 3]);
+    });
+
+    test("map sees accessors defined by the callback", () => {
+        const array = [1, 2, 3];
+        const result = array.map((value, index) => {
+            if (index === 0) {
+                Object.defineProperty(array, 2, {
+                    get() {
+                        return 30;
+                    },
+                });
+            }
+            return value * 2;
+        });
+        expect(result).toEqual([2, 4, 60]);
+    });
+
+    test("map preserves holes created by the callback", () => {
+        const array = [1, 2, 3];
+        const result = array.map(value => {
+            array.length = 1;
+            return value;
+        });
+        expect(result).toHaveLength(3);
+        expect(Object.hasOwn(result, 1)).toBeFalse();
+        expect(result[0]).toBe(1);
+    });
+});
+
+describe("sort", () => {
+    test("sorts numbers by their string representation", () => {
+        expect([10, 9, 1, -1, 100, 2.5, 0, -0].sort()).toEqual([-1, 0, -0, 1, 10, 100, 2.5, 9]);
+        expect([1e21, 5, NaN, Infinity].sort()).toEqual([1e21, 5, Infinity, NaN]);
+    });
+
+    test("keeps equal elements in order", () => {
+        const array = [0, 1, -0, 0];
+        array.sort();
+        expect(Object.is(array[0], 0)).toBeTrue();
+        expect(Object.is(array[1], -0)).toBeTrue();
+        expect(Object.is(array[2], 0)).toBeTrue();
+        expect(array[3]).toBe(1);
+    });
+});
@@ -0,0 +1,223 @@
+// These exercise code shapes that the bytecode optimization passes rewrite, so that a pass
+// that changes what a program does shows up as a failing test.
+
+describe("merging blocks across try/finally", () => {
+    test("finally runs after falling out of the try block", () => {
+        const log = [];
+        try {
+            log.push("try");
+        } finally {
+            log.push("finally");
+        }
+        log.push("after");
+        expect(log).toEqual(["try", "finally", "after"]);
+    });
+
+    test("code after a try block isn't covered by its catch", () => {
+        const log = [];
+        expect(() => {
+            try {
+                log.push("try");
+            } catch {
+                log.push("catch");
+            }
+            throw new Error("after try");
+        }).toThrowWithMessage(Error, "after try");
+        expect(log).toEqual(["try"]);
+    });
+
+    test("code after a finally block isn't covered by an outer finally twice", () => {
+        const log = [];
+        try {
+            try {
+                log.push("inner try");
+            } finally {
+                log.push("inner finally");
+            }
+            log.push("between");
+        } finally {
+            log.push("outer finally");
+        }
+        expect(log).toEqual(["inner try", "inner finally", "between", "outer finally"]);
+    });
+
+    test("break and continue through finally in a loop", () => {
+        const log = [];
+        for (let i = 0; i < 4; ++i) {
+            try {
+                if (i === 1) continue;
+                if (i === 3) break;
+                log.push(`body ${i}`);
+            } finally {
+                log.push(`finally ${i}`);
+            }
+        }
+        expect(log).toEqual(["body 0", "finally 0", "finally 1", "body 2", "finally 2", "finally 3"]);
+    });
+
+    test("return from try and catch through finally", () => {
+        const log = [];
+        function f(shouldThrow) {
+            try {
+                if (shouldThrow) throw 1;
+                return "try";
+            } catch {
+                return "catch";
+            } finally {
+                log.push("finally");
+            }
+        }
+        expect(f(false)).toBe("try");
+        expect(f(true)).toBe("catch");
+        expect(log).toEqual(["finally", "finally"]);
+    });
+
+    test("exception thrown from finally after a completed try", () => {
+        const log = [];
+        expect(() => {
+            try {
+                log.push("try");
+            } finally {
+                log.push("finally");
+                throw new Error("from finally");
+            }
+        }).toThrowWithMessage(Error, "from finally");
+        expect(log).toEqual(["try", "finally"]);
+    });
+});
+
+describe("folding constant branches", () => {
+    test("if statements on constants", () => {
+        const log = [];
+        if (true) log.push("true");
+        if (false) log.push("false");
+        if (0) log.push("0");
+        if (-0) log.push("-0");
+        if (NaN) log.push("NaN");
+        if (1) log.push("1");
+        if (null) log.push("null");
+        if (undefined) log.push("undefined");
+        else log.push("else undefined");
+        expect(log).toEqual(["true", "1", "else undefined"]);
+    });
+
+    test("branches on values that aren't primitive constants are kept", () => {
+        const log = [];
+        if ("") log.push("empty string");
+        if ("0") log.push("string 0");
+        if (0n) log.push("0n");
+        if (1n) log.push("1n");
+        if ({}) log.push("object");
+        expect(log).toEqual(["string 0", "1n", "object"]);
+    });
+
+    test("conditional expressions and logical operators on constants", () => {
+        expect(true ? "yes" : "no").toBe("yes");
+        expect(false ? "yes" : "no").toBe("no");
+        expect(null ?? "default").toBe("default");
+        expect(undefined ?? "default").toBe("default");
+        expect(0 ?? "default").toBe(0);
+        expect(false || "right").toBe("right");
+        expect(true && "right").toBe("right");
+        expect(null?.foo).toBeUndefined();
+    });
+
+    test("loops with constant conditions", () => {
+        let iterations = 0;
+        while (false) iterations++;
+        expect(iterations).toBe(0);
+
+        do {
+            iterations++;
+        } while (false);
+        expect(iterations).toBe(1);
+
+        while (true) {
+            if (++iterations === 5) break;
+        }
+        expect(iterations).toBe(5);
+
+        for (;;) {
+            if (++iterations === 10) break;
+        }
+        expect(iterations).toBe(10);
+    });
+
+    test("constant branch inside try still reaches the handler", () => {
+        let caught = false;
+        try {
+            if (true) throw new Error("thrown");
+        } catch {
+            caught = true;
+        }
+        expect(caught).toBeTrue();
+    });
+});
+
+describe("register compaction", () => {
+    test("values that live across loop iterations", () => {
+        let a = 1;
+        let b = 2;
+        let sum = 0;
+        for (let i = 0; i < 10; ++i) {
+            const t = a + b * i;
+            sum += t;
+            [a, b] = [b, t % 7];
+        }
+        expect(sum).toBe(144);
+        expect(a).toBe(5);
+        expect(b).toBe(3);
+    });
+
+    test("temporaries in nested loops", () => {
+        const result = [];
+        for (let i = 0; i < 3; ++i) {
+            let row = "";
+            for (let j = 0; j < 3; ++j) {
+                row += (i * 3 + j).toString() + (j < 2 ? "," : "");
+            }
+            result.push(row);
+        }
+        expect(result).toEqual(["0,1,2", "3,4,5", "6,7,8"]);
+    });
+
+    test("registers that live across yield in a loop", () => {
+        function* generator() {
+            let total = 0;
+            for (let i = 0; i < 3; ++i) {
+                const before = total;
+                total += yield i;
+                expect(total).toBeGreaterThanOrEqual(before);
+            }
+            return total;
+        }
+        const iterator = generator();
+        expect(iterator.next().value).toBe(0);
+        expect(iterator.next(10).value).toBe(1);
+        expect(iterator.next(20).value).toBe(2);
+        expect(iterator.next(30)).toEqual({ value: 60, done: true });
+    });
+
+    test("registers that live across await in a loop", () => {
+        let result;
+        async function f() {
+            let product = 1;
+            for (const factor of [2, 3, 4]) product *= await factor;
+            return product;
+        }
+        f().then(value => {
+            result = value;
+        });
+        runQueuedPromiseJobs();
+        expect(result).toBe(24);
+    });
+
+    test("closures created in a loop", () => {
+        const functions = [];
+        for (let i = 0; i < 3; ++i) {
+            const doubled = i * 2;
+            functions.push(() => doubled + 1);
+        }
+        expect(functions.map(f => f())).toEqual([1, 3, 5]);
+    });
+});
@@ -0,0 +1,104 @@
+// NOTE: The functions in this file are deliberately long enough for their bodies to be dropped
+//       after parsing and parsed again when they are first called.
+
+var globalCounter = 0;
+const globalConstant = "global";
+
+function bumpGlobalCounter(amount) {
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    globalCounter += amount;
+    return globalCounter + globalConstant.length;
+}
+
+function makeCounter(start) {
+    let count = start;
+    function increment(step) {
+        // This comment only exists to make the function long enough to not be parsed eagerly.
+        // This comment only exists to make the function long enough to not be parsed eagerly.
+        count += step;
+        return count;
+    }
+    return { increment, current: () => count };
+}
+
+function sumArguments() {
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    let sum = 0;
+    for (let i = 0; i < arguments.length; ++i) sum += arguments[i];
+    return sum;
+}
+
+function* countTo(limit) {
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    for (let i = 1; i <= limit; ++i) yield i;
+}
+
+async function doubleLater(value) {
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    // This comment only exists to make the function long enough to not be parsed eagerly.
+    return (await value) * 2;
+}
+
+test("functions can access global variables", () => {
+    expect(bumpGlobalCounter(2)).toBe(8);
+    expect(bumpGlobalCounter(3)).toBe(11);
+    expect(globalCounter).toBe(5);
+});
+
+test("nested functions can access variables of the enclosing function", () => {
+    const counter = makeCounter(10);
+    expect(counter.increment(5)).toBe(15);
+    expect(counter.increment(1)).toBe(16);
+    expect(counter.current()).toBe(16);
+
+    const otherCounter = makeCounter(0);
+    expect(otherCounter.increment(1)).toBe(1);
+    expect(counter.current()).toBe(16);
+});
+
+test("arguments object", () => {
+    expect(sumArguments()).toBe(0);
+    expect(sumArguments(1, 2, 3)).toBe(6);
+});
+
+test("generator functions", () => {
+    expect([...countTo(3)]).toEqual([1, 2, 3]);
+});
+
+test("async functions", () => {
+    let result;
+    doubleLater(Promise.resolve(21)).then(value => {
+        result = value;
+    });
+    runQueuedPromiseJobs();
+    expect(result).toBe(42);
+});
+
+test("function expressions in strict mode code", () => {
+    "use strict";
+    const isStrict = function () {
+        // This comment only exists to make the function long enough to not be parsed eagerly.
+        // This comment only exists to make the function long enough to not be parsed eagerly.
+        return this === undefined;
+    };
+    expect(isStrict()).toBeTrue();
+});
+
+test("source text is kept", () => {
+    const source = sumArguments.toString();
+    expect(source.startsWith("function sumArguments() {")).toBeTrue();
+    expect(source.endsWith("return sum;\n}")).toBeTrue();
+});
+
+test("syntax errors in function bodies are still reported", () => {
+    expect(`
+        function hasSyntaxError() {
+            // This comment only exists to make the function long enough to not be parsed eagerly.
+            // This comment only exists to make the function long enough to not be parsed eagerly.
+            return 1 +;
+        }
+    `).not.toEval();
+});
@@ -16,3 +16,125 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic property access sees the right property for every shape", () => {
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    let objects = [{ x: 0 }, { a: 1, x: 1 }, { a: 1, b: 2, x: 2 }, { a: 1, b: 2, c: 3, x: 3 }];
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j + i * 10);
+            put(objects[j], j + (i + 1) * 10);
+        }
+    }
+});
+
+test("Megamorphic property access", () => {
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    let objects = [];
+    for (let i = 0; i < 20; ++i) {
+        let o = {};
+        o["p" + i] = i;
+        o.x = i;
+        objects.push(o);
+    }
+
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(get(objects[j])).toBe(j + i * 100);
+            put(objects[j], j + (i + 1) * 100);
+        }
+    }
+
+    // Same shapes, but the property is found in the prototype chain and then shadowed.
+    let prototype = { y: "from prototype" };
+    let inheriting = objects.map(o => Object.setPrototypeOf({ ...o }, prototype));
+    function get_y(o) {
+        return o.y;
+    }
+    for (let o of inheriting) expect(get_y(o)).toBe("from prototype");
+    prototype.y = "changed";
+    for (let o of inheriting) expect(get_y(o)).toBe("changed");
+    delete prototype.y;
+    for (let o of inheriting) expect(get_y(o)).toBeUndefined();
+});
+
+test("Cached reads don't make non-writable properties writable", () => {
+    "use strict";
+    function get(o) {
+        return o.x;
+    }
+    function put(o, value) {
+        o.x = value;
+    }
+
+    let objects = [];
+    for (let i = 0; i < 10; ++i) {
+        let o = {};
+        o["p" + i] = i;
+        Object.defineProperty(o, "x", { value: i, writable: false });
+        objects.push(o);
+    }
+
+    for (let o of objects) get(o);
+    for (let o of objects) expect(() => put(o, 42)).toThrow(TypeError);
+    for (let i = 0; i < objects.length; ++i) expect(get(objects[i])).toBe(i);
+});
+
+// Deleting a property of the global object gives it a new shape, so this makes the global variable accesses that
+// happen in between see a new shape every time.
+function giveGlobalObjectNewShapes(callback) {
+    for (let i = 0; i < 10; ++i) {
+        globalThis["temporary" + i] = i;
+        delete globalThis["temporary" + i];
+        callback();
+    }
+}
+
+test("Megamorphic global variable access doesn't use cached prototype properties", () => {
+    Object.prototype.inheritedGlobal = "from prototype";
+    function readGlobal() {
+        return inheritedGlobal;
+    }
+    function readProperty(o) {
+        return o.inheritedGlobal;
+    }
+
+    for (let i = 0; i < 10; ++i) expect(readProperty({ ["p" + i]: i })).toBe("from prototype");
+
+    globalThis.inheritedGlobal = "own";
+    giveGlobalObjectNewShapes(() => expect(readGlobal()).toBe("own"));
+
+    // Now the property is found in the prototype chain, and the megamorphic property access caches it as such.
+    delete globalThis.inheritedGlobal;
+    expect(readProperty(globalThis)).toBe("from prototype");
+    expect(readGlobal()).toBe("from prototype");
+    expect(readGlobal()).toBe("from prototype");
+
+    delete Object.prototype.inheritedGlobal;
+});
+
+test("Megamorphic global variable access sees new lexical declarations", () => {
+    globalThis.shadowedGlobal = "global object";
+    function readGlobal() {
+        return shadowedGlobal;
+    }
+
+    giveGlobalObjectNewShapes(() => expect(readGlobal()).toBe("global object"));
+
+    evaluateScript('let shadowedGlobal = "lexical";');
+    expect(readGlobal()).toBe("lexical");
+    expect(readGlobal()).toBe("lexical");
+    expect(globalThis.shadowedGlobal).toBe("global object");
+});
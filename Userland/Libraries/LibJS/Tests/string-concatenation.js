@@ -28,3 +28,71 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("adding strings with dangling surrogates to long strings", () => {
+    const prefix = "x".repeat(100);
+    expect(prefix + "\ud834" + "\udf06").toBe(prefix + "𝌆");
+    expect((prefix + "\ud834" + "\udf06").length).toBe(102);
+    expect(("\ud834" + prefix + "\udf06").length).toBe(102);
+});
+
+test("building a long string", () => {
+    let string = "";
+    for (let i = 0; i < 100_000; ++i) {
+        string += String.fromCharCode(97 + (i % 26));
+        // Checking the length of a string while building it shouldn't make building it quadratic.
+        expect(string.length).toBe(i + 1);
+    }
+
+    expect(string.length).toBe(100_000);
+    expect(string.substring(0, 28)).toBe("abcdefghijklmnopqrstuvwxyzab");
+    expect(string.slice(-2)).toBe("cd");
+    expect(string[26 * 1000 + 3]).toBe("d");
+});
+
+test("building a long string from long pieces", () => {
+    const piece = "abcdefghijklmnopqrstuvwxyz0123456789";
+    let string = "";
+    for (let i = 0; i < 10_000; ++i) string += piece;
+
+    expect(string.length).toBe(piece.length * 10_000);
+    expect(string.endsWith(piece)).toBeTrue();
+    expect(string.indexOf("9a")).toBe(piece.length - 1);
+});
+
+test("building a deep rope from long pieces", () => {
+    // Every piece is too long to be merged into its neighbor, so each append makes the rope one level deeper.
+    // The second piece comes from slice(), so it is stored as UTF-16 rather than UTF-8.
+    const pieces = ["abcdefghijklmnopqrstuvwxyz012345", "ABCDEFGHIJKLMNOPQRSTUVWXYZ012345".slice(0)];
+    const pieceLength = pieces[0].length;
+    let string = "";
+    for (let i = 0; i < 20_000; ++i) {
+        string += pieces[i % 2];
+        expect(string.length).toBe((i + 1) * pieceLength);
+    }
+
+    expect(string.slice(0, pieceLength * 2)).toBe(pieces[0] + pieces[1]);
+    expect(string.slice(-pieceLength)).toBe(pieces[1]);
+    expect(string[pieceLength * 19_999]).toBe("A");
+    expect(string.indexOf("5A")).toBe(pieceLength - 1);
+});
+
+test("building a long string from both ends", () => {
+    let string = "-";
+    for (let i = 0; i < 10_000; ++i) string = "<" + string + ">";
+
+    expect(string.length).toBe(20_001);
+    expect(string[10_000]).toBe("-");
+    expect(string.lastIndexOf("<")).toBe(9_999);
+});
+
+test("substrings of long strings", () => {
+    const string = "abcdefghijklmnopqrstuvwxyz".repeat(10);
+    const slice = string.slice(26, 26 * 3);
+    expect(slice).toBe("abcdefghijklmnopqrstuvwxyz".repeat(2));
+    expect(slice.length).toBe(52);
+    expect(slice.slice(1, 3)).toBe("bc");
+    expect(slice.substring(26)).toBe("abcdefghijklmnopqrstuvwxyz");
+    expect(slice + "!").toBe("abcdefghijklmnopqrstuvwxyz".repeat(2) + "!");
+    expect(string.split("z", 2)).toEqual(["abcdefghijklmnopqrstuvwxy", "abcdefghijklmnopqrstuvwxy"]);
+});
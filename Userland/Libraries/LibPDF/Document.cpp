@@ -146,11 +146,44 @@ PDFErrorOr<Value> Document::get_or_load_value(u32 index)
     if (!value.has<Empty>()) // FIXME: Use Optional instead?
         return value;
 
+    if (auto it = m_streams.find(index); it != m_streams.end()) {
+        it->value.last_used = ++m_stream_use_counter;
+        return Value { it->value.stream };
+    }
+
     auto object = TRY(m_parser->parse_object_with_index(index));
+    if (object.has<NonnullRefPtr<Object>>() && object.get<NonnullRefPtr<Object>>()->is<StreamObject>()) {
+        auto stream = object.get<NonnullRefPtr<Object>>()->cast<StreamObject>();
+        stream->set_object_index(index);
+        cache_stream(index, move(stream));
+        return object;
+    }
     m_values.set(index, object);
     return object;
 }
 
+void Document::cache_stream(u32 index, NonnullRefPtr<StreamObject> stream)
+{
+    // Unlike other objects, streams can be large once decoded. Only keep the most recently used ones, and
+    // parse the others again from the file when they are needed.
+    auto size_in_bytes = stream->bytes().size();
+    if (size_in_bytes > max_cached_streams_size_in_bytes)
+        return;
+
+    while (m_cached_streams_size_in_bytes + size_in_bytes > max_cached_streams_size_in_bytes) {
+        auto oldest = m_streams.begin();
+        for (auto it = m_streams.begin(); it != m_streams.end(); ++it) {
+            if (it->value.last_used < oldest->value.last_used)
+                oldest = it;
+        }
+        m_cached_streams_size_in_bytes -= oldest->value.stream->bytes().size();
+        m_streams.remove(oldest);
+    }
+
+    m_cached_streams_size_in_bytes += size_in_bytes;
+    m_streams.set(index, CachedStream { move(stream), ++m_stream_use_counter });
+}
+
 u32 Document::get_first_page_index() const
 {
     // FIXME: A PDF can have a different default first page, which
@@ -243,9 +276,9 @@ PDFErrorOr<Page> Document::get_page(u32 index)
     else
         resources = make_object<DictObject>(HashMap<DeprecatedFlyString, Value> {});
 
-    RefPtr<Object> contents;
+    Value contents;
     if (raw_page_object->contains(CommonNames::Contents))
-        contents = TRY(raw_page_object->get_object(this, CommonNames::Contents));
+        contents = raw_page_object->get_value(CommonNames::Contents);
 
     Rectangle media_box;
     auto maybe_media_box_object = TRY(get_inheritable_object(CommonNames::MediaBox, raw_page_object));
@@ -291,7 +324,7 @@ PDFErrorOr<Page> Document::get_page(u32 index)
         VERIFY(rotate % 90 == 0);
     }
 
-    Page page { resources.release_nonnull(), move(contents), media_box, crop_box, user_unit, rotate };
+    Page page { resources.release_nonnull(), move(contents), media_box, crop_box, user_unit, rotate, page_object_index };
     m_pages.set(index, page);
     return page;
 }
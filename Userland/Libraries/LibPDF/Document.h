@@ -16,6 +16,7 @@
 #include <LibPDF/Error.h>
 #include <LibPDF/ObjectDerivatives.h>
 #include <LibPDF/Page.h>
+#include <LibPDF/ResourceCache.h>
 
 namespace PDF {
 
@@ -131,6 +132,8 @@ public:
 
     ALWAYS_INLINE Value get_value(u32 index) const
     {
+        if (auto stream = m_streams.get(index); stream.has_value())
+            return stream->stream;
         return m_values.get(index).value_or({});
     }
 
@@ -158,6 +161,9 @@ public:
 
     PDFErrorOr<void> unfilter_stream(NonnullRefPtr<StreamObject> stream) { return m_parser->unfilter_stream(move(stream)); }
 
+    // Fonts, images and content streams decoded while rendering, shared by all renders of this document.
+    ResourceCache& resource_cache() { return m_resource_cache; }
+
 private:
     explicit Document(NonnullRefPtr<DocumentParser> const& parser);
 
@@ -185,6 +191,15 @@ private:
     PDFErrorOr<NonnullRefPtr<Object>> find_in_name_tree_nodes(NonnullRefPtr<ArrayObject> siblings, DeprecatedFlyString name);
     PDFErrorOr<NonnullRefPtr<Object>> find_in_key_value_array(NonnullRefPtr<ArrayObject> key_value_array, DeprecatedFlyString name);
 
+    void cache_stream(u32 index, NonnullRefPtr<StreamObject>);
+
+    struct CachedStream {
+        NonnullRefPtr<StreamObject> stream;
+        u64 last_used { 0 };
+    };
+
+    static constexpr size_t max_cached_streams_size_in_bytes = 32 * MiB;
+
     NonnullRefPtr<DocumentParser> m_parser;
     Version m_version;
     RefPtr<DictObject> m_catalog;
@@ -192,8 +207,12 @@ private:
     Vector<u32> m_page_object_indices;
     HashMap<u32, Page> m_pages;
     HashMap<u32, Value> m_values;
+    HashMap<u32, CachedStream> m_streams;
+    size_t m_cached_streams_size_in_bytes { 0 };
+    u64 m_stream_use_counter { 0 };
     RefPtr<OutlineDict> m_outline;
     RefPtr<SecurityHandler> m_security_handler;
+    ResourceCache m_resource_cache;
 };
 
 }
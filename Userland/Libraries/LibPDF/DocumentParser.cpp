@@ -590,9 +590,13 @@ PDFErrorOr<NonnullRefPtr<DictObject>> DocumentParser::parse_file_trailer()
     return parse_dict();
 }
 
-PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+PDFErrorOr<void> DocumentParser::load_object_stream(u32 object_stream_index)
 {
-    auto object_stream_index = m_xref_table->object_stream_for_object(index);
+    if (auto it = m_object_streams.find(object_stream_index); it != m_object_streams.end()) {
+        it->value.last_used = ++m_object_stream_use_counter;
+        return {};
+    }
+
     auto stream_offset = m_xref_table->byte_offset_for_object(object_stream_index);
 
     m_reader.move_to(stream_offset);
@@ -612,21 +616,53 @@ PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
     auto object_count = dict->get_value("N").get_u32();
     auto first_object_offset = dict->get_value("First").get_u32();
 
+    // Index the pairs of object numbers and offsets at the start of the stream once, instead of scanning
+    // them every time one of the objects in the stream is looked up.
     Parser stream_parser(m_document, stream->bytes());
-
-    // The data was already decrypted when reading the outer compressed ObjStm.
-    stream_parser.set_encryption_enabled(false);
-
+    HashMap<u32, u32> object_offsets;
+    TRY(object_offsets.try_ensure_capacity(object_count));
     for (u32 i = 0; i < object_count; ++i) {
         auto object_number = TRY(stream_parser.parse_number());
         auto object_offset = TRY(stream_parser.parse_number());
+        object_offsets.ensure(object_number.get_u32(), [&] { return first_object_offset + object_offset.get_u32(); });
+    }
 
-        if (object_number.get_u32() == index) {
-            stream_parser.move_to(first_object_offset + object_offset.get_u32());
-            break;
+    // Keep recently used object streams around, so that loading all objects of a stream doesn't decompress it
+    // every time. The least recently used ones are evicted once they take up too much memory.
+    auto size_in_bytes = stream->bytes().size();
+    while (!m_object_streams.is_empty() && m_object_streams_size_in_bytes + size_in_bytes > max_object_streams_size_in_bytes) {
+        auto oldest = m_object_streams.begin();
+        for (auto it = m_object_streams.begin(); it != m_object_streams.end(); ++it) {
+            if (it->value.last_used < oldest->value.last_used)
+                oldest = it;
         }
+        m_object_streams_size_in_bytes -= oldest->value.stream->bytes().size();
+        m_object_streams.remove(oldest);
     }
+    m_object_streams_size_in_bytes += size_in_bytes;
+
+    m_object_streams.set(object_stream_index, ObjectStream { move(stream), move(object_offsets), ++m_object_stream_use_counter });
+    return {};
+}
+
+PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+{
+    auto object_stream_index = m_xref_table->object_stream_for_object(index);
+    TRY(load_object_stream(object_stream_index));
+    auto const& object_stream = m_object_streams.get(object_stream_index).value();
+
+    auto object_offset = object_stream.object_offsets.get(index);
+    if (!object_offset.has_value())
+        return error("Object not found in object stream");
+
+    // Keep the stream alive while parsing from it, in case the cache evicts it in the meantime.
+    auto stream = object_stream.stream;
+    Parser stream_parser(m_document, stream->bytes());
+
+    // The data was already decrypted when reading the outer compressed ObjStm.
+    stream_parser.set_encryption_enabled(false);
 
+    stream_parser.move_to(object_offset.value());
     stream_parser.push_reference({ index, 0 });
     auto value = TRY(stream_parser.parse_value());
     stream_parser.pop_reference();
@@ -95,6 +95,15 @@ private:
     PDFErrorOr<NonnullRefPtr<XRefTable>> parse_xref_stream();
     PDFErrorOr<NonnullRefPtr<XRefTable>> parse_xref_table();
     PDFErrorOr<NonnullRefPtr<DictObject>> parse_file_trailer();
+    struct ObjectStream {
+        NonnullRefPtr<StreamObject> stream;
+        HashMap<u32, u32> object_offsets;
+        u64 last_used { 0 };
+    };
+
+    static constexpr size_t max_object_streams_size_in_bytes = 8 * MiB;
+
+    PDFErrorOr<void> load_object_stream(u32 object_stream_index);
     PDFErrorOr<Value> parse_compressed_object_with_index(u32 index);
 
     bool navigate_to_before_eof_marker();
@@ -102,6 +111,10 @@ private:
 
     RefPtr<XRefTable> m_xref_table;
     Optional<LinearizationDictionary> m_linearization_dictionary;
+
+    HashMap<u32, ObjectStream> m_object_streams;
+    size_t m_object_streams_size_in_bytes { 0 };
+    u64 m_object_stream_use_counter { 0 };
 };
 
 }
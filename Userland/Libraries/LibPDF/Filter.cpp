@@ -133,32 +133,32 @@ PDFErrorOr<ByteBuffer> Filter::decode_ascii85(ReadonlyBytes bytes)
     return buffer;
 }
 
-PDFErrorOr<ByteBuffer> Filter::decode_png_prediction(Bytes bytes, size_t bytes_per_row, size_t bytes_per_pixel)
+PDFErrorOr<ByteBuffer> Filter::decode_png_prediction(ByteBuffer buffer, size_t bytes_per_row, size_t bytes_per_pixel)
 {
-    int number_of_rows = bytes.size() / bytes_per_row;
+    size_t number_of_rows = buffer.size() / bytes_per_row;
+    size_t decoded_bytes_per_row = bytes_per_row - 1;
 
-    ByteBuffer decoded;
-    TRY(decoded.try_ensure_capacity(bytes.size() - number_of_rows));
+    auto empty_row = TRY(ByteBuffer::create_zeroed(decoded_bytes_per_row));
+    ReadonlyBytes previous_row = empty_row.bytes();
 
-    auto empty_row = TRY(ByteBuffer::create_zeroed(bytes_per_row - 1));
-    auto previous_row = empty_row.bytes();
-
-    for (int row_index = 0; row_index < number_of_rows; ++row_index) {
-        auto row = Bytes { bytes.data() + row_index * bytes_per_row, bytes_per_row };
-
-        auto filter = TRY(Gfx::PNG::filter_type(row[0]));
-        row = row.slice(1);
+    // Rows are decoded in place, and then moved back over the filter type bytes of the rows before them.
+    // A decoded row never overlaps the encoded row after it, so this doesn't need a second buffer.
+    for (size_t row_index = 0; row_index < number_of_rows; ++row_index) {
+        auto filter = TRY(Gfx::PNG::filter_type(buffer[row_index * bytes_per_row]));
+        auto row = buffer.bytes().slice(row_index * bytes_per_row + 1, decoded_bytes_per_row);
 
         Gfx::PNGImageDecoderPlugin::unfilter_scanline(filter, row, previous_row, bytes_per_pixel);
 
-        previous_row = row;
-        decoded.append(row);
+        auto decoded_row = buffer.bytes().slice(row_index * decoded_bytes_per_row, decoded_bytes_per_row);
+        memmove(decoded_row.data(), row.data(), decoded_bytes_per_row);
+        previous_row = decoded_row;
     }
 
-    return decoded;
+    buffer.resize(number_of_rows * decoded_bytes_per_row);
+    return buffer;
 }
 
-PDFErrorOr<ByteBuffer> Filter::decode_tiff_prediction(Bytes bytes, int columns, int colors, int bits_per_component)
+PDFErrorOr<ByteBuffer> Filter::decode_tiff_prediction(ByteBuffer buffer, int columns, int colors, int bits_per_component)
 {
     // TIFF 6 spec, Section 14: Differencing Predictor.
     // "Assuming 8-bit grayscale pixels for the moment, a basic C implementation might look something like this:
@@ -192,23 +192,19 @@ PDFErrorOr<ByteBuffer> Filter::decode_tiff_prediction(Bytes bytes, int columns,
     // Translate from PDF spec language to TIFF 6 spec language:
     int samples_per_pixel = colors;
 
-    ByteBuffer decoded;
-    TRY(decoded.try_ensure_capacity(bytes.size()));
-
-    while (!bytes.is_empty()) {
-        auto row = bytes.slice(0, columns * samples_per_pixel);
+    // The rows are decoded in place.
+    size_t bytes_per_row = columns * samples_per_pixel;
+    for (auto bytes = buffer.bytes(); !bytes.is_empty(); bytes = bytes.slice(bytes_per_row)) {
+        auto row = bytes.slice(0, bytes_per_row);
         for (int column = 1; column < columns; ++column) {
             for (int sample = 0; sample < samples_per_pixel; ++sample) {
                 int index = column * samples_per_pixel + sample;
                 row[index] += row[index - samples_per_pixel];
             }
         }
-        decoded.append(row);
-
-        bytes = bytes.slice(row.size());
     }
 
-    return decoded;
+    return buffer;
 }
 
 PDFErrorOr<ByteBuffer> Filter::handle_lzw_and_flate_parameters(ByteBuffer buffer, RefPtr<DictObject> decode_parms)
@@ -238,21 +234,20 @@ PDFErrorOr<ByteBuffer> Filter::handle_lzw_and_flate_parameters(ByteBuffer buffer
         return AK::Error::from_string_literal("Invalid predictor value");
 
     // Rows are always a whole number of bytes long, for PNG starting with an algorithm tag.
-    auto buffer_bytes = buffer.bytes();
     size_t bytes_per_row = ceil_div(columns * colors * bits_per_component, 8);
     if (predictor != 2)
         bytes_per_row++;
     if (buffer.size() % bytes_per_row) {
         // Rarely, there is some trailing data after the image data. Ignore the part of it that doesn't fit into a row.
         dbgln_if(PDF_DEBUG, "Predictor input data length {} is not divisible into columns {}, dropping {} bytes", buffer.size(), bytes_per_row, buffer.size() % bytes_per_row);
-        buffer_bytes = buffer_bytes.slice(0, buffer.size() - buffer.size() % bytes_per_row);
+        buffer.resize(buffer.size() - buffer.size() % bytes_per_row);
     }
 
     if (predictor == 2)
-        return decode_tiff_prediction(buffer_bytes, columns, colors, bits_per_component);
+        return decode_tiff_prediction(move(buffer), columns, colors, bits_per_component);
 
     size_t bytes_per_pixel = ceil_div(colors * bits_per_component, 8);
-    return decode_png_prediction(buffer_bytes, bytes_per_row, bytes_per_pixel);
+    return decode_png_prediction(move(buffer), bytes_per_row, bytes_per_pixel);
 }
 
 PDFErrorOr<ByteBuffer> Filter::decode_lzw(ReadonlyBytes bytes, RefPtr<DictObject> decode_parms)
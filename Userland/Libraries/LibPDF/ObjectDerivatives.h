@@ -165,6 +165,10 @@ public:
     [[nodiscard]] ReadonlyBytes bytes() const { return m_buffer.bytes(); }
     [[nodiscard]] ByteBuffer& buffer() { return m_buffer; }
 
+    // The index of the indirect object this stream was loaded from. Inline images don't have one.
+    [[nodiscard]] Optional<u32> object_index() const { return m_object_index; }
+    void set_object_index(u32 object_index) { m_object_index = object_index; }
+
     char const* type_name() const override { return "stream"; }
     ByteString to_byte_string(int indent) const override;
 
@@ -173,6 +177,7 @@ private:
 
     NonnullRefPtr<DictObject> m_dict;
     ByteBuffer m_buffer;
+    Optional<u32> m_object_index;
 };
 
 class IndirectValue final : public Object {
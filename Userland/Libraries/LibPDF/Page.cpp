@@ -10,11 +10,19 @@
 
 namespace PDF {
 
-PDFErrorOr<ByteBuffer> Page::page_contents(Document& document) const
+PDFErrorOr<RefPtr<Object>> Page::contents_object(Document& document) const
 {
     // Table 3.27 Entries in a page object on Contents:
     // "If this entry is absent, the page is empty. [...]"
-    if (contents.is_null())
+    if (contents.has<Empty>())
+        return nullptr;
+    return TRY(document.resolve_to<Object>(contents));
+}
+
+PDFErrorOr<ByteBuffer> Page::page_contents(Document& document) const
+{
+    auto contents = TRY(contents_object(document));
+    if (!contents)
         return ByteBuffer {};
 
     // "The value may be either a single stream or an array of streams. If the value
@@ -8,6 +8,7 @@
 
 #include <AK/RefPtr.h>
 #include <LibPDF/Forward.h>
+#include <LibPDF/Value.h>
 
 namespace PDF {
 
@@ -23,12 +24,17 @@ struct Rectangle {
 
 struct Page {
     NonnullRefPtr<DictObject> resources;
-    RefPtr<Object> contents;
+    // The Contents entry as it appears in the page dictionary. It is only resolved when the page is rendered,
+    // so that looking at a page (e.g. for its size) doesn't load and decompress its content streams.
+    Value contents;
     Rectangle media_box;
     Rectangle crop_box;
     float user_unit;
     int rotate;
+    // The index of the page dictionary, which also identifies the page's parsed contents.
+    u32 object_index;
 
+    PDFErrorOr<RefPtr<Object>> contents_object(Document&) const;
     PDFErrorOr<ByteBuffer> page_contents(Document&) const;
 };
 
@@ -56,7 +62,7 @@ struct Formatter<PDF::Page> : Formatter<FormatString> {
         return Formatter<FormatString>::format(builder,
             "Page {{\n  resources={}\n  contents={}\n  media_box={}\n  crop_box={}\n  user_unit={}\n  rotate={}\n}}"sv,
             page.resources->to_byte_string(1),
-            page.contents->to_byte_string(1),
+            page.contents.to_byte_string(1),
             page.media_box,
             page.crop_box,
             page.user_unit,
@@ -435,12 +435,22 @@ PDFErrorOr<NonnullRefPtr<DictObject>> Parser::parse_dict()
 }
 
 PDFErrorOr<void> Parser::unfilter_stream(NonnullRefPtr<StreamObject> stream_object)
+{
+    return unfilter_stream(stream_object, stream_object->bytes());
+}
+
+PDFErrorOr<void> Parser::unfilter_stream(NonnullRefPtr<StreamObject> stream_object, ReadonlyBytes encoded_bytes)
 {
     auto const& dict = stream_object->dict();
-    if (!dict->contains(CommonNames::Filter))
-        return {};
+    Vector<DeprecatedFlyString> filters;
+    if (dict->contains(CommonNames::Filter))
+        filters = TRY(m_document->read_filters(dict));
 
-    Vector<DeprecatedFlyString> filters = TRY(m_document->read_filters(dict));
+    if (filters.is_empty()) {
+        if (encoded_bytes.data() != stream_object->bytes().data())
+            stream_object->buffer() = TRY(ByteBuffer::copy(encoded_bytes));
+        return {};
+    }
 
     // Every filter may get its own parameter dictionary
     Vector<RefPtr<DictObject>> decode_parms_vector;
@@ -468,7 +478,7 @@ PDFErrorOr<void> Parser::unfilter_stream(NonnullRefPtr<StreamObject> stream_obje
         if (!decode_parms_vector.is_empty())
             decode_parms = decode_parms_vector.at(i);
 
-        stream_object->buffer() = TRY(Filter::decode(m_document, stream_object->bytes(), filters.at(i), decode_parms));
+        stream_object->buffer() = TRY(Filter::decode(m_document, i == 0 ? encoded_bytes : stream_object->bytes(), filters.at(i), decode_parms));
     }
 
     return {};
@@ -506,9 +516,17 @@ PDFErrorOr<NonnullRefPtr<StreamObject>> Parser::parse_stream(NonnullRefPtr<DictO
     m_reader.move_by(9);
     m_reader.consume_whitespace();
 
+    bool needs_decryption = m_document->security_handler() && m_enable_encryption;
+    if (!needs_decryption && m_enable_filters && dict->contains(CommonNames::Filter)) {
+        // Decode straight from the file's bytes, without keeping a copy of the encoded data around.
+        auto stream_object = make_object<StreamObject>(dict, ByteBuffer {});
+        TRY(unfilter_stream(stream_object, bytes));
+        return stream_object;
+    }
+
     auto stream_object = make_object<StreamObject>(dict, MUST(ByteBuffer::copy(bytes)));
 
-    if (m_document->security_handler() && m_enable_encryption)
+    if (needs_decryption)
         m_document->security_handler()->decrypt(stream_object, m_current_reference_stack.last());
 
     if (m_enable_filters)
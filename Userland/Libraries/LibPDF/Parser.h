@@ -56,6 +56,7 @@ public:
     PDFErrorOr<HashMap<DeprecatedFlyString, Value>> parse_dict_contents_until(char const*);
     PDFErrorOr<NonnullRefPtr<DictObject>> parse_dict();
     PDFErrorOr<void> unfilter_stream(NonnullRefPtr<StreamObject>);
+    PDFErrorOr<void> unfilter_stream(NonnullRefPtr<StreamObject>, ReadonlyBytes encoded_bytes);
     PDFErrorOr<NonnullRefPtr<StreamObject>> parse_stream(NonnullRefPtr<DictObject> dict);
     PDFErrorOr<Vector<Operator>> parse_operators();
 
@@ -122,10 +122,13 @@ Renderer::Renderer(RefPtr<Document> document, Page const& page, RefPtr<Gfx::Bitm
 
 PDFErrorsOr<void> Renderer::render()
 {
-    auto operators = TRY(Parser::parse_operators(m_document, TRY(m_page.page_contents(*m_document))));
+    auto contents = TRY(m_page.contents_object(*m_document));
+    if (!contents)
+        return {};
+    auto content_stream = TRY(get_content_stream(m_page.object_index, [&] { return m_page.page_contents(*m_document); }));
 
     Errors errors;
-    for (auto& op : operators) {
+    for (auto& op : content_stream->operators) {
         auto maybe_error = handle_operator(op);
         if (maybe_error.is_error()) {
             errors.add_error(maybe_error.release_error());
@@ -497,18 +500,33 @@ RENDERER_HANDLER(text_set_leading)
 
 PDFErrorOr<NonnullRefPtr<PDFFont>> Renderer::get_font(FontCacheKey const& key)
 {
-    auto it = m_font_cache.find(key);
-    if (it != m_font_cache.end()) {
+    auto& resource_cache = m_document->resource_cache();
+    if (auto font = resource_cache.font(key)) {
         // Update the potentially-stale size set in text_set_matrix_and_line_matrix().
-        it->value->set_font_size(key.font_size);
-        return it->value;
+        font->set_font_size(key.font_size);
+        return font.release_nonnull();
     }
 
     auto font = TRY(PDFFont::create(m_document, key.font_dictionary, key.font_size));
-    m_font_cache.set(key, font);
+    resource_cache.set_font(key, font);
     return font;
 }
 
+PDFErrorOr<NonnullRefPtr<ContentStream>> Renderer::get_content_stream(Optional<u32> object_index, AK::Function<PDFErrorOr<ByteBuffer>()> const& read_contents)
+{
+    auto& resource_cache = m_document->resource_cache();
+    if (object_index.has_value()) {
+        if (auto content_stream = resource_cache.content_stream(*object_index))
+            return content_stream.release_nonnull();
+    }
+
+    auto operators = TRY(Parser::parse_operators(m_document, TRY(read_contents())));
+    auto content_stream = adopt_ref(*new ContentStream(move(operators)));
+    if (object_index.has_value())
+        resource_cache.set_content_stream(*object_index, content_stream);
+    return content_stream;
+}
+
 RENDERER_HANDLER(text_set_font)
 {
     auto target_font_name = MUST(m_document->resolve_to<NameObject>(args[0]))->name();
@@ -919,8 +937,8 @@ RENDERER_HANDLER(paint_xobject)
         matrix = Vector { Value { 1 }, Value { 0 }, Value { 0 }, Value { 1 }, Value { 0 }, Value { 0 } };
     }
     MUST(handle_concatenate_matrix(matrix));
-    auto operators = TRY(Parser::parse_operators(m_document, xobject->bytes()));
-    for (auto& op : operators)
+    auto content_stream = TRY(get_content_stream(xobject->object_index(), [&]() -> PDFErrorOr<ByteBuffer> { return TRY(ByteBuffer::copy(xobject->bytes())); }));
+    for (auto& op : content_stream->operators)
         TRY(handle_operator(op, xobject_resources));
     return {};
 }
@@ -1105,7 +1123,7 @@ static Vector<u8> upsample_to_8_bit(ReadonlyBytes content, int samples_per_line,
     return upsampled_storage;
 }
 
-PDFErrorOr<Renderer::LoadedImage> Renderer::load_image(NonnullRefPtr<StreamObject> image)
+PDFErrorOr<LoadedImage> Renderer::load_image(NonnullRefPtr<StreamObject> image)
 {
     auto image_dict = image->dict();
     auto width = TRY(m_document->resolve_to<int>(image_dict->get_value(CommonNames::Width)));
@@ -1343,6 +1361,40 @@ static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> apply_alpha_channel(NonnullRefPtr<Gfx
     return image_bitmap;
 }
 
+PDFErrorOr<LoadedImage> Renderer::load_image_with_mask(NonnullRefPtr<StreamObject> image)
+{
+    // Inline images are created anew on every render and have no object index, so they aren't cached.
+    auto& resource_cache = m_document->resource_cache();
+    auto object_index = image->object_index();
+    if (object_index.has_value()) {
+        if (auto cached_image = resource_cache.image(*object_index); cached_image.has_value())
+            return cached_image.release_value();
+    }
+
+    auto image_bitmap = TRY(load_image(image));
+    if (!image_bitmap.is_image_mask) {
+        auto image_dict = image->dict();
+        if (image_dict->contains(CommonNames::SMask)) {
+            auto smask_bitmap = TRY(load_image(TRY(image_dict->get_stream(m_document, CommonNames::SMask))));
+            image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, smask_bitmap.bitmap));
+        } else if (image_dict->contains(CommonNames::Mask)) {
+            auto mask_object = TRY(image_dict->get_object(m_document, CommonNames::Mask));
+            if (mask_object->is<StreamObject>()) {
+                auto mask_bitmap = TRY(load_image(mask_object->cast<StreamObject>()));
+                bool invert_alpha = mask_bitmap.is_image_mask;
+                image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, mask_bitmap.bitmap, invert_alpha));
+            } else if (mask_object->is<ArrayObject>()) {
+                auto mask_bitmap = TRY(make_mask_bitmap_from_array(mask_object->cast<ArrayObject>(), image));
+                image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, mask_bitmap));
+            }
+        }
+    }
+
+    if (object_index.has_value())
+        resource_cache.set_image(*object_index, image_bitmap);
+    return image_bitmap;
+}
+
 PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
 {
     auto image_dict = image->dict();
@@ -1357,7 +1409,7 @@ PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
         show_empty_image({ width, height });
         return {};
     }
-    auto image_bitmap = TRY(load_image(image));
+    auto image_bitmap = TRY(load_image_with_mask(image));
     if (image_bitmap.is_image_mask) {
         // PDF 1.7 spec, 4.8.5 Masked Images, Stencil Masking:
         // "An image mask (an image XObject whose ImageMask entry is true) [...] is treated as a stencil mask [...].
@@ -1366,6 +1418,8 @@ PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
             return Error(Error::Type::RenderingUnsupported, "Image masks with pattern fill not yet implemented");
 
         // Move mask to alpha channel, and put current color in RGB.
+        // The cached mask is shared with other uses of this image, so color a copy of it.
+        image_bitmap.bitmap = TRY(image_bitmap.bitmap->clone());
         auto current_color = state().paint_style.get<Gfx::Color>();
         for (auto& pixel : *image_bitmap.bitmap) {
             // "a sample value of 0 marks the page with the current color, and a 1 leaves the previous contents unchanged."
@@ -1373,19 +1427,6 @@ PDFErrorOr<void> Renderer::show_image(NonnullRefPtr<StreamObject> image)
             u8 mask_alpha = 255 - Color::from_argb(pixel).luminosity();
             pixel = current_color.with_alpha(mask_alpha).value();
         }
-    } else if (image_dict->contains(CommonNames::SMask)) {
-        auto smask_bitmap = TRY(load_image(TRY(image_dict->get_stream(m_document, CommonNames::SMask))));
-        image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, smask_bitmap.bitmap));
-    } else if (image_dict->contains(CommonNames::Mask)) {
-        auto mask_object = TRY(image_dict->get_object(m_document, CommonNames::Mask));
-        if (mask_object->is<StreamObject>()) {
-            auto mask_bitmap = TRY(load_image(mask_object->cast<StreamObject>()));
-            bool invert_alpha = mask_bitmap.is_image_mask;
-            image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, mask_bitmap.bitmap, invert_alpha));
-        } else if (mask_object->is<ArrayObject>()) {
-            auto mask_bitmap = TRY(make_mask_bitmap_from_array(mask_object->cast<ArrayObject>(), image));
-            image_bitmap.bitmap = TRY(apply_alpha_channel(image_bitmap.bitmap, mask_bitmap));
-        }
     }
 
     auto image_space = calculate_image_space_transformation(image_bitmap.bitmap->size());
@@ -1437,7 +1478,7 @@ Gfx::AffineTransform const& Renderer::calculate_text_rendering_matrix() const
     return m_text_rendering_matrix;
 }
 
-PDFErrorOr<void> Renderer::render_type3_glyph(Gfx::FloatPoint point, StreamObject const& glyph_data, Gfx::AffineTransform const& font_matrix, Optional<NonnullRefPtr<DictObject>> resources)
+PDFErrorOr<void> Renderer::render_type3_glyph(Gfx::FloatPoint point, NonnullRefPtr<StreamObject> glyph_data, Gfx::AffineTransform const& font_matrix, Optional<NonnullRefPtr<DictObject>> resources)
 {
     ScopedState scoped_state { *this };
 
@@ -1448,8 +1489,8 @@ PDFErrorOr<void> Renderer::render_type3_glyph(Gfx::FloatPoint point, StreamObjec
     state().ctm.multiply(font_matrix);
     m_text_rendering_matrix_is_dirty = true;
 
-    auto operators = TRY(Parser::parse_operators(m_document, glyph_data.bytes()));
-    for (auto& op : operators)
+    auto content_stream = TRY(get_content_stream(glyph_data->object_index(), [&]() -> PDFErrorOr<ByteBuffer> { return TRY(ByteBuffer::copy(glyph_data->bytes())); }));
+    for (auto& op : content_stream->operators)
         TRY(handle_operator(op, resources));
     return {};
 }
@@ -108,19 +108,12 @@ public:
 
     static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> apply_page_rotation(NonnullRefPtr<Gfx::Bitmap>, Page const&, int extra_degrees = 0);
 
-    struct FontCacheKey {
-        NonnullRefPtr<DictObject> font_dictionary;
-        float font_size;
-
-        bool operator==(FontCacheKey const&) const = default;
-    };
-
     ALWAYS_INLINE GraphicsState const& state() const { return m_graphics_state_stack.last(); }
     ALWAYS_INLINE TextState const& text_state() const { return state().text_state; }
 
     Gfx::AffineTransform const& calculate_text_rendering_matrix() const;
 
-    PDFErrorOr<void> render_type3_glyph(Gfx::FloatPoint, StreamObject const&, Gfx::AffineTransform const&, Optional<NonnullRefPtr<DictObject>>);
+    PDFErrorOr<void> render_type3_glyph(Gfx::FloatPoint, NonnullRefPtr<StreamObject>, Gfx::AffineTransform const&, Optional<NonnullRefPtr<DictObject>>);
 
     bool show_hidden_text() const { return m_rendering_preferences.show_hidden_text; }
 
@@ -157,11 +150,8 @@ private:
     PDFErrorOr<void> set_graphics_state_from_dict(NonnullRefPtr<DictObject>);
     PDFErrorOr<void> show_text(ByteString const&);
 
-    struct LoadedImage {
-        NonnullRefPtr<Gfx::Bitmap> bitmap;
-        bool is_image_mask = false;
-    };
     PDFErrorOr<LoadedImage> load_image(NonnullRefPtr<StreamObject>);
+    PDFErrorOr<LoadedImage> load_image_with_mask(NonnullRefPtr<StreamObject>);
     PDFErrorOr<NonnullRefPtr<Gfx::Bitmap>> make_mask_bitmap_from_array(NonnullRefPtr<ArrayObject>, NonnullRefPtr<StreamObject>);
     PDFErrorOr<void> show_image(NonnullRefPtr<StreamObject>);
     void show_empty_image(Gfx::IntSize);
@@ -187,6 +177,7 @@ private:
     Gfx::AffineTransform calculate_image_space_transformation(Gfx::IntSize);
 
     PDFErrorOr<NonnullRefPtr<PDFFont>> get_font(FontCacheKey const&);
+    PDFErrorOr<NonnullRefPtr<ContentStream>> get_content_stream(Optional<u32> object_index, AK::Function<PDFErrorOr<ByteBuffer>()> const& read_contents);
 
     class ScopedState;
 
@@ -204,22 +195,12 @@ private:
 
     bool mutable m_text_rendering_matrix_is_dirty { true };
     Gfx::AffineTransform mutable m_text_rendering_matrix;
-
-    HashMap<FontCacheKey, NonnullRefPtr<PDFFont>> m_font_cache;
 };
 
 }
 
 namespace AK {
 
-template<>
-struct Traits<PDF::Renderer::FontCacheKey> : public DefaultTraits<PDF::Renderer::FontCacheKey> {
-    static unsigned hash(PDF::Renderer::FontCacheKey const& key)
-    {
-        return pair_int_hash(ptr_hash(key.font_dictionary.ptr()), int_hash(bit_cast<u32>(key.font_size)));
-    }
-};
-
 template<>
 struct Formatter<PDF::LineCapStyle> : Formatter<StringView> {
     ErrorOr<void> format(FormatBuilder& builder, PDF::LineCapStyle const& style)
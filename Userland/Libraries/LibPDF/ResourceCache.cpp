@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibPDF/Fonts/PDFFont.h>
+#include <LibPDF/ObjectDerivatives.h>
+#include <LibPDF/ResourceCache.h>
+
+namespace PDF {
+
+ResourceCache::ResourceCache() = default;
+
+ResourceCache::~ResourceCache() = default;
+
+template<typename Key, typename Entry>
+void ResourceCache::evict_least_recently_used_entry(HashMap<Key, Entry>& map)
+{
+    VERIFY(!map.is_empty());
+    auto oldest = map.begin();
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        if (it->value.last_used < oldest->value.last_used)
+            oldest = it;
+    }
+    map.remove(oldest);
+}
+
+RefPtr<PDFFont> ResourceCache::font(FontCacheKey const& key)
+{
+    auto it = m_fonts.find(key);
+    if (it == m_fonts.end())
+        return nullptr;
+    it->value.last_used = ++m_use_counter;
+    return it->value.font;
+}
+
+void ResourceCache::set_font(FontCacheKey key, NonnullRefPtr<PDFFont> font)
+{
+    if (m_fonts.size() >= default_max_font_count && !m_fonts.contains(key))
+        evict_least_recently_used_entry(m_fonts);
+    m_fonts.set(move(key), FontEntry { move(font), ++m_use_counter });
+}
+
+Optional<LoadedImage> ResourceCache::image(u32 object_index)
+{
+    auto it = m_images.find(object_index);
+    if (it == m_images.end())
+        return {};
+    it->value.last_used = ++m_use_counter;
+    return it->value.image;
+}
+
+void ResourceCache::set_image(u32 object_index, LoadedImage image)
+{
+    auto size_in_bytes = image.bitmap->size_in_bytes();
+    if (size_in_bytes > default_max_image_size_in_bytes)
+        return;
+
+    if (auto it = m_images.find(object_index); it != m_images.end()) {
+        m_image_size_in_bytes -= it->value.image.bitmap->size_in_bytes();
+        m_images.remove(it);
+    }
+    while (m_image_size_in_bytes + size_in_bytes > default_max_image_size_in_bytes) {
+        auto oldest = m_images.begin();
+        for (auto it = m_images.begin(); it != m_images.end(); ++it) {
+            if (it->value.last_used < oldest->value.last_used)
+                oldest = it;
+        }
+        m_image_size_in_bytes -= oldest->value.image.bitmap->size_in_bytes();
+        m_images.remove(oldest);
+    }
+
+    m_image_size_in_bytes += size_in_bytes;
+    m_images.set(object_index, ImageEntry { move(image), ++m_use_counter });
+}
+
+RefPtr<ContentStream> ResourceCache::content_stream(u32 object_index)
+{
+    auto it = m_content_streams.find(object_index);
+    if (it == m_content_streams.end())
+        return nullptr;
+    it->value.last_used = ++m_use_counter;
+    return it->value.content_stream;
+}
+
+void ResourceCache::set_content_stream(u32 object_index, NonnullRefPtr<ContentStream> content_stream)
+{
+    if (m_content_streams.size() >= default_max_content_stream_count && !m_content_streams.contains(object_index))
+        evict_least_recently_used_entry(m_content_streams);
+    m_content_streams.set(object_index, ContentStreamEntry { move(content_stream), ++m_use_counter });
+}
+
+void ResourceCache::clear()
+{
+    m_fonts.clear();
+    m_images.clear();
+    m_content_streams.clear();
+    m_image_size_in_bytes = 0;
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BitCast.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibPDF/Forward.h>
+#include <LibPDF/Operator.h>
+
+namespace PDF {
+
+class PDFFont;
+
+struct FontCacheKey {
+    NonnullRefPtr<DictObject> font_dictionary;
+    float font_size;
+
+    bool operator==(FontCacheKey const&) const = default;
+};
+
+struct LoadedImage {
+    NonnullRefPtr<Gfx::Bitmap> bitmap;
+    bool is_image_mask = false;
+};
+
+// A parsed content stream. Reference counted so that a renderer can keep walking the operators
+// of a page or form XObject even if the cache evicts it while nested content is being rendered.
+struct ContentStream : public RefCounted<ContentStream> {
+    explicit ContentStream(Vector<Operator> operators)
+        : operators(move(operators))
+    {
+    }
+
+    Vector<Operator> operators;
+};
+
+// Decoded resources that are shared by all renders of a document: fonts, images (with their soft
+// masks applied) and the parsed operators of page contents, form XObjects and Type3 glyphs.
+// Switching between pages or re-rendering a page at a different zoom level doesn't decode the
+// same data again. Each kind of resource is bounded, and the least recently used entries are
+// evicted first.
+//
+// Images and content streams are keyed by the index of the indirect object they were loaded
+// from, not by the stream object itself: the document may drop a stream from its own cache and
+// parse it again later, and the decoded resource should neither keep the raw stream alive nor be
+// missed once the stream is parsed again.
+class ResourceCache {
+    AK_MAKE_NONCOPYABLE(ResourceCache);
+    AK_MAKE_NONMOVABLE(ResourceCache);
+
+public:
+    static constexpr size_t default_max_font_count = 256;
+    static constexpr size_t default_max_image_size_in_bytes = 64 * MiB;
+    static constexpr size_t default_max_content_stream_count = 64;
+
+    ResourceCache();
+    ~ResourceCache();
+
+    RefPtr<PDFFont> font(FontCacheKey const&);
+    void set_font(FontCacheKey, NonnullRefPtr<PDFFont>);
+
+    Optional<LoadedImage> image(u32 object_index);
+    void set_image(u32 object_index, LoadedImage);
+
+    RefPtr<ContentStream> content_stream(u32 object_index);
+    void set_content_stream(u32 object_index, NonnullRefPtr<ContentStream>);
+
+    void clear();
+
+    size_t font_count() const { return m_fonts.size(); }
+    size_t image_count() const { return m_images.size(); }
+    size_t image_size_in_bytes() const { return m_image_size_in_bytes; }
+    size_t content_stream_count() const { return m_content_streams.size(); }
+
+private:
+    struct FontEntry {
+        NonnullRefPtr<PDFFont> font;
+        u64 last_used { 0 };
+    };
+
+    struct ImageEntry {
+        LoadedImage image;
+        u64 last_used { 0 };
+    };
+
+    struct ContentStreamEntry {
+        NonnullRefPtr<ContentStream> content_stream;
+        u64 last_used { 0 };
+    };
+
+    template<typename Key, typename Entry>
+    static void evict_least_recently_used_entry(HashMap<Key, Entry>&);
+
+    HashMap<FontCacheKey, FontEntry> m_fonts;
+    HashMap<u32, ImageEntry> m_images;
+    HashMap<u32, ContentStreamEntry> m_content_streams;
+    size_t m_image_size_in_bytes { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<PDF::FontCacheKey> : public DefaultTraits<PDF::FontCacheKey> {
+    static unsigned hash(PDF::FontCacheKey const& key)
+    {
+        return pair_int_hash(ptr_hash(key.font_dictionary.ptr()), int_hash(bit_cast<u32>(key.font_size)));
+    }
+};
+
+}
@@ -1082,6 +1082,9 @@ public:
     RefPtr<LimitClause> const& limit_clause() const { return m_limit_clause; }
     ResultOr<ResultSet> execute(ExecutionContext&) const override;
 
+    // Unlike execute(), which collects all rows of the result, this produces the rows one at a time.
+    ResultOr<NonnullOwnPtr<ResultCursor>> open_cursor(NonnullRefPtr<Database>, Vector<Value> placeholder_values = {}) const;
+
 private:
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
     bool m_select_all;
@@ -1093,6 +1096,20 @@ private:
     RefPtr<LimitClause> m_limit_clause;
 };
 
+class Explain : public Statement {
+public:
+    Explain(NonnullRefPtr<Select> select_statement)
+        : m_select_statement(move(select_statement))
+    {
+    }
+
+    NonnullRefPtr<Select> const& select_statement() const { return m_select_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Select> m_select_statement;
+};
+
 class DescribeTable : public Statement {
 public:
     DescribeTable(NonnullRefPtr<QualifiedTableName> qualified_table_name)
@@ -1107,4 +1124,19 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class BeginTransaction : public Statement {
+public:
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+};
+
+class CommitTransaction : public Statement {
+public:
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+};
+
+class RollbackTransaction : public Statement {
+public:
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+};
+
 }
@@ -16,29 +16,31 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
 {
     auto table_def = TRY(context.database->get_table(m_schema_name, m_table_name));
 
-    Row row(table_def);
+    Row prototype(table_def);
     for (auto& column : m_column_names) {
-        if (!row.has(column))
+        if (!prototype.has(column))
             return Result { SQLCommand::Insert, SQLErrorCode::ColumnDoesNotExist, column };
     }
 
-    ResultSet result { SQLCommand::Insert };
-    TRY(result.try_ensure_capacity(m_chained_expressions.size()));
+    for (auto& column_def : table_def->columns()) {
+        if (!m_column_names.contains_slow(column_def->name()))
+            prototype[column_def->name()] = column_def->default_value();
+    }
 
-    for (auto& row_expr : m_chained_expressions) {
-        for (auto& column_def : table_def->columns()) {
-            if (!m_column_names.contains_slow(column_def->name()))
-                row[column_def->name()] = column_def->default_value();
-        }
+    // All rows are validated before any of them is written, and are then inserted as a single batch.
+    Vector<Row> rows;
+    TRY(rows.try_ensure_capacity(m_chained_expressions.size()));
 
+    for (auto& row_expr : m_chained_expressions) {
         auto row_value = TRY(row_expr->evaluate(context));
         VERIFY(row_value.type() == SQLType::Tuple);
 
         auto values = row_value.to_vector().release_value();
 
-        if (m_column_names.is_empty() && values.size() != row.size())
+        if (m_column_names.is_empty() && values.size() != prototype.size())
             return Result { SQLCommand::Insert, SQLErrorCode::InvalidNumberOfValues, ByteString::empty() };
 
+        Row row = prototype;
         for (auto ix = 0u; ix < values.size(); ix++) {
             auto& tuple_descriptor = *row.descriptor();
             // In case of having column names, this must succeed since we checked for every column name for existence in the table.
@@ -51,10 +53,17 @@ ResultOr<ResultSet> Insert::execute(ExecutionContext& context) const
             row[element_index] = move(values[ix]);
         }
 
-        TRY(context.database->insert(row));
-        result.insert_row(row, {});
+        rows.unchecked_append(move(row));
     }
 
+    TRY(context.database->insert_rows(rows));
+
+    ResultSet result { SQLCommand::Insert };
+    TRY(result.try_ensure_capacity(rows.size()));
+
+    for (auto const& row : rows)
+        result.insert_row(row, {});
+
     return result;
 }
 
@@ -49,6 +49,8 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         return parse_drop_table_statement();
     case TokenType::Describe:
         return parse_describe_table_statement();
+    case TokenType::Explain:
+        return parse_explain_statement();
     case TokenType::Insert:
         return parse_insert_statement({});
     case TokenType::Update:
@@ -57,8 +59,15 @@ NonnullRefPtr<Statement> Parser::parse_statement()
         return parse_delete_statement({});
     case TokenType::Select:
         return parse_select_statement({});
+    case TokenType::Begin:
+        return parse_begin_transaction_statement();
+    case TokenType::Commit:
+    case TokenType::End:
+        return parse_commit_transaction_statement();
+    case TokenType::Rollback:
+        return parse_rollback_transaction_statement();
     default:
-        expected("CREATE, ALTER, DROP, DESCRIBE, INSERT, UPDATE, DELETE, or SELECT"sv);
+        expected("CREATE, ALTER, DROP, DESCRIBE, EXPLAIN, INSERT, UPDATE, DELETE, SELECT, BEGIN, COMMIT, END, or ROLLBACK"sv);
         return create_ast_node<ErrorStatement>();
     }
 }
@@ -194,6 +203,59 @@ NonnullRefPtr<DescribeTable> Parser::parse_describe_table_statement()
     return create_ast_node<DescribeTable>(move(table_name));
 }
 
+NonnullRefPtr<Statement> Parser::parse_explain_statement()
+{
+    consume(TokenType::Explain);
+    if (consume_if(TokenType::Query))
+        consume(TokenType::Plan);
+
+    RefPtr<CommonTableExpressionList> common_table_expression_list;
+    if (match(TokenType::With)) {
+        common_table_expression_list = parse_common_table_expression_list();
+        if (!common_table_expression_list)
+            return create_ast_node<ErrorStatement>();
+    }
+
+    if (!match(TokenType::Select)) {
+        expected("SELECT"sv);
+        return create_ast_node<ErrorStatement>();
+    }
+
+    return create_ast_node<Explain>(parse_select_statement(move(common_table_expression_list)));
+}
+
+NonnullRefPtr<BeginTransaction> Parser::parse_begin_transaction_statement()
+{
+    // https://sqlite.org/lang_transaction.html
+    consume(TokenType::Begin);
+
+    // Statements are executed one at a time, so the different kinds of transactions all behave the same.
+    if (!consume_if(TokenType::Deferred) && !consume_if(TokenType::Immediate))
+        consume_if(TokenType::Exclusive);
+    consume_if(TokenType::Transaction);
+
+    return create_ast_node<BeginTransaction>();
+}
+
+NonnullRefPtr<CommitTransaction> Parser::parse_commit_transaction_statement()
+{
+    // https://sqlite.org/lang_transaction.html
+    if (!consume_if(TokenType::End))
+        consume(TokenType::Commit);
+    consume_if(TokenType::Transaction);
+
+    return create_ast_node<CommitTransaction>();
+}
+
+NonnullRefPtr<RollbackTransaction> Parser::parse_rollback_transaction_statement()
+{
+    // https://sqlite.org/lang_transaction.html
+    consume(TokenType::Rollback);
+    consume_if(TokenType::Transaction);
+
+    return create_ast_node<RollbackTransaction>();
+}
+
 NonnullRefPtr<Insert> Parser::parse_insert_statement(RefPtr<CommonTableExpressionList> common_table_expression_list)
 {
     // https://sqlite.org/lang_insert.html
@@ -63,6 +63,10 @@ private:
     NonnullRefPtr<AlterTable> parse_alter_table_statement();
     NonnullRefPtr<DropTable> parse_drop_table_statement();
     NonnullRefPtr<DescribeTable> parse_describe_table_statement();
+    NonnullRefPtr<Statement> parse_explain_statement();
+    NonnullRefPtr<BeginTransaction> parse_begin_transaction_statement();
+    NonnullRefPtr<CommitTransaction> parse_commit_transaction_statement();
+    NonnullRefPtr<RollbackTransaction> parse_rollback_transaction_statement();
     NonnullRefPtr<Insert> parse_insert_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Update> parse_update_statement(RefPtr<CommonTableExpressionList>);
     NonnullRefPtr<Delete> parse_delete_statement(RefPtr<CommonTableExpressionList>);
@@ -0,0 +1,654 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/StringBuilder.h>
+#include <AK/TypeCasts.h>
+#include <LibSQL/AST/QueryPlan.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/Row.h>
+
+namespace SQL::AST {
+
+static ResultOr<bool> satisfies_predicates(ExecutionContext& context, Tuple& row, Vector<NonnullRefPtr<Expression>> const& predicates)
+{
+    context.current_row = &row;
+    for (auto const& predicate : predicates) {
+        auto result = TRY(predicate->evaluate(context)).to_bool();
+        if (!result.has_value() || !result.value())
+            return false;
+    }
+    return true;
+}
+
+static ByteString describe_expression(Expression const& expression)
+{
+    if (is<ColumnNameExpression>(expression)) {
+        auto const& column = static_cast<ColumnNameExpression const&>(expression);
+        if (column.table_name().is_empty())
+            return column.column_name();
+        return ByteString::formatted("{}.{}", column.table_name(), column.column_name());
+    }
+    if (is<NumericLiteral>(expression))
+        return ByteString::formatted("{}", static_cast<NumericLiteral const&>(expression).value());
+    if (is<StringLiteral>(expression))
+        return ByteString::formatted("'{}'", static_cast<StringLiteral const&>(expression).value());
+    if (is<BlobLiteral>(expression))
+        return ByteString::formatted("x'{}'", static_cast<BlobLiteral const&>(expression).value());
+    if (is<BooleanLiteral>(expression))
+        return static_cast<BooleanLiteral const&>(expression).value() ? "TRUE" : "FALSE";
+    if (is<NullLiteral>(expression))
+        return "NULL";
+    if (is<Placeholder>(expression))
+        return "?";
+    if (is<BinaryOperatorExpression>(expression)) {
+        auto const& binary = static_cast<BinaryOperatorExpression const&>(expression);
+        return ByteString::formatted("{} {} {}", describe_expression(binary.lhs()), BinaryOperator_name(binary.type()), describe_expression(binary.rhs()));
+    }
+    if (is<UnaryOperatorExpression>(expression)) {
+        auto const& unary = static_cast<UnaryOperatorExpression const&>(expression);
+        return ByteString::formatted("{} {}", UnaryOperator_name(unary.type()), describe_expression(unary.expression()));
+    }
+    if (is<ChainedExpression>(expression)) {
+        Vector<ByteString> elements;
+        for (auto const& element : static_cast<ChainedExpression const&>(expression).expressions())
+            elements.append(describe_expression(element));
+        return ByteString::formatted("({})", ByteString::join(", "sv, elements));
+    }
+    return "...";
+}
+
+static ByteString describe_predicates(Vector<NonnullRefPtr<Expression>> const& predicates)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        if (i > 0)
+            builder.append(" and "sv);
+        builder.append(describe_expression(predicates[i]));
+    }
+    return builder.to_byte_string();
+}
+
+static void append_line(Vector<ByteString>& lines, size_t depth, ByteString const& line)
+{
+    lines.append(ByteString::formatted("{}{}", ByteString::repeated(' ', depth * 2), line));
+}
+
+static NonnullRefPtr<TupleDescriptor> concatenate_descriptors(TupleDescriptor const& left, TupleDescriptor const& right)
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->extend(left);
+    descriptor->extend(right);
+    return descriptor;
+}
+
+SingleRowNode::SingleRowNode()
+    : PlanNode(adopt_ref(*new TupleDescriptor))
+{
+}
+
+ResultOr<Optional<Tuple>> SingleRowNode::next(ExecutionContext&)
+{
+    if (m_done)
+        return Optional<Tuple> {};
+    m_done = true;
+    return Optional<Tuple> { Tuple { m_descriptor } };
+}
+
+void SingleRowNode::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_line(lines, depth, "SINGLE ROW");
+}
+
+TableScanNode::TableScanNode(NonnullRefPtr<TableDef> table, Vector<NonnullRefPtr<Expression>> predicates)
+    : PlanNode(table->to_tuple_descriptor())
+    , m_table(move(table))
+    , m_predicates(move(predicates))
+    , m_next_block_index(m_table->block_index())
+{
+    for (auto const& predicate : m_predicates) {
+        if (auto comparison = column_comparison_for(predicate); comparison.has_value())
+            m_column_comparisons.append(comparison.release_value());
+        else
+            m_row_predicates.append(predicate);
+    }
+}
+
+Optional<TableScanNode::ColumnComparison> TableScanNode::column_comparison_for(Expression const& expression) const
+{
+    if (!is<BinaryOperatorExpression>(expression))
+        return {};
+
+    auto const& comparison = static_cast<BinaryOperatorExpression const&>(expression);
+    switch (comparison.type()) {
+    case BinaryOperator::Equals:
+    case BinaryOperator::NotEquals:
+    case BinaryOperator::LessThan:
+    case BinaryOperator::LessThanEquals:
+    case BinaryOperator::GreaterThan:
+    case BinaryOperator::GreaterThanEquals:
+        break;
+    default:
+        return {};
+    }
+
+    // Only the column may be on the left, as comparisons of values are not necessarily symmetric.
+    if (!is<ColumnNameExpression>(*comparison.lhs()))
+        return {};
+
+    auto const& operand = comparison.rhs();
+    if (!is<NumericLiteral>(*operand) && !is<StringLiteral>(*operand) && !is<Placeholder>(*operand))
+        return {};
+
+    auto const& column = static_cast<ColumnNameExpression const&>(*comparison.lhs());
+    for (size_t i = 0; i < m_descriptor->size(); ++i) {
+        auto const& element = (*m_descriptor)[i];
+        if (!column.table_name().is_empty() && element.table != column.table_name())
+            continue;
+        if (element.name == column.column_name())
+            return ColumnComparison { i, comparison.type(), operand };
+    }
+
+    return {};
+}
+
+ResultOr<bool> TableScanNode::satisfies_column_comparisons(ExecutionContext& context, RowView const& row)
+{
+    if (m_column_comparisons.is_empty())
+        return true;
+
+    // The operands don't depend on the row, so they're only evaluated once. This happens when the first row is read
+    // to report errors, such as a missing placeholder value, only when the comparisons would have been evaluated.
+    if (!m_operand_values.has_value()) {
+        Vector<Value> values;
+        TRY(values.try_ensure_capacity(m_column_comparisons.size()));
+        for (auto const& comparison : m_column_comparisons)
+            values.unchecked_append(TRY(comparison.operand->evaluate(context)));
+        m_operand_values = move(values);
+    }
+
+    for (size_t i = 0; i < m_column_comparisons.size(); ++i) {
+        auto const& comparison = m_column_comparisons[i];
+        auto result = row[comparison.column_index].compare((*m_operand_values)[i]);
+
+        bool satisfied = false;
+        switch (comparison.op) {
+        case BinaryOperator::Equals:
+            satisfied = result == 0;
+            break;
+        case BinaryOperator::NotEquals:
+            satisfied = result != 0;
+            break;
+        case BinaryOperator::LessThan:
+            satisfied = result < 0;
+            break;
+        case BinaryOperator::LessThanEquals:
+            satisfied = result <= 0;
+            break;
+        case BinaryOperator::GreaterThan:
+            satisfied = result > 0;
+            break;
+        case BinaryOperator::GreaterThanEquals:
+            satisfied = result >= 0;
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+
+        if (!satisfied)
+            return false;
+    }
+
+    return true;
+}
+
+ResultOr<Optional<Tuple>> TableScanNode::next(ExecutionContext& context)
+{
+    while (m_next_block_index != 0) {
+        auto row = TRY(context.database->read_row_view(*m_table, m_next_block_index));
+        m_next_block_index = row.next_block_index();
+
+        if (!TRY(satisfies_column_comparisons(context, row)))
+            continue;
+
+        // NOTE: Rows are materialized with the scan's descriptor, as the schema and table names are needed to resolve
+        //       qualified column names.
+        auto tuple = row.to_tuple(m_descriptor);
+        if (TRY(satisfies_predicates(context, tuple, m_row_predicates)))
+            return Optional<Tuple> { move(tuple) };
+    }
+    return Optional<Tuple> {};
+}
+
+void TableScanNode::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    auto line = ByteString::formatted("SCAN {}.{}", m_table->parent()->name(), m_table->name());
+    if (!m_predicates.is_empty())
+        line = ByteString::formatted("{} WHERE {}", line, describe_predicates(m_predicates));
+    append_line(lines, depth, line);
+}
+
+FilterNode::FilterNode(NonnullOwnPtr<PlanNode> input, Vector<NonnullRefPtr<Expression>> predicates)
+    : PlanNode(input->descriptor())
+    , m_input(move(input))
+    , m_predicates(move(predicates))
+{
+}
+
+ResultOr<Optional<Tuple>> FilterNode::next(ExecutionContext& context)
+{
+    while (true) {
+        auto row = TRY(m_input->next(context));
+        if (!row.has_value() || TRY(satisfies_predicates(context, *row, m_predicates)))
+            return row;
+    }
+}
+
+void FilterNode::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_line(lines, depth, ByteString::formatted("FILTER {}", describe_predicates(m_predicates)));
+    m_input->explain(lines, depth + 1);
+}
+
+JoinNode::JoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, Vector<NonnullRefPtr<Expression>> predicates)
+    : PlanNode(concatenate_descriptors(left->descriptor(), right->descriptor()))
+    , m_left(move(left))
+    , m_right(move(right))
+    , m_predicates(move(predicates))
+{
+}
+
+ResultOr<Optional<Tuple>> JoinNode::next(ExecutionContext& context)
+{
+    while (true) {
+        if (!m_left_row.has_value()) {
+            m_left_row = TRY(m_left->next(context));
+            if (!m_left_row.has_value())
+                return Optional<Tuple> {};
+
+            // NOTE: The right input is only read once we know that there is something to join it with.
+            if (!m_right_rows.has_value()) {
+                Vector<Tuple> right_rows;
+                while (true) {
+                    auto right_row = TRY(m_right->next(context));
+                    if (!right_row.has_value())
+                        break;
+                    right_rows.append(right_row.release_value());
+                }
+                m_right_rows = move(right_rows);
+                TRY(build(context, *m_right_rows));
+            }
+
+            m_candidates.clear_with_capacity();
+            m_candidate_index = 0;
+            TRY(find_candidates(context, *m_left_row, m_candidates));
+        }
+
+        while (m_candidate_index < m_candidates.size()) {
+            auto const& right_row = (*m_right_rows)[m_candidates[m_candidate_index++]];
+
+            Tuple row { m_descriptor };
+            for (size_t i = 0; i < m_left_row->size(); ++i)
+                row[i] = (*m_left_row)[i];
+            for (size_t i = 0; i < right_row.size(); ++i)
+                row[m_left_row->size() + i] = right_row[i];
+
+            if (TRY(satisfies_predicates(context, row, m_predicates)))
+                return Optional<Tuple> { move(row) };
+        }
+
+        m_left_row.clear();
+    }
+}
+
+void JoinNode::explain_inputs(Vector<ByteString>& lines, size_t depth) const
+{
+    m_left->explain(lines, depth);
+    m_right->explain(lines, depth);
+}
+
+NestedLoopJoinNode::NestedLoopJoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, Vector<NonnullRefPtr<Expression>> predicates)
+    : JoinNode(move(left), move(right), move(predicates))
+{
+}
+
+ResultOr<void> NestedLoopJoinNode::build(ExecutionContext&, Vector<Tuple>& right_rows)
+{
+    m_right_row_count = right_rows.size();
+    return {};
+}
+
+ResultOr<void> NestedLoopJoinNode::find_candidates(ExecutionContext&, Tuple&, Vector<size_t>& candidates)
+{
+    TRY(candidates.try_ensure_capacity(m_right_row_count));
+    for (size_t i = 0; i < m_right_row_count; ++i)
+        candidates.unchecked_append(i);
+    return {};
+}
+
+void NestedLoopJoinNode::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    auto line = ByteString { "NESTED LOOP JOIN"sv };
+    if (!predicates().is_empty())
+        line = ByteString::formatted("{} ON {}", line, describe_predicates(predicates()));
+    append_line(lines, depth, line);
+    explain_inputs(lines, depth + 1);
+}
+
+HashJoinNode::HashJoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, NonnullRefPtr<Expression> left_key, NonnullRefPtr<Expression> right_key, Vector<NonnullRefPtr<Expression>> predicates)
+    : JoinNode(move(left), move(right), move(predicates))
+    , m_left_key(move(left_key))
+    , m_right_key(move(right_key))
+{
+}
+
+// Value::hash() agrees with Value::compare() for values of these types, as long as both sides have the same type.
+static bool has_hashable_type(Value const& value)
+{
+    switch (value.type()) {
+    case SQLType::Text:
+    case SQLType::Integer:
+    case SQLType::Boolean:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ResultOr<void> HashJoinNode::build(ExecutionContext& context, Vector<Tuple>& right_rows)
+{
+    m_right_row_count = right_rows.size();
+    for (size_t i = 0; i < right_rows.size(); ++i) {
+        context.current_row = &right_rows[i];
+        auto key = TRY(m_right_key->evaluate(context));
+
+        // NULL is never equal to anything.
+        if (key.is_null())
+            continue;
+
+        if (!has_hashable_type(key)) {
+            m_rows_without_hashable_key.append(i);
+            continue;
+        }
+        m_buckets.ensure(key.hash()).append(i);
+    }
+    return {};
+}
+
+ResultOr<void> HashJoinNode::find_candidates(ExecutionContext& context, Tuple& left_row, Vector<size_t>& candidates)
+{
+    context.current_row = &left_row;
+    auto key = TRY(m_left_key->evaluate(context));
+    if (key.is_null())
+        return {};
+
+    if (!has_hashable_type(key)) {
+        TRY(candidates.try_ensure_capacity(m_right_row_count));
+        for (size_t i = 0; i < m_right_row_count; ++i)
+            candidates.unchecked_append(i);
+        return {};
+    }
+
+    if (auto bucket = m_buckets.get(key.hash()); bucket.has_value())
+        TRY(candidates.try_extend(*bucket));
+    TRY(candidates.try_extend(m_rows_without_hashable_key));
+    return {};
+}
+
+void HashJoinNode::explain(Vector<ByteString>& lines, size_t depth) const
+{
+    append_line(lines, depth, ByteString::formatted("HASH JOIN ON {}", describe_predicates(predicates())));
+    explain_inputs(lines, depth + 1);
+}
+
+namespace {
+
+struct HashJoinKeys {
+    NonnullRefPtr<Expression> left;
+    NonnullRefPtr<Expression> right;
+};
+
+// The tables a condition depends on, one bit per table in the FROM clause.
+using TableSet = u64;
+
+struct PlannedTable {
+    NonnullRefPtr<TableDef> table;
+    Vector<NonnullRefPtr<Expression>> scan_predicates;
+    Vector<NonnullRefPtr<Expression>> join_predicates;
+};
+
+}
+
+static Optional<size_t> resolve_column(ColumnNameExpression const& column, Vector<PlannedTable> const& tables)
+{
+    Optional<size_t> table_index;
+    for (size_t i = 0; i < tables.size(); ++i) {
+        auto const& table = *tables[i].table;
+        if (!column.table_name().is_empty() && table.name() != column.table_name())
+            continue;
+
+        auto has_column = any_of(table.columns(), [&](auto const& column_def) { return column_def->name() == column.column_name(); });
+        if (!has_column)
+            continue;
+
+        // Ambiguous column names are reported when the condition is evaluated.
+        if (table_index.has_value())
+            return {};
+        table_index = i;
+    }
+    return table_index;
+}
+
+static Optional<SQLType> column_type(ColumnNameExpression const& column, PlannedTable const& table)
+{
+    for (auto const& column_def : table.table->columns()) {
+        if (column_def->name() == column.column_name())
+            return column_def->type();
+    }
+    return {};
+}
+
+// Returns the tables a condition depends on, or nothing if we can't tell, in which case it is evaluated on the result of all joins.
+static Optional<TableSet> tables_referenced_by(Expression const& expression, Vector<PlannedTable> const& tables)
+{
+    auto union_of = [&](auto const&... expressions) -> Optional<TableSet> {
+        TableSet result = 0;
+        bool known = true;
+        ([&] {
+            if (!known)
+                return;
+            if (auto referenced = tables_referenced_by(*expressions, tables); referenced.has_value())
+                result |= *referenced;
+            else
+                known = false;
+        }(),
+            ...);
+        if (!known)
+            return {};
+        return result;
+    };
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto table_index = resolve_column(static_cast<ColumnNameExpression const&>(expression), tables);
+        if (!table_index.has_value() || *table_index >= sizeof(TableSet) * 8)
+            return {};
+        return static_cast<TableSet>(1) << *table_index;
+    }
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression) || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression))
+        return 0;
+    if (is<BetweenExpression>(expression)) {
+        auto const& between = static_cast<BetweenExpression const&>(expression);
+        return union_of(between.expression(), between.lhs(), between.rhs());
+    }
+    if (is<MatchExpression>(expression)) {
+        auto const& match = static_cast<MatchExpression const&>(expression);
+        if (match.escape())
+            return union_of(match.lhs(), match.rhs(), match.escape());
+        return union_of(match.lhs(), match.rhs());
+    }
+    if (is<NestedDoubleExpression>(expression)) {
+        auto const& nested = static_cast<NestedDoubleExpression const&>(expression);
+        return union_of(nested.lhs(), nested.rhs());
+    }
+    if (is<InChainedExpression>(expression)) {
+        auto const& in_chained = static_cast<InChainedExpression const&>(expression);
+        return union_of(in_chained.expression(), in_chained.expression_chain());
+    }
+    if (is<InSelectionExpression>(expression) || is<InTableExpression>(expression))
+        return {};
+    if (is<NestedExpression>(expression))
+        return union_of(static_cast<NestedExpression const&>(expression).expression());
+    if (is<ChainedExpression>(expression)) {
+        TableSet result = 0;
+        for (auto const& element : static_cast<ChainedExpression const&>(expression).expressions()) {
+            auto referenced = tables_referenced_by(element, tables);
+            if (!referenced.has_value())
+                return {};
+            result |= *referenced;
+        }
+        return result;
+    }
+    if (is<CaseExpression>(expression)) {
+        auto const& case_expression = static_cast<CaseExpression const&>(expression);
+        TableSet result = 0;
+        auto add = [&](Optional<TableSet> referenced) {
+            if (referenced.has_value())
+                result |= *referenced;
+            return referenced.has_value();
+        };
+        if (case_expression.case_expression() && !add(union_of(case_expression.case_expression())))
+            return {};
+        if (case_expression.else_expression() && !add(union_of(case_expression.else_expression())))
+            return {};
+        for (auto const& clause : case_expression.when_then_clauses()) {
+            if (!add(union_of(clause.when, clause.then)))
+                return {};
+        }
+        return result;
+    }
+    return {};
+}
+
+static void split_conjunction(NonnullRefPtr<Expression> const& expression, Vector<NonnullRefPtr<Expression>>& conditions)
+{
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary = static_cast<BinaryOperatorExpression const&>(*expression);
+        if (binary.type() == BinaryOperator::And) {
+            split_conjunction(binary.lhs(), conditions);
+            split_conjunction(binary.rhs(), conditions);
+            return;
+        }
+    }
+
+    // NOTE: A parenthesized expression is a chained expression with a single element, which is true if and only if that element is.
+    if (is<ChainedExpression>(*expression)) {
+        auto const& chained = static_cast<ChainedExpression const&>(*expression);
+        if (chained.expressions().size() == 1) {
+            split_conjunction(chained.expressions().first(), conditions);
+            return;
+        }
+    }
+
+    conditions.append(expression);
+}
+
+// Looks for a condition `left_table.column = right_table.column` that can be used as the key of a hash join with the table at the given index.
+static Optional<HashJoinKeys> find_hash_join_keys(Vector<PlannedTable> const& tables, size_t right_index)
+{
+    for (auto const& predicate : tables[right_index].join_predicates) {
+        if (!is<BinaryOperatorExpression>(*predicate))
+            continue;
+        auto const& binary = static_cast<BinaryOperatorExpression const&>(*predicate);
+        if (binary.type() != BinaryOperator::Equals || !is<ColumnNameExpression>(*binary.lhs()) || !is<ColumnNameExpression>(*binary.rhs()))
+            continue;
+
+        auto const& lhs = static_cast<ColumnNameExpression const&>(*binary.lhs());
+        auto const& rhs = static_cast<ColumnNameExpression const&>(*binary.rhs());
+        auto lhs_table = resolve_column(lhs, tables);
+        auto rhs_table = resolve_column(rhs, tables);
+        if (!lhs_table.has_value() || !rhs_table.has_value())
+            continue;
+
+        auto lhs_type = column_type(lhs, tables[*lhs_table]);
+        if (!lhs_type.has_value() || lhs_type != column_type(rhs, tables[*rhs_table]))
+            continue;
+        if (*lhs_type != SQLType::Text && *lhs_type != SQLType::Integer && *lhs_type != SQLType::Boolean)
+            continue;
+
+        if (*lhs_table < right_index && *rhs_table == right_index)
+            return HashJoinKeys { binary.lhs(), binary.rhs() };
+        if (*rhs_table < right_index && *lhs_table == right_index)
+            return HashJoinKeys { binary.rhs(), binary.lhs() };
+    }
+    return {};
+}
+
+ResultOr<QueryPlan> QueryPlan::create(ExecutionContext& context, Select const& select)
+{
+    Vector<PlannedTable> tables;
+    for (auto const& table_descriptor : select.table_or_subquery_list()) {
+        if (!table_descriptor->is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        if (table_def->num_columns() == 0)
+            continue;
+        tables.append({ move(table_def), {}, {} });
+    }
+
+    Vector<NonnullRefPtr<Expression>> conditions;
+    if (select.where_clause())
+        split_conjunction(*select.where_clause(), conditions);
+
+    // Every condition is evaluated as soon as all the tables it depends on are available.
+    Vector<NonnullRefPtr<Expression>> remaining_conditions;
+    for (auto& condition : conditions) {
+        auto referenced_tables = tables_referenced_by(condition, tables);
+        if (!referenced_tables.has_value() || *referenced_tables == 0) {
+            remaining_conditions.append(move(condition));
+            continue;
+        }
+
+        auto last_table = sizeof(TableSet) * 8 - 1 - count_leading_zeroes(*referenced_tables);
+        if (popcount(*referenced_tables) == 1)
+            tables[last_table].scan_predicates.append(move(condition));
+        else
+            tables[last_table].join_predicates.append(move(condition));
+    }
+
+    OwnPtr<PlanNode> root;
+    for (size_t i = 0; i < tables.size(); ++i) {
+        auto& table = tables[i];
+        NonnullOwnPtr<PlanNode> scan = make<TableScanNode>(table.table, move(table.scan_predicates));
+        if (!root) {
+            VERIFY(table.join_predicates.is_empty());
+            root = move(scan);
+            continue;
+        }
+
+        if (auto keys = find_hash_join_keys(tables, i); keys.has_value())
+            root = make<HashJoinNode>(root.release_nonnull(), move(scan), move(keys->left), move(keys->right), move(table.join_predicates));
+        else
+            root = make<NestedLoopJoinNode>(root.release_nonnull(), move(scan), move(table.join_predicates));
+    }
+
+    if (!root)
+        root = make<SingleRowNode>();
+    if (!remaining_conditions.is_empty())
+        root = make<FilterNode>(root.release_nonnull(), move(remaining_conditions));
+
+    return QueryPlan { root.release_nonnull() };
+}
+
+Vector<ByteString> QueryPlan::explain() const
+{
+    Vector<ByteString> lines;
+    m_root->explain(lines, 0);
+    return lines;
+}
+
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Meta.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+/**
+ * A node of a query plan. Plans are pulled from the root: every call to next()
+ * produces the next row of the node, so rows stream through the plan instead of
+ * the whole cartesian product being materialized first.
+ */
+class PlanNode {
+public:
+    virtual ~PlanNode() = default;
+
+    NonnullRefPtr<TupleDescriptor> const& descriptor() const { return m_descriptor; }
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) = 0;
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const = 0;
+
+protected:
+    explicit PlanNode(NonnullRefPtr<TupleDescriptor> descriptor)
+        : m_descriptor(move(descriptor))
+    {
+    }
+
+    NonnullRefPtr<TupleDescriptor> m_descriptor;
+};
+
+/**
+ * Produces a single row without any columns, for SELECTs without tables.
+ */
+class SingleRowNode final : public PlanNode {
+public:
+    SingleRowNode();
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const override;
+
+private:
+    bool m_done { false };
+};
+
+/**
+ * Walks the rows of a table one block at a time, dropping the rows that don't
+ * satisfy the predicates that only depend on this table.
+ *
+ * Predicates comparing a column with a literal or a placeholder are checked on
+ * the encoded row, so rows they reject are never materialized.
+ */
+class TableScanNode final : public PlanNode {
+public:
+    TableScanNode(NonnullRefPtr<TableDef>, Vector<NonnullRefPtr<Expression>> predicates);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const override;
+
+private:
+    struct ColumnComparison {
+        size_t column_index { 0 };
+        BinaryOperator op;
+        NonnullRefPtr<Expression> operand;
+    };
+
+    Optional<ColumnComparison> column_comparison_for(Expression const&) const;
+    ResultOr<bool> satisfies_column_comparisons(ExecutionContext&, RowView const&);
+
+    NonnullRefPtr<TableDef> m_table;
+    Vector<NonnullRefPtr<Expression>> m_predicates;
+    Vector<ColumnComparison> m_column_comparisons;
+    Vector<NonnullRefPtr<Expression>> m_row_predicates;
+    Optional<Vector<Value>> m_operand_values;
+    Block::Index m_next_block_index { 0 };
+};
+
+/**
+ * Drops the rows of its input that don't satisfy the predicates.
+ */
+class FilterNode final : public PlanNode {
+public:
+    FilterNode(NonnullOwnPtr<PlanNode> input, Vector<NonnullRefPtr<Expression>> predicates);
+
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const override;
+
+private:
+    NonnullOwnPtr<PlanNode> m_input;
+    Vector<NonnullRefPtr<Expression>> m_predicates;
+};
+
+/**
+ * Base class for joins. The rows of the right input are read once and kept in
+ * memory, the rows of the left input are streamed.
+ */
+class JoinNode : public PlanNode {
+public:
+    virtual ResultOr<Optional<Tuple>> next(ExecutionContext&) override;
+
+protected:
+    JoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, Vector<NonnullRefPtr<Expression>> predicates);
+
+    virtual ResultOr<void> build(ExecutionContext&, Vector<Tuple>& right_rows) = 0;
+    virtual ResultOr<void> find_candidates(ExecutionContext&, Tuple& left_row, Vector<size_t>& candidates) = 0;
+
+    void explain_inputs(Vector<ByteString>& lines, size_t depth) const;
+    Vector<NonnullRefPtr<Expression>> const& predicates() const { return m_predicates; }
+
+private:
+    NonnullOwnPtr<PlanNode> m_left;
+    NonnullOwnPtr<PlanNode> m_right;
+    Vector<NonnullRefPtr<Expression>> m_predicates;
+
+    Optional<Vector<Tuple>> m_right_rows;
+    Optional<Tuple> m_left_row;
+    Vector<size_t> m_candidates;
+    size_t m_candidate_index { 0 };
+};
+
+/**
+ * Joins every row of the left input with every row of the right input.
+ */
+class NestedLoopJoinNode final : public JoinNode {
+public:
+    NestedLoopJoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, Vector<NonnullRefPtr<Expression>> predicates);
+
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const override;
+
+private:
+    virtual ResultOr<void> build(ExecutionContext&, Vector<Tuple>& right_rows) override;
+    virtual ResultOr<void> find_candidates(ExecutionContext&, Tuple& left_row, Vector<size_t>& candidates) override;
+
+    size_t m_right_row_count { 0 };
+};
+
+/**
+ * Joins the rows of the left input with the rows of the right input that have
+ * the same key, using a hash table built from the right input. The equality of
+ * the keys is still checked by the join predicates, the hash table only narrows
+ * down the rows to check.
+ */
+class HashJoinNode final : public JoinNode {
+public:
+    HashJoinNode(NonnullOwnPtr<PlanNode> left, NonnullOwnPtr<PlanNode> right, NonnullRefPtr<Expression> left_key, NonnullRefPtr<Expression> right_key, Vector<NonnullRefPtr<Expression>> predicates);
+
+    virtual void explain(Vector<ByteString>& lines, size_t depth) const override;
+
+private:
+    virtual ResultOr<void> build(ExecutionContext&, Vector<Tuple>& right_rows) override;
+    virtual ResultOr<void> find_candidates(ExecutionContext&, Tuple& left_row, Vector<size_t>& candidates) override;
+
+    NonnullRefPtr<Expression> m_left_key;
+    NonnullRefPtr<Expression> m_right_key;
+
+    HashMap<u32, Vector<size_t>> m_buckets;
+    Vector<size_t> m_rows_without_hashable_key;
+    size_t m_right_row_count { 0 };
+};
+
+/**
+ * The plan for a SELECT statement: the WHERE clause is split into its AND-ed
+ * conditions, each of which is evaluated as early as possible. Conditions on a
+ * single table are pushed down into the scan of that table, and equality
+ * conditions between a table and the tables before it in the FROM clause turn
+ * the join with that table into a hash join.
+ */
+class QueryPlan {
+public:
+    static ResultOr<QueryPlan> create(ExecutionContext&, Select const&);
+
+    ResultOr<Optional<Tuple>> next(ExecutionContext& context) { return m_root->next(context); }
+    Vector<ByteString> explain() const;
+
+private:
+    explicit QueryPlan(NonnullOwnPtr<PlanNode> root)
+        : m_root(move(root))
+    {
+    }
+
+    NonnullOwnPtr<PlanNode> m_root;
+};
+
+}
@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Checked.h>
 #include <AK/NumericLimits.h>
+#include <AK/ScopeGuard.h>
 #include <LibSQL/AST/AST.h>
+#include <LibSQL/AST/QueryPlan.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Meta.h>
+#include <LibSQL/ResultCursor.h>
 #include <LibSQL/Row.h>
+#include <LibSQL/RowSorter.h>
 
 namespace SQL::AST {
 
@@ -37,19 +42,66 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
-ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
+namespace {
+
+// The rows of the tables are read as the cursor advances, and the plan keeps its position in them between calls. A
+// modification may free the blocks it is about to read, so the cursor fails once any of its tables has been modified,
+// or a transaction has been rolled back.
+// FIXME: Read from a snapshot of the tables instead.
+class SelectCursor final : public ResultCursor {
+public:
+    static ResultOr<NonnullOwnPtr<SelectCursor>> create(Select const&, NonnullRefPtr<Database>, Vector<Value> placeholder_values);
+
+    virtual ResultOr<Optional<Tuple>> next() override;
+
+private:
+    SelectCursor(Select const& select, NonnullRefPtr<Database> database, Vector<NonnullRefPtr<ResultColumn const>> columns, Vector<ByteString> column_names, Vector<Value> placeholder_values)
+        : ResultCursor(SQLCommand::Select, move(column_names))
+        , m_select(select)
+        , m_columns(move(columns))
+        , m_placeholder_values(move(placeholder_values))
+        , m_context { move(database), m_select.ptr(), m_placeholder_values, nullptr }
+    {
+    }
+
+    ResultOr<void> evaluate_limit_clause();
+    ResultOr<void> ensure_rows_are_valid() const;
+    ResultOr<Tuple> evaluate_columns(Tuple& row);
+    ResultOr<void> sort_rows();
+
+    NonnullRefPtr<Select const> m_select;
+    Vector<NonnullRefPtr<ResultColumn const>> m_columns;
+    Vector<Value> m_placeholder_values;
+    ExecutionContext m_context;
+
+    Vector<NonnullRefPtr<TableDef>> m_tables;
+    u64 m_generation { 0 };
+
+    Optional<QueryPlan> m_plan;
+    OwnPtr<RowSorter> m_sorter;
+    bool m_rows_are_sorted { false };
+
+    size_t m_offset { 0 };
+    size_t m_limit { NumericLimits<size_t>::max() };
+    size_t m_skipped_row_count { 0 };
+    size_t m_returned_row_count { 0 };
+};
+
+ResultOr<NonnullOwnPtr<SelectCursor>> SelectCursor::create(Select const& select, NonnullRefPtr<Database> database, Vector<Value> placeholder_values)
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
     Vector<ByteString> column_names;
+    Vector<NonnullRefPtr<TableDef>> tables;
 
-    auto const& result_column_list = this->result_column_list();
+    auto const& result_column_list = select.result_column_list();
     VERIFY(!result_column_list.is_empty());
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
+    for (auto& table_descriptor : select.table_or_subquery_list()) {
         if (!table_descriptor->is_table())
             return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
 
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        auto table_def = TRY(database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        TRY(tables.try_append(table_def));
 
         if (result_column_list.size() == 1 && result_column_list[0]->type() == ResultType::All) {
             TRY(columns.try_ensure_capacity(columns.size() + table_def->columns().size()));
@@ -83,98 +135,176 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
     }
 
-    ResultSet result { SQLCommand::Select, move(column_names) };
+    auto generation = database->generation();
+    auto cursor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) SelectCursor(select, move(database), move(columns), move(column_names), move(placeholder_values))));
+    cursor->m_tables = move(tables);
+    cursor->m_generation = generation;
+    TRY(cursor->evaluate_limit_clause());
+    cursor->m_plan = TRY(QueryPlan::create(cursor->m_context, select));
 
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
+    if (!select.ordering_term_list().is_empty()) {
+        // With a LIMIT clause, only the rows up to the last row to be returned need to be sorted.
+        Optional<size_t> max_rows_needed;
+        if (select.limit_clause() && !Checked<size_t>::addition_would_overflow(cursor->m_offset, cursor->m_limit))
+            max_rows_needed = cursor->m_offset + cursor->m_limit;
 
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+        cursor->m_sorter = TRY(try_make<RowSorter>(cursor->m_context.database, max_rows_needed));
+    }
 
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
+    return cursor;
+}
 
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
+ResultOr<void> SelectCursor::evaluate_limit_clause()
+{
+    auto const& limit_clause = m_select->limit_clause();
+    if (limit_clause == nullptr)
+        return {};
 
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
+    auto limit = TRY(limit_clause->limit_expression()->evaluate(m_context));
+    if (!limit.is_null()) {
+        auto limit_value_maybe = limit.to_int<size_t>();
+        if (!limit_value_maybe.has_value())
+            return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
 
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
+        m_limit = limit_value_maybe.value();
+    }
+
+    if (limit_clause->offset_expression() != nullptr) {
+        auto offset = TRY(limit_clause->offset_expression()->evaluate(m_context));
+        if (!offset.is_null()) {
+            auto offset_value_maybe = offset.to_int<size_t>();
+            if (!offset_value_maybe.has_value())
+                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
+
+            m_offset = offset_value_maybe.value();
         }
     }
 
-    bool has_ordering { false };
+    return {};
+}
+
+ResultOr<void> SelectCursor::ensure_rows_are_valid() const
+{
+    // Rows that were read before a rollback, including those kept by the sorter, may have been rolled back.
+    if (m_context.database->has_rolled_back_since(m_generation))
+        return Result { SQLCommand::Select, SQLErrorCode::TransactionRolledBack };
+
+    // Once sorted, the rows are read from the sorter, which doesn't depend on the tables anymore.
+    if (m_rows_are_sorted)
+        return {};
+
+    for (auto const& table : m_tables) {
+        if (m_context.database->has_table_changed_since(table, m_generation))
+            return Result { SQLCommand::Select, SQLErrorCode::TableModified, table->name() };
+    }
+    return {};
+}
+
+ResultOr<Tuple> SelectCursor::evaluate_columns(Tuple& row)
+{
+    m_context.current_row = &row;
+    ScopeGuard guard = [&] { m_context.current_row = nullptr; };
+
+    Tuple tuple;
+    for (auto& col : m_columns) {
+        auto value = TRY(col->expression()->evaluate(m_context));
+        tuple.append(value);
+    }
+    return tuple;
+}
+
+ResultOr<void> SelectCursor::sort_rows()
+{
     auto sort_descriptor = adopt_ref(*new TupleDescriptor);
-    for (auto& term : m_ordering_term_list) {
+    for (auto& term : m_select->ordering_term_list())
         sort_descriptor->append(TupleElementDescriptor { .order = term->order() });
-        has_ordering = true;
-    }
     Tuple sort_key(sort_descriptor);
 
-    for (auto& row : rows) {
-        context.current_row = &row;
+    while (true) {
+        auto row = TRY(m_plan->next(m_context));
+        if (!row.has_value())
+            break;
 
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
+        auto tuple = TRY(evaluate_columns(*row));
+
+        m_context.current_row = &row.value();
+        sort_key.clear();
+        for (auto& term : m_select->ordering_term_list()) {
+            auto value = TRY(term->expression()->evaluate(m_context));
+            sort_key.append(value);
         }
+        m_context.current_row = nullptr;
 
-        tuple.clear();
+        TRY(m_sorter->add(tuple, sort_key));
+    }
 
-        for (auto& col : columns) {
-            auto value = TRY(col->expression()->evaluate(context));
-            tuple.append(value);
-        }
+    TRY(m_sorter->finish());
+    m_rows_are_sorted = true;
+    return {};
+}
 
-        if (has_ordering) {
-            sort_key.clear();
-            for (auto& term : m_ordering_term_list) {
-                auto value = TRY(term->expression()->evaluate(context));
-                sort_key.append(value);
-            }
-        }
+ResultOr<Optional<Tuple>> SelectCursor::next()
+{
+    if (m_returned_row_count == m_limit)
+        return Optional<Tuple> {};
 
-        result.insert_row(tuple, sort_key);
-    }
+    TRY(ensure_rows_are_valid());
 
-    if (m_limit_clause != nullptr) {
-        size_t limit_value = NumericLimits<size_t>::max();
-        size_t offset_value = 0;
+    if (m_sorter) {
+        if (!m_rows_are_sorted)
+            TRY(sort_rows());
 
-        auto limit = TRY(m_limit_clause->limit_expression()->evaluate(context));
-        if (!limit.is_null()) {
-            auto limit_value_maybe = limit.to_int<size_t>();
-            if (!limit_value_maybe.has_value())
-                return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "LIMIT clause must evaluate to an integer value"sv };
+        while (true) {
+            auto row = TRY(m_sorter->next());
+            if (!row.has_value())
+                return row;
+
+            if (m_skipped_row_count < m_offset) {
+                ++m_skipped_row_count;
+                continue;
+            }
 
-            limit_value = limit_value_maybe.value();
+            ++m_returned_row_count;
+            return row;
         }
+    }
 
-        if (m_limit_clause->offset_expression() != nullptr) {
-            auto offset = TRY(m_limit_clause->offset_expression()->evaluate(context));
-            if (!offset.is_null()) {
-                auto offset_value_maybe = offset.to_int<size_t>();
-                if (!offset_value_maybe.has_value())
-                    return Result { SQLCommand::Select, SQLErrorCode::SyntaxError, "OFFSET clause must evaluate to an integer value"sv };
+    while (true) {
+        auto row = TRY(m_plan->next(m_context));
+        if (!row.has_value())
+            return row;
 
-                offset_value = offset_value_maybe.value();
-            }
+        // Without an ORDER BY clause, the rows before the OFFSET don't need to be evaluated at all.
+        if (m_skipped_row_count < m_offset) {
+            ++m_skipped_row_count;
+            continue;
         }
 
-        result.limit(offset_value, limit_value);
+        ++m_returned_row_count;
+        return Optional<Tuple> { TRY(evaluate_columns(*row)) };
+    }
+}
+
+}
+
+ResultOr<NonnullOwnPtr<ResultCursor>> Select::open_cursor(NonnullRefPtr<Database> database, Vector<Value> placeholder_values) const
+{
+    return TRY(SelectCursor::create(*this, move(database), move(placeholder_values)));
+}
+
+ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
+{
+    Vector<Value> placeholder_values;
+    TRY(placeholder_values.try_append(context.placeholder_values.data(), context.placeholder_values.size()));
+
+    auto cursor = TRY(open_cursor(context.database, move(placeholder_values)));
+    ResultSet result { SQLCommand::Select, cursor->column_names() };
+
+    while (true) {
+        auto row = TRY(cursor->next());
+        if (!row.has_value())
+            break;
+        result.insert_row(*row, Tuple {});
     }
 
     return result;
@@ -16,8 +16,9 @@ ResultOr<ResultSet> Statement::execute(AK::NonnullRefPtr<Database> database, Rea
     ExecutionContext context { move(database), this, placeholder_values, nullptr };
     auto result = TRY(execute(context));
 
-    // FIXME: When transactional sessions are supported, don't auto-commit modifications.
-    TRY(context.database->commit());
+    // Outside of a transaction, every statement is committed on its own.
+    if (!context.database->in_transaction())
+        TRY(context.database->commit());
 
     return result;
 }
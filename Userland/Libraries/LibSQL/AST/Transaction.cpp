@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/ResultSet.h>
+
+namespace SQL::AST {
+
+ResultOr<ResultSet> BeginTransaction::execute(ExecutionContext& context) const
+{
+    TRY(context.database->begin_transaction());
+    return ResultSet { SQLCommand::Begin };
+}
+
+ResultOr<ResultSet> CommitTransaction::execute(ExecutionContext& context) const
+{
+    TRY(context.database->commit_transaction());
+    return ResultSet { SQLCommand::Commit };
+}
+
+ResultOr<ResultSet> RollbackTransaction::execute(ExecutionContext& context) const
+{
+    TRY(context.database->rollback_transaction());
+    return ResultSet { SQLCommand::Rollback };
+}
+
+}
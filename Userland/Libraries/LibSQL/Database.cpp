@@ -6,6 +6,7 @@
  */
 
 #include <AK/ByteString.h>
+#include <LibCore/System.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Heap.h>
@@ -31,21 +32,7 @@ ResultOr<void> Database::open()
 {
     VERIFY(!m_open);
     TRY(m_heap->open());
-
-    m_schemas = TRY(BTree::create(m_serializer, SchemaDef::index_def()->to_tuple_descriptor(), m_heap->schemas_root()));
-    m_schemas->on_new_root = [&]() {
-        m_heap->set_schemas_root(m_schemas->root());
-    };
-
-    m_tables = TRY(BTree::create(m_serializer, TableDef::index_def()->to_tuple_descriptor(), m_heap->tables_root()));
-    m_tables->on_new_root = [&]() {
-        m_heap->set_tables_root(m_tables->root());
-    };
-
-    m_table_columns = TRY(BTree::create(m_serializer, ColumnDef::index_def()->to_tuple_descriptor(), m_heap->table_columns_root()));
-    m_table_columns->on_new_root = [&]() {
-        m_heap->set_table_columns_root(m_table_columns->root());
-    };
+    TRY(open_catalog());
 
     m_open = true;
 
@@ -78,7 +65,34 @@ ResultOr<void> Database::open()
     return {};
 }
 
-Database::~Database() = default;
+ErrorOr<void> Database::open_catalog()
+{
+    m_schemas = TRY(BTree::create(m_serializer, SchemaDef::index_def()->to_tuple_descriptor(), m_heap->schemas_root()));
+    m_schemas->on_new_root = [&]() {
+        m_heap->set_schemas_root(m_schemas->root());
+    };
+
+    m_tables = TRY(BTree::create(m_serializer, TableDef::index_def()->to_tuple_descriptor(), m_heap->tables_root()));
+    m_tables->on_new_root = [&]() {
+        m_heap->set_tables_root(m_tables->root());
+    };
+
+    m_table_columns = TRY(BTree::create(m_serializer, ColumnDef::index_def()->to_tuple_descriptor(), m_heap->table_columns_root()));
+    m_table_columns->on_new_root = [&]() {
+        m_heap->set_table_columns_root(m_table_columns->root());
+    };
+
+    return {};
+}
+
+Database::~Database()
+{
+    // The heap flushes its write-ahead log when it is destroyed, which must not commit an unfinished transaction.
+    if (m_in_transaction) {
+        if (auto result = m_heap->rollback(); result.is_error())
+            warnln("~Database({}): {}", m_heap->name(), result.error());
+    }
+}
 
 ErrorOr<void> Database::commit()
 {
@@ -87,6 +101,52 @@ ErrorOr<void> Database::commit()
     return {};
 }
 
+ResultOr<void> Database::begin_transaction()
+{
+    VERIFY(is_open());
+
+    if (m_in_transaction)
+        return Result { SQLCommand::Begin, SQLErrorCode::TransactionActive };
+
+    // A rollback restores the heap to what is on disk, so anything written before the transaction is committed now.
+    TRY(m_heap->flush());
+    m_in_transaction = true;
+    return {};
+}
+
+ResultOr<void> Database::commit_transaction()
+{
+    VERIFY(is_open());
+
+    if (!m_in_transaction)
+        return Result { SQLCommand::Commit, SQLErrorCode::NoActiveTransaction };
+
+    TRY(m_heap->flush());
+    m_in_transaction = false;
+    return {};
+}
+
+ResultOr<void> Database::rollback_transaction()
+{
+    VERIFY(is_open());
+
+    if (!m_in_transaction)
+        return Result { SQLCommand::Rollback, SQLErrorCode::NoActiveTransaction };
+
+    TRY(m_heap->rollback());
+    m_in_transaction = false;
+
+    // The rollback discards blocks that readers may still be positioned in, and rows they may have already read.
+    m_rollback_generation = ++m_generation;
+
+    // The cached definitions and the catalog B-trees may refer to blocks that were just discarded.
+    m_schema_cache.clear();
+    m_table_cache.clear();
+    TRY(open_catalog());
+
+    return {};
+}
+
 ResultOr<void> Database::add_schema(SchemaDef const& schema)
 {
     VERIFY(is_open());
@@ -184,6 +244,32 @@ ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
     return ret;
 }
 
+ErrorOr<Row> Database::read_row(TableDef& table, Block::Index block_index)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    return m_serializer.deserialize_block<Row>(block_index, table, block_index);
+}
+
+ErrorOr<RowView> Database::read_row_view(TableDef& table, Block::Index block_index)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    m_serializer.read_storage(block_index);
+    return RowView { m_serializer };
+}
+
+ErrorOr<NonnullRefPtr<Heap>> Database::create_scratch_heap()
+{
+    auto name = ByteString::formatted("{}.scratch-{}", m_heap->name(), m_next_scratch_heap_id++);
+
+    // A scratch file may have been left behind by a process that didn't get to clean up after itself.
+    if (auto result = Core::System::unlink(name); result.is_error() && result.error().code() != ENOENT)
+        return result.release_error();
+
+    auto heap = TRY(Heap::create(move(name)));
+    TRY(heap->open());
+    return heap;
+}
+
 ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -202,19 +288,39 @@ ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 
 ErrorOr<void> Database::insert(Row& row)
 {
-    VERIFY(m_table_cache.get(row.table().key().hash()).has_value());
+    return insert_rows({ &row, 1 });
+}
+
+ErrorOr<void> Database::insert_rows(Span<Row> rows)
+{
+    if (rows.is_empty())
+        return {};
+
+    auto& table = rows.first().table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
     // TODO: implement table constraints such as unique, foreign key, etc.
 
-    row.set_block_index(m_heap->request_new_block_index());
-    row.set_next_block_index(row.table().block_index());
-    TRY(update(row));
+    // Every row is linked in front of the rows inserted before it, so the table's pointer to its first row only has
+    // to be updated once for the whole batch.
+    auto next_block_index = table.block_index();
+    for (auto& row : rows) {
+        VERIFY(&row.table() == &table);
+
+        row.set_block_index(m_heap->request_new_block_index());
+        row.set_next_block_index(next_block_index);
+        TRY(update(row));
+
+        next_block_index = row.block_index();
+    }
 
     // TODO update indexes defined on table.
 
-    auto table_key = row.table().key();
-    table_key.set_block_index(row.block_index());
+    did_modify_table(table);
+
+    auto table_key = table.key();
+    table_key.set_block_index(next_block_index);
     VERIFY(m_tables->update_key_pointer(table_key));
-    row.table().set_block_index(row.block_index());
+    table.set_block_index(next_block_index);
     return {};
 }
 
@@ -224,6 +330,7 @@ ErrorOr<void> Database::remove(Row& row)
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
 
     TRY(m_heap->free_storage(row.block_index()));
+    did_modify_table(table);
 
     if (table.block_index() == row.block_index()) {
         auto table_key = table.key();
@@ -256,9 +363,23 @@ ErrorOr<void> Database::update(Row& tuple)
 
     m_serializer.reset();
     m_serializer.serialize_and_write<Tuple>(tuple);
+    did_modify_table(tuple.table());
 
     // TODO update indexes defined on table.
     return {};
 }
 
+bool Database::has_table_changed_since(TableDef const& table, u64 generation) const
+{
+    if (has_rolled_back_since(generation))
+        return true;
+    auto table_generation = m_table_generations.get(table.hash());
+    return table_generation.has_value() && table_generation.value() > generation;
+}
+
+void Database::did_modify_table(TableDef const& table)
+{
+    m_table_generations.set(table.hash(), ++m_generation);
+}
+
 }
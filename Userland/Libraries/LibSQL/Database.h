@@ -33,6 +33,13 @@ public:
     ErrorOr<void> commit();
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
+    // While a transaction is active, modifications are only kept in the heap's write-ahead log. They are written
+    // to disk by commit_transaction(), and discarded by rollback_transaction().
+    bool in_transaction() const { return m_in_transaction; }
+    ResultOr<void> begin_transaction();
+    ResultOr<void> commit_transaction();
+    ResultOr<void> rollback_transaction();
+
     ResultOr<void> add_schema(SchemaDef const&);
     static Key get_schema_key(ByteString const&);
     ResultOr<NonnullRefPtr<SchemaDef>> get_schema(ByteString const&);
@@ -42,15 +49,36 @@ public:
     ResultOr<NonnullRefPtr<TableDef>> get_table(ByteString const&, ByteString const&);
 
     ErrorOr<Vector<Row>> select_all(TableDef&);
+    ErrorOr<Row> read_row(TableDef&, Block::Index);
+    // The view borrows from the database's serializer, and is only valid until the next read from the database.
+    ErrorOr<RowView> read_row_view(TableDef&, Block::Index);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
     ErrorOr<void> insert(Row&);
+    ErrorOr<void> insert_rows(Span<Row>);
     ErrorOr<void> remove(Row&);
     ErrorOr<void> update(Row&);
 
+    // Every modification of a table bumps the database's generation. Readers that keep their position in a table
+    // between calls, like open cursors, use this to find out whether the table changed underneath them.
+    u64 generation() const { return m_generation; }
+    bool has_table_changed_since(TableDef const&, u64 generation) const;
+    bool has_rolled_back_since(u64 generation) const { return m_rollback_generation > generation; }
+
+    // Scratch space for operations that don't fit in memory, like sorting large result sets. The heap is backed by
+    // a file next to the database file, which the caller removes once it is done with it.
+    ErrorOr<NonnullRefPtr<Heap>> create_scratch_heap();
+
+    size_t max_sort_rows_in_memory() const { return m_max_sort_rows_in_memory; }
+    void set_max_sort_rows_in_memory(size_t max_sort_rows_in_memory) { m_max_sort_rows_in_memory = max_sort_rows_in_memory; }
+
 private:
     explicit Database(NonnullRefPtr<Heap>);
 
+    ErrorOr<void> open_catalog();
+    void did_modify_table(TableDef const&);
+
     bool m_open { false };
+    bool m_in_transaction { false };
     NonnullRefPtr<Heap> m_heap;
     Serializer m_serializer;
     RefPtr<BTree> m_schemas;
@@ -59,6 +87,13 @@ private:
 
     HashMap<u32, NonnullRefPtr<SchemaDef>> m_schema_cache;
     HashMap<u32, NonnullRefPtr<TableDef>> m_table_cache;
+
+    u64 m_generation { 0 };
+    u64 m_rollback_generation { 0 };
+    HashMap<u32, u64> m_table_generations;
+
+    size_t m_next_scratch_heap_id { 0 };
+    size_t m_max_sort_rows_in_memory { 16384 };
 };
 
 }
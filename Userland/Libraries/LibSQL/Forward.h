@@ -19,8 +19,11 @@ class Key;
 class KeyPartDef;
 class Relation;
 class Result;
+class ResultCursor;
 class ResultSet;
 class Row;
+class RowSorter;
+class RowView;
 class SchemaDef;
 class Serializer;
 class TableDef;
@@ -28,13 +31,16 @@ class TreeNode;
 class Tuple;
 class TupleDescriptor;
 struct TupleElementDescriptor;
+class TupleView;
 class Value;
+class ValueView;
 }
 
 namespace SQL::AST {
 class AddColumn;
 class AlterTable;
 class ASTNode;
+class BeginTransaction;
 class BetweenExpression;
 class BinaryOperatorExpression;
 class BlobLiteral;
@@ -46,6 +52,7 @@ class ColumnDefinition;
 class ColumnNameExpression;
 class CommonTableExpression;
 class CommonTableExpressionList;
+class CommitTransaction;
 class CreateTable;
 class Delete;
 class DropColumn;
@@ -53,6 +60,7 @@ class DropTable;
 class ErrorExpression;
 class ErrorStatement;
 class ExistsExpression;
+class Explain;
 class Expression;
 class GroupByClause;
 class InChainedExpression;
@@ -77,6 +85,7 @@ class RenameColumn;
 class RenameTable;
 class ResultColumn;
 class ReturningClause;
+class RollbackTransaction;
 class Select;
 class SignedNumber;
 class Statement;
@@ -86,7 +86,7 @@ ErrorOr<void> Heap::open()
     }
 
     dbgln_if(SQL_DEBUG, "Heap file {} opened; number of blocks = {}; free blocks = {}", name(), m_highest_block_written, m_free_block_indices.size());
-    return {};
+    return remember_flushed_state();
 }
 
 ErrorOr<size_t> Heap::file_size_in_bytes() const
@@ -109,18 +109,33 @@ Block::Index Heap::request_new_block_index()
 }
 
 ErrorOr<ByteBuffer> Heap::read_storage(Block::Index index)
+{
+    ByteBuffer data;
+    TRY(read_storage(index, data));
+    return data;
+}
+
+ErrorOr<void> Heap::read_storage(Block::Index index, ByteBuffer& data)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
 
     // Reconstruct the data storage from a potential chain of blocks
-    ByteBuffer data;
+    size_t size = 0;
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        dbgln_if(SQL_DEBUG, "  -> {} bytes", block.size_in_bytes());
-        TRY(data.try_append(block.data().bytes().slice(0, block.size_in_bytes())));
-        index = block.next_block();
+        auto raw_block = TRY(peek_raw_block(index));
+        auto size_in_bytes = *reinterpret_cast<u32 const*>(raw_block.offset_pointer(0));
+        dbgln_if(SQL_DEBUG, "  -> {} bytes", size_in_bytes);
+        if (size_in_bytes > Block::DATA_SIZE)
+            return Error::from_string_view("Block data size exceeds the block size"sv);
+
+        TRY(data.try_resize(size + size_in_bytes));
+        data.overwrite(size, raw_block.offset_pointer(Block::HEADER_SIZE), size_in_bytes);
+        size += size_in_bytes;
+
+        index = *reinterpret_cast<Block::Index const*>(raw_block.offset_pointer(sizeof(u32)));
     }
-    return data;
+
+    return data.try_resize(size);
 }
 
 ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
@@ -186,6 +201,23 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
     return buffer;
 }
 
+// Returns the raw block without copying it. The bytes are only valid until the next read or write.
+ErrorOr<ReadonlyBytes> Heap::peek_raw_block(Block::Index index)
+{
+    VERIFY(m_file);
+    VERIFY(index < m_next_block);
+
+    if (auto wal_entry = m_write_ahead_log.find(index); wal_entry != m_write_ahead_log.end())
+        return wal_entry->value.bytes();
+
+    if (m_read_buffer.is_empty())
+        m_read_buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
+
+    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
+    TRY(m_file->read_until_filled(m_read_buffer));
+    return m_read_buffer.bytes();
+}
+
 ErrorOr<Block> Heap::read_block(Block::Index index)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
@@ -285,7 +317,28 @@ ErrorOr<void> Heap::flush()
     }
     m_write_ahead_log.clear();
     dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
-    return {};
+    return remember_flushed_state();
+}
+
+ErrorOr<void> Heap::rollback()
+{
+    VERIFY(m_file);
+    dbgln_if(SQL_DEBUG, "Discarding {} blocks from the WAL", m_write_ahead_log.size());
+
+    m_write_ahead_log.clear();
+    m_next_block = m_flushed_next_block;
+    m_free_block_indices.clear();
+    TRY(m_free_block_indices.try_extend(m_flushed_free_block_indices));
+
+    // The zero block holds the B-tree roots, which may have changed since the last flush.
+    return read_zero_block();
+}
+
+ErrorOr<void> Heap::remember_flushed_state()
+{
+    m_flushed_next_block = m_next_block;
+    m_flushed_free_block_indices.clear();
+    return m_flushed_free_block_indices.try_extend(m_free_block_indices);
 }
 
 constexpr static auto FILE_ID = "SerenitySQL "sv;
@@ -66,7 +66,7 @@ private:
  */
 class Heap : public RefCounted<Heap> {
 public:
-    static constexpr u32 VERSION = 5;
+    static constexpr u32 VERSION = 6;
 
     static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
     virtual ~Heap();
@@ -116,15 +116,22 @@ public:
     }
 
     ErrorOr<ByteBuffer> read_storage(Block::Index);
+    // Reads the storage into the given buffer, reusing its capacity. Reading rows one after the other into the same
+    // buffer does not allocate once the buffer is large enough.
+    ErrorOr<void> read_storage(Block::Index, ByteBuffer&);
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
     ErrorOr<void> flush();
 
+    // Discards all writes since the last flush, restoring the heap to the state that is on disk.
+    ErrorOr<void> rollback();
+
 private:
     explicit Heap(ByteString);
 
     ErrorOr<ByteBuffer> read_raw_block(Block::Index);
+    ErrorOr<ReadonlyBytes> peek_raw_block(Block::Index);
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
     ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
 
@@ -136,6 +143,8 @@ private:
     ErrorOr<void> initialize_zero_block();
     ErrorOr<void> update_zero_block();
 
+    ErrorOr<void> remember_flushed_state();
+
     ByteString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
@@ -147,7 +156,12 @@ private:
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
     HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+    ByteBuffer m_read_buffer;
     Vector<Block::Index> m_free_block_indices;
+
+    // The block allocation state as of the last flush, which is restored by a rollback.
+    Block::Index m_flushed_next_block { 1 };
+    Vector<Block::Index> m_flushed_free_block_indices;
 };
 
 }
@@ -16,10 +16,14 @@ namespace SQL {
 
 #define ENUMERATE_SQL_COMMANDS(S) \
     S(Unknown)                    \
+    S(Begin)                      \
+    S(Commit)                     \
     S(Create)                     \
     S(Delete)                     \
     S(Describe)                   \
+    S(Explain)                    \
     S(Insert)                     \
+    S(Rollback)                   \
     S(Select)                     \
     S(Update)
 
@@ -47,6 +51,7 @@ constexpr char const* command_tag(SQLCommand command)
     S(BooleanOperatorTypeMismatch, "Cannot apply '{}' operator to non-boolean operands")          \
     S(ColumnDoesNotExist, "Column '{}' does not exist")                                           \
     S(DatabaseDoesNotExist, "Database '{}' does not exist")                                       \
+    S(DatabaseLocked, "Database is locked by another connection's transaction")                   \
     S(DatabaseUnavailable, "Database Unavailable")                                                \
     S(IntegerOperatorTypeMismatch, "Cannot apply '{}' operator to non-numeric operands")          \
     S(IntegerOverflow, "Operation would cause integer overflow")                                  \
@@ -57,6 +62,7 @@ constexpr char const* command_tag(SQLCommand command)
     S(InvalidOperator, "Invalid operator '{}'")                                                   \
     S(InvalidType, "Invalid type '{}'")                                                           \
     S(InvalidValueType, "Invalid type for attribute '{}'")                                        \
+    S(NoActiveTransaction, "No transaction is active")                                            \
     S(NoError, "No error")                                                                        \
     S(NotYetImplemented, "{}")                                                                    \
     S(NumericOperatorTypeMismatch, "Cannot apply '{}' operator to non-numeric operands")          \
@@ -65,7 +71,10 @@ constexpr char const* command_tag(SQLCommand command)
     S(StatementUnavailable, "Statement with id '{}' Unavailable")                                 \
     S(SyntaxError, "Syntax Error")                                                                \
     S(TableDoesNotExist, "Table '{}' does not exist")                                             \
-    S(TableExists, "Table '{}' already exist")
+    S(TableExists, "Table '{}' already exist")                                                    \
+    S(TableModified, "Table '{}' was modified while its rows were being read")                    \
+    S(TransactionActive, "A transaction is already active")                                       \
+    S(TransactionRolledBack, "The transaction was rolled back while its rows were being read")
 
 enum class SQLErrorCode {
 #undef __ENUMERATE_SQL_ERROR
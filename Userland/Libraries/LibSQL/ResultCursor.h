@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/Result.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL {
+
+/**
+ * Produces the rows of a statement's result one at a time, so that they don't
+ * all have to be kept in memory before being handed to the caller.
+ */
+class ResultCursor {
+public:
+    virtual ~ResultCursor() = default;
+
+    SQLCommand command() const { return m_command; }
+    Vector<ByteString> const& column_names() const { return m_column_names; }
+
+    virtual ResultOr<Optional<Tuple>> next() = 0;
+
+protected:
+    ResultCursor(SQLCommand command, Vector<ByteString> column_names)
+        : m_command(command)
+        , m_column_names(move(column_names))
+    {
+    }
+
+private:
+    SQLCommand m_command { SQLCommand::Unknown };
+    Vector<ByteString> m_column_names;
+};
+
+/**
+ * A cursor over a result set that has already been computed.
+ */
+class ResultSetCursor final : public ResultCursor {
+public:
+    explicit ResultSetCursor(ResultSet result)
+        : ResultCursor(result.command(), result.column_names())
+        , m_result(move(result))
+    {
+    }
+
+    virtual ResultOr<Optional<Tuple>> next() override
+    {
+        if (m_next_row_index == m_result.size())
+            return Optional<Tuple> {};
+        return Optional<Tuple> { m_result[m_next_row_index++].row };
+    }
+
+private:
+    ResultSet m_result;
+    size_t m_next_row_index { 0 };
+};
+
+}
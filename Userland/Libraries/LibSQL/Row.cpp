@@ -6,6 +6,7 @@
 
 #include <LibSQL/Meta.h>
 #include <LibSQL/Row.h>
+#include <LibSQL/Serializer.h>
 
 namespace SQL {
 
@@ -28,4 +29,10 @@ void Row::serialize(Serializer& serializer) const
     serializer.serialize<Block::Index>(next_block_index());
 }
 
+RowView::RowView(Serializer& serializer)
+    : TupleView(serializer)
+    , m_next_block_index(serializer.deserialize<Block::Index>())
+{
+}
+
 }
@@ -10,6 +10,7 @@
 #include <LibSQL/Forward.h>
 #include <LibSQL/Meta.h>
 #include <LibSQL/Tuple.h>
+#include <LibSQL/TupleView.h>
 #include <LibSQL/Value.h>
 
 namespace SQL {
@@ -43,4 +44,17 @@ private:
     Block::Index m_next_block_index { 0 };
 };
 
+/**
+ * A RowView is a Row as it is encoded in a serializer's buffer. See TupleView.
+ */
+class RowView : public TupleView {
+public:
+    explicit RowView(Serializer&);
+
+    [[nodiscard]] Block::Index next_block_index() const { return m_next_block_index; }
+
+private:
+    Block::Index m_next_block_index { 0 };
+};
+
 }
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibCore/System.h>
+#include <LibSQL/Database.h>
+#include <LibSQL/RowSorter.h>
+
+namespace SQL {
+
+namespace {
+
+struct SpilledRow {
+    Block::Index block_index() const { return index; }
+
+    void serialize(Serializer& serializer) const
+    {
+        serializer.serialize<Tuple>(row.row);
+        serializer.serialize<Tuple>(row.sort_key);
+    }
+
+    Block::Index index { 0 };
+    ResultRow const& row;
+};
+
+}
+
+RowSorter::RowSorter(NonnullRefPtr<Database> database, Optional<size_t> max_rows_needed)
+    : m_database(move(database))
+    , m_max_rows_needed(max_rows_needed)
+    , m_max_rows_in_memory(max(m_database->max_sort_rows_in_memory(), 1u))
+{
+}
+
+RowSorter::~RowSorter()
+{
+    if (!m_scratch_heap)
+        return;
+
+    auto name = m_scratch_heap->name();
+    m_serializer = {};
+    m_scratch_heap = nullptr;
+
+    if (auto result = Core::System::unlink(name); result.is_error())
+        warnln("~RowSorter: Could not remove scratch heap {}: {}", name, result.error());
+}
+
+ErrorOr<void> RowSorter::add(Tuple const& row, Tuple const& sort_key)
+{
+    VERIFY(!m_finished);
+
+    if (!m_row_descriptor) {
+        m_row_descriptor = row.descriptor();
+        m_sort_key_descriptor = sort_key.descriptor();
+    }
+
+    if (m_max_rows_needed.has_value() && *m_max_rows_needed <= m_max_rows_in_memory)
+        return add_to_top_rows(row, sort_key);
+
+    TRY(m_rows.try_append(ResultRow { row, sort_key }));
+    if (m_rows.size() >= m_max_rows_in_memory)
+        TRY(spill_rows());
+
+    return {};
+}
+
+ErrorOr<void> RowSorter::add_to_top_rows(Tuple const& row, Tuple const& sort_key)
+{
+    auto max_rows = *m_max_rows_needed;
+    if (max_rows == 0)
+        return {};
+    if (m_rows.size() == max_rows && sort_key.compare(m_rows.last().sort_key) >= 0)
+        return {};
+
+    // Insert the row after all rows with an equal sort key to keep the sort stable.
+    size_t low = 0;
+    size_t high = m_rows.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (sort_key.compare(m_rows[middle].sort_key) < 0)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+
+    TRY(m_rows.try_insert(low, ResultRow { row, sort_key }));
+    if (m_rows.size() > max_rows)
+        m_rows.take_last();
+
+    return {};
+}
+
+void RowSorter::sort_rows()
+{
+    Vector<size_t> order;
+    order.ensure_capacity(m_rows.size());
+    for (size_t i = 0; i < m_rows.size(); ++i)
+        order.unchecked_append(i);
+
+    quick_sort(order, [&](auto a, auto b) {
+        auto result = m_rows[a].sort_key.compare(m_rows[b].sort_key);
+        return result < 0 || (result == 0 && a < b);
+    });
+
+    Vector<ResultRow> sorted_rows;
+    sorted_rows.ensure_capacity(m_rows.size());
+    for (auto index : order)
+        sorted_rows.unchecked_append(move(m_rows[index]));
+
+    m_rows = move(sorted_rows);
+}
+
+ErrorOr<void> RowSorter::spill_rows()
+{
+    if (m_rows.is_empty())
+        return {};
+
+    if (!m_scratch_heap) {
+        m_scratch_heap = TRY(m_database->create_scratch_heap());
+        m_serializer = Serializer { m_scratch_heap };
+    }
+
+    sort_rows();
+
+    Run run;
+    TRY(run.block_indices.try_ensure_capacity(m_rows.size()));
+
+    for (auto const& row : m_rows) {
+        SpilledRow spilled_row { m_serializer.request_new_block_index(), row };
+        m_serializer.serialize_and_write(spilled_row);
+        run.block_indices.unchecked_append(spilled_row.block_index());
+    }
+
+    TRY(m_scratch_heap->flush());
+    m_rows.clear();
+
+    return m_runs.try_append(move(run));
+}
+
+ErrorOr<void> RowSorter::read_next_row_of_run(Run& run)
+{
+    run.head.clear();
+    if (run.position == run.block_indices.size())
+        return {};
+
+    m_serializer.read_storage(run.block_indices[run.position++]);
+    Tuple row { *m_row_descriptor, m_serializer };
+    Tuple sort_key { *m_sort_key_descriptor, m_serializer };
+
+    run.head = ResultRow { move(row), move(sort_key) };
+    return {};
+}
+
+ErrorOr<void> RowSorter::finish()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+
+    if (m_runs.is_empty()) {
+        sort_rows();
+        return {};
+    }
+
+    TRY(spill_rows());
+    for (auto& run : m_runs)
+        TRY(read_next_row_of_run(run));
+
+    return {};
+}
+
+ErrorOr<Optional<Tuple>> RowSorter::next()
+{
+    VERIFY(m_finished);
+
+    if (m_runs.is_empty()) {
+        if (m_next_row_index == m_rows.size())
+            return Optional<Tuple> {};
+        return Optional<Tuple> { m_rows[m_next_row_index++].row };
+    }
+
+    Run* next_run = nullptr;
+    for (auto& run : m_runs) {
+        if (!run.head.has_value())
+            continue;
+
+        // Earlier runs hold rows that were added earlier, so they win ties.
+        if (!next_run || run.head->sort_key.compare(next_run->head->sort_key) < 0)
+            next_run = &run;
+    }
+
+    if (!next_run)
+        return Optional<Tuple> {};
+
+    Tuple row = next_run->head->row;
+    TRY(read_next_row_of_run(*next_run));
+    return Optional<Tuple> { move(row) };
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Heap.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/Serializer.h>
+
+namespace SQL {
+
+/**
+ * Sorts rows by their sort key. Rows with equal sort keys are returned in the
+ * order in which they were added.
+ *
+ * If only the first rows are needed, as for a SELECT with ORDER BY and LIMIT,
+ * only that many rows are kept. Otherwise, the rows are sorted in runs of at
+ * most Database::max_sort_rows_in_memory() rows, which are spilled to a
+ * scratch heap and merged once all rows have been added.
+ */
+class RowSorter {
+    AK_MAKE_NONCOPYABLE(RowSorter);
+    AK_MAKE_NONMOVABLE(RowSorter);
+
+public:
+    RowSorter(NonnullRefPtr<Database>, Optional<size_t> max_rows_needed = {});
+    ~RowSorter();
+
+    ErrorOr<void> add(Tuple const& row, Tuple const& sort_key);
+    ErrorOr<void> finish();
+    ErrorOr<Optional<Tuple>> next();
+
+    size_t run_count() const { return m_runs.size(); }
+
+private:
+    struct Run {
+        Vector<Block::Index> block_indices;
+        size_t position { 0 };
+        Optional<ResultRow> head;
+    };
+
+    ErrorOr<void> add_to_top_rows(Tuple const& row, Tuple const& sort_key);
+    void sort_rows();
+    ErrorOr<void> spill_rows();
+    ErrorOr<void> read_next_row_of_run(Run&);
+
+    NonnullRefPtr<Database> m_database;
+    Optional<size_t> m_max_rows_needed;
+    size_t m_max_rows_in_memory { 0 };
+    bool m_finished { false };
+
+    Vector<ResultRow> m_rows;
+    size_t m_next_row_index { 0 };
+
+    // Spilled rows are stored without their descriptors, so they're read back with the descriptors of the first row.
+    RefPtr<TupleDescriptor> m_row_descriptor;
+    RefPtr<TupleDescriptor> m_sort_key_descriptor;
+
+    RefPtr<Heap> m_scratch_heap;
+    Serializer m_serializer;
+    Vector<Run> m_runs;
+};
+
+}
@@ -24,9 +24,14 @@ public:
     {
     }
 
+    explicit Serializer(ByteBuffer buffer)
+        : m_buffer(move(buffer))
+    {
+    }
+
     void read_storage(Block::Index block_index)
     {
-        m_buffer = m_heap->read_storage(block_index).release_value_but_fixme_should_propagate_errors();
+        m_heap->read_storage(block_index, m_buffer).release_value_but_fixme_should_propagate_errors();
         m_current_offset = 0;
     }
 
@@ -41,6 +46,12 @@ public:
         m_current_offset = 0;
     }
 
+    void seek(size_t offset)
+    {
+        VERIFY(offset <= m_buffer.size());
+        m_current_offset = offset;
+    }
+
     template<typename T, typename... Args>
     T deserialize_block(Block::Index block_index, Args&&... args)
     {
@@ -101,6 +112,18 @@ public:
 
     void serialize(ByteString const&);
 
+    // Returns the bytes without copying them. They are only valid until the next read from the heap.
+    ReadonlyBytes read_bytes(size_t size)
+    {
+        return { read(size), size };
+    }
+
+    ReadonlyBytes bytes_since(size_t offset) const
+    {
+        VERIFY(offset <= m_current_offset);
+        return m_buffer.bytes().slice(offset, m_current_offset - offset);
+    }
+
     template<typename T>
     bool serialize_and_write(T const& t)
     {
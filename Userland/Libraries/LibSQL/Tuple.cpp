@@ -29,7 +29,7 @@ Tuple::Tuple(NonnullRefPtr<TupleDescriptor> const& descriptor, Block::Index bloc
 }
 
 Tuple::Tuple(NonnullRefPtr<TupleDescriptor> const& descriptor, Serializer& serializer)
-    : Tuple(descriptor)
+    : m_descriptor(descriptor)
 {
     deserialize(serializer);
 }
@@ -40,11 +40,21 @@ void Tuple::deserialize(Serializer& serializer)
     serializer.deserialize_to<u32>(m_block_index);
     dbgln_if(SQL_DEBUG, "block_index: {}", m_block_index);
     auto number_of_elements = serializer.deserialize<u32>();
-    m_data.clear();
-    m_descriptor->clear();
+
+    // Only the values are stored, the descriptor is provided by whoever reads the tuple. A tuple read without a
+    // matching descriptor gets unnamed elements of the stored types.
+    auto has_matching_descriptor = m_descriptor->size() == number_of_elements;
+    if (!has_matching_descriptor)
+        m_descriptor = adopt_ref(*new TupleDescriptor);
+
+    m_data.clear_with_capacity();
+    m_data.ensure_capacity(number_of_elements);
+
     for (auto ix = 0u; ix < number_of_elements; ++ix) {
-        m_descriptor->append(serializer.deserialize<TupleElementDescriptor>());
-        m_data.append(serializer.deserialize<Value>());
+        auto value = serializer.deserialize<Value>();
+        if (!has_matching_descriptor)
+            m_descriptor->append(value.descriptor());
+        m_data.unchecked_append(move(value));
     }
 }
 
@@ -53,11 +63,9 @@ void Tuple::serialize(Serializer& serializer) const
     VERIFY(m_descriptor->size() == m_data.size());
     dbgln_if(SQL_DEBUG, "Serializing tuple with block_index {}", block_index());
     serializer.serialize<u32>(block_index());
-    serializer.serialize<u32>(m_descriptor->size());
-    for (auto ix = 0u; ix < m_descriptor->size(); ix++) {
-        serializer.serialize<TupleElementDescriptor>((*m_descriptor)[ix]);
-        serializer.serialize<Value>(m_data[ix]);
-    }
+    serializer.serialize<u32>(m_data.size());
+    for (auto const& value : m_data)
+        serializer.serialize<Value>(value);
 }
 
 Tuple::Tuple(Tuple const& other)
@@ -123,12 +131,8 @@ void Tuple::extend(Tuple const& other)
 size_t Tuple::length() const
 {
     size_t len = 2 * sizeof(u32);
-    for (auto ix = 0u; ix < m_descriptor->size(); ix++) {
-        auto& descriptor = (*m_descriptor)[ix];
-        auto& value = m_data[ix];
-        len += descriptor.length();
-        len += value.length();
-    }
+    for (auto const& value : m_data)
+        len += sizeof(u8) + value.length();
     return len;
 }
 
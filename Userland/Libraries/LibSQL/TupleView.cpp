@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ScopeGuard.h>
+#include <LibSQL/Serializer.h>
+#include <LibSQL/Tuple.h>
+#include <LibSQL/TupleView.h>
+
+namespace SQL {
+
+TupleView::TupleView(Serializer& serializer)
+    : m_serializer(serializer)
+    , m_offset(serializer.offset())
+{
+    m_block_index = serializer.deserialize<Block::Index>();
+
+    auto number_of_elements = serializer.deserialize<u32>();
+    m_values.ensure_capacity(number_of_elements);
+
+    for (auto ix = 0u; ix < number_of_elements; ++ix)
+        m_values.unchecked_append(serializer.deserialize<ValueView>());
+}
+
+Tuple TupleView::to_tuple(NonnullRefPtr<TupleDescriptor> const& descriptor) const
+{
+    auto offset = m_serializer.offset();
+    ScopeGuard restore_offset = [&]() { m_serializer.seek(offset); };
+
+    m_serializer.seek(m_offset);
+    return Tuple { descriptor, m_serializer };
+}
+
+}
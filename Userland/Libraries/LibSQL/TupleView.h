@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibSQL/Forward.h>
+#include <LibSQL/Heap.h>
+#include <LibSQL/Value.h>
+
+namespace SQL {
+
+/**
+ * A TupleView is a Tuple as it is encoded in a serializer's buffer. Its values
+ * are ValueViews borrowing from that buffer, so rows can be inspected and
+ * filtered without materializing them. A tuple is only materialized by
+ * to_tuple(), which decodes it from the same buffer again.
+ *
+ * Like its values, a TupleView is only valid until the serializer reads
+ * something else.
+ */
+class TupleView {
+public:
+    explicit TupleView(Serializer&);
+
+    [[nodiscard]] Block::Index block_index() const { return m_block_index; }
+    [[nodiscard]] size_t size() const { return m_values.size(); }
+
+    ValueView const& operator[](size_t ix) const { return m_values[ix]; }
+
+    [[nodiscard]] Tuple to_tuple(NonnullRefPtr<TupleDescriptor> const&) const;
+
+private:
+    Serializer& m_serializer;
+    size_t m_offset { 0 };
+    Block::Index m_block_index { 0 };
+    Vector<ValueView, 16> m_values;
+};
+
+}
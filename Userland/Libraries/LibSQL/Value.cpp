@@ -843,6 +843,153 @@ TupleElementDescriptor Value::descriptor() const
     return { "", "", "", type(), Order::Ascending };
 }
 
+static size_t encoded_integer_size(TypeData type_data)
+{
+    switch (type_data) {
+    case TypeData::Int8:
+    case TypeData::Uint8:
+        return sizeof(u8);
+    case TypeData::Int16:
+    case TypeData::Uint16:
+        return sizeof(u16);
+    case TypeData::Int32:
+    case TypeData::Uint32:
+        return sizeof(u32);
+    case TypeData::Int64:
+    case TypeData::Uint64:
+        return sizeof(u64);
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+template<typename T>
+static T read_encoded(ReadonlyBytes payload)
+{
+    VERIFY(payload.size() == sizeof(T));
+
+    T value;
+    memcpy(&value, payload.data(), sizeof(T));
+    return value;
+}
+
+void ValueView::deserialize(Serializer& serializer)
+{
+    auto offset = serializer.offset();
+
+    m_type_flags = serializer.deserialize<u8>();
+    m_type = static_cast<SQLType>(m_type_flags & 0x0f);
+
+    auto type_data = static_cast<TypeData>(m_type_flags & 0xf0);
+    m_is_null = type_data == TypeData::Null;
+
+    if (m_is_null) {
+        m_payload = {};
+        return;
+    }
+
+    switch (m_type) {
+    case SQLType::Null:
+        VERIFY_NOT_REACHED();
+    case SQLType::Text:
+        m_payload = serializer.read_bytes(serializer.deserialize<u32>());
+        break;
+    case SQLType::Integer:
+        m_payload = serializer.read_bytes(encoded_integer_size(type_data));
+        break;
+    case SQLType::Float:
+        m_payload = serializer.read_bytes(sizeof(double));
+        break;
+    case SQLType::Boolean:
+        m_payload = serializer.read_bytes(sizeof(bool));
+        break;
+    case SQLType::Tuple:
+        // Nested tuples are not stored in tables, so there is no point in viewing them in place. Keep the whole
+        // encoding around to decode the value when it's needed.
+        serializer.seek(offset);
+        (void)serializer.deserialize<Value>();
+        m_payload = serializer.bytes_since(offset);
+        break;
+    }
+}
+
+Value ValueView::to_value() const
+{
+    Value value { m_type };
+    if (m_is_null)
+        return value;
+
+    switch (m_type) {
+    case SQLType::Null:
+        VERIFY_NOT_REACHED();
+    case SQLType::Text:
+        value.m_value = ByteString { text() };
+        break;
+    case SQLType::Integer:
+        switch (static_cast<TypeData>(m_type_flags & 0xf0)) {
+        case TypeData::Int8:
+            value.m_value = static_cast<i64>(read_encoded<i8>(m_payload));
+            break;
+        case TypeData::Int16:
+            value.m_value = static_cast<i64>(read_encoded<i16>(m_payload));
+            break;
+        case TypeData::Int32:
+            value.m_value = static_cast<i64>(read_encoded<i32>(m_payload));
+            break;
+        case TypeData::Int64:
+            value.m_value = read_encoded<i64>(m_payload);
+            break;
+        case TypeData::Uint8:
+            value.m_value = static_cast<u64>(read_encoded<u8>(m_payload));
+            break;
+        case TypeData::Uint16:
+            value.m_value = static_cast<u64>(read_encoded<u16>(m_payload));
+            break;
+        case TypeData::Uint32:
+            value.m_value = static_cast<u64>(read_encoded<u32>(m_payload));
+            break;
+        case TypeData::Uint64:
+            value.m_value = read_encoded<u64>(m_payload);
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+        break;
+    case SQLType::Float:
+        value.m_value = read_encoded<double>(m_payload);
+        break;
+    case SQLType::Boolean:
+        value.m_value = read_encoded<bool>(m_payload);
+        break;
+    case SQLType::Tuple: {
+        Serializer serializer { ByteBuffer::copy(m_payload).release_value_but_fixme_should_propagate_errors() };
+        value = serializer.deserialize<Value>();
+        break;
+    }
+    }
+
+    return value;
+}
+
+int ValueView::compare(Value const& other) const
+{
+    // This must order values exactly like Value::compare() does, but strings are compared without copying them.
+    if (is_null())
+        return -1;
+    if (other.is_null())
+        return 1;
+
+    if (m_type == SQLType::Text)
+        return text().compare(other.to_byte_string());
+    return to_value().compare(other);
+}
+
+StringView ValueView::text() const
+{
+    VERIFY(m_type == SQLType::Text);
+    return { m_payload.data(), m_payload.size() };
+}
+
 ResultOr<NonnullRefPtr<TupleDescriptor>> Value::infer_tuple_descriptor(Vector<Value> const& values)
 {
     auto descriptor = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) SQL::TupleDescriptor));
@@ -166,6 +166,7 @@ public:
 
 private:
     friend Serializer;
+    friend ValueView;
 
     struct TupleValue {
         NonnullRefPtr<TupleDescriptor> descriptor;
@@ -181,6 +182,31 @@ private:
     Optional<ValueType> m_value;
 };
 
+/**
+ * A `ValueView` is a `Value` as it is encoded in a serializer's buffer. It
+ * borrows the encoded bytes instead of copying them, so inspecting it does not
+ * allocate. A `ValueView` is only valid until the serializer reads something
+ * else.
+ */
+class ValueView {
+public:
+    [[nodiscard]] SQLType type() const { return m_type; }
+    [[nodiscard]] bool is_null() const { return m_is_null; }
+
+    [[nodiscard]] Value to_value() const;
+    [[nodiscard]] int compare(Value const&) const;
+
+    void deserialize(Serializer&);
+
+private:
+    [[nodiscard]] StringView text() const;
+
+    SQLType m_type { SQLType::Null };
+    bool m_is_null { true };
+    u8 m_type_flags { 0 };
+    ReadonlyBytes m_payload;
+};
+
 }
 
 template<>
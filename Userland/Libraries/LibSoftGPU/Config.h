@@ -24,6 +24,13 @@ static constexpr int MAX_TEXTURE_SIZE = 2048;
 static constexpr float MAX_TEXTURE_LOD_BIAS = 2.f;
 static constexpr int SUBPIXEL_BITS = 4;
 
+// Triangles are binned into square screen tiles that are rasterized in parallel. Tiles need an even size so
+// that no pixel quad ever straddles two of them.
+static constexpr int RASTERIZER_TILE_SIZE = 64;
+static_assert(RASTERIZER_TILE_SIZE % 2 == 0);
+static constexpr size_t MIN_TRIANGLES_FOR_BINNING = 32;
+static constexpr size_t MAX_RASTERIZER_THREADS = 16;
+
 static constexpr int NUM_SHADER_INPUTS = 64;
 
 // Verify that we have enough inputs to hold vertex color and texture coordinates for all fixed function texture units
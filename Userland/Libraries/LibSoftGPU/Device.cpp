@@ -7,6 +7,7 @@
  */
 
 #include <AK/AnyOf.h>
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/Math.h>
 #include <AK/NumericLimits.h>
@@ -14,6 +15,7 @@
 #include <AK/SIMDMath.h>
 #include <AK/String.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/Vector2.h>
 #include <LibGfx/Vector3.h>
@@ -29,13 +31,13 @@
 
 namespace SoftGPU {
 
-static i64 g_num_rasterized_triangles;
-static i64 g_num_pixels;
-static i64 g_num_pixels_shaded;
-static i64 g_num_pixels_blended;
-static i64 g_num_sampler_calls;
-static i64 g_num_stencil_writes;
-static i64 g_num_quads;
+static Atomic<i64> g_num_rasterized_triangles;
+static Atomic<i64> g_num_pixels;
+static Atomic<i64> g_num_pixels_shaded;
+static Atomic<i64> g_num_pixels_blended;
+static Atomic<i64> g_num_sampler_calls;
+static Atomic<i64> g_num_stencil_writes;
+static Atomic<i64> g_num_quads;
 
 using AK::abs;
 using AK::SIMD::any;
@@ -53,6 +55,17 @@ using AK::SIMD::u32x4;
 
 static constexpr int subpixel_factor = 1 << SUBPIXEL_BITS;
 
+// Calculates the pixel bounds of a triangle from its vertices in subpixel coordinates.
+static Gfx::IntRect triangle_render_bounds(IntVector2 const& v0, IntVector2 const& v1, IntVector2 const& v2)
+{
+    Gfx::IntRect render_bounds;
+    render_bounds.set_left(min(min(v0.x(), v1.x()), v2.x()) / subpixel_factor);
+    render_bounds.set_right(max(max(v0.x(), v1.x()), v2.x()) / subpixel_factor + 1);
+    render_bounds.set_top(min(min(v0.y(), v1.y()), v2.y()) / subpixel_factor);
+    render_bounds.set_bottom(max(max(v0.y(), v1.y()), v2.y()) / subpixel_factor + 1);
+    return render_bounds;
+}
+
 // Returns positive values for counter-clockwise rotation of vertices. Note that it returns the
 // area of a parallelogram with sides {a, b} and {b, c}, so _double_ the area of the triangle {a, b, c}.
 constexpr static i32 edge_function(IntVector2 const& a, IntVector2 const& b, IntVector2 const& c)
@@ -223,7 +236,7 @@ ALWAYS_INLINE static Vector4<f32x4> blend_colors(
 }
 
 template<typename CB1, typename CB2, typename CB3>
-ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
+ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, ShaderProcessor& shader_processor, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
 {
     // Return if alpha testing is a no-op
     if (m_options.enable_alpha_test && m_options.alpha_test_func == GPU::AlphaTestFunction::Never)
@@ -231,9 +244,9 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
     auto const alpha_test_ref_value = expand4(m_options.alpha_test_ref_value);
 
     // Buffers
-    auto color_buffer = m_frame_buffer->color_buffer();
-    auto depth_buffer = m_frame_buffer->depth_buffer();
-    auto stencil_buffer = m_frame_buffer->stencil_buffer();
+    auto& color_buffer = m_frame_buffer->color_buffer();
+    auto& depth_buffer = m_frame_buffer->depth_buffer();
+    auto& stencil_buffer = m_frame_buffer->stencil_buffer();
 
     // Stencil configuration and writing
     auto const& stencil_configuration = m_stencil_configuration[GPU::Face::Front];
@@ -327,10 +340,10 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
             GPU::StencilType* stencil_ptrs[4];
             i32x4 stencil_value;
             if (m_options.enable_stencil_test) {
-                stencil_ptrs[0] = coverage_bits & 1 ? &stencil_buffer->scanline(qy)[qx] : nullptr;
-                stencil_ptrs[1] = coverage_bits & 2 ? &stencil_buffer->scanline(qy)[qx + 1] : nullptr;
-                stencil_ptrs[2] = coverage_bits & 4 ? &stencil_buffer->scanline(qy + 1)[qx] : nullptr;
-                stencil_ptrs[3] = coverage_bits & 8 ? &stencil_buffer->scanline(qy + 1)[qx + 1] : nullptr;
+                stencil_ptrs[0] = coverage_bits & 1 ? &stencil_buffer.scanline(qy)[qx] : nullptr;
+                stencil_ptrs[1] = coverage_bits & 2 ? &stencil_buffer.scanline(qy)[qx + 1] : nullptr;
+                stencil_ptrs[2] = coverage_bits & 4 ? &stencil_buffer.scanline(qy + 1)[qx] : nullptr;
+                stencil_ptrs[3] = coverage_bits & 8 ? &stencil_buffer.scanline(qy + 1)[qx + 1] : nullptr;
 
                 stencil_value = load4_masked(stencil_ptrs[0], stencil_ptrs[1], stencil_ptrs[2], stencil_ptrs[3], quad.mask);
                 stencil_value &= stencil_configuration.test_mask;
@@ -383,10 +396,10 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
 
             // Depth testing
             GPU::DepthType* depth_ptrs[4] = {
-                coverage_bits & 1 ? &depth_buffer->scanline(qy)[qx] : nullptr,
-                coverage_bits & 2 ? &depth_buffer->scanline(qy)[qx + 1] : nullptr,
-                coverage_bits & 4 ? &depth_buffer->scanline(qy + 1)[qx] : nullptr,
-                coverage_bits & 8 ? &depth_buffer->scanline(qy + 1)[qx + 1] : nullptr,
+                coverage_bits & 1 ? &depth_buffer.scanline(qy)[qx] : nullptr,
+                coverage_bits & 2 ? &depth_buffer.scanline(qy)[qx + 1] : nullptr,
+                coverage_bits & 4 ? &depth_buffer.scanline(qy + 1)[qx] : nullptr,
+                coverage_bits & 8 ? &depth_buffer.scanline(qy + 1)[qx + 1] : nullptr,
             };
             if (m_options.enable_depth_test) {
                 set_quad_depth(quad);
@@ -454,7 +467,7 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
             INCREASE_STATISTICS_COUNTER(g_num_pixels_shaded, maskcount(quad.mask));
 
             set_quad_attributes(quad);
-            shade_fragments(quad);
+            shade_fragments(quad, shader_processor);
 
             // Alpha testing
             if (m_options.enable_alpha_test) {
@@ -473,10 +486,10 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
                 continue;
 
             GPU::ColorType* color_ptrs[4] = {
-                coverage_bits & 1 ? &color_buffer->scanline(qy)[qx] : nullptr,
-                coverage_bits & 2 ? &color_buffer->scanline(qy)[qx + 1] : nullptr,
-                coverage_bits & 4 ? &color_buffer->scanline(qy + 1)[qx] : nullptr,
-                coverage_bits & 8 ? &color_buffer->scanline(qy + 1)[qx + 1] : nullptr,
+                coverage_bits & 1 ? &color_buffer.scanline(qy)[qx] : nullptr,
+                coverage_bits & 2 ? &color_buffer.scanline(qy)[qx + 1] : nullptr,
+                coverage_bits & 4 ? &color_buffer.scanline(qy + 1)[qx] : nullptr,
+                coverage_bits & 8 ? &color_buffer.scanline(qy + 1)[qx + 1] : nullptr,
             };
 
             u32x4 dst_u32;
@@ -546,6 +559,7 @@ void Device::rasterize_line_antialiased(GPU::Vertex& from, GPU::Vertex& to)
     f32x4 distance_along_line;
     rasterize(
         render_bounds,
+        m_shader_processor,
         [&from_coords4, &distance_along_line, &line_vector4, &line_dot4, &line_radius](auto& quad) {
             auto const screen_coordinates4 = to_vec2_f32x4(quad.screen_coordinates);
             auto const pixel_vector = screen_coordinates4 - from_coords4;
@@ -602,6 +616,7 @@ void Device::rasterize_point_aliased(GPU::Vertex& point)
     // Rasterize the point as a rect
     rasterize(
         point_rect,
+        m_shader_processor,
         [](auto& quad) {
             // We already passed in point_rect, so this doesn't matter
             quad.mask = expand4(~0);
@@ -634,6 +649,7 @@ void Device::rasterize_point_antialiased(GPU::Vertex& point)
     // Rasterize using a 2D signed distance field for a circle
     rasterize(
         render_bounds,
+        m_shader_processor,
         [&center4, &radius](auto& quad) {
             auto screen_coords = to_vec2_f32x4(quad.screen_coordinates);
             auto distance_to_point = length(center4 - screen_coords) - radius;
@@ -662,7 +678,7 @@ void Device::rasterize_point(GPU::Vertex& point)
         rasterize_point_aliased(point);
 }
 
-void Device::rasterize_triangle(Triangle& triangle)
+Optional<Gfx::IntRect> Device::setup_triangle(Triangle& triangle) const
 {
     INCREASE_STATISTICS_COUNTER(g_num_rasterized_triangles, 1);
 
@@ -672,25 +688,34 @@ void Device::rasterize_triangle(Triangle& triangle)
 
     auto triangle_area = edge_function(v0, v1, v2);
     if (triangle_area == 0)
-        return;
+        return {};
 
     // Perform face culling
     if (m_options.enable_culling) {
         bool is_front = (m_options.front_face == GPU::WindingOrder::CounterClockwise ? triangle_area > 0 : triangle_area < 0);
 
         if (!is_front && m_options.cull_back)
-            return;
+            return {};
 
         if (is_front && m_options.cull_front)
-            return;
+            return {};
     }
 
     // Force counter-clockwise ordering of vertices
-    if (triangle_area < 0) {
+    if (triangle_area < 0)
         swap(triangle.vertices[0], triangle.vertices[1]);
-        swap(v0, v1);
-        triangle_area *= -1;
-    }
+
+    return triangle_render_bounds(v0, v1, v2);
+}
+
+void Device::rasterize_triangle(Triangle const& triangle, Gfx::IntRect const& clip_rect, ShaderProcessor& shader_processor)
+{
+    auto v0 = (triangle.vertices[0].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v1 = (triangle.vertices[1].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v2 = (triangle.vertices[2].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+
+    auto triangle_area = edge_function(v0, v1, v2);
+    VERIFY(triangle_area > 0);
 
     auto const& vertex0 = triangle.vertices[0];
     auto const& vertex1 = triangle.vertices[1];
@@ -724,12 +749,7 @@ void Device::rasterize_triangle(Triangle& triangle)
             && edges.z() >= zero.z();
     };
 
-    // Calculate render bounds based on the triangle's vertices
-    Gfx::IntRect render_bounds;
-    render_bounds.set_left(min(min(v0.x(), v1.x()), v2.x()) / subpixel_factor);
-    render_bounds.set_right(max(max(v0.x(), v1.x()), v2.x()) / subpixel_factor + 1);
-    render_bounds.set_top(min(min(v0.y(), v1.y()), v2.y()) / subpixel_factor);
-    render_bounds.set_bottom(max(max(v0.y(), v1.y()), v2.y()) / subpixel_factor + 1);
+    auto render_bounds = triangle_render_bounds(v0, v1, v2);
 
     // Calculate depth of fragment for fog;
     // OpenGL 1.5 chapter 3.10: "An implementation may choose to approximate the
@@ -772,8 +792,12 @@ void Device::rasterize_triangle(Triangle& triangle)
         expand4(vertex2.window_coordinates.z() + depth_offset),
     };
 
+    // Only touch the pixels inside the clip rect; the depth offset above still depends on the full triangle
+    render_bounds.intersect(clip_rect);
+
     rasterize(
         render_bounds,
+        shader_processor,
         [&](auto& quad) {
             auto edge_values = calculate_edge_values4(quad.screen_coordinates * subpixel_factor + half_pixel_offset);
             quad.mask = test_point4(edge_values);
@@ -816,6 +840,8 @@ Device::Device(Gfx::IntSize size)
     m_options.scissor_box = m_frame_buffer->rect();
     m_options.viewport = m_frame_buffer->rect();
 
+    m_rasterizer_thread_count = min<size_t>(Core::System::hardware_concurrency(), MAX_RASTERIZER_THREADS);
+
     // Ensure we can always append 3 vertices unchecked
     m_clipped_vertices.ensure_capacity(3);
 }
@@ -1187,14 +1213,95 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
         }
     }
 
-    for (auto& triangle : m_processed_triangles)
-        rasterize_triangle(triangle);
+    if (m_processed_triangles.size() >= MIN_TRIANGLES_FOR_BINNING && m_rasterizer_thread_count > 1) {
+        rasterize_triangles_binned();
+        return;
+    }
+
+    auto const frame_buffer_rect = m_frame_buffer->rect();
+    for (auto& triangle : m_processed_triangles) {
+        if (setup_triangle(triangle).has_value())
+            rasterize_triangle(triangle, frame_buffer_rect, m_shader_processor);
+    }
+}
+
+void Device::rasterize_triangles_binned()
+{
+    // Binning: every triangle is added to the bin of each tile that its bounds overlap. Because triangles are
+    // appended in submission order and a tile is only ever rasterized by a single thread, every pixel still sees
+    // its triangles in draw order, and all depth, stencil and color buffer accesses for a tile stay on one thread.
+    auto binning_rect = m_frame_buffer->rect();
+    if (m_options.scissor_enabled)
+        binning_rect.intersect(m_options.scissor_box);
+    if (binning_rect.is_empty())
+        return;
+
+    m_tile_columns = ceil_div(m_frame_buffer->rect().width(), RASTERIZER_TILE_SIZE);
+    auto const tile_rows = ceil_div(m_frame_buffer->rect().height(), RASTERIZER_TILE_SIZE);
+    m_tile_bins.resize(m_tile_columns * tile_rows);
+    for (auto& bin : m_tile_bins)
+        bin.clear_with_capacity();
+
+    for (u32 triangle_index = 0; triangle_index < m_processed_triangles.size(); ++triangle_index) {
+        auto render_bounds = setup_triangle(m_processed_triangles[triangle_index]);
+        if (!render_bounds.has_value())
+            continue;
+        render_bounds->intersect(binning_rect);
+        if (render_bounds->is_empty())
+            continue;
+
+        auto const first_column = render_bounds->left() / RASTERIZER_TILE_SIZE;
+        auto const last_column = (render_bounds->right() - 1) / RASTERIZER_TILE_SIZE;
+        auto const first_row = render_bounds->top() / RASTERIZER_TILE_SIZE;
+        auto const last_row = (render_bounds->bottom() - 1) / RASTERIZER_TILE_SIZE;
+        for (int row = first_row; row <= last_row; ++row) {
+            for (int column = first_column; column <= last_column; ++column)
+                m_tile_bins[row * m_tile_columns + column].append(triangle_index);
+        }
+    }
+
+    // Rasterization: the calling thread and all pool workers keep taking the next unprocessed tile until none are left
+    if (!m_rasterizer_thread_pool) {
+        m_rasterizer_thread_pool = make<Threading::ThreadPool<size_t>>(
+            [this](size_t worker_index) { rasterize_tiles(*m_worker_shader_processors[worker_index]); },
+            m_rasterizer_thread_count - 1);
+        for (size_t i = 0; i < m_rasterizer_thread_count - 1; ++i)
+            m_worker_shader_processors.append(make<ShaderProcessor>(m_samplers));
+    }
+
+    m_next_tile_index.store(0, AK::MemoryOrder::memory_order_relaxed);
+    for (size_t i = 0; i < m_worker_shader_processors.size(); ++i)
+        m_rasterizer_thread_pool->submit(i);
+    rasterize_tiles(m_shader_processor);
+    m_rasterizer_thread_pool->wait_for_all();
+}
+
+void Device::rasterize_tiles(ShaderProcessor& shader_processor)
+{
+    while (true) {
+        auto const tile_index = m_next_tile_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        if (tile_index >= m_tile_bins.size())
+            return;
+
+        auto const& bin = m_tile_bins[tile_index];
+        if (bin.is_empty())
+            continue;
+
+        Gfx::IntRect const tile_rect {
+            static_cast<int>(tile_index % m_tile_columns) * RASTERIZER_TILE_SIZE,
+            static_cast<int>(tile_index / m_tile_columns) * RASTERIZER_TILE_SIZE,
+            RASTERIZER_TILE_SIZE,
+            RASTERIZER_TILE_SIZE,
+        };
+        for (auto triangle_index : bin)
+            rasterize_triangle(m_processed_triangles[triangle_index], tile_rect, shader_processor);
+    }
 }
 
-ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
+ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad, ShaderProcessor& shader_processor)
 {
     if (m_current_fragment_shader) {
-        m_shader_processor.execute(quad, *m_current_fragment_shader);
+        shader_processor.execute(quad, *m_current_fragment_shader);
         return;
     }
 
@@ -1372,7 +1479,7 @@ void Device::clear_color(FloatVector4 const& color)
     if (m_options.scissor_enabled)
         clear_rect.intersect(m_options.scissor_box);
 
-    m_frame_buffer->color_buffer()->fill(fill_color, clear_rect);
+    m_frame_buffer->color_buffer().fill(fill_color, clear_rect);
 }
 
 void Device::clear_depth(GPU::DepthType depth)
@@ -1381,7 +1488,7 @@ void Device::clear_depth(GPU::DepthType depth)
     if (m_options.scissor_enabled)
         clear_rect.intersect(m_options.scissor_box);
 
-    m_frame_buffer->depth_buffer()->fill(depth, clear_rect);
+    m_frame_buffer->depth_buffer().fill(depth, clear_rect);
 }
 
 void Device::clear_stencil(GPU::StencilType value)
@@ -1390,7 +1497,7 @@ void Device::clear_stencil(GPU::StencilType value)
     if (m_options.scissor_enabled)
         clear_rect.intersect(m_options.scissor_box);
 
-    m_frame_buffer->stencil_buffer()->fill(value, clear_rect);
+    m_frame_buffer->stencil_buffer().fill(value, clear_rect);
 }
 
 GPU::ImageDataLayout Device::color_buffer_data_layout(Vector2<u32> size, Vector2<i32> offset)
@@ -1444,7 +1551,7 @@ GPU::ImageDataLayout Device::depth_buffer_data_layout(Vector2<u32> size, Vector2
 
 void Device::blit_from_color_buffer(Gfx::Bitmap& target)
 {
-    m_frame_buffer->color_buffer()->blit_flipped_to_bitmap(target, m_frame_buffer->rect());
+    m_frame_buffer->color_buffer().blit_flipped_to_bitmap(target, m_frame_buffer->rect());
 
     if constexpr (ENABLE_STATISTICS_OVERLAY)
         draw_statistics_overlay(target);
@@ -1453,7 +1560,7 @@ void Device::blit_from_color_buffer(Gfx::Bitmap& target)
 void Device::blit_from_color_buffer(NonnullRefPtr<GPU::Image> image, u32 level, Vector2<u32> input_size, Vector2<i32> input_offset, Vector3<i32> output_offset)
 {
     auto input_layout = color_buffer_data_layout(input_size, input_offset);
-    auto const* input_data = m_frame_buffer->color_buffer()->scanline(0);
+    auto const* input_data = m_frame_buffer->color_buffer().scanline(0);
 
     auto const& softgpu_image = reinterpret_cast<Image*>(image.ptr());
     auto output_layout = softgpu_image->image_data_layout(level, output_offset);
@@ -1471,7 +1578,7 @@ void Device::blit_from_color_buffer(void* output_data, Vector2<i32> input_offset
     auto input_layout = color_buffer_data_layout({ output_selection.width, output_selection.height }, input_offset);
 
     PixelConverter converter { input_layout, output_layout };
-    auto const* input_data = m_frame_buffer->color_buffer()->scanline(0);
+    auto const* input_data = m_frame_buffer->color_buffer().scanline(0);
     auto conversion_result = converter.convert(input_data, output_data, {});
     if (conversion_result.is_error())
         dbgln("Pixel conversion failed: {}", conversion_result.error().string_literal());
@@ -1483,7 +1590,7 @@ void Device::blit_from_depth_buffer(void* output_data, Vector2<i32> input_offset
     auto input_layout = depth_buffer_data_layout({ output_selection.width, output_selection.height }, input_offset);
 
     PixelConverter converter { input_layout, output_layout };
-    auto const* input_data = m_frame_buffer->depth_buffer()->scanline(0);
+    auto const* input_data = m_frame_buffer->depth_buffer().scanline(0);
     auto conversion_result = converter.convert(input_data, output_data, {});
     if (conversion_result.is_error())
         dbgln("Pixel conversion failed: {}", conversion_result.error().string_literal());
@@ -1492,7 +1599,7 @@ void Device::blit_from_depth_buffer(void* output_data, Vector2<i32> input_offset
 void Device::blit_from_depth_buffer(NonnullRefPtr<GPU::Image> image, u32 level, Vector2<u32> input_size, Vector2<i32> input_offset, Vector3<i32> output_offset)
 {
     auto input_layout = depth_buffer_data_layout(input_size, input_offset);
-    auto const* input_data = m_frame_buffer->depth_buffer()->scanline(0);
+    auto const* input_data = m_frame_buffer->depth_buffer().scanline(0);
 
     auto const& softgpu_image = reinterpret_cast<Image*>(image.ptr());
     auto output_layout = softgpu_image->image_data_layout(level, output_offset);
@@ -1519,7 +1626,7 @@ void Device::blit_to_color_buffer_at_raster_position(void const* input_data, GPU
         { rasterization_rect.x(), rasterization_rect.y() });
 
     PixelConverter converter { input_layout, output_layout };
-    auto* output_data = m_frame_buffer->color_buffer()->scanline(0);
+    auto* output_data = m_frame_buffer->color_buffer().scanline(0);
     auto conversion_result = converter.convert(input_data, output_data, {});
     if (conversion_result.is_error())
         dbgln("Pixel conversion failed: {}", conversion_result.error().string_literal());
@@ -1537,7 +1644,7 @@ void Device::blit_to_depth_buffer_at_raster_position(void const* input_data, GPU
         { rasterization_rect.x(), rasterization_rect.y() });
 
     PixelConverter converter { input_layout, output_layout };
-    auto* output_data = m_frame_buffer->depth_buffer()->scanline(0);
+    auto* output_data = m_frame_buffer->depth_buffer().scanline(0);
     auto conversion_result = converter.convert(input_data, output_data, {});
     if (conversion_result.is_error())
         dbgln("Pixel conversion failed: {}", conversion_result.error().string_literal());
@@ -1561,20 +1668,26 @@ void Device::draw_statistics_overlay(Gfx::Bitmap& target)
     if (milliseconds > MILLISECONDS_PER_STATISTICS_PERIOD) {
 
         int num_rendertarget_pixels = m_frame_buffer->rect().size().area();
+        i64 num_rasterized_triangles = g_num_rasterized_triangles;
+        i64 num_pixels = g_num_pixels;
+        i64 num_pixels_shaded = g_num_pixels_shaded;
+        i64 num_pixels_blended = g_num_pixels_blended;
+        i64 num_stencil_writes = g_num_stencil_writes;
+        i64 num_quads = g_num_quads;
 
         StringBuilder builder;
         builder.appendff("Timings      : {:.1}ms {:.1}FPS\n",
             static_cast<double>(milliseconds) / frame_counter,
             (milliseconds > 0) ? 1000.0 * frame_counter / milliseconds : 9999.0);
-        builder.appendff("Triangles    : {}\n", g_num_rasterized_triangles);
-        builder.appendff("SIMD usage   : {}%\n", g_num_quads > 0 ? g_num_pixels_shaded * 25 / g_num_quads : 0);
+        builder.appendff("Triangles    : {}\n", num_rasterized_triangles);
+        builder.appendff("SIMD usage   : {}%\n", num_quads > 0 ? num_pixels_shaded * 25 / num_quads : 0);
         builder.appendff("Pixels       : {}, Stencil: {}%, Shaded: {}%, Blended: {}%, Overdraw: {}%\n",
-            g_num_pixels,
-            g_num_pixels > 0 ? g_num_stencil_writes * 100 / g_num_pixels : 0,
-            g_num_pixels > 0 ? g_num_pixels_shaded * 100 / g_num_pixels : 0,
-            g_num_pixels_shaded > 0 ? g_num_pixels_blended * 100 / g_num_pixels_shaded : 0,
-            num_rendertarget_pixels > 0 ? g_num_pixels_shaded * 100 / num_rendertarget_pixels - 100 : 0);
-        builder.appendff("Sampler calls: {}\n", g_num_sampler_calls);
+            num_pixels,
+            num_pixels > 0 ? num_stencil_writes * 100 / num_pixels : 0,
+            num_pixels > 0 ? num_pixels_shaded * 100 / num_pixels : 0,
+            num_pixels_shaded > 0 ? num_pixels_blended * 100 / num_pixels_shaded : 0,
+            num_rendertarget_pixels > 0 ? num_pixels_shaded * 100 / num_rendertarget_pixels - 100 : 0);
+        builder.appendff("Sampler calls: {}\n", g_num_sampler_calls.load());
 
         debug_string = builder.to_string().release_value_but_fixme_should_propagate_errors();
 
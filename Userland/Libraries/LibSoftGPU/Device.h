@@ -8,7 +8,11 @@
 #pragma once
 
 #include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibGPU/Device.h>
@@ -38,6 +42,7 @@
 #include <LibSoftGPU/Shader.h>
 #include <LibSoftGPU/ShaderProcessor.h>
 #include <LibSoftGPU/Triangle.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace SoftGPU {
 
@@ -93,7 +98,7 @@ private:
     GPU::ImageDataLayout depth_buffer_data_layout(Vector2<u32> size, Vector2<i32> offset);
 
     template<typename CB1, typename CB2, typename CB3>
-    void rasterize(Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes);
+    void rasterize(Gfx::IntRect& render_bounds, ShaderProcessor&, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes);
 
     void rasterize_line_aliased(GPU::Vertex&, GPU::Vertex&);
     void rasterize_line_antialiased(GPU::Vertex&, GPU::Vertex&);
@@ -103,8 +108,11 @@ private:
     void rasterize_point_antialiased(GPU::Vertex&);
     void rasterize_point(GPU::Vertex&);
 
-    void rasterize_triangle(Triangle&);
-    void shade_fragments(PixelQuad&);
+    Optional<Gfx::IntRect> setup_triangle(Triangle&) const;
+    void rasterize_triangle(Triangle const&, Gfx::IntRect const& clip_rect, ShaderProcessor&);
+    void rasterize_triangles_binned();
+    void rasterize_tiles(ShaderProcessor&);
+    void shade_fragments(PixelQuad&, ShaderProcessor&);
 
     RefPtr<FrameBuffer<GPU::ColorType, GPU::DepthType, GPU::StencilType>> m_frame_buffer {};
     GPU::RasterizerOptions m_options;
@@ -127,6 +135,14 @@ private:
     Array<GPU::TextureUnitConfiguration, GPU::NUM_TEXTURE_UNITS> m_texture_unit_configuration;
     RefPtr<Shader> m_current_fragment_shader;
     ShaderProcessor m_shader_processor;
+
+    // Binning rasterizer state; see rasterize_triangles_binned()
+    size_t m_rasterizer_thread_count { 1 };
+    int m_tile_columns { 0 };
+    Vector<Vector<u32>> m_tile_bins;
+    Atomic<size_t> m_next_tile_index { 0 };
+    Vector<NonnullOwnPtr<ShaderProcessor>> m_worker_shader_processors;
+    OwnPtr<Threading::ThreadPool<size_t>> m_rasterizer_thread_pool;
 };
 
 }
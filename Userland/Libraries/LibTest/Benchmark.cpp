@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
+#include <LibCore/File.h>
+#include <LibTest/Benchmark.h>
+#include <math.h>
+
+namespace Test {
+
+BenchmarkStatistics BenchmarkStatistics::from_samples(Vector<double> samples, u64 iterations_per_sample)
+{
+    BenchmarkStatistics statistics;
+    statistics.sample_count = samples.size();
+    statistics.iterations_per_sample = iterations_per_sample;
+    if (samples.is_empty())
+        return statistics;
+
+    quick_sort(samples);
+
+    auto count = samples.size();
+    statistics.min = samples.first();
+    if (count % 2 == 0)
+        statistics.median = (samples[count / 2 - 1] + samples[count / 2]) / 2;
+    else
+        statistics.median = samples[count / 2];
+
+    // Nearest-rank percentile, so the p95 of a handful of samples is their maximum.
+    auto p95_rank = static_cast<size_t>(ceil(0.95 * count));
+    statistics.p95 = samples[max<size_t>(p95_rank, 1) - 1];
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+    statistics.mean = sum / count;
+
+    if (count > 1) {
+        double sum_of_squared_deviations = 0;
+        for (auto sample : samples)
+            sum_of_squared_deviations += (sample - statistics.mean) * (sample - statistics.mean);
+        statistics.standard_deviation = sqrt(sum_of_squared_deviations / (count - 1));
+    }
+
+    return statistics;
+}
+
+BenchmarkComparison compare_benchmark_statistics(BenchmarkStatistics const& baseline, BenchmarkStatistics const& current, double threshold_in_percent)
+{
+    BenchmarkComparison comparison;
+    if (baseline.median <= 0)
+        return comparison;
+
+    auto difference = current.median - baseline.median;
+    comparison.change_in_percent = difference / baseline.median * 100;
+    comparison.is_regression = comparison.change_in_percent > threshold_in_percent
+        && difference > baseline.standard_deviation + current.standard_deviation;
+    return comparison;
+}
+
+ErrorOr<BenchmarkResults> load_benchmark_results(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(contents));
+    if (!json.is_object())
+        return Error::from_string_literal("Benchmark results must be a JSON object");
+
+    auto benchmarks = json.as_object().get_array("benchmarks"sv);
+    if (!benchmarks.has_value())
+        return Error::from_string_literal("Benchmark results are missing the benchmarks array");
+
+    BenchmarkResults results;
+    for (auto const& value : benchmarks->values()) {
+        if (!value.is_object())
+            continue;
+        auto const& benchmark = value.as_object();
+        auto name = benchmark.get_byte_string("name"sv);
+        if (!name.has_value())
+            continue;
+
+        BenchmarkStatistics statistics;
+        statistics.sample_count = benchmark.get_u64("samples"sv).value_or(0);
+        statistics.iterations_per_sample = benchmark.get_u64("iterations_per_sample"sv).value_or(0);
+        statistics.min = benchmark.get_double_with_precision_loss("min_ns"sv).value_or(0);
+        statistics.median = benchmark.get_double_with_precision_loss("median_ns"sv).value_or(0);
+        statistics.p95 = benchmark.get_double_with_precision_loss("p95_ns"sv).value_or(0);
+        statistics.mean = benchmark.get_double_with_precision_loss("mean_ns"sv).value_or(0);
+        statistics.standard_deviation = benchmark.get_double_with_precision_loss("stddev_ns"sv).value_or(0);
+        TRY(results.try_set(name.release_value(), statistics));
+    }
+    return results;
+}
+
+ErrorOr<void> save_benchmark_results(StringView path, StringView suite_name, Vector<ByteString> const& names, BenchmarkResults const& results)
+{
+    JsonArray benchmarks;
+    for (auto const& name : names) {
+        auto statistics = results.get(name);
+        if (!statistics.has_value())
+            continue;
+
+        JsonObject benchmark;
+        benchmark.set("name", name);
+        benchmark.set("samples", static_cast<u64>(statistics->sample_count));
+        benchmark.set("iterations_per_sample", statistics->iterations_per_sample);
+        benchmark.set("min_ns", statistics->min);
+        benchmark.set("median_ns", statistics->median);
+        benchmark.set("p95_ns", statistics->p95);
+        benchmark.set("mean_ns", statistics->mean);
+        benchmark.set("stddev_ns", statistics->standard_deviation);
+        TRY(benchmarks.append(move(benchmark)));
+    }
+
+    JsonObject json;
+    json.set("suite", suite_name);
+    json.set("benchmarks", move(benchmarks));
+
+    auto serialized = json.to_byte_string();
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_until_depleted(serialized.bytes()));
+    return {};
+}
+
+ByteString format_benchmark_time(double nanoseconds)
+{
+    if (nanoseconds < 1'000)
+        return ByteString::formatted("{:.1f}ns", nanoseconds);
+    if (nanoseconds < 1'000'000)
+        return ByteString::formatted("{:.2f}us", nanoseconds / 1'000);
+    if (nanoseconds < 1'000'000'000)
+        return ByteString::formatted("{:.2f}ms", nanoseconds / 1'000'000);
+    return ByteString::formatted("{:.2f}s", nanoseconds / 1'000'000'000);
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/Vector.h>
+
+namespace Test {
+
+// Keeps the compiler from optimizing away the computation of a value that a benchmark never uses.
+template<typename T>
+ALWAYS_INLINE void do_not_optimize(T const& value)
+{
+    asm volatile(""
+                 :
+                 : "m"(value)
+                 : "memory");
+}
+
+// Forces the compiler to assume that all memory has been read and written, so that stores
+// in the benchmark aren't elided.
+ALWAYS_INLINE void clobber_memory()
+{
+    asm volatile("" ::
+                     : "memory");
+}
+
+struct BenchmarkStatistics {
+    // All times are per iteration, in nanoseconds.
+    static BenchmarkStatistics from_samples(Vector<double> samples, u64 iterations_per_sample);
+
+    size_t sample_count { 0 };
+    u64 iterations_per_sample { 0 };
+    double min { 0 };
+    double median { 0 };
+    double p95 { 0 };
+    double mean { 0 };
+    double standard_deviation { 0 };
+};
+
+struct BenchmarkComparison {
+    // Positive when the benchmark got slower.
+    double change_in_percent { 0 };
+    bool is_regression { false };
+};
+
+// Compares medians. A benchmark only regresses if it's slower by more than the threshold, and
+// by more than the noise we measured in both runs.
+BenchmarkComparison compare_benchmark_statistics(BenchmarkStatistics const& baseline, BenchmarkStatistics const& current, double threshold_in_percent);
+
+using BenchmarkResults = HashMap<ByteString, BenchmarkStatistics>;
+
+ErrorOr<BenchmarkResults> load_benchmark_results(StringView path);
+ErrorOr<void> save_benchmark_results(StringView path, StringView suite_name, Vector<ByteString> const& names, BenchmarkResults const&);
+
+ByteString format_benchmark_time(double nanoseconds);
+
+}
@@ -156,6 +156,22 @@ void set_suite_setup_function(Function<void()> setup);
     static struct __BENCHMARK_TYPE(x) __BENCHMARK_TYPE(x);                                           \
     static void __BENCHMARK_FUNC(x)()
 
+// Registers one benchmark per given size, named "x/size". The body sees the size as `size`.
+#define BENCHMARK_CASE_WITH_SIZES(x, ...)                                                                                    \
+    static void __BENCHMARK_FUNC(x)(size_t size);                                                                            \
+    struct __BENCHMARK_TYPE(x) {                                                                                             \
+        __BENCHMARK_TYPE(x)                                                                                                  \
+        ()                                                                                                                   \
+        {                                                                                                                    \
+            for (size_t size : { __VA_ARGS__ }) {                                                                            \
+                auto name = ByteString::formatted("{}/{}", #x, size);                                                        \
+                add_test_case_to_suite(adopt_ref(*new ::Test::TestCase(name, [size] { __BENCHMARK_FUNC(x)(size); }, true))); \
+            }                                                                                                                \
+        }                                                                                                                    \
+    };                                                                                                                       \
+    static struct __BENCHMARK_TYPE(x) __BENCHMARK_TYPE(x);                                                                   \
+    static void __BENCHMARK_FUNC(x)(size_t size)
+
 // Randomized test
 
 #define __RANDOMIZED_TEST_FUNC(x) __randomized_test_##x
@@ -6,12 +6,14 @@
  */
 
 #include <AK/Function.h>
+#include <AK/LexicalPath.h>
+#include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
 #include <LibTest/Macros.h>
 #include <LibTest/TestResult.h>
 #include <LibTest/TestSuite.h>
-#include <math.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 
 namespace Test {
@@ -127,15 +129,41 @@ int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
     bool do_benchmarks_only = false;
     bool do_list_cases = false;
     StringView search_string = "*"sv;
+    ByteString benchmark_baseline_path;
+
+    if (auto const* repetitions = getenv("BENCHMARK_REPETITIONS"))
+        m_benchmark_repetitions = StringView { repetitions, strlen(repetitions) }.to_number<u64>().value_or(m_benchmark_repetitions);
+    if (auto const* min_sample_time = getenv("BENCHMARK_MIN_SAMPLE_TIME"))
+        m_benchmark_min_sample_time_ms = StringView { min_sample_time, strlen(min_sample_time) }.to_number<u64>().value_or(m_benchmark_min_sample_time_ms);
 
     args_parser.add_option(do_tests_only, "Only run tests.", "tests");
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench");
-    args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(m_benchmark_repetitions, "Number of samples to take of each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(m_benchmark_warmup_runs, "Number of times to run each benchmark before taking samples (default 0)", "benchmark_warmup", 0, "N");
+    args_parser.add_option(m_benchmark_min_sample_time_ms, "Repeat each benchmark within a sample until the sample takes at least this long (default 0)", "benchmark_min_sample_time", 0, "MS");
+    args_parser.add_option(m_benchmark_results_path, "Write the benchmark results as JSON to this file", "benchmark_json", 0, "FILE");
+    args_parser.add_option(benchmark_baseline_path, "Fail benchmarks that regressed compared to the results in this file", "benchmark_baseline", 0, "FILE");
+    args_parser.add_option(m_benchmark_regression_threshold, "How much slower than the baseline a benchmark may get, in percent (default 10)", "benchmark_regression_threshold", 0, "PERCENT");
     args_parser.add_option(m_randomized_runs, "Number of times to run each RANDOMIZED_TEST_CASE (default 100)", "randomized_runs", 0, "RUNS");
     args_parser.add_option(do_list_cases, "List available test cases.", "list");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    // run-tests sets these to collect or compare the benchmark results of all test suites at once.
+    auto results_file_name = ByteString::formatted("{}.json", LexicalPath::basename(suite_name));
+    if (auto const* directory = getenv("BENCHMARK_RESULTS_DIR"); directory && m_benchmark_results_path.is_empty())
+        m_benchmark_results_path = LexicalPath::join({ directory, strlen(directory) }, results_file_name).string();
+    if (auto const* directory = getenv("BENCHMARK_BASELINE_DIR"); directory && benchmark_baseline_path.is_empty())
+        benchmark_baseline_path = LexicalPath::join({ directory, strlen(directory) }, results_file_name).string();
+
+    if (!benchmark_baseline_path.is_empty()) {
+        auto baseline_or_error = load_benchmark_results(benchmark_baseline_path);
+        if (baseline_or_error.is_error())
+            warnln("Could not load benchmark baseline {}: {}", benchmark_baseline_path, baseline_or_error.error());
+        else
+            m_benchmark_baseline = baseline_or_error.release_value();
+    }
+
     if (m_setup)
         m_setup();
 
@@ -186,40 +214,23 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
 
     for (auto const& t : tests) {
         auto const test_type = t->is_benchmark() ? "benchmark" : "test";
-        auto const repetitions = t->is_benchmark() ? m_benchmark_repetitions : 1;
 
         warnln("Running {} '{}'.", test_type, t->name());
         m_current_test_result = TestResult::NotRun;
         enable_reporting();
 
         u64 total_time = 0;
-        u64 sum_of_squared_times = 0;
-        u64 min_time = NumericLimits<u64>::max();
-        u64 max_time = 0;
-
-        for (u64 i = 0; i < repetitions; ++i) {
+        if (t->is_benchmark()) {
+            total_time = run_benchmark(*t);
+        } else {
             TestElapsedTimer timer;
             t->func()();
-            auto const iteration_time = timer.elapsed_milliseconds();
-            total_time += iteration_time;
-            sum_of_squared_times += iteration_time * iteration_time;
-            min_time = min(min_time, iteration_time);
-            max_time = max(max_time, iteration_time);
+            total_time = timer.elapsed_milliseconds();
 
             // Non-randomized tests don't touch the test result when passing.
             if (m_current_test_result == TestResult::NotRun)
                 m_current_test_result = TestResult::Passed;
-        }
-
-        if (repetitions != 1) {
-            double average = total_time / double(repetitions);
-            double average_squared = average * average;
-            double standard_deviation = sqrt((sum_of_squared_times + repetitions * average_squared - 2 * total_time * average) / (repetitions - 1));
 
-            dbgln("{} {} '{}' on average in {:.1f}±{:.1f}ms (min={}ms, max={}ms, total={}ms)",
-                test_result_to_string(m_current_test_result), test_type, t->name(),
-                average, standard_deviation, min_time, max_time, total_time);
-        } else {
             dbgln("{} {} '{}' in {}ms", test_result_to_string(m_current_test_result), test_type, t->name(), total_time);
         }
 
@@ -282,9 +293,93 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
         }
     }
 
+    if (!m_benchmark_results_path.is_empty() && !m_benchmark_names.is_empty()) {
+        if (auto result = save_benchmark_results(m_benchmark_results_path, m_suite_name, m_benchmark_names, m_benchmark_results); result.is_error())
+            warnln("Could not write benchmark results to {}: {}", m_benchmark_results_path, result.error());
+    }
+
     // We have multiple TestResults, all except for Passed being "bad".
     // Let's get a count of them:
     return (int)(test_count - test_passed_count + benchmark_count - benchmark_passed_count);
 }
 
+void TestSuite::run_benchmark_iterations(TestCase const& test_case, u64 iterations)
+{
+    for (u64 i = 0; i < iterations && m_current_test_result != TestResult::Failed; ++i) {
+        test_case.func()();
+
+        // Non-randomized tests don't touch the test result when passing.
+        if (m_current_test_result == TestResult::NotRun)
+            m_current_test_result = TestResult::Passed;
+    }
+}
+
+u64 TestSuite::run_benchmark(TestCase const& test_case)
+{
+    TestElapsedTimer timer;
+
+    for (u64 i = 0; i < m_benchmark_warmup_runs; ++i)
+        run_benchmark_iterations(test_case, 1);
+
+    // Fast benchmarks are repeated within each sample, so that the samples aren't dominated by
+    // timer resolution. The calibration runs double as additional warmup.
+    u64 iterations = 1;
+    auto const min_sample_time = Duration::from_milliseconds(m_benchmark_min_sample_time_ms);
+    while (min_sample_time > Duration::zero() && m_current_test_result != TestResult::Failed) {
+        auto start = MonotonicTime::now();
+        run_benchmark_iterations(test_case, iterations);
+        auto elapsed = MonotonicTime::now() - start;
+        if (elapsed >= min_sample_time)
+            break;
+
+        // Aim a bit past the minimum, but don't trust a single short run too much.
+        auto elapsed_ns = max<i64>(elapsed.to_nanoseconds(), 1);
+        auto estimate = static_cast<u64>(iterations * 1.2 * min_sample_time.to_nanoseconds() / elapsed_ns);
+        iterations = clamp(estimate, iterations * 2, iterations * 10);
+    }
+
+    Vector<double> samples;
+    auto const sample_count = max<u64>(m_benchmark_repetitions, 1);
+    for (u64 i = 0; i < sample_count && m_current_test_result != TestResult::Failed; ++i) {
+        auto start = MonotonicTime::now();
+        run_benchmark_iterations(test_case, iterations);
+        auto elapsed = MonotonicTime::now() - start;
+        samples.append(static_cast<double>(elapsed.to_nanoseconds()) / iterations);
+    }
+
+    auto const& name = test_case.name();
+    if (m_current_test_result != TestResult::Passed) {
+        dbgln("{} benchmark '{}'", test_result_to_string(m_current_test_result), name);
+        return timer.elapsed_milliseconds();
+    }
+
+    auto statistics = BenchmarkStatistics::from_samples(move(samples), iterations);
+    if (statistics.sample_count == 1 && iterations == 1) {
+        dbgln("{} benchmark '{}' in {}", test_result_to_string(m_current_test_result), name, format_benchmark_time(statistics.median));
+    } else {
+        dbgln("{} benchmark '{}' in {} (median of {} samples of {} iterations, p95={}, mean={}±{}, min={})",
+            test_result_to_string(m_current_test_result), name, format_benchmark_time(statistics.median),
+            statistics.sample_count, iterations, format_benchmark_time(statistics.p95), format_benchmark_time(statistics.mean),
+            format_benchmark_time(statistics.standard_deviation), format_benchmark_time(statistics.min));
+    }
+
+    if (m_benchmark_baseline.has_value()) {
+        if (auto baseline = m_benchmark_baseline->get(name); baseline.has_value()) {
+            auto comparison = compare_benchmark_statistics(*baseline, statistics, m_benchmark_regression_threshold);
+            if (comparison.is_regression) {
+                warnln("\033[31;1mREGRESSION\033[0m: Benchmark '{}' got {:.1f}% slower ({} -> {})",
+                    name, comparison.change_in_percent, format_benchmark_time(baseline->median), format_benchmark_time(statistics.median));
+                m_current_test_result = TestResult::Failed;
+            } else {
+                dbgln("Benchmark '{}' changed by {:.1f}% compared to the baseline ({} -> {})",
+                    name, comparison.change_in_percent, format_benchmark_time(baseline->median), format_benchmark_time(statistics.median));
+            }
+        }
+    }
+
+    m_benchmark_names.append(name);
+    m_benchmark_results.set(name, statistics);
+    return timer.elapsed_milliseconds();
+}
+
 } // namespace Test
@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/Function.h>
 #include <AK/Vector.h>
+#include <LibTest/Benchmark.h>
 #include <LibTest/Macros.h>
 #include <LibTest/Randomized/RandomnessSource.h>
 #include <LibTest/TestCase.h>
@@ -63,12 +64,23 @@ public:
     u64 randomized_runs() { return m_randomized_runs; }
 
 private:
+    // Returns how long the benchmark ran for, in milliseconds.
+    u64 run_benchmark(TestCase const&);
+    void run_benchmark_iterations(TestCase const&, u64 iterations);
+
     static TestSuite* s_global;
     Vector<NonnullRefPtr<TestCase>> m_cases;
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     ByteString m_suite_name;
     u64 m_benchmark_repetitions = 1;
+    u64 m_benchmark_warmup_runs = 0;
+    u64 m_benchmark_min_sample_time_ms = 0;
+    double m_benchmark_regression_threshold = 10;
+    ByteString m_benchmark_results_path;
+    Optional<BenchmarkResults> m_benchmark_baseline;
+    BenchmarkResults m_benchmark_results;
+    Vector<ByteString> m_benchmark_names;
     u64 m_randomized_runs = 100;
     Function<void()> m_setup;
     TestResult m_current_test_result = TestResult::NotRun;
@@ -22,9 +22,12 @@ struct ThreadPoolLooper {
     {
         Optional<typename Pool::Work> entry;
         while (true) {
+            // NOTE: The busy count is bumped while the queue is still locked, so that wait_for_all()
+            //       never observes an empty queue with the dequeued work not yet accounted for.
             entry = pool.m_work_queue.with_locked([&](auto& queue) -> Optional<typename Pool::Work> {
                 if (queue.is_empty())
                     return {};
+                pool.m_busy_count++;
                 return queue.dequeue();
             });
             if (entry.has_value())
@@ -36,12 +39,17 @@ struct ThreadPoolLooper {
                 return IterationDecision::Continue;
 
             pool.m_mutex.lock();
-            pool.m_work_available.wait();
+            if (pool.is_queue_empty() && !pool.m_should_exit)
+                pool.m_work_available.wait();
             pool.m_mutex.unlock();
         }
 
-        pool.m_busy_count++;
         pool.m_handler(entry.release_value());
+
+        pool.m_mutex.lock();
+        pool.m_busy_count--;
+        pool.m_work_done.broadcast();
+        pool.m_mutex.unlock();
         return IterationDecision::Continue;
     }
 };
@@ -86,6 +94,7 @@ public:
     void request_exit()
     {
         m_should_exit.store(true, AK::MemoryOrder::memory_order_release);
+        MutexLocker locker(m_mutex);
         m_work_available.broadcast();
     }
 
@@ -99,27 +108,25 @@ public:
         m_work_queue.with_locked([&](auto& queue) {
             queue.enqueue({ move(work) });
         });
+        MutexLocker locker(m_mutex);
         m_work_available.broadcast();
     }
 
     void wait_for_all()
     {
-        while (true) {
-            if (m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); }))
-                break;
-            m_mutex.lock();
-            m_work_done.wait();
-            m_mutex.unlock();
-        }
-
-        while (m_busy_count.load(AK::MemoryOrder::memory_order_acquire) > 0) {
-            m_mutex.lock();
+        // NOTE: Workers only signal m_work_done while holding m_mutex, so checking the condition
+        //       under the same lock guarantees that we can't miss the final wakeup.
+        MutexLocker locker(m_mutex);
+        while (!is_queue_empty() || m_busy_count.load(AK::MemoryOrder::memory_order_acquire) > 0)
             m_work_done.wait();
-            m_mutex.unlock();
-        }
     }
 
 private:
+    bool is_queue_empty()
+    {
+        return m_work_queue.with_locked([](auto& queue) { return queue.is_empty(); });
+    }
+
     template<typename... Args>
     void initialize_workers(size_t concurrency, Args&&... looper_args)
     {
@@ -128,8 +135,6 @@ private:
                 Looper<ThreadPool> thread_looper { move(looper_args)... };
                 for (; !m_should_exit;) {
                     auto result = thread_looper.next(*this, true);
-                    m_busy_count--;
-                    m_work_done.signal();
                     if (result == IterationDecision::Break)
                         break;
                 }
@@ -27,22 +27,7 @@ CommandExecutorCPU::CommandExecutorCPU(Gfx::Bitmap& bitmap, bool enable_affine_c
 
 CommandResult CommandExecutorCPU::draw_glyph_run(DrawGlyphRun const& command)
 {
-    auto& painter = this->painter();
-    auto const& glyphs = command.glyph_run->glyphs();
-    for (auto& glyph_or_emoji : glyphs) {
-        auto transformed_glyph = glyph_or_emoji;
-        transformed_glyph.visit([&](auto& glyph) {
-            glyph.position = glyph.position.scaled(command.scale).translated(command.translation);
-            glyph.font = glyph.font->with_size(glyph.font->point_size() * static_cast<float>(command.scale));
-        });
-        if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
-            auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
-            painter.draw_glyph(glyph.position, glyph.code_point, *glyph.font, command.color);
-        } else {
-            auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
-            painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *emoji.font);
-        }
-    }
+    painter().draw_glyph_run(command.glyph_run->glyphs(), command.color, command.translation, static_cast<float>(command.scale));
     return CommandResult::Continue;
 }
 
@@ -148,6 +133,12 @@ CommandResult CommandExecutorCPU::push_stacking_context(PushStackingContext cons
     if (command.mask.has_value()) {
         // TODO: Support masks and other stacking context features at the same time.
         // Note: Currently only SVG masking is implemented (which does not use CSS transforms anyway).
+        auto destination_rect = command.source_paintable_rect.translated(command.post_transform_translation);
+        if (would_be_fully_clipped_by_painter(destination_rect)) {
+            // OPTIMIZATION: Nothing painted into the mask layer could end up inside the clip rect.
+            painter().restore();
+            return CommandResult::SkipStackingContext;
+        }
         auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, command.mask->mask_bitmap->size());
         if (bitmap_or_error.is_error())
             return CommandResult::Continue;
@@ -155,7 +146,7 @@ CommandResult CommandExecutorCPU::push_stacking_context(PushStackingContext cons
         stacking_contexts.append(StackingContext {
             .painter = AK::make<Gfx::Painter>(bitmap),
             .opacity = 1,
-            .destination = command.source_paintable_rect.translated(command.post_transform_translation),
+            .destination = destination_rect,
             .scaling_mode = Gfx::Painter::ScalingMode::None,
             .mask = command.mask });
         painter().translate(-command.source_paintable_rect.location());
@@ -178,6 +169,13 @@ CommandResult CommandExecutorCPU::push_stacking_context(PushStackingContext cons
     auto transformed_destination_rect = affine_transform.map(source_rect).translated(command.transform.origin);
     auto destination_rect = transformed_destination_rect.to_rounded<int>();
 
+    if (would_be_fully_clipped_by_painter(destination_rect)) {
+        // OPTIMIZATION: Everything inside this stacking context is composited through a layer that would be
+        //               clipped away entirely, so there is no point in allocating the layer or painting into it.
+        painter().restore();
+        return CommandResult::SkipStackingContext;
+    }
+
     // FIXME: We should find a way to scale the paintable, rather than paint into a separate bitmap,
     // then scale it. This snippet now copies the background at the destination, then scales it down/up
     // to the size of the source (which could add some artefacts, though just scaling the bitmap already does that).
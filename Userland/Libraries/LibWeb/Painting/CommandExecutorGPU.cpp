@@ -386,7 +386,8 @@ bool CommandExecutorGPU::would_be_fully_clipped_by_painter(Gfx::IntRect rect) co
 
 void CommandExecutorGPU::prepare_glyph_texture(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs)
 {
-    AccelGfx::GlyphAtlas::the().update(unique_glyphs);
+    if (auto result = AccelGfx::GlyphAtlas::the().update(unique_glyphs); result.is_error())
+        dbgln("Failed to update the glyph atlas: {}", result.error());
 }
 
 void CommandExecutorGPU::prepare_to_execute([[maybe_unused]] size_t corner_clip_max_depth)
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/AnimationDecoder.h>
+#include <LibGfx/Bitmap.h>
+
+namespace ImageDecoder {
+
+NonnullRefPtr<AnimationDecoder> AnimationDecoder::create(Core::AnonymousBuffer encoded_buffer, NonnullRefPtr<Gfx::ImageDecoder> decoder, Optional<Gfx::IntSize> ideal_size)
+{
+    return adopt_ref(*new AnimationDecoder(move(encoded_buffer), move(decoder), ideal_size));
+}
+
+AnimationDecoder::AnimationDecoder(Core::AnonymousBuffer encoded_buffer, NonnullRefPtr<Gfx::ImageDecoder> decoder, Optional<Gfx::IntSize> ideal_size)
+    : m_encoded_buffer(move(encoded_buffer))
+    , m_decoder(move(decoder))
+    , m_ideal_size(ideal_size)
+    , m_frame_count(m_decoder->frame_count())
+{
+}
+
+ErrorOr<AnimationDecoder::Frame> AnimationDecoder::decode_frame(u32 frame_index)
+{
+    if (frame_index >= m_frame_count)
+        return Error::from_string_literal("Invalid frame index");
+
+    auto frame = TRY(m_decoder->frame(frame_index, m_ideal_size));
+    auto bitmap = frame.image->to_shareable_bitmap();
+    if (!bitmap.is_valid())
+        return Error::from_string_literal("Could not share decoded frame");
+    return Frame { move(bitmap), static_cast<u32>(frame.duration) };
+}
+
+Optional<AnimationDecoder::Frame> AnimationDecoder::cached_frame(u32 frame_index)
+{
+    for (size_t i = 0; i < m_cached_frames.size(); ++i) {
+        if (m_cached_frames[i].frame_index != frame_index)
+            continue;
+        auto cached_frame = m_cached_frames.take(i);
+        auto frame = cached_frame.frame;
+        m_cached_frames.append(move(cached_frame));
+        return frame;
+    }
+    return {};
+}
+
+void AnimationDecoder::cache_frame(u32 frame_index, Frame frame)
+{
+    m_cached_frames.remove_first_matching([&](auto const& cached_frame) { return cached_frame.frame_index == frame_index; });
+    if (m_cached_frames.size() == max_cached_frames)
+        m_cached_frames.take_first();
+    m_cached_frames.append({ frame_index, move(frame) });
+}
+
+}
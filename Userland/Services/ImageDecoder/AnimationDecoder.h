@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibGfx/ShareableBitmap.h>
+#include <LibGfx/Size.h>
+
+namespace ImageDecoder {
+
+// Keeps the decoder of an animated image alive, so that the client can ask for its frames one at a time
+// instead of receiving all of them up front. Only a few recently used frames are kept around.
+//
+// decode_frame() runs on the background thread, while the frame cache is only used from the main thread.
+// Since the background thread never touches a cached bitmap, their reference counts are never raced on.
+class AnimationDecoder : public AtomicRefCounted<AnimationDecoder> {
+public:
+    struct Frame {
+        Gfx::ShareableBitmap bitmap;
+        u32 duration { 0 };
+    };
+
+    static NonnullRefPtr<AnimationDecoder> create(Core::AnonymousBuffer encoded_buffer, NonnullRefPtr<Gfx::ImageDecoder>, Optional<Gfx::IntSize> ideal_size);
+
+    size_t frame_count() const { return m_frame_count; }
+
+    ErrorOr<Frame> decode_frame(u32 frame_index);
+
+    Optional<Frame> cached_frame(u32 frame_index);
+    void cache_frame(u32 frame_index, Frame);
+
+private:
+    AnimationDecoder(Core::AnonymousBuffer encoded_buffer, NonnullRefPtr<Gfx::ImageDecoder>, Optional<Gfx::IntSize> ideal_size);
+
+    static constexpr size_t max_cached_frames = 8;
+
+    struct CachedFrame {
+        u32 frame_index { 0 };
+        Frame frame;
+    };
+
+    // The decoder reads straight from the encoded data, so it has to stay alive for as long as the decoder does.
+    Core::AnonymousBuffer m_encoded_buffer;
+    NonnullRefPtr<Gfx::ImageDecoder> m_decoder;
+    Optional<Gfx::IntSize> m_ideal_size;
+    size_t m_frame_count { 0 };
+
+    // Ordered from least to most recently used.
+    Vector<CachedFrame, max_cached_frames> m_cached_frames;
+};
+
+}
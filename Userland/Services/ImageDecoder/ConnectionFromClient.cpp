@@ -25,6 +25,12 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, job] : m_pending_frame_jobs) {
+        job->cancel();
+    }
+    m_pending_frame_jobs.clear();
+    m_animation_decoders.clear();
+
     Threading::quit_background_thread();
     Core::EventLoop::current().quit(0);
 }
@@ -33,6 +39,9 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
 {
     for (size_t i = 0; i < decoder.frame_count(); ++i) {
         auto frame_or_error = decoder.frame(i, ideal_size);
+        // The data may have been cut short, e.g. by an interrupted download. Still images show as much of it as there is.
+        if (frame_or_error.is_error() && decoder.frame_count() == 1)
+            frame_or_error = decoder.partial_frame(i);
         if (frame_or_error.is_error()) {
             bitmaps.append(Gfx::ShareableBitmap {});
             durations.append(0);
@@ -44,7 +53,7 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
     }
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type, bool decode_frames_on_demand)
 {
     auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
 
@@ -57,6 +66,7 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     if (auto maybe_metadata = decoder->metadata(); maybe_metadata.has_value() && is<Gfx::ExifMetadata>(*maybe_metadata)) {
         auto const& exif = static_cast<Gfx::ExifMetadata const&>(maybe_metadata.value());
@@ -70,6 +80,15 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
+    if (decode_frames_on_demand && decoder->frame_count() > 1) {
+        auto animation_decoder = AnimationDecoder::create(move(encoded_buffer), decoder.release_nonnull(), ideal_size);
+        auto first_frame = TRY(animation_decoder->decode_frame(0));
+        result.bitmaps.append(move(first_frame.bitmap));
+        result.durations.append(first_frame.duration);
+        result.animation_decoder = move(animation_decoder);
+        return result;
+    }
+
     decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), result.bitmaps, result.durations);
 
     if (result.bitmaps.is_empty())
@@ -78,14 +97,19 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+        // The action only runs once, so the encoded data can be handed off to the animation decoder.
+        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type), decode_frames_on_demand](auto&) mutable -> ErrorOr<DecodeResult> {
+            return TRY(decode_image_to_details(move(encoded_buffer), ideal_size, mime_type, decode_frames_on_demand));
         },
         [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.bitmaps, result.durations, result.scale);
+            if (result.animation_decoder) {
+                result.animation_decoder->cache_frame(0, { result.bitmaps.first(), result.durations.first() });
+                strong_this->m_animation_decoders.set(image_id, result.animation_decoder.release_nonnull());
+            }
+            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.frame_count, result.bitmaps, result.durations, result.scale);
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
@@ -96,7 +120,7 @@ NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image
         });
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool decode_frames_on_demand)
 {
     auto image_id = m_next_image_id++;
 
@@ -106,7 +130,7 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type));
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type, decode_frames_on_demand));
 
     return image_id;
 }
@@ -118,4 +142,47 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     }
 }
 
+NonnullRefPtr<ConnectionFromClient::FrameJob> ConnectionFromClient::make_decode_animation_frame_job(u64 job_id, i64 image_id, u32 frame_index, NonnullRefPtr<AnimationDecoder> animation_decoder)
+{
+    return FrameJob::construct(
+        [animation_decoder, frame_index](auto&) -> ErrorOr<AnimationDecoder::Frame> {
+            return animation_decoder->decode_frame(frame_index);
+        },
+        [strong_this = NonnullRefPtr(*this), job_id, image_id, frame_index, animation_decoder](AnimationDecoder::Frame frame) -> ErrorOr<void> {
+            animation_decoder->cache_frame(frame_index, frame);
+            strong_this->async_did_decode_animation_frame(image_id, frame_index, frame.bitmap, frame.duration);
+            strong_this->m_pending_frame_jobs.remove(job_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), job_id, image_id, frame_index](Error error) -> void {
+            if (strong_this->is_open())
+                strong_this->async_did_fail_to_decode_animation_frame(image_id, frame_index, MUST(String::formatted("Decoding failed: {}", error)));
+            strong_this->m_pending_frame_jobs.remove(job_id);
+        });
+}
+
+void ConnectionFromClient::request_animation_frame(i64 image_id, u32 frame_index)
+{
+    auto animation_decoder = m_animation_decoders.get(image_id);
+    if (!animation_decoder.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No frames to decode on demand for image {}", image_id);
+        async_did_fail_to_decode_animation_frame(image_id, frame_index, "No frames to decode on demand for this image"_string);
+        return;
+    }
+
+    if (auto frame = animation_decoder.value()->cached_frame(frame_index); frame.has_value()) {
+        async_did_decode_animation_frame(image_id, frame_index, frame->bitmap, frame->duration);
+        return;
+    }
+
+    auto job_id = m_next_frame_job_id++;
+    m_pending_frame_jobs.set(job_id, make_decode_animation_frame_job(job_id, image_id, frame_index, *animation_decoder.value()));
+}
+
+void ConnectionFromClient::release_image(i64 image_id)
+{
+    // Frame jobs that are still pending keep the decoder alive until they're done.
+    m_animation_decoders.remove(image_id);
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <ImageDecoder/AnimationDecoder.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
@@ -27,23 +28,35 @@ public:
     struct DecodeResult {
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
         Vector<Gfx::ShareableBitmap> bitmaps;
         Vector<u32> durations;
+
+        // Only set when the frames of an animated image are decoded on demand. bitmaps then only holds the first frame.
+        RefPtr<AnimationDecoder> animation_decoder;
     };
 
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using FrameJob = Threading::BackgroundAction<AnimationDecoder::Frame>;
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type, bool decode_frames_on_demand) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual void request_animation_frame(i64 image_id, u32 frame_index) override;
+    virtual void release_image(i64 image_id) override;
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand);
+    NonnullRefPtr<FrameJob> make_decode_animation_frame_job(u64 job_id, i64 image_id, u32 frame_index, NonnullRefPtr<AnimationDecoder>);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+
+    u64 m_next_frame_job_id { 0 };
+    HashMap<u64, NonnullRefPtr<FrameJob>> m_pending_frame_jobs;
+    HashMap<i64, NonnullRefPtr<AnimationDecoder>> m_animation_decoders;
 };
 
 }
@@ -38,6 +38,7 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
 void ConnectionFromClient::die()
 {
     s_connections.remove(client_id());
+    DatabaseConnection::disconnect_client(client_id());
 
     if (on_disconnect)
         on_disconnect();
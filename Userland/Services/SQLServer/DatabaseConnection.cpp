@@ -61,9 +61,44 @@ DatabaseConnection::DatabaseConnection(NonnullRefPtr<SQL::Database> database, By
 void DatabaseConnection::disconnect()
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::disconnect(connection_id {}, database '{}'", connection_id(), m_database_name);
+
+    // Nobody would be left to end the transaction, and the other connections couldn't modify the database anymore.
+    if (m_in_transaction) {
+        if (auto result = m_database->rollback_transaction(); result.is_error())
+            warnln("Could not roll back transaction of connection {}: {}", connection_id(), result.error().error_string());
+        m_in_transaction = false;
+    }
+
     s_connections.remove(connection_id());
 }
 
+void DatabaseConnection::disconnect_client(int client_id)
+{
+    Vector<NonnullRefPtr<DatabaseConnection>> connections;
+    for (auto const& connection : s_connections) {
+        if (connection.value->client_id() == client_id)
+            connections.append(connection.value);
+    }
+
+    for (auto& connection : connections)
+        connection->disconnect();
+}
+
+SQL::ResultOr<void> DatabaseConnection::ensure_statement_can_execute(SQL::AST::Statement const& statement) const
+{
+    // While one connection has a transaction open, the others may only read from the database. Their modifications
+    // would otherwise become part of that transaction, and be discarded if it is rolled back.
+    if (is<SQL::AST::Select>(statement) || is<SQL::AST::Explain>(statement) || is<SQL::AST::DescribeTable>(statement))
+        return {};
+
+    for (auto const& connection : s_connections) {
+        if (connection.value.ptr() != this && connection.value->m_in_transaction && connection.value->m_database.ptr() == m_database.ptr())
+            return SQL::Result { SQL::SQLCommand::Unknown, SQL::SQLErrorCode::DatabaseLocked };
+    }
+
+    return {};
+}
+
 SQL::ResultOr<SQL::StatementID> DatabaseConnection::prepare_statement(StringView sql)
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::prepare_statement(connection_id {}, database '{}', sql '{}'", connection_id(), m_database_name, sql);
@@ -8,6 +8,7 @@
 
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
+#include <LibSQL/AST/AST.h>
 #include <LibSQL/Database.h>
 #include <LibSQL/Result.h>
 #include <LibSQL/Type.h>
@@ -25,8 +26,15 @@ public:
     NonnullRefPtr<SQL::Database> database() { return m_database; }
     StringView database_name() const { return m_database_name; }
     void disconnect();
+    static void disconnect_client(int client_id);
     SQL::ResultOr<SQL::StatementID> prepare_statement(StringView sql);
 
+    // A transaction is begun and ended by the statements of a single connection, but its modifications go to the
+    // database that is shared by all connections to it.
+    bool in_transaction() const { return m_in_transaction; }
+    void set_in_transaction(bool in_transaction) { m_in_transaction = in_transaction; }
+    SQL::ResultOr<void> ensure_statement_can_execute(SQL::AST::Statement const&) const;
+
 private:
     DatabaseConnection(NonnullRefPtr<SQL::Database> database, ByteString database_name, int client_id);
 
@@ -34,6 +42,7 @@ private:
     ByteString m_database_name;
     SQL::ConnectionID m_connection_id { 0 };
     int m_client_id { 0 };
+    bool m_in_transaction { false };
 };
 
 }
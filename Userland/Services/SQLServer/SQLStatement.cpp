@@ -70,6 +70,23 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
     auto execution_id = m_next_execution_id++;
 
     Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
+        if (auto result = connection().ensure_statement_can_execute(*m_statement); result.is_error()) {
+            report_error(result.release_error(), execution_id);
+            return;
+        }
+
+        // The rows of a SELECT are produced as the client asks for them, instead of all being computed up front.
+        if (is<SQL::AST::Select>(*m_statement)) {
+            auto cursor = static_cast<SQL::AST::Select const&>(*m_statement).open_cursor(connection().database(), placeholder_values);
+            if (cursor.is_error()) {
+                report_error(cursor.release_error(), execution_id);
+                return;
+            }
+
+            start_sending_rows(execution_id, cursor.release_value());
+            return;
+        }
+
         auto execution_result = m_statement->execute(connection().database(), placeholder_values);
 
         if (execution_result.is_error()) {
@@ -86,11 +103,13 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
         auto result = execution_result.release_value();
         auto result_size = result.size();
 
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+        if (result.command() == SQL::SQLCommand::Begin)
+            connection().set_in_transaction(true);
+        else if (result.command() == SQL::SQLCommand::Commit || result.command() == SQL::SQLCommand::Rollback)
+            connection().set_in_transaction(false);
 
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
+        if (should_send_result_rows(result)) {
+            start_sending_rows(execution_id, make<SQL::ResultSetCursor>(move(result)));
         } else {
             if (result.command() == SQL::SQLCommand::Insert)
                 client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
@@ -106,6 +125,32 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
     return execution_id;
 }
 
+void SQLStatement::start_sending_rows(SQL::ExecutionID execution_id, NonnullOwnPtr<SQL::ResultCursor> cursor)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    // The first row is read up front to be able to tell the client whether there are any rows at all.
+    auto first_row = cursor->next();
+    if (first_row.is_error()) {
+        report_error(first_row.release_error(), execution_id);
+        return;
+    }
+
+    if (!first_row.value().has_value()) {
+        client_connection->async_execution_success(statement_id(), execution_id, cursor->column_names(), false, 0, 0, 0);
+        return;
+    }
+
+    client_connection->async_execution_success(statement_id(), execution_id, cursor->column_names(), true, 0, 0, 0);
+
+    m_ongoing_executions.set(execution_id, { move(cursor), first_row.release_value(), 0 });
+    ready_for_next_result(execution_id);
+}
+
 void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
 {
     auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
@@ -119,14 +164,29 @@ void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
         return;
     }
 
-    if (execution->result.is_empty()) {
+    // Rows are only read from the cursor once the client is ready for them, so a slow client doesn't cause the
+    // whole result to pile up in memory.
+    auto row = move(execution->next_row);
+    execution->next_row.clear();
+
+    if (!row.has_value()) {
+        auto next_row = execution->cursor->next();
+        if (next_row.is_error()) {
+            m_ongoing_executions.remove(execution_id);
+            report_error(next_row.release_error(), execution_id);
+            return;
+        }
+        row = next_row.release_value();
+    }
+
+    if (!row.has_value()) {
         client_connection->async_results_exhausted(statement_id(), execution_id, execution->result_size);
         m_ongoing_executions.remove(execution_id);
         return;
     }
 
-    auto result_row = execution->result.take_first();
-    client_connection->async_next_result(statement_id(), execution_id, result_row.row.take_data());
+    ++execution->result_size;
+    client_connection->async_next_result(statement_id(), execution_id, row->take_data());
 }
 
 bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
@@ -136,6 +196,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
     switch (result.command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
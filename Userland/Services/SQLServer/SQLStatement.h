@@ -11,6 +11,7 @@
 #include <AK/Vector.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/Result.h>
+#include <LibSQL/ResultCursor.h>
 #include <LibSQL/ResultSet.h>
 #include <LibSQL/Type.h>
 #include <SQLServer/DatabaseConnection.h>
@@ -32,13 +33,15 @@ private:
     SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
 
     bool should_send_result_rows(SQL::ResultSet const& result) const;
+    void start_sending_rows(SQL::ExecutionID, NonnullOwnPtr<SQL::ResultCursor>);
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
 
     DatabaseConnection& m_connection;
     SQL::StatementID m_statement_id { 0 };
 
     struct Execution {
-        SQL::ResultSet result;
+        NonnullOwnPtr<SQL::ResultCursor> cursor;
+        Optional<SQL::Tuple> next_row;
         size_t result_size { 0 };
     };
     HashMap<SQL::ExecutionID, Execution> m_ongoing_executions;
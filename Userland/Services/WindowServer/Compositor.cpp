@@ -18,6 +18,7 @@
 #include <AK/Memory.h>
 #include <AK/ScopeGuard.h>
 #include <AK/TemporaryChange.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Timer.h>
 #include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Font/Font.h>
@@ -180,6 +181,11 @@ void Compositor::compose()
         return;
     }
 
+    auto frame_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    ScopeGuard record_frame_time = [&] {
+        record_frame_time_sample(frame_timer.elapsed_time());
+    };
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -599,10 +605,51 @@ void Compositor::compose()
         screen_data.draw_cursor(cursor_screen, cursor_rect);
     }
 
+    flush_all_screens();
+}
+
+void Compositor::flush_all_screens()
+{
+    if (Screen::count() <= 1) {
+        Screen::for_each([&](auto& screen) {
+            flush(screen);
+            return IterationDecision::Continue;
+        });
+        return;
+    }
+
+    // Flushing only touches the per-screen buffers and device, so with multiple screens
+    // we can copy each of them on its own thread instead of one after another.
+    if (!m_flush_thread_pool) {
+        m_flush_thread_pool = make<Threading::ThreadPool<Screen*>>([this](Screen* screen) {
+            flush(*screen);
+        });
+    }
     Screen::for_each([&](auto& screen) {
-        flush(screen);
+        m_flush_thread_pool->submit(&screen);
         return IterationDecision::Continue;
     });
+    m_flush_thread_pool->wait_for_all();
+}
+
+void Compositor::record_frame_time_sample(Duration frame_time)
+{
+    auto bucket = min(static_cast<size_t>(frame_time.to_milliseconds()), m_frame_time_histogram.size() - 1);
+    m_frame_time_histogram[bucket]++;
+}
+
+Vector<u64> Compositor::frame_time_histogram() const
+{
+    Vector<u64> histogram;
+    histogram.ensure_capacity(m_frame_time_histogram.size());
+    for (auto count : m_frame_time_histogram)
+        histogram.unchecked_append(count);
+    return histogram;
+}
+
+void Compositor::reset_frame_time_histogram()
+{
+    m_frame_time_histogram.fill(0);
 }
 
 void Compositor::flush(Screen& screen)
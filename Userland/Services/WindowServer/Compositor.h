@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <LibCore/EventReceiver.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Font/Font.h>
+#include <LibThreading/ThreadPool.h>
 #include <WindowServer/Overlays.h>
 
 namespace WindowServer {
@@ -184,6 +186,11 @@ public:
 
     void set_flash_flush(bool b) { m_flash_flush = b; }
 
+    // One bucket per millisecond of compose time, the last bucket collects all slower frames.
+    static constexpr size_t frame_time_histogram_bucket_count = 34;
+    Vector<u64> frame_time_histogram() const;
+    void reset_frame_time_histogram();
+
     static NonnullOwnPtr<CompositorScreenData> create_screen_data(Badge<Screen>)
     {
         return adopt_own(*new CompositorScreenData());
@@ -205,6 +212,8 @@ private:
     void recompute_occlusions();
     void change_cursor(Cursor const*);
     void flush(Screen&);
+    void flush_all_screens();
+    void record_frame_time_sample(Duration);
     Gfx::IntPoint window_transition_offset(Window&);
     void update_animations(Screen&, Gfx::DisjointIntRectSet& flush_rects);
     void create_window_stack_switch_overlay(WindowStack&);
@@ -251,6 +260,9 @@ private:
     Optional<Gfx::Color> m_custom_background_color;
 
     HashTable<Animation*> m_animations;
+
+    OwnPtr<Threading::ThreadPool<Screen*>> m_flush_thread_pool;
+    Array<u64, frame_time_histogram_bucket_count> m_frame_time_histogram {};
 };
 
 }
@@ -1357,6 +1357,16 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+Messages::WindowServer::GetFrameTimeHistogramResponse ConnectionFromClient::get_frame_time_histogram()
+{
+    return Compositor::the().frame_time_histogram();
+}
+
+void ConnectionFromClient::reset_frame_time_histogram()
+{
+    Compositor::the().reset_frame_time_histogram();
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
@@ -54,6 +54,7 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(load_json);
     JS_DECLARE_NATIVE_FUNCTION(last_value_getter);
     JS_DECLARE_NATIVE_FUNCTION(print);
+    JS_DECLARE_NATIVE_FUNCTION(inline_cache_stats);
 };
 
 class ScriptObject final : public JS::GlobalObject {
@@ -324,6 +325,7 @@ void ReplObject::initialize(JS::Realm& realm)
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
     define_native_function(realm, "print", print, 1, attr);
+    define_native_function(realm, "inlineCacheStats", inline_cache_stats, 0, attr);
 
     define_native_accessor(
         realm,
@@ -371,6 +373,7 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     warnln("REPL commands:");
     warnln("    exit(code): exit the REPL with specified code. Defaults to 0.");
     warnln("    help(): display this menu");
+    warnln("    inlineCacheStats(): print the hit and miss counts of every property lookup cache.");
     warnln("    loadINI(file): load the given file as INI.");
     warnln("    loadJSON(file): load the given file as JSON.");
     warnln("    print(value): pretty-print the given JS value.");
@@ -378,6 +381,14 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::inline_cache_stats)
+{
+    JS::Bytecode::Executable::for_each_live_executable([](auto const& executable) {
+        executable.dump_property_lookup_cache_statistics();
+    });
+    return JS::js_undefined();
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::load_ini)
 {
     return load_ini_impl(vm);
@@ -533,6 +544,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    bool disable_bytecode_optimizations = false;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -540,6 +552,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(disable_bytecode_optimizations, "Disable bytecode optimization passes (use with -d to dump the unoptimized bytecode)", "disable-bytecode-optimizations", 'p');
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
@@ -553,6 +566,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.parse(arguments);
 
     bool syntax_highlight = !disable_syntax_highlight;
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
 
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
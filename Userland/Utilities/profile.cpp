@@ -5,19 +5,23 @@
  */
 
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <poll.h>
 #include <serenity.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 static Optional<pid_t> determine_pid_to_profile(StringView pid_argument, bool all_processes);
+static ErrorOr<void> drain_profile_stream(Core::File& output_file);
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     Core::ArgsParser args_parser;
 
     StringView pid_argument {};
+    StringView output_path {};
     Vector<StringView> command;
     bool wait = false;
     bool free = false;
@@ -35,6 +39,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(disable, "Disable", nullptr, 'd');
     args_parser.add_option(free, "Free the profiling buffer for the associated process(es).", nullptr, 'f');
     args_parser.add_option(wait, "Enable profiling and wait for user input to disable.", nullptr, 'w');
+    args_parser.add_option(output_path, "With -a -w, keep draining /sys/kernel/profile_stream into this file while profiling", nullptr, 'o', "path");
     args_parser.add_option(Core::ArgsParser::Option {
         Core::ArgsParser::OptionArgumentMode::Required,
         "Enable tracking specific event type", nullptr, 't', "event_type",
@@ -54,6 +59,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 event_mask |= PERF_EVENT_SYSCALL;
             else if (event_type == "filesystem")
                 event_mask |= PERF_EVENT_FILESYSTEM;
+            else if (event_type == "lock_contention")
+                event_mask |= PERF_EVENT_LOCK_CONTENTION;
+            else if (event_type == "off_cpu")
+                event_mask |= PERF_EVENT_OFF_CPU;
             else {
                 warnln("Unknown event type '{}' specified.", event_type);
                 exit(1);
@@ -65,7 +74,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto print_types = [] {
         outln();
-        outln("Event type can be one of: sample, context_switch, page_fault, syscall, filesystem, kmalloc and kfree.");
+        outln("Event type can be one of: sample, context_switch, page_fault, syscall, filesystem, lock_contention, off_cpu, kmalloc and kfree.");
     };
 
     if (!args_parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage)) {
@@ -94,6 +103,11 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return 1;
         }
 
+        if (!output_path.is_empty() && !(all_processes && wait)) {
+            warnln("-o requires -a and -w.");
+            return 1;
+        }
+
         pid_t pid = pid_opt.value();
         if (wait || enable) {
             TRY(Core::System::profiling_enable(pid, event_mask));
@@ -102,6 +116,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 return 0;
         }
 
+        if (wait && !output_path.is_empty()) {
+            auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+            outln("Profiling enabled, writing to {}, waiting for user input to disable...", output_path);
+
+            // The kernel buffer only holds a few seconds worth of events on a busy system,
+            // so move them into the file as we go instead of reading them all at the end.
+            pollfd stdin_pollfd { .fd = STDIN_FILENO, .events = POLLIN, .revents = 0 };
+            while (TRY(Core::System::poll({ &stdin_pollfd, 1 }, 1000)) == 0)
+                TRY(drain_profile_stream(*output_file));
+
+            TRY(Core::System::profiling_disable(pid));
+            TRY(drain_profile_stream(*output_file));
+            return 0;
+        }
+
         if (wait) {
             outln("Profiling enabled, waiting for user input to disable...");
             (void)getchar();
@@ -123,6 +152,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     return 0;
 }
 
+static ErrorOr<void> drain_profile_stream(Core::File& output_file)
+{
+    // Every read of profile_stream hands out a self-contained perfcore with the events
+    // recorded since the previous one; Profiler loads a file of them back to back.
+    auto stream = TRY(Core::File::open("/sys/kernel/profile_stream"sv, Core::File::OpenMode::Read));
+    auto data = TRY(stream->read_until_eof());
+    TRY(output_file.write_until_depleted(data));
+    return {};
+}
+
 static Optional<pid_t> determine_pid_to_profile(StringView pid_argument, bool all_processes)
 {
     if (all_processes) {
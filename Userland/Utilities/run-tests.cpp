@@ -331,6 +331,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     ByteString test_glob;
     ByteString exclude_pattern;
     ByteString config_file;
+    StringView benchmark_results_directory;
+    StringView benchmark_baseline_directory;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(Core::ArgsParser::Option {
@@ -351,6 +353,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(print_json, "Show results as JSON", "json", 'j');
     args_parser.add_option(print_all_output, "Show all test output", "verbose", 'v');
     args_parser.add_option(run_benchmarks, "Run benchmarks as well", "benchmarks", 'b');
+    args_parser.add_option(benchmark_results_directory, "Save the benchmark results of each test as JSON in this directory", "benchmark-results", 0, "directory");
+    args_parser.add_option(benchmark_baseline_directory, "Fail benchmarks that regressed compared to the results saved in this directory", "benchmark-baseline", 0, "directory");
     args_parser.add_option(run_skipped_tests, "Run all matching tests, even those marked as 'skip'", "all", 'a');
     args_parser.add_option(unlink_coredumps, "Unlink coredumps after printing backtraces", "unlink-coredumps");
     args_parser.add_option(test_glob, "Only run tests matching the given glob", "filter", 'f', "glob");
@@ -367,6 +371,22 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     // Make UBSAN deadly for all tests we run by default.
     TRY(Core::Environment::set("UBSAN_OPTIONS"sv, "halt_on_error=1"sv, Core::Environment::Overwrite::Yes));
 
+    // Results that are saved or compared should be statistically meaningful, so take more than a single sample
+    // of each benchmark unless told otherwise. Tests are run from their own directory, so the benchmark
+    // directories have to be absolute.
+    if (!benchmark_results_directory.is_empty() || !benchmark_baseline_directory.is_empty()) {
+        TRY(Core::Environment::set("BENCHMARK_REPETITIONS"sv, "10"sv, Core::Environment::Overwrite::No));
+        TRY(Core::Environment::set("BENCHMARK_MIN_SAMPLE_TIME"sv, "10"sv, Core::Environment::Overwrite::No));
+    }
+    if (!benchmark_results_directory.is_empty()) {
+        run_benchmarks = true;
+        TRY(Core::Environment::set("BENCHMARK_RESULTS_DIR"sv, TRY(FileSystem::absolute_path(benchmark_results_directory)), Core::Environment::Overwrite::Yes));
+    }
+    if (!benchmark_baseline_directory.is_empty()) {
+        run_benchmarks = true;
+        TRY(Core::Environment::set("BENCHMARK_BASELINE_DIR"sv, TRY(FileSystem::absolute_path(benchmark_baseline_directory)), Core::Environment::Overwrite::Yes));
+    }
+
     if (!run_benchmarks)
         TRY(Core::Environment::set("TESTS_ONLY"sv, "1"sv, Core::Environment::Overwrite::Yes));
 
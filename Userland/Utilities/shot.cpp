@@ -11,6 +11,7 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/Process.h>
+#include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/Clipboard.h>
@@ -150,7 +151,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 0;
     }
 
-    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap);
+    // Screenshots can be huge, so trade a bit of file size for not keeping the user waiting.
+    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap, { .compression_level = Gfx::PNGWriter::Options::CompressionLevel::Default, .compression_thread_count = Core::System::hardware_concurrency() });
     if (encoded_bitmap_or_error.is_error()) {
         warnln("Failed to encode PNG");
         return 1;
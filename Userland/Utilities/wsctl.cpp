@@ -8,16 +8,46 @@
 #include <LibGUI/Application.h>
 #include <LibGUI/ConnectionToWindowServer.h>
 
+static void print_frame_time_histogram(Vector<u64> const& bucket_counts)
+{
+    u64 total_frames = 0;
+    for (auto count : bucket_counts)
+        total_frames += count;
+
+    outln("Compositor frame times ({} frames):", total_frames);
+    if (total_frames == 0)
+        return;
+
+    for (size_t bucket = 0; bucket < bucket_counts.size(); ++bucket) {
+        auto count = bucket_counts[bucket];
+        if (count == 0)
+            continue;
+        auto percentage = static_cast<double>(count) * 100.0 / static_cast<double>(total_frames);
+        if (bucket == bucket_counts.size() - 1)
+            outln("  >= {:2} ms: {:8} ({:.1}%)", bucket, count, percentage);
+        else
+            outln("     {:2} ms: {:8} ({:.1}%)", bucket, count, percentage);
+    }
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     auto app = TRY(GUI::Application::create(arguments));
 
     int flash_flush = -1;
+    bool show_frame_times = false;
+    bool reset_frame_times = false;
     Core::ArgsParser args_parser;
     args_parser.add_option(flash_flush, "Flash flush (repaint) rectangles", "flash-flush", 'f', "0/1");
+    args_parser.add_option(show_frame_times, "Show a histogram of compositor frame times", "frame-times", 't');
+    args_parser.add_option(reset_frame_times, "Reset the compositor frame time histogram", "reset-frame-times", 'r');
     args_parser.parse(arguments);
 
     if (flash_flush != -1)
         GUI::ConnectionToWindowServer::the().async_set_flash_flush(flash_flush);
+    if (show_frame_times)
+        print_frame_time_histogram(GUI::ConnectionToWindowServer::the().get_frame_time_histogram());
+    if (reset_frame_times)
+        GUI::ConnectionToWindowServer::the().async_reset_frame_time_histogram();
     return 0;
 }